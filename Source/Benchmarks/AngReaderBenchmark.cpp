@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/TSL/AngReader.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Writes a square grid .ang file with 'numRows' x 'numCols' points. The values
+// are formatted the same way the TSL software writes them.
+// -----------------------------------------------------------------------------
+bool WriteSyntheticAngFile(const std::string& filePath, int32_t numRows, int32_t numCols)
+{
+  FILE* f = std::fopen(filePath.c_str(), "wb");
+  if(nullptr == f)
+  {
+    return false;
+  }
+  std::fprintf(f, "# TEM_PIXperUM          1.000000\n# x-star                0.372300\n# y-star                0.689300\n# z-star                0.970100\n");
+  std::fprintf(f, "# WorkingDistance       5.000000\n#\n# Phase 1\n# MaterialName  \tNickel\n# Formula     \tNi\n# Info\t\t\n# Symmetry              43\n");
+  std::fprintf(f, "# LatticeConstants      3.520 3.520 3.520  90.000  90.000  90.000\n# NumberFamilies        1\n# hklFamilies   \t 1  1  1 1 0.000000\n");
+  std::fprintf(f, "# Categories 0 0 0 0 0 \n#\n# GRID: SqrGrid\n# XSTEP: 0.250000\n# YSTEP: 0.250000\n");
+  std::fprintf(f, "# NCOLS_ODD: %d\n# NCOLS_EVEN: %d\n# NROWS: %d\n#\n# OPERATOR: \tBenchmark\n#\n# SAMPLEID: \t\n#\n# SCANID: \t\n#\n", numCols, numCols, numRows);
+
+  uint32_t seed = 5489u;
+  for(int32_t y = 0; y < numRows; y++)
+  {
+    for(int32_t x = 0; x < numCols; x++)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      float phi1 = static_cast<float>(seed % 62831u) * 0.0001f;
+      float phi = static_cast<float>((seed >> 8) % 31415u) * 0.0001f;
+      float phi2 = static_cast<float>((seed >> 4) % 62831u) * 0.0001f;
+      std::fprintf(f, " %8.5f %8.5f %8.5f %12.5f %12.5f %6.1f %6.3f  %d %6d %7.3f\n", phi1, phi, phi2, x * 0.25f, y * 0.25f, static_cast<float>(seed % 2000u) * 0.1f,
+                   static_cast<float>(seed % 1000u) * 0.001f, 1, static_cast<int>(seed % 4096u), static_cast<float>(seed % 180u));
+    }
+  }
+  std::fclose(f);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+double TimeRead(const std::string& filePath, bool useMemoryMapping, size_t& numElements)
+{
+  auto start = std::chrono::steady_clock::now();
+  AngReader reader;
+  reader.setFileName(filePath);
+  reader.setUseMemoryMapping(useMemoryMapping);
+  int err = reader.readFile();
+  auto end = std::chrono::steady_clock::now();
+  if(err < 0)
+  {
+    std::cout << "Error reading file: " << err << "\n" << reader.getErrorMessage() << std::endl;
+  }
+  numElements = reader.getNumberOfElements();
+  return std::chrono::duration<double>(end - start).count();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  std::string filePath = (fs::temp_directory_path() / "AngReaderBenchmark.ang").string();
+  int32_t numRows = 2500;
+  int32_t numCols = 4000; // 10 Million points by default
+  if(argc > 1)
+  {
+    filePath = argv[1];
+  }
+  if(argc > 3)
+  {
+    numRows = std::stoi(argv[2]);
+    numCols = std::stoi(argv[3]);
+  }
+
+  std::cout << "Writing " << static_cast<size_t>(numRows) * numCols << " points to " << filePath << std::endl;
+  if(!WriteSyntheticAngFile(filePath, numRows, numCols))
+  {
+    std::cout << "Could not write the synthetic file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  size_t numElements = 0;
+  double streamTime = TimeRead(filePath, false, numElements);
+  std::cout << "Stream Reader:        " << streamTime << " s  (" << numElements / streamTime << " points/s)" << std::endl;
+  double mappedTime = TimeRead(filePath, true, numElements);
+  std::cout << "Memory Mapped Reader: " << mappedTime << " s  (" << numElements / mappedTime << " points/s)" << std::endl;
+  std::cout << "Speedup: " << streamTime / mappedTime << "x" << std::endl;
+
+  fs::remove(filePath);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/BatchColumnParser.hpp"
+#include "EbsdLib/IO/HKL/DataParser.hpp"
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+
+namespace
+{
+constexpr size_t k_NumColumns = 11;
+constexpr size_t k_RowsPerBatch = 1024;
+
+// The columns of a .ctf file: Phase X Y Bands Error Euler1 Euler2 Euler3 MAD BC BS
+const bool k_IsInteger[k_NumColumns] = {true, false, false, true, true, false, false, false, false, true, true};
+
+// -----------------------------------------------------------------------------
+// Creates 'numRows' tab delimited lines formatted the same way the HKL software writes them.
+// -----------------------------------------------------------------------------
+std::vector<std::string> CreateSyntheticCtfRows(size_t numRows)
+{
+  std::vector<std::string> rows(numRows);
+  uint32_t seed = 5489u;
+  char buffer[256];
+  for(size_t i = 0; i < numRows; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    std::snprintf(buffer, sizeof(buffer), "1\t%.4f\t%.4f\t%u\t0\t%.4f\t%.4f\t%.4f\t%.4f\t%u\t%u", static_cast<float>(i % 1000) * 0.25f, static_cast<float>(i / 1000) * 0.25f, seed % 12u,
+                  static_cast<float>(seed % 36000u) * 0.01f, static_cast<float>((seed >> 8) % 18000u) * 0.01f, static_cast<float>((seed >> 4) % 36000u) * 0.01f,
+                  static_cast<float>(seed % 1000u) * 0.001f, seed % 256u, (seed >> 3) % 256u);
+    rows[i] = buffer;
+  }
+  return rows;
+}
+
+// -----------------------------------------------------------------------------
+// The original approach: split each line into strings and call the virtual parse() for every cell
+// -----------------------------------------------------------------------------
+double TimeDataParsers(const std::vector<std::string>& rows)
+{
+  size_t numRows = rows.size();
+  std::vector<DataParser::Pointer> parsers(k_NumColumns);
+  for(size_t c = 0; c < k_NumColumns; c++)
+  {
+    std::string name = std::to_string(c);
+    if(k_IsInteger[c])
+    {
+      parsers[c] = Int32Parser::New(nullptr, numRows, name, static_cast<int>(c));
+    }
+    else
+    {
+      parsers[c] = FloatParser::New(nullptr, numRows, name, static_cast<int>(c));
+    }
+    parsers[c]->allocateArray(numRows);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < numRows; i++)
+  {
+    std::string line = rows[i];
+    EbsdStringUtils::StringTokenType tokens = EbsdStringUtils::split(line, '\t');
+    for(const auto& dparser : parsers)
+    {
+      dparser->parse(tokens[dparser->getColumnIndex()], i);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+// -----------------------------------------------------------------------------
+// The batch approach: hand blocks of string_views to the BatchColumnParser
+// -----------------------------------------------------------------------------
+double TimeBatchColumnParser(const std::vector<std::string>& rows)
+{
+  size_t numRows = rows.size();
+  std::vector<std::vector<int32_t>> intColumns(k_NumColumns);
+  std::vector<std::vector<float>> floatColumns(k_NumColumns);
+  BatchColumnParser parser;
+  parser.setDelimiter(BatchColumnParser::Delimiter::Tab);
+  parser.setRequireAllColumns(true);
+  parser.setConvertDecimalCommas(true);
+  parser.setNumberOfColumns(k_NumColumns);
+  for(size_t c = 0; c < k_NumColumns; c++)
+  {
+    if(k_IsInteger[c])
+    {
+      intColumns[c].resize(numRows);
+      parser.setColumn(c, EbsdLib::NumericTypes::Type::Int32, intColumns[c].data());
+    }
+    else
+    {
+      floatColumns[c].resize(numRows);
+      parser.setColumn(c, EbsdLib::NumericTypes::Type::Float, floatColumns[c].data());
+    }
+  }
+
+  std::vector<std::string_view> views(k_RowsPerBatch);
+  auto start = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < numRows; i += k_RowsPerBatch)
+  {
+    size_t count = std::min(k_RowsPerBatch, numRows - i);
+    for(size_t r = 0; r < count; r++)
+    {
+      views[r] = rows[i + r];
+    }
+    if(parser.parseRows(views.data(), count, i) < 0)
+    {
+      std::cout << "Parse error at row " << i + parser.getErrorRow() << std::endl;
+      break;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numRows = 2000000;
+  if(argc > 1)
+  {
+    numRows = std::stoull(argv[1]);
+  }
+
+  std::cout << "Creating " << numRows << " rows of " << k_NumColumns << " columns" << std::endl;
+  std::vector<std::string> rows = CreateSyntheticCtfRows(numRows);
+  double numCells = static_cast<double>(numRows * k_NumColumns);
+
+  double parserTime = TimeDataParsers(rows);
+  std::cout << "DataParser::parse():  " << parserTime << " s  (" << numCells / parserTime << " cells/s)" << std::endl;
+  double batchTime = TimeBatchColumnParser(rows);
+  std::cout << "BatchColumnParser:    " << batchTime << " s  (" << numCells / batchTime << " cells/s)" << std::endl;
+  std::cout << "Speedup: " << parserTime / batchTime << "x" << std::endl;
+  return EXIT_SUCCESS;
+}
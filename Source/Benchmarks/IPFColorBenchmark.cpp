@@ -0,0 +1,70 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numVoxels = 1000000;
+  if(argc > 1)
+  {
+    numVoxels = std::stoull(argv[1]);
+  }
+
+  std::mt19937_64 generator(5489u);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<float> eulers(numVoxels * 3);
+  for(size_t i = 0; i < numVoxels; i++)
+  {
+    eulers[i * 3] = static_cast<float>(distribution(generator) * EbsdLib::Constants::k_2PiD);
+    eulers[i * 3 + 1] = static_cast<float>(distribution(generator) * EbsdLib::Constants::k_PiD);
+    eulers[i * 3 + 2] = static_cast<float>(distribution(generator) * EbsdLib::Constants::k_2PiD);
+  }
+  double refDir[3] = {0.0, 0.0, 1.0};
+  std::vector<uint8_t> colors(numVoxels * 3);
+  std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+
+  std::cout << "IPF colors of " << numVoxels << " random voxels (voxels/s)" << std::endl;
+  std::cout << std::setw(28) << "Laue Class" << std::setw(8) << "SymOps" << std::setw(14) << "Scalar" << std::setw(14) << "Batch" << std::setw(10) << "Speedup" << std::endl;
+  std::cout << std::scientific << std::setprecision(3);
+
+  std::vector<int32_t> phases(numVoxels, 1);
+  for(uint32_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+  {
+    const LaueOps::Pointer& ops = allOps[laueIndex];
+
+    // The per voxel virtual call that make_ipf used before
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < numVoxels; i++)
+    {
+      double euler[3] = {eulers[i * 3], eulers[i * 3 + 1], eulers[i * 3 + 2]};
+      EbsdLib::Rgb argb = ops->generateIPFColor(euler, refDir, false);
+      colors[i * 3] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+      colors[i * 3 + 1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+      colors[i * 3 + 2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double scalarRate = static_cast<double>(numVoxels) / std::chrono::duration<double>(end - start).count();
+
+    // Phase 0 is unused, phase 1 has the Laue class being measured
+    std::vector<uint32_t> crystalStructures = {EbsdLib::CrystalStructure::UnknownCrystalStructure, laueIndex};
+    start = std::chrono::steady_clock::now();
+    LaueOps::GenerateIPFColors(eulers.data(), phases.data(), crystalStructures, refDir, nullptr, numVoxels, colors.data());
+    end = std::chrono::steady_clock::now();
+    double batchRate = static_cast<double>(numVoxels) / std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::setw(28) << ops->getSymmetryName() << std::setw(8) << ops->getNumSymOps() << std::setw(14) << scalarRate << std::setw(14) << batchRate << std::setw(10) << batchRate / scalarRate
+              << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+std::vector<float> CreateRandomQuats(size_t numQuats, std::mt19937_64& generator)
+{
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<float> quats(numQuats * 4);
+  for(size_t i = 0; i < numQuats; i++)
+  {
+    OrientationD eu(distribution(generator) * EbsdLib::Constants::k_2PiD, distribution(generator) * EbsdLib::Constants::k_PiD, distribution(generator) * EbsdLib::Constants::k_2PiD);
+    QuatD q = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+    quats[i * 4] = static_cast<float>(q.x());
+    quats[i * 4 + 1] = static_cast<float>(q.y());
+    quats[i * 4 + 2] = static_cast<float>(q.z());
+    quats[i * 4 + 3] = static_cast<float>(q.w());
+  }
+  return quats;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numPairs = 1000000;
+  if(argc > 1)
+  {
+    numPairs = std::stoull(argv[1]);
+  }
+
+  std::mt19937_64 generator(5489u);
+  std::vector<float> q1 = CreateRandomQuats(numPairs, generator);
+  std::vector<float> q2 = CreateRandomQuats(numPairs, generator);
+  std::vector<float> axisAngles(numPairs * 4);
+
+  std::cout << "Misorientations of " << numPairs << " random quaternion pairs (pairs/s)" << std::endl;
+  std::cout << std::setw(28) << "Laue Class" << std::setw(8) << "SymOps" << std::setw(14) << "Scalar" << std::setw(14) << "Batch" << std::setw(10) << "Speedup" << std::endl;
+  std::cout << std::scientific << std::setprecision(3);
+
+  std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+  for(size_t opIndex = 0; opIndex < 11; opIndex++)
+  {
+    const LaueOps::Pointer& ops = allOps[opIndex];
+
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < numPairs; i++)
+    {
+      QuatF qa(q1[i * 4], q1[i * 4 + 1], q1[i * 4 + 2], q1[i * 4 + 3]);
+      QuatF qb(q2[i * 4], q2[i * 4 + 1], q2[i * 4 + 2], q2[i * 4 + 3]);
+      OrientationF axisAngle = ops->calculateMisorientation(qa, qb);
+      axisAngle.copyInto(axisAngles.data() + i * 4, 4);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double scalarRate = static_cast<double>(numPairs) / std::chrono::duration<double>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ops->calculateMisorientations(q1.data(), q2.data(), numPairs, axisAngles.data());
+    end = std::chrono::steady_clock::now();
+    double batchRate = static_cast<double>(numPairs) / std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::setw(28) << ops->getSymmetryName() << std::setw(8) << ops->getNumSymOps() << std::setw(14) << scalarRate << std::setw(14) << batchRate << std::setw(10) << batchRate / scalarRate
+              << std::endl;
+  }
+
+  std::cout << std::endl << "Fundamental zone reduction of " << numPairs << " random quaternions (quats/s)" << std::endl;
+  std::cout << std::setw(28) << "Laue Class" << std::setw(8) << "SymOps" << std::setw(14) << "Scalar" << std::setw(14) << "Batch" << std::setw(10) << "Speedup" << std::endl;
+  std::vector<float> fzQuats(numPairs * 4);
+  for(size_t opIndex = 0; opIndex < 11; opIndex++)
+  {
+    const LaueOps::Pointer& ops = allOps[opIndex];
+
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < numPairs; i++)
+    {
+      QuatD fz = ops->getFZQuat(QuatD(q1[i * 4], q1[i * 4 + 1], q1[i * 4 + 2], q1[i * 4 + 3]));
+      fzQuats[i * 4] = static_cast<float>(fz.x());
+      fzQuats[i * 4 + 1] = static_cast<float>(fz.y());
+      fzQuats[i * 4 + 2] = static_cast<float>(fz.z());
+      fzQuats[i * 4 + 3] = static_cast<float>(fz.w());
+    }
+    auto end = std::chrono::steady_clock::now();
+    double scalarRate = static_cast<double>(numPairs) / std::chrono::duration<double>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ops->getFZQuats(q1.data(), numPairs, fzQuats.data());
+    end = std::chrono::steady_clock::now();
+    double batchRate = static_cast<double>(numPairs) / std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::setw(28) << ops->getSymmetryName() << std::setw(8) << ops->getNumSymOps() << std::setw(14) << scalarRate << std::setw(14) << batchRate << std::setw(10) << batchRate / scalarRate
+              << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
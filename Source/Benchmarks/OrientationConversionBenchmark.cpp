@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/FixedOrientation.hpp"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/OrientationMath/OrientationBatchKernels.hpp"
+#include "EbsdLib/OrientationMath/OrientationConverter.hpp"
+
+namespace
+{
+template <typename T>
+struct TypeTag
+{
+  using type = T;
+};
+
+/**
+ * @brief Tuple knows how to create a representation from a tuple in a flat array and how to store it back.
+ */
+template <typename Type>
+struct Tuple;
+
+template <>
+struct Tuple<OrientationF>
+{
+  static OrientationF make(float* ptr, size_t stride)
+  {
+    return OrientationF(ptr, stride);
+  }
+  static void store(const OrientationF& value, float* ptr, size_t stride)
+  {
+    value.copyInto(ptr, stride);
+  }
+};
+
+template <size_t N>
+struct Tuple<FixedOrientation<float, N>>
+{
+  static FixedOrientation<float, N> make(float* ptr, size_t stride)
+  {
+    return FixedOrientation<float, N>(ptr);
+  }
+  static void store(const FixedOrientation<float, N>& value, float* ptr, size_t stride)
+  {
+    value.copyInto(ptr, stride);
+  }
+};
+
+template <>
+struct Tuple<QuatF>
+{
+  static QuatF make(float* ptr, size_t stride)
+  {
+    return QuatF(ptr[0], ptr[1], ptr[2], ptr[3]);
+  }
+  static void store(const QuatF& value, float* ptr, size_t stride)
+  {
+    value.copyInto(ptr, QuatF::Order::VectorScalar);
+  }
+};
+
+// The types used by the heap based Orientation path and the stack based FixedOrientation path for each representation
+using Dyn_eu = OrientationF;
+using Dyn_om = OrientationF;
+using Dyn_ax = OrientationF;
+using Dyn_ro = OrientationF;
+using Dyn_qu = QuatF;
+using Dyn_ho = OrientationF;
+using Dyn_cu = OrientationF;
+
+using Fix_eu = Euler3<float>;
+using Fix_om = OrientationMatrix9<float>;
+using Fix_ax = AxisAngle4<float>;
+using Fix_ro = Rodrigues4<float>;
+using Fix_qu = QuatF;
+using Fix_ho = Homochoric3<float>;
+using Fix_cu = Cubochoric3<float>;
+
+enum Representation : size_t
+{
+  k_eu = 0,
+  k_om,
+  k_ax,
+  k_ro,
+  k_qu,
+  k_ho,
+  k_cu,
+  k_NumRepresentations
+};
+
+const size_t k_Strides[k_NumRepresentations] = {3, 9, 4, 4, 4, 3, 3};
+
+// -----------------------------------------------------------------------------
+template <typename InType, typename OutType, typename Function>
+double TimeConversion(std::vector<float>& input, size_t inStride, std::vector<float>& output, size_t outStride, Function function)
+{
+  size_t numTuples = input.size() / inStride;
+  auto start = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    InType in = Tuple<InType>::make(input.data() + i * inStride, inStride);
+    Tuple<OutType>::store(function(in, TypeTag<OutType>()), output.data() + i * outStride, outStride);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return static_cast<double>(numTuples) / std::chrono::duration<double>(end - start).count();
+}
+
+// -----------------------------------------------------------------------------
+template <typename DynIn, typename DynOut, typename FixIn, typename FixOut, typename Function>
+void RunPair(const std::string& name, std::vector<float>& input, size_t inStride, size_t outStride, Function function)
+{
+  std::vector<float> output(input.size() / inStride * outStride);
+  double dynRate = TimeConversion<DynIn, DynOut>(input, inStride, output, outStride, function);
+  double fixRate = TimeConversion<FixIn, FixOut>(input, inStride, output, outStride, function);
+  std::cout << std::setw(6) << name << std::setw(18) << dynRate << std::setw(18) << fixRate << std::setw(10) << fixRate / dynRate << std::endl;
+}
+
+#define RUN_PAIR(FROM, TO)                                                                                                                                                                             \
+  RunPair<Dyn_##FROM, Dyn_##TO, Fix_##FROM, Fix_##TO>(#FROM "2" #TO, data[k_##FROM], k_Strides[k_##FROM], k_Strides[k_##TO], [](const auto& in, auto tag) {                                              \
+    using InType = std::decay_t<decltype(in)>;                                                                                                                                                         \
+    using OutType = typename decltype(tag)::type;                                                                                                                                                      \
+    return OrientationTransformation::FROM##2##TO<InType, OutType>(in);                                                                                                                                \
+  });
+
+// -----------------------------------------------------------------------------
+template <class Scalar, class Kernel>
+void RunBatchPair(const std::string& name, std::vector<float>& input)
+{
+  size_t numTuples = input.size() / Kernel::k_InStride;
+  std::vector<float> output(numTuples * Kernel::k_OutStride);
+
+  auto start = std::chrono::steady_clock::now();
+  ConvertRepresentation<float, Scalar> serial(input.data(), output.data(), Kernel::k_InStride, Kernel::k_OutStride);
+  serial.convert(0, numTuples);
+  auto end = std::chrono::steady_clock::now();
+  double scalarRate = static_cast<double>(numTuples) / std::chrono::duration<double>(end - start).count();
+
+  start = std::chrono::steady_clock::now();
+  OrientationBatch::convert<float, Kernel>(input.data(), output.data(), numTuples);
+  end = std::chrono::steady_clock::now();
+  double batchRate = static_cast<double>(numTuples) / std::chrono::duration<double>(end - start).count();
+
+  std::cout << std::setw(6) << name << std::setw(18) << scalarRate << std::setw(18) << batchRate << std::setw(10) << batchRate / scalarRate << std::endl;
+}
+
+#define RUN_BATCH_PAIR(FROM, TO, NAME) RunBatchPair<Convertors::NAME<float>, OrientationBatch::NAME<float>>(#FROM "2" #TO, data[k_##FROM]);
+
+// -----------------------------------------------------------------------------
+void RunFusedConversion(const std::vector<float>& eulers)
+{
+  using OCType = OrientationConverter<EbsdLib::FloatArrayType, float>;
+  size_t numTuples = eulers.size() / 3;
+  EbsdLib::FloatArrayType::Pointer eulerArray = EbsdLib::FloatArrayType::CreateArray(numTuples, {3ULL}, "Eulers", true);
+  std::copy(eulers.begin(), eulers.end(), eulerArray->getPointer(0));
+  OCType::Pointer converter = EulerConverter<EbsdLib::FloatArrayType, float>::New();
+  converter->setInputData(eulerArray);
+
+  const std::vector<OrientationRepresentation::Type> targets = {OrientationRepresentation::Type::Quaternion, OrientationRepresentation::Type::Rodrigues,
+                                                                OrientationRepresentation::Type::OrientationMatrix};
+  auto start = std::chrono::steady_clock::now();
+  for(const auto& target : targets)
+  {
+    converter->convertRepresentationTo(target);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double separateRate = static_cast<double>(numTuples) / std::chrono::duration<double>(end - start).count();
+
+  std::vector<EbsdLib::FloatArrayType::Pointer> outputs = {EbsdLib::FloatArrayType::CreateArray(numTuples, {4ULL}, "Quats", true),
+                                                           EbsdLib::FloatArrayType::CreateArray(numTuples, {4ULL}, "Rodrigues", true),
+                                                           EbsdLib::FloatArrayType::CreateArray(numTuples, {9ULL}, "OrientationMatrix", true)};
+  start = std::chrono::steady_clock::now();
+  converter->convertRepresentationsTo(targets, outputs);
+  end = std::chrono::steady_clock::now();
+  double fusedRate = static_cast<double>(numTuples) / std::chrono::duration<double>(end - start).count();
+
+  std::cout << std::endl << "Euler to Quaternion, Rodrigues and Orientation Matrix (tuples/s)" << std::endl;
+  std::cout << std::setw(18) << "Separate" << std::setw(18) << "Fused" << std::setw(10) << "Speedup" << std::endl;
+  std::cout << std::setw(18) << separateRate << std::setw(18) << fusedRate << std::setw(10) << fusedRate / separateRate << std::endl;
+}
+
+#define RUN_FROM(FROM, A, B, C, D, E, F)                                                                                                                                                               \
+  RUN_PAIR(FROM, A)                                                                                                                                                                                    \
+  RUN_PAIR(FROM, B)                                                                                                                                                                                    \
+  RUN_PAIR(FROM, C)                                                                                                                                                                                    \
+  RUN_PAIR(FROM, D)                                                                                                                                                                                    \
+  RUN_PAIR(FROM, E)                                                                                                                                                                                    \
+  RUN_PAIR(FROM, F)
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numTuples = 500000;
+  if(argc > 1)
+  {
+    numTuples = std::stoull(argv[1]);
+  }
+
+  // Create random Euler angles and convert them into every other representation
+  std::vector<std::vector<float>> data(k_NumRepresentations);
+  for(size_t r = 0; r < k_NumRepresentations; r++)
+  {
+    data[r].resize(numTuples * k_Strides[r]);
+  }
+  std::mt19937_64 generator(5489u);
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    Fix_eu eu(distribution(generator) * EbsdLib::Constants::k_2PiF, distribution(generator) * EbsdLib::Constants::k_PiF, distribution(generator) * EbsdLib::Constants::k_2PiF);
+    eu.copyInto(data[k_eu].data() + i * 3, 3);
+    OrientationTransformation::eu2om<Fix_eu, Fix_om>(eu).copyInto(data[k_om].data() + i * 9, 9);
+    OrientationTransformation::eu2ax<Fix_eu, Fix_ax>(eu).copyInto(data[k_ax].data() + i * 4, 4);
+    OrientationTransformation::eu2ro<Fix_eu, Fix_ro>(eu).copyInto(data[k_ro].data() + i * 4, 4);
+    OrientationTransformation::eu2qu<Fix_eu, Fix_qu>(eu).copyInto(data[k_qu].data() + i * 4, QuatF::Order::VectorScalar);
+    OrientationTransformation::eu2ho<Fix_eu, Fix_ho>(eu).copyInto(data[k_ho].data() + i * 3, 3);
+    OrientationTransformation::eu2cu<Fix_eu, Fix_cu>(eu).copyInto(data[k_cu].data() + i * 3, 3);
+  }
+
+  std::cout << "Converting " << numTuples << " tuples per conversion pair (tuples/s)" << std::endl;
+  std::cout << std::setw(6) << "Pair" << std::setw(18) << "Orientation" << std::setw(18) << "FixedOrientation" << std::setw(10) << "Speedup" << std::endl;
+  std::cout << std::scientific << std::setprecision(3);
+
+  RUN_FROM(eu, om, ax, ro, qu, ho, cu)
+  RUN_FROM(om, eu, ax, ro, qu, ho, cu)
+  RUN_FROM(ax, eu, om, ro, qu, ho, cu)
+  RUN_FROM(ro, eu, om, ax, qu, ho, cu)
+  RUN_FROM(qu, eu, om, ax, ro, ho, cu)
+  RUN_FROM(ho, eu, om, ax, ro, qu, cu)
+  RUN_FROM(cu, eu, om, ax, ro, qu, ho)
+
+  const std::vector<std::pair<OrientationBatch::InstructionSet, std::string>> instructionSets = {
+      {OrientationBatch::InstructionSet::Portable, "Portable"}, {OrientationBatch::InstructionSet::AVX2, "AVX2"}, {OrientationBatch::InstructionSet::AVX512, "AVX-512"}};
+  for(const auto& instructionSet : instructionSets)
+  {
+    if(!OrientationBatch::SetInstructionSet(instructionSet.first))
+    {
+      continue;
+    }
+    std::cout << std::endl << instructionSet.second << " batch kernels, " << OrientationBatch::GetBatchWidth() << " tuples per iteration, single thread (tuples/s)" << std::endl;
+    std::cout << std::setw(6) << "Pair" << std::setw(18) << "Scalar" << std::setw(18) << "Batch" << std::setw(10) << "Speedup" << std::endl;
+    RUN_BATCH_PAIR(eu, qu, Eu2Qu)
+    RUN_BATCH_PAIR(eu, om, Eu2Om)
+    RUN_BATCH_PAIR(qu, eu, Qu2Eu)
+    RUN_BATCH_PAIR(qu, om, Qu2Om)
+    RUN_BATCH_PAIR(om, qu, Om2Qu)
+    RUN_BATCH_PAIR(qu, ro, Qu2Ro)
+    RUN_BATCH_PAIR(ro, qu, Ro2Qu)
+  }
+
+  // The loop above leaves the best instruction set selected
+  RunFusedConversion(data[k_eu]);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/FixedOrientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/LaueOps/SO3Sampler.h"
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numPoints = 10000000;
+  if(argc > 1)
+  {
+    numPoints = std::stoull(argv[1]);
+  }
+
+  // Uniformly distributed candidate orientations stored in a structure of arrays layout
+  std::mt19937_64 generator(5489u);
+  std::uniform_real_distribution<double> distribution(-0.5 * EbsdLib::LPs::ap, 0.5 * EbsdLib::LPs::ap);
+  std::vector<double> rodrigues(4 * numPoints);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    Cubochoric3<double> cu(distribution(generator), distribution(generator), distribution(generator));
+    Rodrigues4<double> rod = OrientationTransformation::cu2ro<Cubochoric3<double>, Rodrigues4<double>>(cu);
+    for(size_t c = 0; c < 4; c++)
+    {
+      rodrigues[c * numPoints + i] = rod[c];
+    }
+  }
+
+  SO3Sampler::Pointer sampler = SO3Sampler::New();
+  std::vector<uint64_t> mask((numPoints + 63) / 64);
+  std::vector<double> rod(4);
+
+  std::cout << "FZ membership of " << numPoints << " random orientations (points/s)" << std::endl;
+  std::cout << std::setw(8) << "pgnum" << std::setw(12) << "Inside" << std::setw(14) << "Scalar" << std::setw(14) << "Batch" << std::setw(10) << "Speedup" << std::endl;
+
+  // One point group of each FZ type and axis order
+  const std::vector<int> pointGroups = {1, 3, 6, 9, 12, 16, 18, 21, 24, 28, 32};
+  for(int pgnum : pointGroups)
+  {
+    const int fzType = SO3Sampler::GetFZType(pgnum);
+    const int fzOrder = SO3Sampler::GetFZOrder(pgnum);
+
+    // The per point test with the point group switch inside the loop
+    auto start = std::chrono::steady_clock::now();
+    size_t scalarInside = 0;
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      for(size_t c = 0; c < 4; c++)
+      {
+        rod[c] = rodrigues[c * numPoints + i];
+      }
+      scalarInside += sampler->IsinsideFZ(rod.data(), fzType, fzOrder) ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double scalarRate = static_cast<double>(numPoints) / std::chrono::duration<double>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t batchInside = sampler->IsinsideFZ(rodrigues.data(), numPoints, pgnum, mask.data());
+    end = std::chrono::steady_clock::now();
+    double batchRate = static_cast<double>(numPoints) / std::chrono::duration<double>(end - start).count();
+
+    if(scalarInside != batchInside)
+    {
+      std::cout << "Point group " << pgnum << ": the scalar and batch tests disagree (" << scalarInside << " vs " << batchInside << ")" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << std::setw(8) << pgnum << std::setw(12) << batchInside << std::scientific << std::setprecision(3) << std::setw(14) << scalarRate << std::setw(14) << batchRate << std::fixed
+              << std::setprecision(2) << std::setw(10) << batchRate / scalarRate << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,22 @@
+# --------------------------------------------------------------------------
+# Performance benchmarks. These are stand alone executables that are NOT run
+# as part of the unit tests because they generate large synthetic data sets.
+# --------------------------------------------------------------------------
+function(EbsdLibAddBenchmark)
+  set(options)
+  set(oneValueArgs NAME)
+  set(multiValueArgs SOURCES)
+  cmake_parse_arguments(Z "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+
+  add_executable(${Z_NAME} ${Z_SOURCES})
+  target_link_libraries(${Z_NAME} PUBLIC EbsdLib)
+  target_include_directories(${Z_NAME} PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
+  set_target_properties(${Z_NAME} PROPERTIES FOLDER EbsdLibProj/Benchmarks)
+endfunction()
+
+EbsdLibAddBenchmark(NAME AngReaderBenchmark SOURCES ${EbsdLibProj_SOURCE_DIR}/Source/Benchmarks/AngReaderBenchmark.cpp)
+EbsdLibAddBenchmark(NAME ColumnParserBenchmark SOURCES ${EbsdLibProj_SOURCE_DIR}/Source/Benchmarks/ColumnParserBenchmark.cpp)
+EbsdLibAddBenchmark(NAME OrientationConversionBenchmark SOURCES ${EbsdLibProj_SOURCE_DIR}/Source/Benchmarks/OrientationConversionBenchmark.cpp)
+EbsdLibAddBenchmark(NAME MisorientationBenchmark SOURCES ${EbsdLibProj_SOURCE_DIR}/Source/Benchmarks/MisorientationBenchmark.cpp)
+EbsdLibAddBenchmark(NAME IPFColorBenchmark SOURCES ${EbsdLibProj_SOURCE_DIR}/Source/Benchmarks/IPFColorBenchmark.cpp)
+EbsdLibAddBenchmark(NAME SO3FZBenchmark SOURCES ${EbsdLibProj_SOURCE_DIR}/Source/Benchmarks/SO3FZBenchmark.cpp)
@@ -35,13 +35,28 @@
 
 #include "EbsdDataArray.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
 #include <numeric>
 #include <string>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 #ifndef __has_builtin
 #define __has_builtin(x) 0
 #endif
@@ -116,6 +131,215 @@ T byteSwap(T value)
   return value;
 }
 
+constexpr size_t k_CacheLineAlignment = 64;
+constexpr size_t k_HugePageSize = 2 * 1024 * 1024;
+// Every supported OS maps files on at least 4 KiB pages
+constexpr size_t k_MappedPageAlignment = 4096;
+// Smallest number of bytes that one task fills; smaller arrays are filled serially
+constexpr size_t k_FillGrainSize = 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+size_t PolicyAlignment(EbsdLib::AllocationPolicy policy, size_t numBytes)
+{
+  switch(policy)
+  {
+  case EbsdLib::AllocationPolicy::Aligned:
+  case EbsdLib::AllocationPolicy::FirstTouch:
+    return k_CacheLineAlignment;
+  case EbsdLib::AllocationPolicy::HugePage:
+#if defined(__linux__)
+    // Arrays smaller than one huge page are never advised, so 2 MiB alignment would only fragment the heap
+    return numBytes >= k_HugePageSize ? k_HugePageSize : k_CacheLineAlignment;
+#else
+    return k_CacheLineAlignment;
+#endif
+  case EbsdLib::AllocationPolicy::MemoryMapped:
+    return k_MappedPageAlignment;
+  case EbsdLib::AllocationPolicy::Default:
+    break;
+  }
+  return alignof(std::max_align_t);
+}
+
+// -----------------------------------------------------------------------------
+void* AllocateAlignedBytes(size_t numBytes, size_t alignment)
+{
+#if defined(_MSC_VER)
+  return _aligned_malloc(numBytes, alignment);
+#else
+  void* ptr = nullptr;
+  if(posix_memalign(&ptr, alignment, numBytes) != 0)
+  {
+    return nullptr;
+  }
+  return ptr;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void FreeAlignedBytes(void* ptr)
+{
+#if defined(_MSC_VER)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+/**
+ * @brief Book keeping for the blocks of the MemoryMapped policy. An array only holds the
+ * address of its values, so the mapping that owns an address is looked up here when the
+ * block is resized, advised or freed.
+ */
+struct MappedBlock
+{
+  std::unique_ptr<MemoryMappedFile> file;
+  size_t offset = 0;
+};
+
+// -----------------------------------------------------------------------------
+std::mutex& MappedBlocksMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// -----------------------------------------------------------------------------
+std::map<const void*, MappedBlock>& MappedBlocks()
+{
+  static std::map<const void*, MappedBlock> blocks;
+  return blocks;
+}
+
+// -----------------------------------------------------------------------------
+void* RegisterMappedBlock(std::unique_ptr<MemoryMappedFile> file, size_t offset)
+{
+  char* ptr = file->writableData() + offset;
+  std::lock_guard<std::mutex> lock(MappedBlocksMutex());
+  MappedBlocks()[ptr] = MappedBlock{std::move(file), offset};
+  return ptr;
+}
+
+// -----------------------------------------------------------------------------
+void* AllocateMappedBytes(size_t numBytes, const std::string& directory)
+{
+  auto file = std::make_unique<MemoryMappedFile>();
+  if(!file->createScratch(directory, numBytes))
+  {
+    return nullptr;
+  }
+  return RegisterMappedBlock(std::move(file), 0);
+}
+
+// -----------------------------------------------------------------------------
+void* MapFileBytes(const std::string& filePath, size_t offset, size_t numBytes)
+{
+  auto file = std::make_unique<MemoryMappedFile>();
+  if(!file->open(filePath, MemoryMappedFile::OpenMode::CopyOnWrite) || file->size() < offset + numBytes || file->writableData() == nullptr)
+  {
+    return nullptr;
+  }
+  return RegisterMappedBlock(std::move(file), offset);
+}
+
+// -----------------------------------------------------------------------------
+void* ResizeMappedBytes(void* ptr, size_t numBytes)
+{
+  std::lock_guard<std::mutex> lock(MappedBlocksMutex());
+  auto& blocks = MappedBlocks();
+  auto iter = blocks.find(ptr);
+  if(iter == blocks.end() || !iter->second.file->isScratch() || !iter->second.file->resize(numBytes))
+  {
+    return nullptr;
+  }
+  MappedBlock block = std::move(iter->second);
+  blocks.erase(iter);
+  void* newPtr = block.file->writableData();
+  blocks[newPtr] = std::move(block);
+  return newPtr;
+}
+
+// -----------------------------------------------------------------------------
+void FreeMappedBytes(void* ptr)
+{
+  std::unique_ptr<MemoryMappedFile> file;
+  {
+    std::lock_guard<std::mutex> lock(MappedBlocksMutex());
+    auto& blocks = MappedBlocks();
+    auto iter = blocks.find(ptr);
+    if(iter == blocks.end())
+    {
+      return;
+    }
+    file = std::move(iter->second.file);
+    blocks.erase(iter);
+  }
+  // Unmapping can write back dirty pages so it is done outside of the lock
+  file.reset();
+}
+
+// -----------------------------------------------------------------------------
+void AdviseMappedBytes(const void* ptr, MemoryMappedFile::AccessHint hint, size_t offset, size_t numBytes)
+{
+  std::lock_guard<std::mutex> lock(MappedBlocksMutex());
+  auto& blocks = MappedBlocks();
+  auto iter = blocks.find(ptr);
+  if(iter == blocks.end())
+  {
+    return;
+  }
+  iter->second.file->advise(hint, iter->second.offset + offset, numBytes);
+}
+
+/**
+ * @brief Fills a range of elements with a value. Large ranges are split statically
+ * across the worker threads so that each thread writes, and therefore first touches,
+ * one contiguous part of the array.
+ */
+template <typename T>
+class FillImpl
+{
+public:
+  FillImpl(T* data, T value)
+  : m_Data(data)
+  , m_Value(value)
+  {
+  }
+  virtual ~FillImpl() = default;
+
+  void fill(size_t start, size_t end) const
+  {
+    std::fill(m_Data + start, m_Data + end, m_Value);
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    fill(r.begin(), r.end());
+  }
+#endif
+
+private:
+  T* m_Data;
+  T m_Value;
+};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void FillElements(T* data, size_t numElements, T value)
+{
+  FillImpl<T> impl(data, value);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  const size_t grainSize = std::max(k_FillGrainSize / sizeof(T), static_cast<size_t>(1));
+  if(numElements > grainSize)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numElements, grainSize), impl, tbb::static_partitioner());
+    return;
+  }
+#endif
+  impl.fill(0, numElements);
+}
+
 } // namespace
 
 template <typename T>
@@ -224,7 +448,7 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuple
     return nullptr;
   }
   comp_dims_type cDims = {1};
-  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, cDims, static_cast<T>(0), allocate);
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, cDims, static_cast<T>(0), false);
   if(allocate)
   {
     if(d->allocate() < 0)
@@ -246,7 +470,7 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuple
   }
   comp_dims_type cDims(static_cast<size_t>(rank));
   std::copy(dims, dims + rank, cDims.begin());
-  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, cDims, static_cast<T>(0), allocate);
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, cDims, static_cast<T>(0), false);
   if(allocate)
   {
     if(d->allocate() < 0)
@@ -266,7 +490,7 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuple
   {
     return nullptr;
   }
-  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), allocate);
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), false);
   if(allocate)
   {
     if(d->allocate() < 0)
@@ -289,7 +513,7 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(const comp_dims
 
   size_t numTuples = std::accumulate(tupleDims.cbegin(), tupleDims.cend(), static_cast<size_t>(1), std::multiplies<>());
 
-  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), allocate);
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), false);
   if(allocate)
   {
     if(d->allocate() < 0)
@@ -301,6 +525,69 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(const comp_dims
   return d;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuples, const comp_dims_type& compDims, const std::string& name, bool allocate, EbsdLib::AllocationPolicy policy)
+{
+  if(name.empty())
+  {
+    return nullptr;
+  }
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), false);
+  d->m_AllocationPolicy = policy;
+  if(allocate)
+  {
+    if(d->allocate() < 0)
+    {
+      // Could not allocate enough memory, reset the pointer to null and return
+      return nullptr;
+    }
+  }
+  return d;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateUninitializedArray(size_t numTuples, const comp_dims_type& compDims, const std::string& name, EbsdLib::AllocationPolicy policy)
+{
+  if(name.empty())
+  {
+    return nullptr;
+  }
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), false);
+  d->m_AllocationPolicy = policy;
+  if(d->allocateStorage(false) < 0)
+  {
+    // Could not allocate enough memory, reset the pointer to null and return
+    return nullptr;
+  }
+  return d;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::MapFile(const std::string& filePath, size_t byteOffset, size_t numTuples, const comp_dims_type& compDims, const std::string& name)
+{
+  if(name.empty() || byteOffset % sizeof(T) != 0)
+  {
+    return nullptr;
+  }
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), false);
+  d->m_AllocationPolicy = EbsdLib::AllocationPolicy::MemoryMapped;
+  if(d->m_Size == 0)
+  {
+    return d;
+  }
+  auto ptr = static_cast<T*>(MapFileBytes(filePath, byteOffset, d->m_Size * sizeof(T)));
+  if(nullptr == ptr)
+  {
+    return nullptr;
+  }
+  d->m_Array = ptr;
+  d->m_IsAllocated = true;
+  return d;
+}
+
 template <typename T>
 typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::createNewArray(size_t numTuples, int rank, const size_t* compDims, const std::string& name, bool allocate) const
 {
@@ -317,7 +604,8 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::createNewArray(size_t numTu
 template <typename T>
 typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::FromQVector(const std::vector<T>& vec, const std::string& name)
 {
-  Pointer p = CreateArray(static_cast<size_t>(vec.size()), name, true);
+  comp_dims_type cDims = {1};
+  Pointer p = CreateUninitializedArray(static_cast<size_t>(vec.size()), cDims, name);
   if(nullptr != p)
   {
     std::copy(vec.cbegin(), vec.cend(), p->begin());
@@ -330,7 +618,7 @@ template <typename T>
 typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::FromStdVector(const std::vector<T>& vec, const std::string& name)
 {
   comp_dims_type cDims = {1};
-  Pointer p = CreateArray(vec.size(), cDims, name, true);
+  Pointer p = CreateUninitializedArray(vec.size(), cDims, name);
   if(nullptr != p)
   {
     std::copy(vec.cbegin(), vec.cend(), p->begin());
@@ -342,7 +630,8 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::FromStdVector(const std::ve
 template <typename T>
 typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CopyFromPointer(const T* data, size_t size, const std::string& name)
 {
-  Pointer p = CreateArray(size, name, true);
+  comp_dims_type cDims = {1};
+  Pointer p = CreateUninitializedArray(size, cDims, name);
   if(nullptr != p)
   {
     std::copy(data, data + size, p->begin());
@@ -371,6 +660,7 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::WrapPointer(T* data, size_t
   d->m_Array = data;
   // Set who owns the data, i.e., who is going to "free" the memory
   d->m_OwnsData = ownsData;
+  d->m_IsWrapped = true;
   if(nullptr != data)
   {
     d->m_IsAllocated = true;
@@ -401,11 +691,19 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::deepCopy(bool forceNoAlloca
   {
     allocate = false;
   }
-  auto daCopy = CreateArray(getNumberOfTuples(), getComponentDimensions(), getName(), allocate);
-  if(m_IsAllocated && !forceNoAllocate)
+  if(!allocate)
+  {
+    return CreateArray(getNumberOfTuples(), getComponentDimensions(), getName(), false);
+  }
+  // Every value is overwritten by the copy so the new array does not need to be initialized
+  auto daCopy = std::make_shared<EbsdDataArray<T>>(getNumberOfTuples(), getName(), getComponentDimensions(), static_cast<T>(0), false);
+  daCopy->m_AllocationPolicy = m_IsWrapped ? EbsdLib::AllocationPolicy::Default : m_AllocationPolicy;
+  daCopy->m_ScratchDirectory = m_ScratchDirectory;
+  if(daCopy->allocateStorage(false) < 0)
   {
-    std::copy(begin(), end(), daCopy->begin());
+    return nullptr;
   }
+  std::copy(begin(), end(), daCopy->begin());
   return daCopy;
 }
 
@@ -624,6 +922,13 @@ void EbsdDataArray<T>::releaseOwnership()
 // -----------------------------------------------------------------------------
 template <typename T>
 int32_t EbsdDataArray<T>::allocate()
+{
+  return allocateStorage(true);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+int32_t EbsdDataArray<T>::allocateStorage(bool initialize)
 {
   if((nullptr != m_Array) && m_OwnsData)
   {
@@ -639,7 +944,8 @@ int32_t EbsdDataArray<T>::allocate()
   }
 
   size_t newSize = m_Size;
-  m_Array = new(std::nothrow) T[newSize]();
+  m_Array = allocateElements(newSize, initialize);
+  m_IsWrapped = false;
   if(!m_Array)
   {
     std::cout << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
@@ -651,6 +957,106 @@ int32_t EbsdDataArray<T>::allocate()
   return 1;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+int32_t EbsdDataArray<T>::setAllocationPolicy(EbsdLib::AllocationPolicy policy)
+{
+  if(policy == m_AllocationPolicy)
+  {
+    return 1;
+  }
+  if(nullptr == m_Array || !m_OwnsData || m_Size == 0)
+  {
+    m_AllocationPolicy = policy;
+    return 1;
+  }
+
+  const EbsdLib::AllocationPolicy oldPolicy = m_IsWrapped ? EbsdLib::AllocationPolicy::Default : m_AllocationPolicy;
+  m_AllocationPolicy = policy;
+  T* newArray = allocateElements(m_Size, false);
+  if(nullptr == newArray)
+  {
+    m_AllocationPolicy = oldPolicy;
+    std::cout << "Unable to allocate " << m_Size << " elements of size " << sizeof(T) << " bytes. ";
+    return -1;
+  }
+  std::copy(m_Array, m_Array + m_Size, newArray);
+  FreeElements(m_Array, oldPolicy);
+  m_Array = newArray;
+  m_IsWrapped = false;
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+EbsdLib::AllocationPolicy EbsdDataArray<T>::getAllocationPolicy() const
+{
+  return m_AllocationPolicy;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+size_t EbsdDataArray<T>::getAlignment() const
+{
+  if(m_IsWrapped)
+  {
+    return alignof(T);
+  }
+  size_t alignment = std::max(PolicyAlignment(m_AllocationPolicy, m_Size * sizeof(T)), alignof(T));
+  if(m_AllocationPolicy == EbsdLib::AllocationPolicy::MemoryMapped && nullptr != m_Array)
+  {
+    // A mapped file region starts at its byte offset inside of the first page
+    const auto address = reinterpret_cast<uintptr_t>(m_Array);
+    alignment = std::min(alignment, static_cast<size_t>(address & (~address + 1)));
+  }
+  return alignment;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::setScratchDirectory(const std::string& directory)
+{
+  m_ScratchDirectory = directory;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::string EbsdDataArray<T>::getScratchDirectory() const
+{
+  return m_ScratchDirectory;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool EbsdDataArray<T>::isMemoryMapped() const
+{
+  return m_AllocationPolicy == EbsdLib::AllocationPolicy::MemoryMapped && !m_IsWrapped && nullptr != m_Array;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::advise(MemoryMappedFile::AccessHint hint) const
+{
+  if(!isMemoryMapped())
+  {
+    return;
+  }
+  AdviseMappedBytes(m_Array, hint, 0, m_Size * sizeof(T));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::advise(MemoryMappedFile::AccessHint hint, size_t startTuple, size_t numTuples) const
+{
+  if(!isMemoryMapped() || startTuple >= m_NumTuples)
+  {
+    return;
+  }
+  numTuples = std::min(numTuples, m_NumTuples - startTuple);
+  const size_t tupleBytes = m_NumComponents * sizeof(T);
+  AdviseMappedBytes(m_Array, hint, startTuple * tupleBytes, numTuples * tupleBytes);
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 void EbsdDataArray<T>::initializeWithZeros()
@@ -659,7 +1065,7 @@ void EbsdDataArray<T>::initializeWithZeros()
   {
     return;
   }
-  std::fill_n(m_Array, m_Size, static_cast<T>(0));
+  FillElements(m_Array, m_Size, static_cast<T>(0));
 }
 
 // -----------------------------------------------------------------------------
@@ -670,7 +1076,11 @@ void EbsdDataArray<T>::initializeWithValue(T initValue, size_t offset)
   {
     return;
   }
-  std::fill(begin() + offset, end(), initValue);
+  if(offset >= m_Size)
+  {
+    return;
+  }
+  FillElements(m_Array + offset, m_Size - offset, initValue);
 }
 
 // -----------------------------------------------------------------------------
@@ -704,8 +1114,13 @@ int32_t EbsdDataArray<T>::eraseTuples(const comp_dims_type& idxs)
   // Calculate the new size of the array to copy into
   size_t newSize = (getNumberOfTuples() - idxs.size()) * m_NumComponents;
 
-  // Create a new m_Array to copy into
-  T* newArray = new T[newSize]();
+  // Create a new m_Array to copy into. Every value is overwritten by the copy.
+  T* newArray = allocateElements(newSize, false);
+  if(nullptr == newArray)
+  {
+    std::cout << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
+    return -1;
+  }
 
 #ifndef NDEBUG
   // Splat AB across the array so we know if we are copying the values or not
@@ -739,6 +1154,7 @@ int32_t EbsdDataArray<T>::eraseTuples(const comp_dims_type& idxs)
     m_Size = newSize;
     m_Array = newArray;
     m_OwnsData = true;
+    m_IsWrapped = false;
     m_MaxId = newSize - 1;
     m_IsAllocated = true;
     return 0;
@@ -783,6 +1199,7 @@ int32_t EbsdDataArray<T>::eraseTuples(const comp_dims_type& idxs)
   m_Array = newArray;
   // This object has now allocated its memory and owns it.
   m_OwnsData = true;
+  m_IsWrapped = false;
   m_IsAllocated = true;
   m_MaxId = newSize - 1;
 
@@ -1389,6 +1806,7 @@ void EbsdDataArray<T>::clear()
   m_Array = nullptr;
   m_Size = 0;
   m_OwnsData = true;
+  m_IsWrapped = false;
   m_MaxId = 0;
   m_IsAllocated = false;
   m_NumTuples = 0;
@@ -1442,9 +1860,10 @@ void EbsdDataArray<T>::deallocate()
       }
 #endif
 
-  delete[](m_Array);
+  FreeElements(m_Array, m_IsWrapped ? EbsdLib::AllocationPolicy::Default : m_AllocationPolicy);
 
   m_Array = nullptr;
+  m_IsWrapped = false;
   m_IsAllocated = false;
 }
 
@@ -1489,7 +1908,26 @@ T* EbsdDataArray<T>::resizeAndExtend(size_t size)
     return m_Array;
   }
 
-  newArray = new(std::nothrow) T[newSize]();
+  // A scratch file grows in place and MemoryMappedFile::resize() hands back the new bytes zeroed
+  if(m_AllocationPolicy == EbsdLib::AllocationPolicy::MemoryMapped && nullptr != m_Array && m_OwnsData && !m_IsWrapped)
+  {
+    newArray = resizeMappedElements(newSize);
+    if(nullptr != newArray)
+    {
+      m_Size = newSize;
+      m_Array = newArray;
+      m_MaxId = newSize - 1;
+      m_IsAllocated = true;
+      if(newSize > oldSize && m_InitValue != static_cast<T>(0))
+      {
+        initializeWithValue(m_InitValue, oldSize);
+      }
+      return m_Array;
+    }
+  }
+
+  // The copy and the initialization of the new tuples below write every value
+  newArray = allocateElements(newSize, false);
   if(!newArray)
   {
     std::cout << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
@@ -1517,6 +1955,7 @@ T* EbsdDataArray<T>::resizeAndExtend(size_t size)
 
   // This object has now allocated its memory and owns it.
   m_OwnsData = true;
+  m_IsWrapped = false;
 
   m_MaxId = newSize - 1;
   m_IsAllocated = true;
@@ -1530,6 +1969,76 @@ T* EbsdDataArray<T>::resizeAndExtend(size_t size)
   return m_Array;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+T* EbsdDataArray<T>::allocateElements(size_t numElements, bool initialize) const
+{
+  T* ptr = nullptr;
+  if(m_AllocationPolicy == EbsdLib::AllocationPolicy::MemoryMapped)
+  {
+    // New scratch files read as zero so there is nothing to initialize
+    return static_cast<T*>(AllocateMappedBytes(numElements * sizeof(T), m_ScratchDirectory));
+  }
+  if(m_AllocationPolicy == EbsdLib::AllocationPolicy::Default)
+  {
+    ptr = new(std::nothrow) T[numElements];
+  }
+  else
+  {
+    const size_t alignment = std::max(PolicyAlignment(m_AllocationPolicy, numElements * sizeof(T)), alignof(T));
+    ptr = static_cast<T*>(AllocateAlignedBytes(numElements * sizeof(T), alignment));
+  }
+  if(nullptr == ptr)
+  {
+    return nullptr;
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // The advice has to be given before the pages are touched for the first time
+  if(m_AllocationPolicy == EbsdLib::AllocationPolicy::HugePage && numElements * sizeof(T) >= k_HugePageSize)
+  {
+    madvise(ptr, numElements * sizeof(T), MADV_HUGEPAGE);
+  }
+#endif
+
+  // FillElements() splits large arrays statically across the worker threads. The
+  // FirstTouch policy relies on that placement so it is applied even when the caller
+  // is going to overwrite every value.
+  if(initialize || m_AllocationPolicy == EbsdLib::AllocationPolicy::FirstTouch)
+  {
+    FillElements(ptr, numElements, static_cast<T>(0));
+  }
+  return ptr;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::FreeElements(T* ptr, EbsdLib::AllocationPolicy policy)
+{
+  if(nullptr == ptr)
+  {
+    return;
+  }
+  if(policy == EbsdLib::AllocationPolicy::Default)
+  {
+    delete[](ptr);
+    return;
+  }
+  if(policy == EbsdLib::AllocationPolicy::MemoryMapped)
+  {
+    FreeMappedBytes(ptr);
+    return;
+  }
+  FreeAlignedBytes(ptr);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T* EbsdDataArray<T>::resizeMappedElements(size_t numElements)
+{
+  return static_cast<T*>(ResizeMappedBytes(m_Array, numElements * sizeof(T)));
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -44,6 +44,23 @@
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/Utilities/MemoryMappedFile.h"
+
+namespace EbsdLib
+{
+/**
+ * @brief Selects how an EbsdDataArray allocates the memory that it owns. The policy only
+ * affects memory that the array allocates itself; wrapped pointers are never touched.
+ */
+enum class AllocationPolicy : int32_t
+{
+  Default = 0,     ///< new[] with the default alignment of the C++ runtime
+  Aligned = 1,     ///< Aligned to a 64 byte cache line so that SIMD kernels need no unaligned prologue
+  HugePage = 2,    ///< Arrays of at least 2 MiB are aligned to 2 MiB and advised as transparent huge pages where the OS supports it, smaller arrays are aligned to 64 bytes
+  FirstTouch = 3,  ///< Aligned to 64 bytes and always zeroed in parallel, even when created uninitialized, so that the worker threads first touch the pages
+  MemoryMapped = 4 ///< Backed by an unnamed, memory mapped scratch file so that arrays larger than the physical memory are paged to disk instead of to swap
+};
+} // namespace EbsdLib
 
 /**
  * @class EbsdDataArray
@@ -168,6 +185,46 @@ public:
    */
   static Pointer CreateArray(const comp_dims_type& tupleDims, const comp_dims_type& compDims, const std::string& name, bool allocate);
 
+  /**
+   * @brief Static constructor that selects how the memory is allocated
+   * @param numTuples The number of tuples in the array.
+   * @param compDims The number of elements in each axis dimension.
+   * @param name The name of the array
+   * @param allocate Will all the memory be allocated at time of construction
+   * @param policy The allocation policy used for this and any later allocation
+   * @return Std::Shared_Ptr wrapping an instance of EbsdDataArrayTemplate<T>
+   */
+  static Pointer CreateArray(size_t numTuples, const comp_dims_type& compDims, const std::string& name, bool allocate, EbsdLib::AllocationPolicy policy);
+
+  /**
+   * @brief Static constructor that allocates the memory but does NOT initialize it. Use this
+   * when every value is written right after creation, for example by a conversion or a file
+   * read, so that the memory is not touched twice.
+   * @param numTuples The number of tuples in the array.
+   * @param compDims The number of elements in each axis dimension.
+   * @param name The name of the array
+   * @param policy The allocation policy used for this and any later allocation
+   * @return Std::Shared_Ptr wrapping an instance of EbsdDataArrayTemplate<T>
+   */
+  static Pointer CreateUninitializedArray(size_t numTuples, const comp_dims_type& compDims, const std::string& name,
+                                          EbsdLib::AllocationPolicy policy = EbsdLib::AllocationPolicy::Default);
+
+  /**
+   * @brief Static constructor that maps a region of an existing binary file instead of reading
+   * it. Pages are only read from disk when they are accessed. The file itself is never
+   * modified: values written through getPointer() or the iterators go to private copies of
+   * the affected pages. Resizing the array moves the values into a scratch file using the
+   * MemoryMapped allocation policy.
+   * @param filePath The file to map
+   * @param byteOffset Offset of the first value in the file. Must be a multiple of sizeof(T).
+   * @param numTuples The number of tuples in the array.
+   * @param compDims The number of elements in each axis dimension.
+   * @param name The name of the array
+   * @return Std::Shared_Ptr wrapping an instance of EbsdDataArrayTemplate<T> or nullptr if the
+   * file could not be mapped or is too short.
+   */
+  static Pointer MapFile(const std::string& filePath, size_t byteOffset, size_t numTuples, const comp_dims_type& compDims, const std::string& name);
+
   //========================================= Instance Constructing EbsdDataArray Objects =================================
   /**
    * @brief createNewArray Creates a new EbsdDataArray object using the same POD type as the existing instance
@@ -343,12 +400,65 @@ public:
   int32_t allocate();
 
   /**
-   * @brief Sets all the values to zero.
+   * @brief Sets the policy used to allocate memory. If the array already owns allocated
+   * memory the values are moved into a block allocated with the new policy.
+   * @param policy The new allocation policy
+   * @return 1 on success, -1 if the new block could not be allocated
+   */
+  int32_t setAllocationPolicy(EbsdLib::AllocationPolicy policy);
+
+  /**
+   * @brief Returns the policy used to allocate memory
+   */
+  EbsdLib::AllocationPolicy getAllocationPolicy() const;
+
+  /**
+   * @brief Returns the alignment in bytes that is guaranteed for the start of the
+   * internal array. This depends on the size of the array for the HugePage policy.
+   * Wrapped pointers only guarantee the alignment of T.
+   */
+  size_t getAlignment() const;
+
+  /**
+   * @brief Sets the directory that the scratch files of the MemoryMapped allocation policy
+   * are created in. An empty string, the default, selects the temporary directory of the
+   * system. The setting applies to the next allocation.
+   */
+  void setScratchDirectory(const std::string& directory);
+
+  /**
+   * @brief Returns the directory that scratch files are created in
+   */
+  std::string getScratchDirectory() const;
+
+  /**
+   * @brief Returns true if the values live in a memory mapped scratch file or file region
+   */
+  bool isMemoryMapped() const;
+
+  /**
+   * @brief Tells the operating system how the values are going to be accessed. This only has
+   * an effect on memory mapped arrays and is silently ignored otherwise.
+   * @param hint
+   */
+  void advise(MemoryMappedFile::AccessHint hint) const;
+
+  /**
+   * @brief Same as advise(MemoryMappedFile::AccessHint) but only for a range of tuples, for
+   * example WillNeed on the next slice while the current one is processed.
+   * @param hint
+   * @param startTuple The first tuple of the range
+   * @param numTuples The number of tuples in the range
+   */
+  void advise(MemoryMappedFile::AccessHint hint, size_t startTuple, size_t numTuples) const;
+
+  /**
+   * @brief Sets all the values to zero. Large arrays are filled in parallel.
    */
   void initializeWithZeros();
 
   /**
-   * @brief Sets all the values to value.
+   * @brief Sets all the values starting at offset to value. Large arrays are filled in parallel.
    */
   void initializeWithValue(T initValue, size_t offset = 0);
 
@@ -1191,6 +1301,36 @@ protected:
    */
   T* resizeAndExtend(size_t size);
 
+  /**
+   * @brief Allocates the internal array for the current size
+   * @param initialize When true all values are set to zero
+   * @return 1 on success, -1 on failure
+   */
+  int32_t allocateStorage(bool initialize);
+
+  /**
+   * @brief Allocates a block of elements using the current allocation policy
+   * @param numElements The number of elements
+   * @param initialize When true all values are set to zero
+   * @return Pointer to the block or nullptr if the allocation failed
+   */
+  T* allocateElements(size_t numElements, bool initialize) const;
+
+  /**
+   * @brief Frees a block that was allocated with allocateElements()
+   * @param ptr The block to free
+   * @param policy The policy that the block was allocated with
+   */
+  static void FreeElements(T* ptr, EbsdLib::AllocationPolicy policy);
+
+  /**
+   * @brief Grows or shrinks a scratch file backed block in place
+   * @param numElements The new number of elements
+   * @return The new address of the block or nullptr if the block is not a scratch file or could
+   * not be resized. The block is left untouched on failure.
+   */
+  T* resizeMappedElements(size_t numElements);
+
 private:
   std::string m_Name = {};
   T* m_Array = nullptr;
@@ -1202,6 +1342,9 @@ private:
   comp_dims_type m_CompDims = {1};
   bool m_IsAllocated = false;
   bool m_OwnsData = true;
+  bool m_IsWrapped = false;
+  EbsdLib::AllocationPolicy m_AllocationPolicy = EbsdLib::AllocationPolicy::Default;
+  std::string m_ScratchDirectory = {};
 };
 
 // -----------------------------------------------------------------------------
@@ -250,7 +250,7 @@ private:
 
 #define SHUFFLE_ARRAY(name, var, Type)                                                                                                                                                                 \
   {                                                                                                                                                                                                    \
-    Type* f = allocateArray<Type>(totalDataRows);                                                                                                                                                      \
+    Type* f = allocateArray<Type>(totalDataRows, false); /* Every value is written below */                                                                                                            \
     for(size_t i = 0; i < totalDataRows; ++i)                                                                                                                                                          \
     {                                                                                                                                                                                                  \
       size_t nIdx = shuffleTable[i];                                                                                                                                                                   \
@@ -263,10 +263,9 @@ private:
   free##name##Pointer(); /* Always free the current data before reading new data */                                                                                                                    \
   if(m_ReadAllArrays == true || m_ArrayNames.find(h5name) != m_ArrayNames.end())                                                                                                                       \
   {                                                                                                                                                                                                    \
-    auto _##name = allocateArray<type>(totalDataRows);                                                                                                                                                 \
+    auto _##name = allocateArray<type>(totalDataRows, false); /* The data set read overwrites every value */                                                                                           \
     if(nullptr != _##name)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      ::memset(_##name, 0, numBytes);                                                                                                                                                                  \
       std::string dataName = h5name;                                                                                                                                                                   \
       err = H5Lite::readPointerDataset(gid, dataName, _##name);                                                                                                                                        \
       if(err < 0)                                                                                                                                                                                      \
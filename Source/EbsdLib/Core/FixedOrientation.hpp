@@ -0,0 +1,249 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * @brief The FixedOrientation class holds a single orientation representation in a
+ * std::array of N values that lives on the stack. It provides the same subset of
+ * the STL interface that the conversion functions in OrientationTransformation use
+ * from the Orientation class, but without any heap allocation. This makes it the
+ * preferred type when converting large numbers of orientations one tuple at a time.
+ *
+ * Use the aliases Euler3, OrientationMatrix9, AxisAngle4, Rodrigues4, Homochoric3
+ * and Cubochoric3 to make the intended representation clear in the calling code.
+ */
+template <typename T, size_t N>
+class FixedOrientation
+{
+public:
+  using size_type = size_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  static constexpr size_type k_Size = N;
+
+  /**
+   * @brief Creates an orientation with all values set to zero
+   */
+  FixedOrientation()
+  : m_Array{}
+  {
+  }
+
+  /**
+   * @brief Creates an orientation with all values set to 'init'. This constructor exists
+   * so that generic code written as 'OutputType res(size)' works with this class. The
+   * size must not be larger than N and values beyond 'size' are set to zero.
+   * @param size The number of elements that the caller needs
+   * @param init Initialization value to be assigned to each element
+   */
+  explicit FixedOrientation(size_type size, T init = static_cast<T>(0))
+  : m_Array{}
+  {
+    assert(size <= N);
+    for(size_type i = 0; i < size && i < N; i++)
+    {
+      m_Array[i] = init;
+    }
+  }
+
+  /**
+   * @brief Creates an orientation by copying N values from an existing array.
+   * Unlike Orientation the values are copied and the pointer is not retained.
+   * @param ptr Pointer to at least N values
+   */
+  explicit FixedOrientation(const T* ptr)
+  {
+    for(size_type i = 0; i < N; i++)
+    {
+      m_Array[i] = ptr[i];
+    }
+  }
+
+  FixedOrientation(T val0, T val1, T val2)
+  : m_Array{{val0, val1, val2}}
+  {
+    static_assert(N == 3, "FixedOrientation: 3 values can only initialize a 3 component orientation");
+  }
+
+  FixedOrientation(T val0, T val1, T val2, T val3)
+  : m_Array{{val0, val1, val2, val3}}
+  {
+    static_assert(N == 4, "FixedOrientation: 4 values can only initialize a 4 component orientation");
+  }
+
+  FixedOrientation(T val0, T val1, T val2, T val3, T val4, T val5, T val6, T val7, T val8)
+  : m_Array{{val0, val1, val2, val3, val4, val5, val6, val7, val8}}
+  {
+    static_assert(N == 9, "FixedOrientation: 9 values can only initialize a 9 component orientation");
+  }
+
+  ~FixedOrientation() = default;
+
+  FixedOrientation(const FixedOrientation&) = default;
+  FixedOrientation(FixedOrientation&&) noexcept = default;
+  FixedOrientation& operator=(const FixedOrientation&) = default;
+  FixedOrientation& operator=(FixedOrientation&&) noexcept = default;
+
+  // ######### Iterators #########
+  iterator begin()
+  {
+    return m_Array.data();
+  }
+  iterator end()
+  {
+    return m_Array.data() + N;
+  }
+  const_iterator begin() const
+  {
+    return m_Array.data();
+  }
+  const_iterator end() const
+  {
+    return m_Array.data() + N;
+  }
+
+  // ######### Capacity #########
+  constexpr size_type size() const
+  {
+    return N;
+  }
+  constexpr size_type max_size() const
+  {
+    return N;
+  }
+  constexpr bool empty() const noexcept
+  {
+    return N == 0;
+  }
+
+  // ######### Element Access #########
+  inline reference operator[](size_type index)
+  {
+    return m_Array[index];
+  }
+  inline const_reference operator[](size_type index) const
+  {
+    return m_Array[index];
+  }
+  inline reference at(size_type index)
+  {
+    return m_Array.at(index);
+  }
+  inline const_reference at(size_type index) const
+  {
+    return m_Array.at(index);
+  }
+  inline T* data() noexcept
+  {
+    return m_Array.data();
+  }
+  inline const T* data() const noexcept
+  {
+    return m_Array.data();
+  }
+
+  /**
+   * @brief Copies at most 'size' values into the array pointed to by 'ptr'
+   */
+  void copyInto(T* ptr, size_type size) const
+  {
+    if(size > N)
+    {
+      size = N;
+    }
+    for(size_type i = 0; i < size; i++)
+    {
+      ptr[i] = m_Array[i];
+    }
+  }
+
+  /**
+   * @brief toGMatrix Copies the values of a 9 component orientation into the 3x3 "G" Matrix
+   * @param g
+   */
+  void toGMatrix(T g[3][3]) const
+  {
+    static_assert(N == 9, "FixedOrientation: Only an orientation matrix can be copied into a G Matrix");
+    for(size_type i = 0; i < 9; i++)
+    {
+      g[i / 3][i % 3] = m_Array[i];
+    }
+  }
+
+private:
+  std::array<T, N> m_Array;
+};
+
+template <typename T>
+using Euler3 = FixedOrientation<T, 3>;
+template <typename T>
+using OrientationMatrix9 = FixedOrientation<T, 9>;
+template <typename T>
+using AxisAngle4 = FixedOrientation<T, 4>;
+template <typename T>
+using Rodrigues4 = FixedOrientation<T, 4>;
+template <typename T>
+using Homochoric3 = FixedOrientation<T, 3>;
+template <typename T>
+using Cubochoric3 = FixedOrientation<T, 3>;
+
+/**
+ * @brief RebindOrientation gives the type that a conversion function uses for an
+ * intermediate representation with N components. Containers that size themselves
+ * at runtime (Orientation, std::vector, Quaternion) are used as is, while a
+ * FixedOrientation is rebound to a FixedOrientation with N components.
+ */
+template <typename ContainerType, size_t N>
+struct RebindOrientation
+{
+  using type = ContainerType;
+};
+
+template <typename T, size_t M, size_t N>
+struct RebindOrientation<FixedOrientation<T, M>, N>
+{
+  using type = FixedOrientation<T, N>;
+};
+
+template <typename ContainerType, size_t N>
+using RebindOrientation_t = typename RebindOrientation<ContainerType, N>::type;
@@ -758,7 +758,7 @@ protected:
           || MUD_FLAP_4 != 0xABABABABABABABABul
           || MUD_FLAP_5 != 0xABABABABABABABABul)
       {
-        Q_∂(false);
+        Q_ASSERT(false);
       }
 #endif
     delete[](m_Array);
@@ -49,6 +49,7 @@
 #include <Eigen/Dense>
 #include <Eigen/Eigen>
 
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Math/EbsdMatrixMath.h"
@@ -128,9 +129,10 @@ namespace DConst = EbsdLib::Constants;
 
 /**
  * @brief The OrientationTransformation namespace
- * template parameter InputType can be one of std::vector<T>, std::vector<T> or OrientationArray<T>
+ * template parameter InputType can be one of std::vector<T>, Orientation<T> or FixedOrientation<T, N>
  * and template parameter typename OutputType::value_type is the type specified in T. For example if InputType is std::vector<float>
- * then typename OutputType::value_type is float.
+ * then typename OutputType::value_type is float. When a conversion goes through an intermediate representation
+ * the intermediate uses RebindOrientation_t so that FixedOrientation types never allocate on the heap.
  */
 namespace OrientationTransformation
 {
@@ -1159,11 +1161,11 @@ OutputType ho2ax(const InputType& h)
 {
   OutputType res(4);
   using value_type = typename OutputType::value_type;
-  using OMHelperType = ArrayHelpers<OutputType, value_type>;
+  using OMHelperType = ArrayHelpers<InputType, value_type>;
 
   value_type thr = 1.0E-8f;
 
-  typename OutputType::value_type hmag = ArrayHelpers<InputType, value_type>::sumofSquares(h);
+  typename OutputType::value_type hmag = OMHelperType::sumofSquares(h);
   if(hmag == 0.0)
   {
     res[0] = 0.0;
@@ -1302,8 +1304,10 @@ OutputType om2qu(const InputType& om, typename Quaternion<typename OutputType::v
   */
   // om2ax(om, oax);
 
-  InputType eu = om2eu<InputType, InputType>(om);
-  InputType oax = eu2ax<InputType, InputType>(eu);
+  using EulerType = RebindOrientation_t<InputType, 3>;
+  using AxisAngleType = RebindOrientation_t<InputType, 4>;
+  EulerType eu = om2eu<InputType, EulerType>(om);
+  AxisAngleType oax = eu2ax<EulerType, AxisAngleType>(eu);
 
   if(oax[0] * res[x] < 0.0)
   {
@@ -1564,7 +1568,7 @@ OutputType ro2ho(const InputType& r)
   using OMHelperType = ArrayHelpers<OutputType, value_type>;
 
   value_type f = 0.0;
-  value_type rv = OMHelperType::sumofSquares(r);
+  value_type rv = ArrayHelpers<InputType, value_type>::sumofSquares(r);
   if(rv == 0.0)
   {
     OMHelperType::splat(res, 0.0);
@@ -1803,8 +1807,9 @@ OutputType cu2ho(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType ro2om(const InputType& ro)
 {
-  OutputType ax = ro2ax<InputType, OutputType>(ro);
-  return ax2om<OutputType, OutputType>(ax);
+  using AxisAngleType = RebindOrientation_t<OutputType, 4>;
+  AxisAngleType ax = ro2ax<InputType, AxisAngleType>(ro);
+  return ax2om<AxisAngleType, OutputType>(ax);
 }
 
 /**: ro2eu
@@ -1822,8 +1827,9 @@ OutputType ro2om(const InputType& ro)
 template <typename InputType, typename OutputType>
 OutputType ro2eu(const InputType& ro)
 {
-  OutputType om = ro2om<InputType, OutputType>(ro);
-  return om2eu<OutputType, OutputType>(om);
+  using OrientationMatrixType = RebindOrientation_t<OutputType, 9>;
+  OrientationMatrixType om = ro2om<InputType, OrientationMatrixType>(ro);
+  return om2eu<OrientationMatrixType, OutputType>(om);
 }
 
 /**: eu2ho
@@ -1840,8 +1846,9 @@ OutputType ro2eu(const InputType& ro)
 template <typename InputType, typename OutputType>
 OutputType eu2ho(const InputType& eu)
 {
-  OutputType ax = eu2ax<InputType, OutputType>(eu);
-  return ax2ho<OutputType, OutputType>(ax);
+  using AxisAngleType = RebindOrientation_t<OutputType, 4>;
+  AxisAngleType ax = eu2ax<InputType, AxisAngleType>(eu);
+  return ax2ho<AxisAngleType, OutputType>(ax);
 }
 
 /**: om2ro
@@ -1858,8 +1865,9 @@ OutputType eu2ho(const InputType& eu)
 template <typename InputType, typename OutputType>
 OutputType om2ro(const InputType& om)
 {
-  OutputType eu = om2eu<InputType, OutputType>(om); // Convert the OM to Euler
-  return eu2ro<OutputType, OutputType>(eu);         // Convert Euler to Rodrigues
+  using EulerType = RebindOrientation_t<OutputType, 3>;
+  EulerType eu = om2eu<InputType, EulerType>(om); // Convert the OM to Euler
+  return eu2ro<EulerType, OutputType>(eu);        // Convert Euler to Rodrigues
 }
 
 /**: om2ho
@@ -1877,8 +1885,9 @@ OutputType om2ro(const InputType& om)
 template <typename InputType, typename OutputType>
 OutputType om2ho(const InputType& om)
 {
-  OutputType ax = om2ax<InputType, OutputType>(om); // Convert the OM to Axis-Angles
-  return ax2ho<OutputType, OutputType>(ax);         // Convert Axis-Angles to Homochoric
+  using AxisAngleType = RebindOrientation_t<OutputType, 4>;
+  AxisAngleType ax = om2ax<InputType, AxisAngleType>(om); // Convert the OM to Axis-Angles
+  return ax2ho<AxisAngleType, OutputType>(ax);            // Convert Axis-Angles to Homochoric
 }
 
 /**: ax2eu
@@ -1896,8 +1905,9 @@ OutputType om2ho(const InputType& om)
 template <typename InputType, typename OutputType>
 OutputType ax2eu(const InputType& ax)
 {
-  OutputType om = ax2om<InputType, OutputType>(ax);
-  return om2eu<OutputType, OutputType>(om);
+  using OrientationMatrixType = RebindOrientation_t<OutputType, 9>;
+  OrientationMatrixType om = ax2om<InputType, OrientationMatrixType>(ax);
+  return om2eu<OrientationMatrixType, OutputType>(om);
 }
 
 /**: ro2qu
@@ -1932,8 +1942,9 @@ OutputType ro2qu(const InputType& ro, typename Quaternion<typename OutputType::v
 template <typename InputType, typename OutputType>
 OutputType ho2eu(const InputType& ho)
 {
-  OutputType ax = ho2ax<InputType, OutputType>(ho);
-  return ax2eu<OutputType, OutputType>(ax);
+  using AxisAngleType = RebindOrientation_t<OutputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2eu<AxisAngleType, OutputType>(ax);
 }
 
 /**: ho2om
@@ -1950,8 +1961,9 @@ OutputType ho2eu(const InputType& ho)
 template <typename InputType, typename OutputType>
 OutputType ho2om(const InputType& ho)
 {
-  OutputType ax = ho2ax<InputType, OutputType>(ho);
-  return ax2om<OutputType, OutputType>(ax);
+  using AxisAngleType = RebindOrientation_t<OutputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2om<AxisAngleType, OutputType>(ax);
 }
 
 /**: ho2ro
@@ -1986,8 +1998,9 @@ OutputType ho2ro(const InputType& ho)
 template <typename InputType, typename OutputType>
 OutputType ho2qu(const InputType& ho, typename Quaternion<typename OutputType::value_type>::Order layout = Quaternion<typename OutputType::value_type>::Order::VectorScalar)
 {
-  InputType ax = ho2ax<InputType, InputType>(ho);
-  return ax2qu<InputType, OutputType>(ax, layout);
+  using AxisAngleType = RebindOrientation_t<InputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2qu<AxisAngleType, OutputType>(ax, layout);
 }
 
 /**: eu2cu
@@ -2102,8 +2115,9 @@ OutputType qu2cu(const InputType& qu, typename Quaternion<typename OutputType::v
 template <typename InputType, typename OutputType>
 OutputType cu2eu(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2eu<OutputType, OutputType>(ho);
+  using HomochoricType = RebindOrientation_t<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2eu<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2om
@@ -2122,8 +2136,9 @@ OutputType cu2eu(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType cu2om(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2om<OutputType, OutputType>(ho);
+  using HomochoricType = RebindOrientation_t<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2om<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2ax
@@ -2142,8 +2157,9 @@ OutputType cu2om(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType cu2ax(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2ax<OutputType, OutputType>(ho);
+  using HomochoricType = RebindOrientation_t<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2ax<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2ro
@@ -2162,8 +2178,9 @@ OutputType cu2ax(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType cu2ro(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2ro<OutputType, OutputType>(ho);
+  using HomochoricType = RebindOrientation_t<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2ro<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2qu
@@ -0,0 +1,358 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+
+/**
+ * @class BatchColumnParser BatchColumnParser.hpp EbsdLib/IO/BatchColumnParser.hpp
+ * @brief This class parses delimited rows of text data straight into column
+ * centric arrays. Rows are handed over as std::string_views so no intermediate
+ * strings are created. When a block of rows is parsed the rows are first split
+ * into tokens and then each column is converted in a single tight loop, so the
+ * numeric type of a column is looked at once per block instead of once per cell.
+ *
+ * Copies of a parser share the destination arrays but have their own scratch
+ * space, which allows each thread to use its own copy on disjoint rows.
+ */
+class BatchColumnParser
+{
+public:
+  /**
+   * @brief How the tokens of a row are separated.
+   */
+  enum class Delimiter : int32_t
+  {
+    Whitespace = 0, //!< Any run of white space separates two tokens (.ang files)
+    Tab = 1         //!< Tab characters separate tokens, empty tokens are skipped (.ctf files)
+  };
+
+  /**
+   * @brief Error codes that are returned by the parse methods
+   */
+  enum ErrorCodes : int32_t
+  {
+    k_NoError = 0,
+    k_ColumnCountMismatch = -1,
+    k_ConversionError = -2
+  };
+
+  BatchColumnParser() = default;
+  ~BatchColumnParser() = default;
+
+  BatchColumnParser(const BatchColumnParser&) = default;
+  BatchColumnParser(BatchColumnParser&&) noexcept = default;
+  BatchColumnParser& operator=(const BatchColumnParser&) = default;
+  BatchColumnParser& operator=(BatchColumnParser&&) noexcept = default;
+
+  /**
+   * @brief Sets how the tokens of each row are separated. The default is Delimiter::Whitespace
+   */
+  void setDelimiter(Delimiter delimiter)
+  {
+    m_Delimiter = delimiter;
+  }
+
+  /**
+   * @brief If true every row must have exactly as many tokens as there are columns. If false
+   * rows may have fewer tokens, in which case only the leading columns are filled, and any extra
+   * tokens are ignored. The default is false.
+   */
+  void setRequireAllColumns(bool value)
+  {
+    m_RequireAllColumns = value;
+  }
+
+  /**
+   * @brief If true European style decimal commas are converted to decimal points before a
+   * value is converted. The default is false.
+   */
+  void setConvertDecimalCommas(bool value)
+  {
+    m_ConvertDecimalCommas = value;
+  }
+
+  /**
+   * @brief Sets the number of columns and resets all of them to be skipped.
+   */
+  void setNumberOfColumns(size_t numColumns)
+  {
+    m_Columns.assign(numColumns, Column());
+  }
+
+  /**
+   * @brief Returns the number of columns
+   */
+  size_t getNumberOfColumns() const
+  {
+    return m_Columns.size();
+  }
+
+  /**
+   * @brief Sets the destination of a column. The column will be parsed as a 32 bit integer if
+   * the type is NumericTypes::Type::Int32 and as a 32 bit float otherwise. Integer columns that
+   * hold floating point text are truncated to an integer. A nullptr destination skips the column.
+   * @param index The zero based index of the column in each row
+   * @param type The numeric type of the destination array
+   * @param ptr The destination array
+   */
+  void setColumn(size_t index, EbsdLib::NumericTypes::Type type, void* ptr)
+  {
+    if(index >= m_Columns.size())
+    {
+      m_Columns.resize(index + 1);
+    }
+    m_Columns[index].isInteger = (type == EbsdLib::NumericTypes::Type::Int32);
+    m_Columns[index].ptr = ptr;
+  }
+
+  /**
+   * @brief Returns the zero based row (relative to the first row handed to the last parse call) at which the last error occurred.
+   */
+  size_t getErrorRow() const
+  {
+    return m_ErrorRow;
+  }
+
+  /**
+   * @brief Returns the zero based column at which the last error occurred.
+   */
+  size_t getErrorColumn() const
+  {
+    return m_ErrorColumn;
+  }
+
+  /**
+   * @brief Returns the number of tokens of the row at which the last error occurred.
+   */
+  size_t getErrorTokenCount() const
+  {
+    return m_ErrorTokenCount;
+  }
+
+  /**
+   * @brief Parses a single row
+   * @param row The characters of the row. Leading and trailing white space is ignored.
+   * @param index The index in the destination arrays that receives the values.
+   * @return k_NoError or a negative error code
+   */
+  int32_t parseRow(std::string_view row, size_t index)
+  {
+    return parseRows(&row, 1, index);
+  }
+
+  /**
+   * @brief Parses a block of consecutive rows.
+   * @param rows Pointer to the first of 'numRows' rows
+   * @param numRows The number of rows
+   * @param firstIndex The index in the destination arrays that receives the values of the first row.
+   * @return k_NoError or a negative error code. Rows before the failing row have been parsed.
+   */
+  int32_t parseRows(const std::string_view* rows, size_t numRows, size_t firstIndex)
+  {
+    const size_t numColumns = m_Columns.size();
+    m_Tokens.resize(numRows * numColumns);
+    m_TokenCounts.resize(numRows);
+
+    // Split all the rows into tokens first.
+    size_t validRows = numRows;
+    int32_t err = k_NoError;
+    for(size_t r = 0; r < numRows; r++)
+    {
+      size_t numTokens = tokenize(rows[r], m_Tokens.data() + r * numColumns, numColumns);
+      m_TokenCounts[r] = numTokens;
+      if(m_RequireAllColumns && numTokens != numColumns)
+      {
+        m_ErrorRow = r;
+        m_ErrorColumn = 0;
+        m_ErrorTokenCount = numTokens;
+        validRows = r;
+        err = k_ColumnCountMismatch;
+        break;
+      }
+    }
+
+    // Now convert column by column.
+    for(size_t c = 0; c < numColumns; c++)
+    {
+      const Column& column = m_Columns[c];
+      if(column.ptr == nullptr)
+      {
+        continue;
+      }
+      size_t failedRow = column.isInteger ? convertColumn<int32_t>(column, c, validRows, firstIndex) : convertColumn<float>(column, c, validRows, firstIndex);
+      if(failedRow < validRows)
+      {
+        m_ErrorRow = failedRow;
+        m_ErrorColumn = c;
+        m_ErrorTokenCount = m_TokenCounts[failedRow];
+        validRows = failedRow;
+        err = k_ConversionError;
+      }
+    }
+    return err;
+  }
+
+private:
+  struct Column
+  {
+    bool isInteger = false;
+    void* ptr = nullptr;
+  };
+
+  Delimiter m_Delimiter = Delimiter::Whitespace;
+  bool m_RequireAllColumns = false;
+  bool m_ConvertDecimalCommas = false;
+  std::vector<Column> m_Columns;
+  std::vector<std::string_view> m_Tokens;
+  std::vector<size_t> m_TokenCounts;
+  size_t m_ErrorRow = 0;
+  size_t m_ErrorColumn = 0;
+  size_t m_ErrorTokenCount = 0;
+
+  /**
+   * @brief Splits the row into at most 'maxTokens' tokens and returns the total number of tokens in the row.
+   */
+  size_t tokenize(std::string_view row, std::string_view* tokens, size_t maxTokens) const
+  {
+    const char* cursor = row.data();
+    const char* last = row.data() + row.size();
+    while(cursor < last && EbsdStringUtils::is_space(*cursor))
+    {
+      ++cursor;
+    }
+    while(last > cursor && EbsdStringUtils::is_space(*(last - 1)))
+    {
+      --last;
+    }
+
+    size_t numTokens = 0;
+    while(cursor < last)
+    {
+      const char* tokenEnd = cursor;
+      if(m_Delimiter == Delimiter::Whitespace)
+      {
+        while(tokenEnd < last && !EbsdStringUtils::is_space(*tokenEnd))
+        {
+          ++tokenEnd;
+        }
+      }
+      else
+      {
+        while(tokenEnd < last && *tokenEnd != '\t')
+        {
+          ++tokenEnd;
+        }
+      }
+      if(tokenEnd != cursor)
+      {
+        if(numTokens < maxTokens)
+        {
+          tokens[numTokens] = std::string_view(cursor, static_cast<size_t>(tokenEnd - cursor));
+        }
+        numTokens++;
+      }
+      cursor = tokenEnd;
+      if(m_Delimiter == Delimiter::Whitespace)
+      {
+        while(cursor < last && EbsdStringUtils::is_space(*cursor))
+        {
+          ++cursor;
+        }
+      }
+      else if(cursor < last)
+      {
+        ++cursor;
+      }
+    }
+    return numTokens;
+  }
+
+  /**
+   * @brief Converts one column of 'numRows' tokenized rows. Returns the row that failed or 'numRows' on success.
+   */
+  template <typename T>
+  size_t convertColumn(const Column& column, size_t columnIndex, size_t numRows, size_t firstIndex) const
+  {
+    T* destination = static_cast<T*>(column.ptr) + firstIndex;
+    const size_t numColumns = m_Columns.size();
+    for(size_t r = 0; r < numRows; r++)
+    {
+      // Rows with fewer tokens leave the trailing columns untouched
+      if(columnIndex >= m_TokenCounts[r])
+      {
+        continue;
+      }
+      std::string_view token = m_Tokens[r * numColumns + columnIndex];
+      const char* first = token.data();
+      const char* last = token.data() + token.size();
+      char buffer[64];
+      if(m_ConvertDecimalCommas && std::find(first, last, ',') != last)
+      {
+        // No number needs this many characters. Converting a truncated copy would silently store a wrong value.
+        if(token.size() > sizeof(buffer))
+        {
+          return r;
+        }
+        std::replace_copy(first, last, buffer, ',', '.');
+        first = buffer;
+        last = buffer + token.size();
+      }
+      if(EbsdStringUtils::parse_number(first, last, destination[r]) != nullptr)
+      {
+        continue;
+      }
+      if constexpr(std::is_integral_v<T>)
+      {
+        // Some files have floats instead of integers so lets try that.
+        float value = 0.0f;
+        if(EbsdStringUtils::parse_number(first, last, value) != nullptr)
+        {
+          destination[r] = static_cast<T>(value);
+          continue;
+        }
+      }
+      return r;
+    }
+    return numRows;
+  }
+};
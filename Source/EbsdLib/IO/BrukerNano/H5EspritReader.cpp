@@ -561,7 +561,6 @@ int H5EspritReader::readData(hid_t parId)
     return -90012;
   }
   setNumberOfElements(totalDataRows);
-  size_t numBytes = totalDataRows * sizeof(float);
   std::string sBuf;
   std::stringstream ss(sBuf);
 
@@ -605,7 +604,7 @@ int H5EspritReader::readData(hid_t parId)
       m_PatternDims[0] = static_cast<int>(dims[1]);
       m_PatternDims[1] = static_cast<int>(dims[2]);
 
-      m_PatternData = this->allocateArray<uint8_t>(totalDataRows);
+      m_PatternData = this->allocateArray<uint8_t>(totalDataRows, false); // The data set read overwrites every value
       err = H5Lite::readPointerDataset(gid, EbsdLib::H5Esprit::RawPatterns, m_PatternData);
     }
   }
@@ -614,6 +613,34 @@ int H5EspritReader::readData(hid_t parId)
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::Pointer H5EspritReader::createPatternReader()
+{
+  return H5PatternReader::Create(*this, getFileName(), getPatternDatasetPath(), m_ChunkCache);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5EspritReader::readPatterns(size_t firstIndex, size_t count, uint8_t* buffer)
+{
+  return H5PatternReader::ReadPatterns(*this, m_PatternReader, getFileName(), getPatternDatasetPath(), m_ChunkCache, firstIndex, count, buffer);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string H5EspritReader::getPatternDatasetPath() const
+{
+  if(m_HDF5Path.empty())
+  {
+    return {};
+  }
+  return m_HDF5Path + "/" + EbsdLib::H5Esprit::EBSD + "/" + EbsdLib::H5Esprit::Data + "/" + EbsdLib::H5Esprit::RawPatterns;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #include "EbsdLib/IO/BrukerNano/EspritConstants.h"
 #include "EbsdLib/IO/BrukerNano/EspritPhase.h"
 #include "EbsdLib/IO/EbsdReader.h"
+#include "EbsdLib/IO/H5PatternReader.h"
 #include "EbsdLib/IO/TSL/AngHeaderEntry.h"
 
 /**
@@ -209,6 +210,32 @@ public:
    */
   void readAllArrays(bool b);
 
+  /**
+   * @brief Opens the RawPatterns data set of the scan selected with setHDF5Path() so that
+   * the patterns can be read a range at a time, for example with an H5PatternReader::BlockIterator.
+   * Prefer this over ReadPatternData for large scans since the patterns never have to fit into
+   * memory at once. The returned reader is independent of this reader.
+   * @return The pattern reader or nullptr if the data set could not be opened, in which case
+   * the error code and message of this reader are set.
+   */
+  H5PatternReader::Pointer createPatternReader();
+
+  /**
+   * @brief The chunk cache that createPatternReader() and readPatterns() open the RawPatterns
+   * data set with. Set it before the first call to readPatterns().
+   */
+  EBSD_INSTANCE_PROPERTY(H5ChunkCache, ChunkCache)
+
+  /**
+   * @brief Reads a range of patterns into buffer with a single hyperslab read. The pattern data
+   * set is opened on the first call and stays open until the file name or HDF5 path changes.
+   * @param firstIndex Index of the first pattern
+   * @param count Number of patterns
+   * @param buffer Must hold count * PatternHeight * PatternWidth bytes
+   * @return Negative value on error
+   */
+  int readPatterns(size_t firstIndex, size_t count, uint8_t* buffer);
+
   int getXDimension() override;
   void setXDimension(int xdim) override;
   int getYDimension() override;
@@ -224,6 +251,12 @@ protected:
    */
   int readData(hid_t parId);
 
+  /**
+   * @brief Returns the path of the RawPatterns data set of the scan selected with setHDF5Path(),
+   * or an empty string if no scan is selected
+   */
+  std::string getPatternDatasetPath() const;
+
   /**
    * @brief sanityCheckForOpening
    * @return
@@ -236,6 +269,8 @@ private:
   std::set<std::string> m_ArrayNames;
   bool m_ReadAllArrays = true;
 
+  H5PatternReader::Pointer m_PatternReader;
+
   std::vector<EspritPhase::Pointer> m_Phases;
 
 public:
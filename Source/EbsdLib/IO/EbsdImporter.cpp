@@ -0,0 +1,183 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "EbsdImporter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#if __has_include(<tbb/parallel_pipeline.h>)
+#include <tbb/parallel_pipeline.h>
+#else
+#include <tbb/pipeline.h>
+#endif
+#include <tbb/task_arena.h>
+#endif
+
+namespace
+{
+/**
+ * @brief One file of importFiles() after it went through the parser stage
+ */
+struct ParsedFile
+{
+  std::string filePath;
+  std::unique_ptr<EbsdReader> reader;
+  int readError = 0;
+};
+using ParsedFilePointer = std::shared_ptr<ParsedFile>;
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#if __has_include(<tbb/parallel_pipeline.h>)
+constexpr auto k_SerialInOrder = tbb::filter_mode::serial_in_order;
+constexpr auto k_Parallel = tbb::filter_mode::parallel;
+#else
+constexpr auto k_SerialInOrder = tbb::filter::serial_in_order;
+constexpr auto k_Parallel = tbb::filter::parallel;
+#endif
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int EbsdImporter::importFiles(hid_t fileId, int64_t zStartIndex, const std::vector<std::string>& ebsdFiles, size_t numThreads)
+{
+  setCancel(false);
+  setErrorCode(0);
+
+  const size_t numFiles = ebsdFiles.size();
+  size_t filesWritten = 0;
+  int64_t z = zStartIndex;
+  int err = 0;
+
+  auto reportProgress = [&](const std::string& filePath) {
+    std::stringstream ss;
+    ss << "Imported file " << filesWritten << " of " << numFiles << ": " << filePath << "\n";
+    progressMessage(ss.str(), static_cast<int>(100 * filesWritten / numFiles));
+  };
+
+  // Importers that can not parse ahead of the writer import one file after the other
+  if(nullptr == createReader())
+  {
+    for(const auto& filePath : ebsdFiles)
+    {
+      if(getCancel())
+      {
+        break;
+      }
+      err = importFile(fileId, z, filePath);
+      if(err < 0)
+      {
+        return err;
+      }
+      z += numberOfSlicesImported();
+      filesWritten++;
+      reportProgress(filePath);
+    }
+    return 0;
+  }
+
+  // Set by the writer to stop feeding and parsing files after an error or a cancel
+  std::atomic<bool> stop(false);
+
+  auto parseFile = [this, &ebsdFiles, &stop](size_t index) {
+    ParsedFilePointer parsed = std::make_shared<ParsedFile>();
+    parsed->filePath = ebsdFiles[index];
+    if(!stop)
+    {
+      parsed->reader = createReader();
+      parsed->reader->setFileName(parsed->filePath);
+      parsed->readError = parsed->reader->readFile();
+    }
+    return parsed;
+  };
+
+  auto writeFile = [&](const ParsedFilePointer& parsed) {
+    if(stop || nullptr == parsed->reader)
+    {
+      return;
+    }
+    if(getCancel())
+    {
+      stop = true;
+      return;
+    }
+    err = writeParsedFile(fileId, z, *parsed->reader, parsed->readError);
+    // Release the parsed data before the next file is written
+    parsed->reader.reset();
+    if(err < 0)
+    {
+      stop = true;
+      return;
+    }
+    z += numberOfSlicesImported();
+    filesWritten++;
+    reportProgress(parsed->filePath);
+  };
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  if(numThreads == 0)
+  {
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  // The number of live tokens bounds how many parsed files wait for the writer
+  size_t nextIndex = 0;
+  tbb::task_arena arena(static_cast<int>(numThreads));
+  arena.execute([&]() {
+    tbb::parallel_pipeline(numThreads * 2,
+                           tbb::make_filter<void, size_t>(k_SerialInOrder,
+                                                          [&](tbb::flow_control& fc) -> size_t {
+                                                            if(stop || nextIndex >= numFiles)
+                                                            {
+                                                              fc.stop();
+                                                              return 0;
+                                                            }
+                                                            return nextIndex++;
+                                                          }) &
+                               tbb::make_filter<size_t, ParsedFilePointer>(k_Parallel, parseFile) & tbb::make_filter<ParsedFilePointer, void>(k_SerialInOrder, writeFile));
+  });
+#else
+  for(size_t i = 0; i < numFiles && !stop; i++)
+  {
+    writeFile(parseFile(i));
+  }
+#endif
+
+  return err < 0 ? err : 0;
+}
@@ -35,12 +35,18 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/EbsdReader.h"
 
 #ifdef EbsdLib_ENABLE_HDF5
 #include <hdf5.h>
+
+#include "EbsdLib/IO/H5DatasetLayout.h"
 #endif
 /**
  * @class EbsdImporter EbsdImporter.h EbsdLib/EbsdImporter.h
@@ -144,6 +150,23 @@ public:
    */
   virtual int importFile(hid_t fileId, int64_t index, const std::string& ebsd) = 0;
 
+#ifdef EbsdLib_ENABLE_HDF5
+  /**
+   * @brief Imports a series of files into consecutive z slices starting at zStartIndex. Up to
+   * numThreads files are parsed at the same time while a single writer stores them into the
+   * HDF5 file in z order, so only one thread ever makes HDF5 calls. At most two parsed files
+   * per thread are held in memory. Progress messages come from the writer, which may be a
+   * worker thread. Setting Cancel stops the import after the slice that is being written.
+   * Importers that do not implement createReader() import the files one after the other.
+   * @param fileId HDF5 fileId of an open HDF5 file that the data will be stored into
+   * @param zStartIndex The z index of the first file
+   * @param ebsdFiles The raw data files from the manufacturer in z order
+   * @param numThreads Number of files parsed at the same time. Zero uses all cores.
+   * @return 0 on success or when cancelled, negative on error
+   */
+  virtual int importFiles(hid_t fileId, int64_t zStartIndex, const std::vector<std::string>& ebsdFiles, size_t numThreads = 0);
+#endif
+
   /**
    * @brief Returns the dimensions for the EBSD Data set
    * @param x Number of X Voxels (out)
@@ -171,9 +194,53 @@ public:
    */
   virtual void setFileVersion(uint32_t version) = 0;
 
+#ifdef EbsdLib_ENABLE_HDF5
+  /**
+   * @brief Sets the chunking and compression of the data arrays that are written for each slice
+   */
+  virtual void setDatasetLayout(const H5DatasetLayout& value)
+  {
+    m_DatasetLayout = value;
+  }
+  /**
+   * @brief Getter property for DatasetLayout
+   * @return Value of DatasetLayout
+   */
+  virtual H5DatasetLayout getDatasetLayout() const
+  {
+    return m_DatasetLayout;
+  }
+#endif
+
 protected:
   EbsdImporter() = default;
 
+#ifdef EbsdLib_ENABLE_HDF5
+  /**
+   * @brief Creates the reader that parses one file for importFiles(). The reader must not make
+   * any HDF5 calls since readers run on several threads at the same time.
+   * @return The reader or nullptr if this importer does not support parsing ahead
+   */
+  virtual std::unique_ptr<EbsdReader> createReader() const
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Writes a file that createReader() parsed into slice z. This is never called from
+   * more than one thread at a time.
+   * @param fileId HDF5 fileId of an open HDF5 file that the data will be stored into
+   * @param z The z index of the file
+   * @param reader The reader that parsed the file
+   * @param readError The value that readFile() returned
+   * @return Negative value on error
+   */
+  virtual int writeParsedFile(hid_t fileId, int64_t z, EbsdReader& reader, int readError)
+  {
+    return -1;
+  }
+#endif
+
 public:
   EbsdImporter(const EbsdImporter&) = delete;            // Copy Constructor Not Implemented
   EbsdImporter(EbsdImporter&&) = delete;                 // Move Constructor Not Implemented
@@ -183,4 +250,7 @@ public:
 private:
   int m_ErrorCode = 0;
   bool m_Cancel = false;
+#ifdef EbsdLib_ENABLE_HDF5
+  H5DatasetLayout m_DatasetLayout = {};
+#endif
 };
@@ -199,12 +199,14 @@ public:
    * @brief Allocats a contiguous chunk of memory to store values from the .ang file
    * @param numberOfElements The number of elements in the Array. This method can
    * also optionally produce SSE aligned memory for use with SSE intrinsics
+   * @param initialize When false the memory is NOT set to zero. Use this when every value is
+   * written right after the allocation, for example by reading a complete data set.
    * @return Pointer to allocated memory
    */
   template <typename T>
-  T* allocateArray(size_t numberOfElements)
+  T* allocateArray(size_t numberOfElements, bool initialize = true)
   {
-    T* m_buffer = new T[numberOfElements]();
+    T* m_buffer = initialize ? new T[numberOfElements]() : new T[numberOfElements];
     return m_buffer;
   }
 
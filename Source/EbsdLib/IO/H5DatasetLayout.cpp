@@ -0,0 +1,201 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "H5DatasetLayout.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr hsize_t k_TargetChunkBytes = 1024 * 1024;
+
+/**
+ * @brief Returns true if the filter is available for writing in this HDF5 library
+ */
+bool CanEncodeWith(H5Z_filter_t filter)
+{
+  if(H5Zfilter_avail(filter) <= 0)
+  {
+    return false;
+  }
+  unsigned int filterConfig = 0;
+  if(H5Zget_filter_info(filter, &filterConfig) < 0)
+  {
+    return false;
+  }
+  return (filterConfig & H5Z_FILTER_CONFIG_ENCODE_ENABLED) != 0;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5DatasetLayout::isChunked() const
+{
+  return chunkShape != ChunkShape::Contiguous || compression != Compression::None || shuffle;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<hsize_t> H5DatasetLayout::getDims(hsize_t xCells, hsize_t yCells) const
+{
+  if(chunkShape == ChunkShape::Tiles)
+  {
+    return {yCells, xCells};
+  }
+  return {xCells * yCells};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5DatasetLayout::createDatasetProperties(hsize_t xCells, hsize_t yCells, size_t elementSize) const
+{
+  // HDF5 can not chunk an empty data set, so those stay contiguous
+  if(!isChunked() || xCells == 0 || yCells == 0)
+  {
+    return H5P_DEFAULT;
+  }
+
+  std::vector<hsize_t> chunkDims;
+  if(chunkShape == ChunkShape::Tiles)
+  {
+    const hsize_t tile = std::max(tileSize, hsize_t(1));
+    chunkDims = {std::min(tile, yCells), std::min(tile, xCells)};
+  }
+  else
+  {
+    hsize_t rows = rowsPerChunk;
+    if(rows == 0)
+    {
+      const hsize_t rowBytes = xCells * static_cast<hsize_t>(std::max(elementSize, size_t(1)));
+      rows = std::max(k_TargetChunkBytes / rowBytes, hsize_t(1));
+    }
+    chunkDims = {std::min(rows, yCells) * xCells};
+  }
+
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if(dcpl < 0)
+  {
+    return dcpl;
+  }
+  herr_t err = H5Pset_chunk(dcpl, static_cast<int>(chunkDims.size()), chunkDims.data());
+  // The shuffle filter has to run before the compression filter
+  if(err >= 0 && shuffle)
+  {
+    err = H5Pset_shuffle(dcpl);
+  }
+  if(err >= 0 && compression == Compression::Deflate)
+  {
+    err = CanEncodeWith(H5Z_FILTER_DEFLATE) ? H5Pset_deflate(dcpl, static_cast<unsigned int>(std::clamp(compressionLevel, 1, 9))) : -1;
+  }
+  if(err >= 0 && compression == Compression::SZip)
+  {
+    // SZip needs an even number of pixels per block of at most 32
+    unsigned int pixelsPerBlock = static_cast<unsigned int>(std::clamp(compressionLevel, 2, 32)) & ~1u;
+    err = CanEncodeWith(H5Z_FILTER_SZIP) ? H5Pset_szip(dcpl, H5_SZIP_NN_OPTION_MASK, pixelsPerBlock) : -1;
+  }
+  if(err < 0)
+  {
+    H5Pclose(dcpl);
+    return -1;
+  }
+  return dcpl;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+herr_t H5DatasetLayout::writeDataset(hid_t locId, const std::string& name, hid_t dataType, hsize_t xCells, hsize_t yCells, const void* data) const
+{
+  hid_t dcpl = createDatasetProperties(xCells, yCells, H5Tget_size(dataType));
+  if(dcpl < 0)
+  {
+    return -1;
+  }
+
+  std::vector<hsize_t> dims = getDims(xCells, yCells);
+  herr_t err = -1;
+  hid_t dataspaceId = H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr);
+  if(dataspaceId >= 0)
+  {
+    hid_t datasetId = H5Dcreate(locId, name.c_str(), dataType, dataspaceId, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    if(datasetId >= 0)
+    {
+      err = H5Dwrite(datasetId, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+      if(H5Dclose(datasetId) < 0)
+      {
+        err = -1;
+      }
+    }
+    H5Sclose(dataspaceId);
+  }
+  if(dcpl != H5P_DEFAULT)
+  {
+    H5Pclose(dcpl);
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5ChunkCache::isDefault() const
+{
+  return numSlots == H5D_CHUNK_CACHE_NSLOTS_DEFAULT && numBytes == H5D_CHUNK_CACHE_NBYTES_DEFAULT && preemption < 0.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5ChunkCache::createAccessProperties() const
+{
+  if(isDefault())
+  {
+    return H5P_DEFAULT;
+  }
+  hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+  if(dapl < 0)
+  {
+    return dapl;
+  }
+  if(H5Pset_chunk_cache(dapl, numSlots, numBytes, preemption) < 0)
+  {
+    H5Pclose(dapl);
+    return -1;
+  }
+  return dapl;
+}
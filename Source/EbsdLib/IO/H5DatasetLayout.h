@@ -0,0 +1,146 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @brief Storage layout of the data arrays that the H5Ang and H5Ctf importers write. The
+ * defaults give the contiguous, uncompressed data sets of earlier versions.
+ *
+ * HDF5 filters only work on chunked data sets, so asking for compression or shuffling with a
+ * Contiguous chunk shape uses row aligned chunks. Row chunks keep the one dimensional data sets
+ * of the .h5ebsd specification. Tile chunks store each array as a two dimensional
+ * (rows, columns) data set so that a rectangular region of a scan touches as few chunks as
+ * possible. The H5Ebsd volume readers understand both layouts.
+ */
+struct EbsdLib_EXPORT H5DatasetLayout
+{
+  enum class ChunkShape : int32_t
+  {
+    Contiguous = 0,
+    Rows = 1,
+    Tiles = 2
+  };
+
+  enum class Compression : int32_t
+  {
+    None = 0,
+    Deflate = 1,
+    SZip = 2
+  };
+
+  ChunkShape chunkShape = ChunkShape::Contiguous; ///<* How the data sets are split into chunks
+  hsize_t rowsPerChunk = 0;                       ///<* Scan rows per chunk for Rows. Zero picks about 1 MiB per chunk
+  hsize_t tileSize = 64;                          ///<* Edge length in points of the square chunks for Tiles
+  Compression compression = Compression::None;    ///<* The compression filter
+  int32_t compressionLevel = 6;                   ///<* Deflate level (1-9) or SZip pixels per block (even, 2-32)
+  bool shuffle = false;                           ///<* Byte shuffle the values before compressing them
+
+  /**
+   * @brief Returns true if the data sets are written in chunks
+   */
+  bool isChunked() const;
+
+  /**
+   * @brief Returns the data set dimensions, slowest first, of a scan with xCells columns and yCells rows
+   */
+  std::vector<hsize_t> getDims(hsize_t xCells, hsize_t yCells) const;
+
+  /**
+   * @brief Creates the data set creation property list for a scan. The caller closes a list
+   * that is not H5P_DEFAULT.
+   * @param xCells Number of columns of the scan
+   * @param yCells Number of rows of the scan
+   * @param elementSize Size in bytes of one value
+   * @return The property list, H5P_DEFAULT for the contiguous layout or a negative value if the
+   * requested filter is not available in this HDF5 library
+   */
+  hid_t createDatasetProperties(hsize_t xCells, hsize_t yCells, size_t elementSize) const;
+
+  /**
+   * @brief Writes one data array of a scan with this layout
+   * @param locId The group to write the data set into
+   * @param name Name of the data set
+   * @param dataType The HDF5 memory and file type of the values
+   * @param xCells Number of columns of the scan
+   * @param yCells Number of rows of the scan
+   * @param data The xCells * yCells values, row by row
+   * @return Negative value on error
+   */
+  herr_t writeDataset(hid_t locId, const std::string& name, hid_t dataType, hsize_t xCells, hsize_t yCells, const void* data) const;
+
+  template <typename T>
+  herr_t writeDataset(hid_t locId, const std::string& name, hsize_t xCells, hsize_t yCells, const T* data) const
+  {
+    static_assert(std::is_same<T, float>::value || std::is_same<T, int32_t>::value, "H5DatasetLayout::writeDataset supports float and int32_t arrays");
+    hid_t dataType = std::is_same<T, float>::value ? H5T_NATIVE_FLOAT : H5T_NATIVE_INT32;
+    return writeDataset(locId, name, dataType, xCells, yCells, static_cast<const void*>(data));
+  }
+};
+
+/**
+ * @brief Chunk cache settings for reading chunked data sets. The defaults keep the settings of
+ * the HDF5 library. For partial reads of compressed data the cache should hold at least all the
+ * chunks of one read, and numSlots should be a prime about 100 times the number of chunks that
+ * fit in the cache.
+ */
+struct EbsdLib_EXPORT H5ChunkCache
+{
+  size_t numSlots = H5D_CHUNK_CACHE_NSLOTS_DEFAULT; ///<* Number of slots in the hash table of the cache
+  size_t numBytes = H5D_CHUNK_CACHE_NBYTES_DEFAULT; ///<* Size of the cache in bytes
+  double preemption = H5D_CHUNK_CACHE_W0_DEFAULT;   ///<* How strongly fully read chunks are evicted first (0.0 - 1.0)
+
+  /**
+   * @brief Returns true if all values are the library defaults
+   */
+  bool isDefault() const;
+
+  /**
+   * @brief Creates the data set access property list for H5Dopen. The caller closes a list
+   * that is not H5P_DEFAULT.
+   * @return The property list or H5P_DEFAULT if all values are the library defaults
+   */
+  hid_t createAccessProperties() const;
+};
@@ -33,6 +33,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "H5EbsdVolumeReader.h"
+
+#include <algorithm>
+#include <sstream>
 #include <utility>
 
 #if defined(H5Support_NAMESPACE)
@@ -96,6 +99,127 @@ int H5EbsdVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoin
   return -1;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5EbsdVolumeReader::SliceRegion H5EbsdVolumeReader::CenterSlice(int64_t xpoints, int64_t ypoints, int64_t xpointsslice, int64_t ypointsslice)
+{
+  const int64_t xstartspot = (xpoints - xpointsslice) / 2;
+  const int64_t ystartspot = (ypoints - ypointsslice) / 2;
+
+  SliceRegion region;
+  region.srcXStart = std::max(-xstartspot, int64_t(0));
+  region.srcYStart = std::max(-ystartspot, int64_t(0));
+  region.dstXStart = std::max(xstartspot, int64_t(0));
+  region.dstYStart = std::max(ystartspot, int64_t(0));
+  region.rowLength = std::max(std::min(xpointsslice, xpoints), int64_t(0));
+  region.numRows = std::max(std::min(ypointsslice, ypoints), int64_t(0));
+  return region;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5EbsdVolumeReader::readSliceIntoVolume(hid_t dataGid, const std::vector<SliceColumn>& columns, int64_t xpoints, int64_t ypoints, int64_t zpoints, int64_t zval, int64_t xpointsslice,
+                                            int64_t ypointsslice)
+{
+  const SliceRegion region = CenterSlice(xpoints, ypoints, xpointsslice, ypointsslice);
+  if(region.rowLength == 0 || region.numRows == 0 || zval < 0 || zval >= zpoints)
+  {
+    return 0;
+  }
+
+  // The memory space is the whole volume. Selecting the rows of the slice in plane zval lets
+  // HDF5 write every value straight to its final location.
+  hsize_t volumeDims[3] = {static_cast<hsize_t>(zpoints), static_cast<hsize_t>(ypoints), static_cast<hsize_t>(xpoints)};
+  hsize_t memStart[3] = {static_cast<hsize_t>(zval), static_cast<hsize_t>(region.dstYStart), static_cast<hsize_t>(region.dstXStart)};
+  hsize_t memCount[3] = {1, static_cast<hsize_t>(region.numRows), static_cast<hsize_t>(region.rowLength)};
+  hid_t memSpace = H5Screate_simple(3, volumeDims, nullptr);
+  if(memSpace < 0)
+  {
+    setErrorCode(-90021);
+    setErrorMessage("H5EbsdVolumeReader Error: Could not create the memory data space for the volume.");
+    return getErrorCode();
+  }
+  H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, nullptr, memCount, nullptr);
+
+  // The slice data sets are either one flat array of ypointsslice rows of xpointsslice points,
+  // where the selected rows are a strided block selection, or a (rows, columns) array.
+  hsize_t flatStart = static_cast<hsize_t>(region.srcYStart * xpointsslice + region.srcXStart);
+  hsize_t flatStride = static_cast<hsize_t>(xpointsslice);
+  hsize_t flatCount = static_cast<hsize_t>(region.numRows);
+  hsize_t flatBlock = static_cast<hsize_t>(region.rowLength);
+  hsize_t planeStart[2] = {static_cast<hsize_t>(region.srcYStart), static_cast<hsize_t>(region.srcXStart)};
+  hsize_t planeCount[2] = {static_cast<hsize_t>(region.numRows), static_cast<hsize_t>(region.rowLength)};
+  hid_t dapl = m_ChunkCache.createAccessProperties();
+
+  int err = 0;
+  for(const auto& column : columns)
+  {
+    if(nullptr == column.destination || (!column.required && !H5Lite::datasetExists(dataGid, column.name)))
+    {
+      continue;
+    }
+    hid_t datasetId = H5Dopen(dataGid, column.name.c_str(), dapl < 0 ? H5P_DEFAULT : dapl);
+    if(datasetId < 0)
+    {
+      std::stringstream ss;
+      ss << "Error reading dataset '" << column.name
+         << "' from the HDF5 file. This data set is required to be in the file because either the program is set to read ALL the Data arrays or the program was instructed to read this array.";
+      setErrorCode(-90020);
+      setErrorMessage(ss.str());
+      err = getErrorCode();
+      break;
+    }
+    hid_t fileSpace = H5Dget_space(datasetId);
+    const int rank = H5Sget_simple_extent_ndims(fileSpace);
+    hsize_t fileDims[2] = {0, 0};
+    if(rank == 1 || rank == 2)
+    {
+      H5Sget_simple_extent_dims(fileSpace, fileDims, nullptr);
+    }
+    const bool isFlat = rank == 1 && fileDims[0] == static_cast<hsize_t>(xpointsslice * ypointsslice);
+    const bool isPlane = rank == 2 && fileDims[0] == static_cast<hsize_t>(ypointsslice) && fileDims[1] == static_cast<hsize_t>(xpointsslice);
+    if(!isFlat && !isPlane)
+    {
+      std::stringstream ss;
+      ss << "The size of dataset '" << column.name << "' does not match the " << xpointsslice << " x " << ypointsslice << " points of the slice.";
+      setErrorCode(-90022);
+      setErrorMessage(ss.str());
+      err = getErrorCode();
+    }
+    else
+    {
+      if(isFlat)
+      {
+        H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &flatStart, &flatStride, &flatCount, &flatBlock);
+      }
+      else
+      {
+        H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, planeStart, nullptr, planeCount, nullptr);
+      }
+      if(H5Dread(datasetId, column.memType, memSpace, fileSpace, H5P_DEFAULT, column.destination) < 0)
+      {
+        setErrorCode(-90020);
+        setErrorMessage("Error reading dataset '" + column.name + "' from the HDF5 file.");
+        err = getErrorCode();
+      }
+    }
+    H5Sclose(fileSpace);
+    H5Dclose(datasetId);
+    if(err < 0)
+    {
+      break;
+    }
+  }
+  H5Sclose(memSpace);
+  if(dapl > 0)
+  {
+    H5Pclose(dapl);
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -37,10 +37,14 @@
 
 #include <set>
 #include <string>
+#include <vector>
+
+#include "H5Support/H5Lite.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/H5DatasetLayout.h"
 #include "EbsdLib/IO/H5EbsdVolumeInfo.h"
 
 /**
@@ -113,6 +117,9 @@ public:
   /** @brief The number of elements in a column of data. This should be rows * columns */
   EBSD_INSTANCE_PROPERTY(size_t, NumberOfElements)
 
+  /** @brief The chunk cache used to open the data sets of each slice. The default keeps the HDF5 settings */
+  EBSD_INSTANCE_PROPERTY(H5ChunkCache, ChunkCache)
+
   /**
    * @brief Returns the pointer to the data for a given feature
    * @param featureName The name of the feature to return the pointer to.
@@ -153,6 +160,54 @@ public:
 protected:
   H5EbsdVolumeReader();
 
+  /**
+   * @brief One data set of a slice that readSliceIntoVolume() reads into a volume array
+   */
+  struct SliceColumn
+  {
+    std::string name;
+    hid_t memType = -1;
+    void* destination = nullptr;
+    bool required = true;
+  };
+
+  /**
+   * @brief The part of a slice that lands in the volume. The slice is centered in the XY plane
+   * of the volume and cropped around its center when it is larger than the volume.
+   */
+  struct SliceRegion
+  {
+    int64_t srcXStart = 0;
+    int64_t srcYStart = 0;
+    int64_t dstXStart = 0;
+    int64_t dstYStart = 0;
+    int64_t rowLength = 0;
+    int64_t numRows = 0;
+  };
+
+  /**
+   * @brief Computes where a slice of xpointsslice x ypointsslice points lands in a volume plane
+   * of xpoints x ypoints points.
+   */
+  static SliceRegion CenterSlice(int64_t xpoints, int64_t ypoints, int64_t xpointsslice, int64_t ypointsslice);
+
+  /**
+   * @brief Reads the data sets of one slice straight into plane zval of the volume arrays using
+   * a hyperslab of the memory data space, so no intermediate slice buffers are needed. Columns
+   * with a nullptr destination, and columns that are not required and missing from the file,
+   * are skipped.
+   * @param dataGid The 'Data' group of the slice
+   * @param columns The data sets to read
+   * @param xpoints Number of X voxels of the volume
+   * @param ypoints Number of Y voxels of the volume
+   * @param zpoints Number of Z voxels of the volume
+   * @param zval The Z plane of the volume to write
+   * @param xpointsslice Number of X points in the slice
+   * @param ypointsslice Number of Y points in the slice
+   * @return 0 on success or a negative error code
+   */
+  int readSliceIntoVolume(hid_t dataGid, const std::vector<SliceColumn>& columns, int64_t xpoints, int64_t ypoints, int64_t zpoints, int64_t zval, int64_t xpointsslice, int64_t ypointsslice);
+
 private:
   std::set<std::string> m_ArrayNames;
   bool m_ReadAllArrays;
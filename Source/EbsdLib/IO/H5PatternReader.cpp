@@ -0,0 +1,502 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "H5PatternReader.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <sstream>
+
+#include "H5Support/H5Utilities.h"
+
+#include "EbsdLib/IO/EbsdReader.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::H5PatternReader()
+: m_ErrorCode(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::~H5PatternReader()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::Pointer H5PatternReader::Create(EbsdReader& owner, const std::string& filePath, const std::string& datasetPath, const H5ChunkCache& chunkCache)
+{
+  if(filePath.empty() || datasetPath.empty())
+  {
+    owner.setErrorCode(-90510);
+    owner.setErrorMessage(ClassName() + " Error: The file name and HDF5 path must be set before the patterns can be read.");
+    return NullPointer();
+  }
+  Pointer patternReader = New();
+  patternReader->setChunkCache(chunkCache);
+  if(patternReader->open(filePath, datasetPath) < 0)
+  {
+    owner.setErrorCode(patternReader->getErrorCode());
+    owner.setErrorMessage(patternReader->getErrorMessage());
+    return NullPointer();
+  }
+  return patternReader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5PatternReader::ReadPatterns(EbsdReader& owner, Pointer& patternReader, const std::string& filePath, const std::string& datasetPath, const H5ChunkCache& chunkCache, size_t firstIndex,
+                                  size_t count, uint8_t* buffer)
+{
+  if(nullptr == patternReader || patternReader->getFilePath() != filePath || patternReader->getDatasetPath() != datasetPath)
+  {
+    patternReader = Create(owner, filePath, datasetPath, chunkCache);
+    if(nullptr == patternReader)
+    {
+      return owner.getErrorCode();
+    }
+  }
+  int err = patternReader->readPatterns(firstIndex, count, buffer);
+  if(err < 0)
+  {
+    owner.setErrorCode(err);
+    owner.setErrorMessage(patternReader->getErrorMessage());
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5PatternReader::open(const std::string& filePath, const std::string& datasetPath)
+{
+  close();
+  setErrorCode(0);
+  setErrorMessage("");
+  m_FilePath = filePath;
+  m_DatasetPath = datasetPath;
+
+  m_FileId = H5Utilities::openFile(filePath, true);
+  if(m_FileId < 0)
+  {
+    std::stringstream ss;
+    ss << getNameOfClass() << " Error: Could not open HDF5 file '" << filePath << "'";
+    setErrorCode(-90500);
+    setErrorMessage(ss.str());
+    return getErrorCode();
+  }
+
+  hid_t dapl = m_ChunkCache.createAccessProperties();
+  m_DatasetId = H5Dopen(m_FileId, datasetPath.c_str(), dapl < 0 ? H5P_DEFAULT : dapl);
+  if(dapl > 0)
+  {
+    H5Pclose(dapl);
+  }
+  if(m_DatasetId < 0)
+  {
+    std::stringstream ss;
+    ss << getNameOfClass() << " Error: Could not open pattern data set '" << datasetPath << "'";
+    close();
+    setErrorCode(-90501);
+    setErrorMessage(ss.str());
+    return getErrorCode();
+  }
+
+  hid_t dataspaceId = H5Dget_space(m_DatasetId);
+  const int rank = H5Sget_simple_extent_ndims(dataspaceId);
+  if(rank < 2)
+  {
+    H5Sclose(dataspaceId);
+    std::stringstream ss;
+    ss << getNameOfClass() << " Error: The pattern data set '" << datasetPath << "' must have at least 2 dimensions";
+    close();
+    setErrorCode(-90502);
+    setErrorMessage(ss.str());
+    return getErrorCode();
+  }
+  m_Dims.resize(static_cast<size_t>(rank));
+  H5Sget_simple_extent_dims(dataspaceId, m_Dims.data(), nullptr);
+  H5Sclose(dataspaceId);
+
+  // A block that covers whole chunks along the pattern index decompresses every chunk exactly once
+  m_ChunkPatterns = 1;
+  hid_t createPropId = H5Dget_create_plist(m_DatasetId);
+  if(createPropId >= 0)
+  {
+    if(H5Pget_layout(createPropId) == H5D_CHUNKED)
+    {
+      std::vector<hsize_t> chunkDims(m_Dims.size(), 0);
+      if(H5Pget_chunk(createPropId, rank, chunkDims.data()) == rank && chunkDims[0] > 0)
+      {
+        m_ChunkPatterns = static_cast<size_t>(chunkDims[0]);
+      }
+    }
+    H5Pclose(createPropId);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5PatternReader::close()
+{
+  if(m_DatasetId >= 0)
+  {
+    H5Dclose(m_DatasetId);
+  }
+  if(m_FileId >= 0)
+  {
+    H5Utilities::closeFile(m_FileId);
+  }
+  m_DatasetId = -1;
+  m_FileId = -1;
+  m_Dims.clear();
+  m_ChunkPatterns = 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5PatternReader::isOpen() const
+{
+  return m_DatasetId >= 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string H5PatternReader::getFilePath() const
+{
+  return m_FilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string H5PatternReader::getDatasetPath() const
+{
+  return m_DatasetPath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::getNumberOfPatterns() const
+{
+  return m_Dims.empty() ? 0 : static_cast<size_t>(m_Dims[0]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> H5PatternReader::getPatternDims() const
+{
+  if(m_Dims.empty())
+  {
+    return {};
+  }
+  return std::vector<size_t>(m_Dims.begin() + 1, m_Dims.end());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::getPatternSize() const
+{
+  if(m_Dims.empty())
+  {
+    return 0;
+  }
+  return std::accumulate(m_Dims.cbegin() + 1, m_Dims.cend(), static_cast<size_t>(1), std::multiplies<size_t>());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::getChunkPatterns() const
+{
+  return m_ChunkPatterns;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::getAlignedBlockSize(size_t numPatterns) const
+{
+  numPatterns = std::max(numPatterns, static_cast<size_t>(1));
+  return ((numPatterns + m_ChunkPatterns - 1) / m_ChunkPatterns) * m_ChunkPatterns;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5PatternReader::readPatterns(size_t firstIndex, size_t count, uint8_t* buffer)
+{
+  const int err = readHyperslab(firstIndex, count, buffer);
+  if(err < 0)
+  {
+    return setReadError(err, firstIndex, count);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5PatternReader::readHyperslab(size_t firstIndex, size_t count, uint8_t* buffer) const
+{
+  if(!isOpen())
+  {
+    return -90503;
+  }
+  if(count == 0)
+  {
+    return 0;
+  }
+  if(nullptr == buffer || firstIndex >= getNumberOfPatterns() || count > getNumberOfPatterns() - firstIndex)
+  {
+    return -90504;
+  }
+
+  std::vector<hsize_t> offset(m_Dims.size(), 0);
+  std::vector<hsize_t> blockDims = m_Dims;
+  offset[0] = static_cast<hsize_t>(firstIndex);
+  blockDims[0] = static_cast<hsize_t>(count);
+
+  hid_t fileSpaceId = H5Dget_space(m_DatasetId);
+  herr_t err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset.data(), nullptr, blockDims.data(), nullptr);
+  hid_t memSpaceId = H5Screate_simple(static_cast<int>(blockDims.size()), blockDims.data(), nullptr);
+  if(err >= 0 && memSpaceId >= 0)
+  {
+    err = H5Dread(m_DatasetId, H5T_NATIVE_UINT8, memSpaceId, fileSpaceId, H5P_DEFAULT, buffer);
+  }
+  else
+  {
+    err = -1;
+  }
+  if(memSpaceId >= 0)
+  {
+    H5Sclose(memSpaceId);
+  }
+  H5Sclose(fileSpaceId);
+  return err < 0 ? -90505 : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5PatternReader::setReadError(int errorCode, size_t firstIndex, size_t count)
+{
+  std::stringstream ss;
+  ss << getNameOfClass() << " Error: ";
+  switch(errorCode)
+  {
+  case -90503:
+    ss << "No pattern data set is open";
+    break;
+  case -90504:
+    ss << "Patterns [" << firstIndex << ", " << firstIndex + count << ") are outside of the " << getNumberOfPatterns() << " patterns in the data set";
+    break;
+  default:
+    ss << "Could not read patterns [" << firstIndex << ", " << firstIndex + count << ")";
+    break;
+  }
+  setErrorCode(errorCode);
+  setErrorMessage(ss.str());
+  return errorCode;
+}
+
+// -----------------------------------------------------------------------------
+H5PatternReader::Pointer H5PatternReader::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+void H5PatternReader::setErrorMessage(const std::string& value)
+{
+  m_ErrorMessage = value;
+}
+
+// -----------------------------------------------------------------------------
+std::string H5PatternReader::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+std::string H5PatternReader::getNameOfClass() const
+{
+  return std::string("H5PatternReader");
+}
+
+// -----------------------------------------------------------------------------
+std::string H5PatternReader::ClassName()
+{
+  return std::string("H5PatternReader");
+}
+
+// =============================================================================
+// BlockIterator
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::BlockIterator::BlockIterator(H5PatternReader& reader, size_t patternsPerBlock)
+: m_Reader(reader)
+, m_BlockSize(reader.getAlignedBlockSize(patternsPerBlock))
+{
+  hbool_t threadSafe = 0;
+  m_Prefetch = H5is_library_threadsafe(&threadSafe) >= 0 && threadSafe > 0;
+  startRead(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::BlockIterator::~BlockIterator()
+{
+  // The background read writes into m_Pending so it has to finish before the buffers go away
+  if(m_PendingRead.valid())
+  {
+    m_PendingRead.wait();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5PatternReader::BlockIterator::startRead(size_t firstIndex)
+{
+  const size_t numPatterns = m_Reader.getNumberOfPatterns();
+  if(firstIndex >= numPatterns)
+  {
+    return;
+  }
+  m_PendingIndex = firstIndex;
+  m_PendingCount = std::min(m_BlockSize, numPatterns - firstIndex);
+  m_Pending.resize(m_PendingCount * m_Reader.getPatternSize());
+
+  const H5PatternReader* reader = &m_Reader;
+  uint8_t* destination = m_Pending.data();
+  const size_t count = m_PendingCount;
+  if(!m_Prefetch)
+  {
+    // Without a thread safe HDF5 library the block is read right here on the calling thread
+    std::promise<int> result;
+    result.set_value(reader->readHyperslab(firstIndex, count, destination));
+    m_PendingRead = result.get_future();
+    return;
+  }
+  // The worker only reads. The error code travels back through the future so the reader
+  // itself is never modified from the worker thread.
+  m_PendingRead = std::async(std::launch::async, [reader, firstIndex, count, destination]() { return reader->readHyperslab(firstIndex, count, destination); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5PatternReader::BlockIterator::next()
+{
+  if(!m_PendingRead.valid())
+  {
+    m_Count = 0;
+    return false;
+  }
+  m_ErrorCode = m_PendingRead.get();
+  if(m_ErrorCode < 0)
+  {
+    m_Reader.setReadError(m_ErrorCode, m_PendingIndex, m_PendingCount);
+    m_Count = 0;
+    return false;
+  }
+  std::swap(m_Current, m_Pending);
+  m_FirstIndex = m_PendingIndex;
+  m_Count = m_PendingCount;
+
+  // Read the following block while the caller works on this one
+  startRead(m_FirstIndex + m_Count);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const uint8_t* H5PatternReader::BlockIterator::data() const
+{
+  return m_Current.data();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::BlockIterator::getFirstIndex() const
+{
+  return m_FirstIndex;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::BlockIterator::getCount() const
+{
+  return m_Count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5PatternReader::BlockIterator::getBlockSize() const
+{
+  return m_BlockSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5PatternReader::BlockIterator::getErrorCode() const
+{
+  return m_ErrorCode;
+}
@@ -0,0 +1,311 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/H5DatasetLayout.h"
+
+class EbsdReader;
+
+/**
+ * @class H5PatternReader H5PatternReader.h EbsdLib/IO/H5PatternReader.h
+ * @brief Reads EBSD patterns out of a [NumPatterns][Height][Width] data set a range of
+ * patterns at a time using HDF5 hyperslabs, so that the pattern data set never has to be
+ * held in memory as a whole. The data set stays open between reads.
+ */
+class EbsdLib_EXPORT H5PatternReader
+{
+public:
+  using Self = H5PatternReader;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<Self>;
+  static Pointer NullPointer();
+
+  EBSD_STATIC_NEW_MACRO(H5PatternReader)
+
+  /**
+   * @brief Returns the name of the class for H5PatternReader
+   */
+  std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for H5PatternReader
+   */
+  static std::string ClassName();
+
+  virtual ~H5PatternReader();
+
+  /**
+   * @brief These get filled out if there are errors. Negative values are error codes
+   */
+  EBSD_INSTANCE_PROPERTY(int, ErrorCode)
+
+  /**
+   * @brief Setter property for ErrorMessage
+   */
+  void setErrorMessage(const std::string& value);
+  /**
+   * @brief Getter property for ErrorMessage
+   * @return Value of ErrorMessage
+   */
+  std::string getErrorMessage() const;
+
+  /**
+   * @brief The chunk cache used to open the pattern data set. Set it before calling open().
+   * A cache that holds the chunks of a whole block avoids decompressing chunks more than once.
+   */
+  EBSD_INSTANCE_PROPERTY(H5ChunkCache, ChunkCache)
+
+  /**
+   * @brief Creates a reader for the pattern data set of an EBSD reader and opens it.
+   * @param owner The EBSD reader that receives the error code and message on failure
+   * @param filePath The HDF5 file
+   * @param datasetPath Full path to the pattern data set. Empty if the scan is not selected yet.
+   * @param chunkCache The chunk cache to open the data set with
+   * @return The open reader or nullptr on error
+   */
+  static Pointer Create(EbsdReader& owner, const std::string& filePath, const std::string& datasetPath, const H5ChunkCache& chunkCache);
+
+  /**
+   * @brief Reads a range of patterns for an EBSD reader that keeps its pattern reader between
+   * calls. The reader is created on the first call and created again whenever the file or data
+   * set path changes.
+   * @param owner The EBSD reader that receives the error code and message on failure
+   * @param patternReader The pattern reader kept by owner
+   * @param filePath The HDF5 file
+   * @param datasetPath Full path to the pattern data set. Empty if the scan is not selected yet.
+   * @param chunkCache The chunk cache to open the data set with
+   * @param firstIndex Index of the first pattern
+   * @param count Number of patterns
+   * @param buffer Must hold count * getPatternSize() values
+   * @return Negative value on error
+   */
+  static int ReadPatterns(EbsdReader& owner, Pointer& patternReader, const std::string& filePath, const std::string& datasetPath, const H5ChunkCache& chunkCache, size_t firstIndex, size_t count,
+                          uint8_t* buffer);
+
+  /**
+   * @brief Opens the pattern data set. Any previously opened data set is closed first.
+   * @param filePath The HDF5 file
+   * @param datasetPath Full path to the pattern data set inside of the file
+   * @return Negative value on error
+   */
+  int open(const std::string& filePath, const std::string& datasetPath);
+
+  /**
+   * @brief Closes the data set and the file
+   */
+  void close();
+
+  /**
+   * @brief Returns true if a pattern data set is open
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Returns the file of the data set that was last opened
+   */
+  std::string getFilePath() const;
+
+  /**
+   * @brief Returns the path of the data set that was last opened
+   */
+  std::string getDatasetPath() const;
+
+  /**
+   * @brief Returns the number of patterns, which is the slowest dimension of the data set
+   */
+  size_t getNumberOfPatterns() const;
+
+  /**
+   * @brief Returns the dimensions of a single pattern, slowest first
+   */
+  std::vector<size_t> getPatternDims() const;
+
+  /**
+   * @brief Returns the number of values (bytes) in a single pattern
+   */
+  size_t getPatternSize() const;
+
+  /**
+   * @brief Returns how many patterns one HDF5 chunk spans. This is 1 for contiguous data sets.
+   */
+  size_t getChunkPatterns() const;
+
+  /**
+   * @brief Rounds a number of patterns up to a whole number of chunks so that a block read
+   * never decompresses a chunk that the next block needs again.
+   * @param numPatterns
+   */
+  size_t getAlignedBlockSize(size_t numPatterns) const;
+
+  /**
+   * @brief Reads a contiguous range of patterns into the buffer with a single hyperslab read.
+   * Values are converted to uint8_t by HDF5 if the data set uses a different type.
+   * @param firstIndex Index of the first pattern
+   * @param count Number of patterns
+   * @param buffer Must hold count * getPatternSize() values
+   * @return Negative value on error
+   */
+  int readPatterns(size_t firstIndex, size_t count, uint8_t* buffer);
+
+  /**
+   * @class BlockIterator
+   * @brief Walks the patterns of an open H5PatternReader block by block. If the HDF5 library
+   * was built thread safe (H5is_library_threadsafe()) the next block is read on a background
+   * thread while the caller works on the current one, otherwise each block is read
+   * synchronously. Only two blocks are ever held in memory.
+   *
+   * While a block is being prefetched the reader must not be used for anything else and no
+   * other HDF5 call may be made anywhere in the process, since it would either wait for the
+   * read or, through a second copy of the library, race with it. Errors are reported by
+   * next() on the calling thread.
+   *
+   * @code
+   *   H5PatternReader::BlockIterator iter(*reader, 4096);
+   *   while(iter.next())
+   *   {
+   *     process(iter.data(), iter.getFirstIndex(), iter.getCount());
+   *   }
+   * @endcode
+   */
+  class EbsdLib_EXPORT BlockIterator
+  {
+  public:
+    /**
+     * @param reader An open reader
+     * @param patternsPerBlock Requested block size. It is rounded up to a whole number of chunks.
+     */
+    BlockIterator(H5PatternReader& reader, size_t patternsPerBlock);
+    ~BlockIterator();
+
+    /**
+     * @brief Advances to the next block
+     * @return false when all patterns have been visited or a read failed
+     */
+    bool next();
+
+    /**
+     * @brief Returns the patterns of the current block
+     */
+    const uint8_t* data() const;
+
+    /**
+     * @brief Returns the index of the first pattern of the current block
+     */
+    size_t getFirstIndex() const;
+
+    /**
+     * @brief Returns the number of patterns in the current block
+     */
+    size_t getCount() const;
+
+    /**
+     * @brief Returns the block size after rounding to the chunk size
+     */
+    size_t getBlockSize() const;
+
+    /**
+     * @brief Returns the error of the last read, negative if next() stopped because of an error
+     */
+    int getErrorCode() const;
+
+  private:
+    /**
+     * @brief Starts reading the block that begins at firstIndex, on a background thread if prefetching
+     */
+    void startRead(size_t firstIndex);
+
+    H5PatternReader& m_Reader;
+    bool m_Prefetch = false;
+    size_t m_BlockSize = 1;
+    size_t m_FirstIndex = 0;
+    size_t m_Count = 0;
+    int m_ErrorCode = 0;
+    std::vector<uint8_t> m_Current;
+    std::vector<uint8_t> m_Pending;
+    size_t m_PendingIndex = 0;
+    size_t m_PendingCount = 0;
+    std::future<int> m_PendingRead;
+
+  public:
+    BlockIterator(const BlockIterator&) = delete;            // Copy Constructor Not Implemented
+    BlockIterator(BlockIterator&&) = delete;                 // Move Constructor Not Implemented
+    BlockIterator& operator=(const BlockIterator&) = delete; // Copy Assignment Not Implemented
+    BlockIterator& operator=(BlockIterator&&) = delete;      // Move Assignment Not Implemented
+  };
+
+protected:
+  H5PatternReader();
+
+private:
+  /**
+   * @brief Performs the hyperslab read of readPatterns() without touching the error state
+   * of the reader, so that it can run on a background thread.
+   * @return 0 or the error code that readPatterns() would set
+   */
+  int readHyperslab(size_t firstIndex, size_t count, uint8_t* buffer) const;
+
+  /**
+   * @brief Sets the error code and the matching message for a failed read of the given range
+   * @return The error code
+   */
+  int setReadError(int errorCode, size_t firstIndex, size_t count);
+
+  std::string m_ErrorMessage = {};
+  std::string m_FilePath = {};
+  std::string m_DatasetPath = {};
+  hid_t m_FileId = -1;
+  hid_t m_DatasetId = -1;
+  std::vector<hsize_t> m_Dims;
+  size_t m_ChunkPatterns = 1;
+
+public:
+  H5PatternReader(const H5PatternReader&) = delete;            // Copy Constructor Not Implemented
+  H5PatternReader(H5PatternReader&&) = delete;                 // Move Constructor Not Implemented
+  H5PatternReader& operator=(const H5PatternReader&) = delete; // Copy Assignment Not Implemented
+  H5PatternReader& operator=(H5PatternReader&&) = delete;      // Move Assignment Not Implemented
+};
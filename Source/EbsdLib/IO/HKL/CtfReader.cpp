@@ -36,20 +36,34 @@
 #include "CtfReader.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "CtfPhase.h"
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+#include "EbsdLib/Utilities/MemoryMappedFile.h"
 
 //#define PI_OVER_2f       90.0f
 //#define THREE_PI_OVER_2f 270.0f
 //#define TWO_PIf          360.0f
 //#define ONE_PIf          180.0f
 
+namespace
+{
+constexpr size_t k_DefaultParallelBlockSize = 4 * 1024 * 1024;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -82,6 +96,8 @@ CtfReader::CtfReader()
   setXCells(0);
   setYCells(0);
   setZCells(1);
+  m_UseParallelRead = false;
+  m_ParallelBlockSize = k_DefaultParallelBlockSize;
 }
 
 // -----------------------------------------------------------------------------
@@ -545,6 +561,20 @@ int CtfReader::readData(std::ifstream& in)
     }
   }
 
+  if(initializeDataParser() < 0)
+  {
+    return getErrorCode();
+  }
+
+  if(m_UseParallelRead)
+  {
+    std::istream::pos_type dataOffset = in.tellg();
+    if(dataOffset >= 0)
+    {
+      return readDataParallel(static_cast<size_t>(dataOffset), static_cast<size_t>(xCells) * static_cast<size_t>(yCells));
+    }
+  }
+
   // Now start reading the data line by line
   int err = 0;
   size_t counter = 0;
@@ -597,6 +627,314 @@ int CtfReader::readData(std::ifstream& in)
   return 0;
 }
 
+namespace
+{
+constexpr size_t k_RowsPerBatch = 1024;
+
+/**
+ * @brief Records the first error that a block of lines encountered.
+ */
+struct CtfBlockResult
+{
+  size_t parsedLines = 0;
+  size_t errorLine = std::numeric_limits<size_t>::max();
+  int errorCode = 0;
+  size_t errorTokenCount = 0;
+};
+
+/**
+ * @brief The CountCtfLinesImpl class counts the newline characters in each fixed size block of the data section.
+ */
+class CountCtfLinesImpl
+{
+public:
+  CountCtfLinesImpl(const char* body, size_t bodySize, size_t blockSize, std::vector<size_t>& newLineCounts)
+  : m_Body(body)
+  , m_BodySize(bodySize)
+  , m_BlockSize(blockSize)
+  , m_NewLineCounts(newLineCounts)
+  {
+  }
+
+  void count(size_t start, size_t end) const
+  {
+    for(size_t block = start; block < end; block++)
+    {
+      const char* cursor = m_Body + block * m_BlockSize;
+      const char* blockEnd = m_Body + std::min(m_BodySize, (block + 1) * m_BlockSize);
+      size_t numNewLines = 0;
+      while(cursor < blockEnd)
+      {
+        cursor = static_cast<const char*>(::memchr(cursor, '\n', static_cast<size_t>(blockEnd - cursor)));
+        if(cursor == nullptr)
+        {
+          break;
+        }
+        ++numNewLines;
+        ++cursor;
+      }
+      m_NewLineCounts[block] = numNewLines;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    count(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Body;
+  size_t m_BodySize;
+  size_t m_BlockSize;
+  std::vector<size_t>& m_NewLineCounts;
+};
+
+/**
+ * @brief The ParseCtfBlockImpl class parses every line that starts inside a block of the data section
+ * straight into the column arrays. The index of the first line of each block is known from the newline counts
+ * so every block can be parsed independently. Each block uses its own copy of the column parser.
+ */
+class ParseCtfBlockImpl
+{
+public:
+  ParseCtfBlockImpl(const char* body, size_t bodySize, size_t blockSize, const std::vector<size_t>& firstLineIndex, const BatchColumnParser& parser, size_t firstWantedLine,
+                    size_t numWantedLines, std::vector<CtfBlockResult>& results)
+  : m_Body(body)
+  , m_BodySize(bodySize)
+  , m_BlockSize(blockSize)
+  , m_FirstLineIndex(firstLineIndex)
+  , m_Parser(parser)
+  , m_FirstWantedLine(firstWantedLine)
+  , m_NumWantedLines(numWantedLines)
+  , m_Results(results)
+  {
+  }
+
+  void parse(size_t start, size_t end) const
+  {
+    BatchColumnParser parser = m_Parser;
+    std::vector<std::string_view> rows;
+    rows.reserve(k_RowsPerBatch);
+    for(size_t block = start; block < end; block++)
+    {
+      parseBlock(block, parser, rows);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    parse(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Body;
+  size_t m_BodySize;
+  size_t m_BlockSize;
+  const std::vector<size_t>& m_FirstLineIndex;
+  const BatchColumnParser& m_Parser;
+  size_t m_FirstWantedLine;
+  size_t m_NumWantedLines;
+  std::vector<CtfBlockResult>& m_Results;
+
+  void parseBlock(size_t block, BatchColumnParser& parser, std::vector<std::string_view>& rows) const
+  {
+    const char* bodyEnd = m_Body + m_BodySize;
+    const char* blockStart = m_Body + block * m_BlockSize;
+    const char* blockEnd = m_Body + std::min(m_BodySize, (block + 1) * m_BlockSize);
+    size_t lineIndex = m_FirstLineIndex[block];
+    CtfBlockResult& result = m_Results[block];
+
+    // Find the first line that starts inside this block. A line that started in the previous block belongs to that block.
+    const char* cursor = blockStart;
+    if(block > 0 && *(blockStart - 1) != '\n')
+    {
+      cursor = static_cast<const char*>(::memchr(blockStart, '\n', static_cast<size_t>(blockEnd - blockStart)));
+      if(cursor == nullptr)
+      {
+        return;
+      }
+      ++cursor;
+      ++lineIndex;
+    }
+
+    // Lines are gathered into batches of consecutive rows which are then converted column by column
+    rows.clear();
+    size_t batchFirstLine = 0;
+    const size_t lastWantedLine = m_FirstWantedLine + m_NumWantedLines;
+    while(cursor < blockEnd && lineIndex < lastWantedLine)
+    {
+      const char* lineEnd = static_cast<const char*>(::memchr(cursor, '\n', static_cast<size_t>(bodyEnd - cursor)));
+      bool isLastLine = (lineEnd == nullptr);
+      lineEnd = isLastLine ? bodyEnd : lineEnd;
+
+      if(lineIndex >= m_FirstWantedLine)
+      {
+        std::string_view row(cursor, static_cast<size_t>(lineEnd - cursor));
+        // An empty last line without a newline is the end of the file and not a line of data
+        if(isLastLine && std::all_of(row.begin(), row.end(), EbsdStringUtils::is_space))
+        {
+          break;
+        }
+        if(rows.empty())
+        {
+          batchFirstLine = lineIndex;
+        }
+        rows.push_back(row);
+        if(rows.size() == k_RowsPerBatch && !parseBatch(parser, rows, batchFirstLine, result))
+        {
+          return;
+        }
+      }
+      cursor = lineEnd + 1;
+      ++lineIndex;
+    }
+    parseBatch(parser, rows, batchFirstLine, result);
+  }
+
+  bool parseBatch(BatchColumnParser& parser, std::vector<std::string_view>& rows, size_t batchFirstLine, CtfBlockResult& result) const
+  {
+    if(rows.empty())
+    {
+      return true;
+    }
+    int32_t err = parser.parseRows(rows.data(), rows.size(), batchFirstLine - m_FirstWantedLine);
+    if(err < 0)
+    {
+      result.parsedLines += parser.getErrorRow();
+      result.errorLine = batchFirstLine + parser.getErrorRow();
+      if(err == BatchColumnParser::k_ColumnCountMismatch)
+      {
+        result.errorCode = -109;
+        result.errorTokenCount = parser.getErrorTokenCount();
+      }
+      else
+      {
+        result.errorCode = -108;
+        result.errorTokenCount = parser.getErrorColumn();
+      }
+      rows.clear();
+      return false;
+    }
+    result.parsedLines += rows.size();
+    rows.clear();
+    return true;
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::readDataParallel(size_t dataOffset, size_t pointsPerSlice)
+{
+  MemoryMappedFile mappedFile;
+  if(!mappedFile.open(getFileName()))
+  {
+    std::string msg = std::string("Ctf file could not be opened: ") + getFileName();
+    setErrorCode(-100);
+    setErrorMessage(msg);
+    return -100;
+  }
+  mappedFile.advise(MemoryMappedFile::AccessHint::Sequential);
+
+  const char* body = mappedFile.data() + std::min(dataOffset, mappedFile.size());
+  size_t bodySize = mappedFile.size() - std::min(dataOffset, mappedFile.size());
+
+  size_t firstWantedLine = 0;
+  if(m_SingleSliceRead >= 0)
+  {
+    firstWantedLine = static_cast<size_t>(m_SingleSliceRead) * pointsPerSlice;
+  }
+  size_t numWantedLines = getNumberOfElements();
+
+  const size_t blockSize = std::max<size_t>(m_ParallelBlockSize, 1);
+  size_t numBlocks = (bodySize + blockSize - 1) / blockSize;
+  std::vector<size_t> firstLineIndex(numBlocks, 0);
+  std::vector<CtfBlockResult> results(numBlocks);
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), CountCtfLinesImpl(body, bodySize, blockSize, firstLineIndex), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    CountCtfLinesImpl serial(body, bodySize, blockSize, firstLineIndex);
+    serial.count(0, numBlocks);
+  }
+
+  // Convert the newline counts into the index of the line that is active at the start of each block
+  size_t runningTotal = 0;
+  for(size_t block = 0; block < numBlocks; block++)
+  {
+    size_t numNewLines = firstLineIndex[block];
+    firstLineIndex[block] = runningTotal;
+    runningTotal += numNewLines;
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), ParseCtfBlockImpl(body, bodySize, blockSize, firstLineIndex, m_DataParser, firstWantedLine, numWantedLines, results), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    ParseCtfBlockImpl serial(body, bodySize, blockSize, firstLineIndex, m_DataParser, firstWantedLine, numWantedLines, results);
+    serial.parse(0, numBlocks);
+  }
+
+  // The first error in file order is reported, the same as the serial reader which stops at the first bad line.
+  size_t counter = 0;
+  const CtfBlockResult* firstError = nullptr;
+  for(const auto& result : results)
+  {
+    counter += result.parsedLines;
+    if(result.errorCode < 0 && (firstError == nullptr || result.errorLine < firstError->errorLine))
+    {
+      firstError = &result;
+    }
+  }
+
+  if(firstError != nullptr)
+  {
+    size_t row = ((firstError->errorLine - firstWantedLine) % pointsPerSlice) / static_cast<size_t>(getXCells());
+    std::stringstream ss;
+    if(firstError->errorCode == -109)
+    {
+      setErrorCode(-107);
+      ss << "The number of tab delimited data columns (" << firstError->errorTokenCount << ") does not match the number of tab delimited header columns (";
+      ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes, specifically the header line that labels each column of data.";
+    }
+    else
+    {
+      setErrorCode(firstError->errorCode);
+      ss << "The value in data column " << firstError->errorTokenCount << " could not be converted to a number.";
+    }
+    ss << "The error occurred at data row " << row << " which is " << row << " past ";
+    ss << "the column header row.";
+    ss << "\nThe CTF Reader will now abort reading any further in the file.";
+    setErrorMessage(ss.str());
+    return firstError->errorCode;
+  }
+
+  if(counter != numWantedLines)
+  {
+    std::stringstream ss;
+    ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter << "\nTotal Data Points Read=" << counter << "\n";
+    setErrorMessage(ss.str());
+    setErrorCode(-105);
+    return -105;
+  }
+  return 0;
+}
+
 #if 0
 #define PRINT_HTML_TABLE_ROW(p)                                                                                                                                                                        \
   std::cout << "<tr>\n    <td>" << p->getKey() << "</td>\n    <td>" << p->getHDFType() << "</td>\n";                                                                                                   \
@@ -718,42 +1056,56 @@ int CtfReader::parseHeaderLines(std::vector<std::string>& headerLines)
 int CtfReader::parseDataLine(std::string& line, size_t row, size_t col, size_t offset, size_t xCells, size_t yCells)
 {
   /* When reading the data there should be at least 11 cols of data.
+   * European comma style decimals are converted to US/UK style points by the parser.
    */
-  //  float x, y,  p1, p, p2, mad;
-  //  int phase, bCount, error, bc, bs;
-  //  size_t offset = i;
-
-  // Filter the line to convert European command style decimals to US/UK style points
-  //  std::vector<char> cLine(line.size()+1);
-  //  ::memcpy( &(cLine.front()), line.c_str(), line.size() + 1);
-  for(int c = 0; c < line.size(); ++c)
-  {
-    if(line.at(c) == ',')
-    {
-      line[c] = '.';
-    }
-  }
-
-  EbsdStringUtils::StringTokenType tokens = EbsdStringUtils::split(line, '\t');
-  if(tokens.size() != m_NamePointerMap.size())
+  int32_t err = m_DataParser.parseRow(line, offset);
+  if(err == BatchColumnParser::k_ColumnCountMismatch)
   {
     setErrorCode(-107);
-    std::string msg;
-    std::stringstream ss(msg);
-    ss << "The number of tab delimited data columns (" << tokens.size() << ") does not match the number of tab delimited header columns (";
+    std::stringstream ss;
+    ss << "The number of tab delimited data columns (" << m_DataParser.getErrorTokenCount() << ") does not match the number of tab delimited header columns (";
     ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes, specifically the header line that labels each column of data.";
     ss << "The error occurred at data row " << row << " which is " << row << " past ";
     ss << "the column header row.";
     ss << "\nThe CTF Reader will now abort reading any further in the file.";
-
-    setErrorMessage(msg);
+    setErrorMessage(ss.str());
     return -109;
   }
+  if(err < 0)
+  {
+    setErrorCode(-108);
+    std::stringstream ss;
+    ss << "The value in data column " << m_DataParser.getErrorColumn() << " could not be converted to a number.";
+    ss << "The error occurred at data row " << row << " which is " << row << " past ";
+    ss << "the column header row.";
+    ss << "\nThe CTF Reader will now abort reading any further in the file.";
+    setErrorMessage(ss.str());
+    return -108;
+  }
+  return 0;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::initializeDataParser()
+{
+  m_DataParser.setDelimiter(BatchColumnParser::Delimiter::Tab);
+  m_DataParser.setRequireAllColumns(true);
+  m_DataParser.setConvertDecimalCommas(true);
+  m_DataParser.setNumberOfColumns(m_NamePointerMap.size());
   for(const auto& iter : m_NamePointerMap)
   {
-    DataParser::Pointer dparser = iter.second;
-    dparser->parse(tokens[dparser->getColumnIndex()], offset);
+    const DataParser::Pointer& dparser = iter.second;
+    size_t columnIndex = static_cast<size_t>(dparser->getColumnIndex());
+    if(columnIndex >= m_NamePointerMap.size())
+    {
+      setErrorCode(-107);
+      setErrorMessage("The column headers of the CTF file could not be matched to the data columns.");
+      return -107;
+    }
+    EbsdLib::NumericTypes::Type type = (dparser->IsA() == 1) ? EbsdLib::NumericTypes::Type::Int32 : EbsdLib::NumericTypes::Type::Float;
+    m_DataParser.setColumn(columnIndex, type, dparser->getVoidPointer());
   }
   return 0;
 }
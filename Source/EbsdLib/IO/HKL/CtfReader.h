@@ -48,6 +48,7 @@
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/BatchColumnParser.hpp"
 #include "EbsdLib/IO/EbsdReader.h"
 
 #define CTF_READER_PTR_PROP(name, var, type)                                                                                                                                                           \
@@ -154,6 +155,21 @@ public:
 
   void readOnlySliceIndex(int slice);
 
+  /**
+   * @brief When true the data section of the file is memory mapped, split into
+   * line aligned blocks and the blocks are parsed concurrently directly into the
+   * column arrays. The single slice read and premature end of file semantics are
+   * the same as the serial reader. The default is false.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseParallelRead)
+
+  /**
+   * @brief The size in bytes of the blocks that the data section is split into when
+   * UseParallelRead is true. Lines that straddle a block boundary belong to the block
+   * they start in. The default is 4 MiB.
+   */
+  EBSD_INSTANCE_PROPERTY(size_t, ParallelBlockSize)
+
   int getXDimension() override;
   void setXDimension(int xdim) override;
   int getYDimension() override;
@@ -171,6 +187,7 @@ private:
   int m_SingleSliceRead = -1;
 
   std::map<std::string, DataParser::Pointer> m_NamePointerMap;
+  BatchColumnParser m_DataParser;
 
   /**
    * @brief
@@ -201,6 +218,19 @@ private:
    */
   int readData(std::ifstream& in);
 
+  /**
+   * @brief Parses the data section of the file in parallel from a memory mapping of the file
+   * @param dataOffset The byte offset into the file of the first line of data
+   * @param pointsPerSlice Number of data lines in a single Z slice
+   */
+  int readDataParallel(size_t dataOffset, size_t pointsPerSlice);
+
+  /**
+   * @brief Configures the column parser from the allocated column arrays
+   * @return Error code
+   */
+  int initializeDataParser();
+
   /**
    * @brief Reads a line of Data from the ASCII based file
    * @param line The current line of data
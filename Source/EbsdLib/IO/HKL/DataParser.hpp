@@ -179,7 +179,8 @@ public:
 
   bool allocateArray(size_t numberOfElements) override
   {
-    m_Ptr = new(std::nothrow) int32_t[numberOfElements]();
+    // The CtfReader fills the array with a marker value right after it is allocated
+    m_Ptr = new(std::nothrow) int32_t[numberOfElements];
     return (m_Ptr != nullptr);
   }
 
@@ -285,7 +286,8 @@ public:
 
   bool allocateArray(size_t numberOfElements) override
   {
-    m_Ptr = new(std::nothrow) float[numberOfElements]();
+    // The CtfReader fills the array with a marker value right after it is allocated
+    m_Ptr = new(std::nothrow) float[numberOfElements];
     return (m_Ptr != nullptr);
   }
 
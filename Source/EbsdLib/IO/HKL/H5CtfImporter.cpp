@@ -36,6 +36,7 @@
 #include "H5CtfImporter.h"
 
 #include <cassert>
+#include <memory>
 
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
@@ -90,7 +91,7 @@ using namespace H5Support_NAMESPACE;
   {                                                                                                                                                                                                    \
     if(nullptr != dataPtr)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      err = H5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);                                                                                                                                \
+      err = datasetLayout.writeDataset(gid, key, xCells, yCells, dataPtr);                                                                                                                             \
       if(err < 0)                                                                                                                                                                                      \
       {                                                                                                                                                                                                \
         std::stringstream ss;                                                                                                                                                                          \
@@ -144,7 +145,6 @@ int H5CtfImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5CtfImporter::importFile(hid_t fileId, int64_t z, const std::string& ctfFile)
 {
-  herr_t err = -1;
   setCancel(false);
   setErrorCode(0);
   // setPipelineMessage("");
@@ -154,7 +154,33 @@ int H5CtfImporter::importFile(hid_t fileId, int64_t z, const std::string& ctfFil
   reader.setFileName(ctfFile);
 
   // Now actually read the file
-  err = reader.readFile();
+  int err = reader.readFile();
+  return writeParsedFile(fileId, z, reader, err);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::unique_ptr<EbsdReader> H5CtfImporter::createReader() const
+{
+  return std::make_unique<CtfReader>();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::writeParsedFile(hid_t fileId, int64_t z, EbsdReader& ebsdReader, int readError)
+{
+  herr_t err = readError;
+
+  auto* ctfReader = dynamic_cast<CtfReader*>(&ebsdReader);
+  if(nullptr == ctfReader)
+  {
+    setErrorCode(-800);
+    progressMessage("H5CtfImporter Error: The file '" + ebsdReader.getFileName() + "' was not parsed by a CtfReader.", 100);
+    return -1;
+  }
+  CtfReader& reader = *ctfReader;
 
   // Check for errors
   if(err < 0)
@@ -331,8 +357,10 @@ int H5CtfImporter::writeSliceData(hid_t fileId, CtfReader& reader, int z, int ac
     return -1;
   }
 
-  int32_t rank = 1;
-  hsize_t dims[1] = {static_cast<hsize_t>(reader.getXCells() * reader.getYCells())};
+  const H5DatasetLayout datasetLayout = getDatasetLayout();
+  hsize_t xCells = static_cast<hsize_t>(reader.getXCells());
+  hsize_t yCells = static_cast<hsize_t>(reader.getYCells());
+  hsize_t totalPoints = xCells * yCells;
 
   EbsdLib::NumericTypes::Type numType = EbsdLib::NumericTypes::Type::UnknownNumType;
   std::vector<std::string> columnNames = reader.getColumnNames();
@@ -346,8 +374,8 @@ int H5CtfImporter::writeSliceData(hid_t fileId, CtfReader& reader, int z, int ac
       if(nullptr == dataPtr)
       {
         assert(false);
-      }                                            // We are going to crash here. I would rather crash than have bad data
-      dataPtr = dataPtr + (actualSlice * dims[0]); // Put the pointer at the proper offset into the larger array
+      }                                                // We are going to crash here. I would rather crash than have bad data
+      dataPtr = dataPtr + (actualSlice * totalPoints); // Put the pointer at the proper offset into the larger array
       WRITE_EBSD_DATA_ARRAY(reader, int, gid, name);
     }
     else if(numType == EbsdLib::NumericTypes::Type::Float)
@@ -356,8 +384,8 @@ int H5CtfImporter::writeSliceData(hid_t fileId, CtfReader& reader, int z, int ac
       if(nullptr == dataPtr)
       {
         assert(false);
-      }                                            // We are going to crash here. I would rather crash than have bad data
-      dataPtr = dataPtr + (actualSlice * dims[0]); // Put the pointer at the proper offset into the larger array
+      }                                                // We are going to crash here. I would rather crash than have bad data
+      dataPtr = dataPtr + (actualSlice * totalPoints); // Put the pointer at the proper offset into the larger array
       WRITE_EBSD_DATA_ARRAY(reader, float, gid, name);
     }
     else
@@ -124,6 +124,21 @@ public:
 protected:
   H5CtfImporter();
 
+  /**
+   * @brief Creates the CtfReader that importFiles() parses each file with
+   */
+  std::unique_ptr<EbsdReader> createReader() const override;
+
+  /**
+   * @brief Writes a parsed .ctf file into the HDF5 file. 3D .ctf files fill consecutive slices
+   * starting at z.
+   * @param fileId The valid HDF5 file Id for an already open HDF5 file
+   * @param z The slice index for the file
+   * @param ebsdReader The CtfReader that parsed the file
+   * @param readError The value that CtfReader::readFile() returned
+   */
+  int writeParsedFile(hid_t fileId, int64_t z, EbsdReader& ebsdReader, int readError) override;
+
   int writeSliceData(hid_t fileId, CtfReader& reader, int z, int actualSlice);
 
 private:
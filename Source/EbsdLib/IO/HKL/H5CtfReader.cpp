@@ -331,7 +331,6 @@ int H5CtfReader::readData(hid_t parId)
   }
 
   setNumberOfElements(totalDataRows);
-  size_t numBytes = totalDataRows * sizeof(float);
   std::string sBuf;
   std::stringstream ss(sBuf);
 
@@ -36,8 +36,11 @@
 #include "H5CtfVolumeReader.h"
 
 #include <cmath>
+#include <iostream>
+#include <vector>
 
 #include "H5Support/H5Lite.h"
+#include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/H5Utilities.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
@@ -258,67 +261,77 @@ std::vector<CtfPhase::Pointer> H5CtfVolumeReader::getPhases()
 // -----------------------------------------------------------------------------
 int H5CtfVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
 {
-  int index = 0;
   int err = -1;
   // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-  int readerIndex = 0;
-  int64_t xpointsslice = 0;
-  int64_t ypointsslice = 0;
-  int64_t xpointstemp = 0;
-  int64_t ypointstemp = 0;
   int zval = 0;
 
-  int xstartspot = 0;
-  int ystartspot = 0;
-
   err = readVolumeInfo();
 
+  hid_t fileId = H5Utilities::openFile(getFileName(), true);
+  if(fileId < 0)
+  {
+    std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+    return -77000;
+  }
+  H5ScopedFileSentinel sentinel(fileId, false);
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == EbsdLib::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
+  /* For HKL OIM Files if there is a single phase then the value of the phase
+   * data is one (1). If there are 2 or more phases then the lowest value
+   * of phase is also one (1). However, if there are "zero solutions" in the data
+   * then those points are assigned a phase of zero.  Since those points can be identified
+   * by other methods, the phase of these points should be changed to one since in the rest
+   * of the reconstruction code we follow the convention that the lowest value is One (1)
+   * even if there is only a single phase. The conversion of zeros to ones is currently
+   * disabled.
+   */
+
+  // The data sets of each slice are read straight into the volume arrays. Older files do not
+  // always have the X and Y data sets.
+  std::vector<SliceColumn> columns = {
+      {EbsdLib::Ctf::Phase, H5T_NATIVE_INT32, m_Phase},
+      {EbsdLib::Ctf::X, H5T_NATIVE_FLOAT, m_X, false},
+      {EbsdLib::Ctf::Y, H5T_NATIVE_FLOAT, m_Y, false},
+      {EbsdLib::Ctf::Bands, H5T_NATIVE_INT32, m_Bands},
+      {EbsdLib::Ctf::Error, H5T_NATIVE_INT32, m_Error},
+      {EbsdLib::Ctf::Euler1, H5T_NATIVE_FLOAT, m_Euler1},
+      {EbsdLib::Ctf::Euler2, H5T_NATIVE_FLOAT, m_Euler2},
+      {EbsdLib::Ctf::Euler3, H5T_NATIVE_FLOAT, m_Euler3},
+      {EbsdLib::Ctf::MAD, H5T_NATIVE_FLOAT, m_MAD},
+      {EbsdLib::Ctf::BC, H5T_NATIVE_INT32, m_BC},
+      {EbsdLib::Ctf::BS, H5T_NATIVE_INT32, m_BS},
+  };
+
   for(int64_t slice = 0; slice < zpoints; ++slice)
   {
-    H5CtfReader::Pointer reader = H5CtfReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(EbsdStringUtils::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
+    std::string index = EbsdStringUtils::number(slice + getSliceStart());
+    hid_t gid = H5Gopen(fileId, index.c_str(), H5P_DEFAULT);
+    if(gid < 0)
+    {
+      std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+      return -77000;
+    }
 
-    err = reader->readFile();
+    H5CtfReader::Pointer reader = H5CtfReader::New();
+    reader->setHDF5Path(index);
+    err = reader->readHeader(gid);
     if(err < 0)
     {
       std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+      err = H5Gclose(gid);
       return -77000;
     }
-    readerIndex = 0;
-    xpointsslice = reader->getXCells();
-    ypointsslice = reader->getYCells();
-    int* phasePtr = reader->getPhasePointer();
-    float* xPtr = reader->getXPointer();
-    float* yPtr = reader->getYPointer();
-    int* bandPtr = reader->getBandCountPointer();
-    int* errorPtr = reader->getErrorPointer();
-    float* euler1Ptr = reader->getEuler1Pointer();
-    float* euler2Ptr = reader->getEuler2Pointer();
-    float* euler3Ptr = reader->getEuler3Pointer();
-    float* madPtr = reader->getMeanAngularDeviationPointer();
-    int* bcPtr = reader->getBandContrastPointer();
-    int* bsPtr = reader->getBandSlopePointer();
 
-    xpointstemp = xpoints;
-    ypointstemp = ypoints;
-    xstartspot = static_cast<int>((xpointstemp - xpointsslice) / 2);
-    ystartspot = static_cast<int>((ypointstemp - ypointsslice) / 2);
+    const int64_t xpointsslice = reader->getXCells();
+    const int64_t ypointsslice = reader->getYCells();
 
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == EbsdLib::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
     if(ZDir == 0)
     {
       zval = static_cast<int>(slice);
@@ -328,73 +341,19 @@ int H5CtfVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
       zval = static_cast<int>((zpoints - 1) - slice);
     }
 
-    // Copy the data from the current storage into the Storage Location
-    for(int64_t j = 0; j < ypointsslice; j++)
+    hid_t dataGid = H5Gopen(gid, EbsdLib::H5Aztec::Data.c_str(), H5P_DEFAULT);
+    if(dataGid < 0)
     {
-      for(int64_t i = 0; i < xpointsslice; i++)
-      {
-        index = static_cast<int32_t>((zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot));
-        if(nullptr != phasePtr)
-        {
-          m_Phase[index] = phasePtr[readerIndex];
-        }
-        if(nullptr != xPtr)
-        {
-          m_X[index] = xPtr[readerIndex];
-        }
-        if(nullptr != yPtr)
-        {
-          m_Y[index] = yPtr[readerIndex];
-        }
-        if(nullptr != bandPtr)
-        {
-          m_Bands[index] = bandPtr[readerIndex];
-        }
-        if(nullptr != errorPtr)
-        {
-          m_Error[index] = errorPtr[readerIndex];
-        }
-        if(nullptr != euler1Ptr)
-        {
-          m_Euler1[index] = euler1Ptr[readerIndex];
-        }
-        if(nullptr != euler2Ptr)
-        {
-          m_Euler2[index] = euler2Ptr[readerIndex];
-        }
-        if(nullptr != euler3Ptr)
-        {
-          m_Euler3[index] = euler3Ptr[readerIndex];
-        }
-        if(nullptr != madPtr)
-        {
-          m_MAD[index] = madPtr[readerIndex];
-        }
-        if(nullptr != bcPtr)
-        {
-          m_BC[index] = bcPtr[readerIndex];
-        }
-        if(nullptr != bsPtr)
-        {
-          m_BS[index] = bsPtr[readerIndex];
-        }
-
-        /* For HKL OIM Files if there is a single phase then the value of the phase
-         * data is one (1). If there are 2 or more phases then the lowest value
-         * of phase is also one (1). However, if there are "zero solutions" in the data
-         * then those points are assigned a phase of zero.  Since those points can be identified
-         * by other methods, the phase of these points should be changed to one since in the rest
-         * of the reconstruction code we follow the convention that the lowest value is One (1)
-         * even if there is only a single phase. The next if statement converts all zeros to ones
-         * if there is a single phase in the OIM data.
-         */
-        //        if(nullptr != phasePtr && m_Phase[index] < 1)
-        //        {
-        //          m_Phase[index] = 1;
-        //        }
-
-        ++readerIndex;
-      }
+      std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+      err = H5Gclose(gid);
+      return -77000;
+    }
+    err = readSliceIntoVolume(dataGid, columns, xpoints, ypoints, zpoints, zval, xpointsslice, ypointsslice);
+    H5Gclose(dataGid);
+    H5Gclose(gid);
+    if(err < 0)
+    {
+      return err;
     }
   }
   return err;
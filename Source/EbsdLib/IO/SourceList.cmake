@@ -5,6 +5,7 @@ set(EbsdLib_${DIR_NAME}_HDRS
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/EbsdImporter.h       
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/EbsdHeaderEntry.h    
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/AngleFileLoader.h
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/BatchColumnParser.hpp
 )
 
 set(EbsdLib_${DIR_NAME}_SRCS
@@ -17,11 +18,16 @@ if(EbsdLib_ENABLE_HDF5)
     ${EbsdLib_${DIR_NAME}_HDRS}
     ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5EbsdVolumeReader.h
     ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5EbsdVolumeInfo.h
+    ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5PatternReader.h
+    ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5DatasetLayout.h
   )
   set(EbsdLib_${DIR_NAME}_SRCS
     ${EbsdLib_${DIR_NAME}_SRCS}
     ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5EbsdVolumeInfo.cpp
     ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5EbsdVolumeReader.cpp
+    ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5PatternReader.cpp
+    ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/H5DatasetLayout.cpp
+    ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/EbsdImporter.cpp
   )
 endif()
 
@@ -36,6 +36,7 @@
 #include "AngReader.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -43,6 +44,8 @@
 
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+#include "EbsdLib/Utilities/MemoryMappedFile.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -64,6 +67,7 @@ AngReader::AngReader()
   setNumFeatures(10);
 
   m_ReadHexGrid = false;
+  m_UseMemoryMapping = false;
 
   // Initialize the map of header key to header value
   m_HeaderMap[EbsdLib::Ang::TEMPIXPerUM] = AngHeaderEntry<float>::NewEbsdHeaderEntry(EbsdLib::Ang::TEMPIXPerUM);
@@ -291,6 +295,10 @@ int AngReader::readFile()
 {
   setErrorCode(0);
   setErrorMessage("");
+  if(m_UseMemoryMapping)
+  {
+    return readMemoryMappedFile();
+  }
   std::string buf;
   setHeaderIsComplete(false);
 
@@ -323,6 +331,75 @@ int AngReader::readFile()
   // Update the Original Header variable
   setOriginalHeader(origHeader);
 
+  if(validateHeader() < 0)
+  {
+    return getErrorCode();
+  }
+
+  // We need to pass in the buffer because it has the first line of data
+  readData(in, buf);
+
+  return getErrorCode();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::readMemoryMappedFile()
+{
+  setHeaderIsComplete(false);
+
+  MemoryMappedFile mappedFile;
+  if(!mappedFile.open(getFileName()))
+  {
+    std::string msg = "Ang file could not be opened:" + getFileName();
+    setErrorCode(-100);
+    setErrorMessage(msg);
+    return -100;
+  }
+  mappedFile.advise(MemoryMappedFile::AccessHint::Sequential);
+
+  std::string origHeader;
+  setOriginalHeader(origHeader);
+  m_PhaseVector.clear();
+
+  const char* cursor = mappedFile.data();
+  const char* end = cursor + mappedFile.size();
+  std::string buf;
+  // The header is small so it is parsed with the same string based code as the stream path.
+  while(cursor < end && !getHeaderIsComplete())
+  {
+    const char* lineEnd = static_cast<const char*>(::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    lineEnd = (lineEnd == nullptr) ? end : lineEnd;
+    if(lineEnd == cursor || *cursor != '#')
+    {
+      setHeaderIsComplete(true);
+      break;
+    }
+    buf.assign(cursor, lineEnd);
+    origHeader.append(buf).append("\n");
+    parseHeaderLine(buf);
+    cursor = (lineEnd == end) ? end : lineEnd + 1;
+  }
+  // Update the Original Header variable
+  setOriginalHeader(origHeader);
+
+  if(validateHeader() < 0)
+  {
+    return getErrorCode();
+  }
+
+  // cursor now points at the first line of data
+  readMemoryMappedData(cursor, end);
+
+  return getErrorCode();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::validateHeader()
+{
   if(getErrorCode() < 0)
   {
     return getErrorCode();
@@ -341,21 +418,15 @@ int AngReader::readFile()
     setErrorMessage("No phase was parsed in the header portion of the file. This possibly means that part of the header is missing.");
     return -150;
   }
-  // We need to pass in the buffer because it has the first line of data
-  readData(in, buf);
-
-  return getErrorCode();
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void AngReader::readData(std::ifstream& in, std::string& buf)
+int AngReader::allocateDataArrays(size_t& totalDataPoints)
 {
-  std::string streamBuf;
-  std::stringstream ss(streamBuf);
-
-  size_t totalDataPoints = 0;
+  totalDataPoints = 0;
 
   std::string grid = getGrid();
 
@@ -367,7 +438,7 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   {
     setErrorCode(-200);
     setErrorMessage("NumRows Sanity Check not correct. Check the entry for NROWS in the .ang file");
-    return;
+    return -200;
   }
   if(grid.find(EbsdLib::Ang::SquareGrid) == 0)
   {
@@ -388,7 +459,7 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   {
     setErrorCode(-400);
     setErrorMessage("Ang Files with Hex Grids Are NOT currently supported - Try converting them to Square Grid with the Hex2Sqr Converter filter.");
-    return;
+    return -400;
   }
   else if(grid.find(EbsdLib::Ang::HexGrid) == 0 && m_ReadHexGrid)
   {
@@ -412,12 +483,11 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   {
     setErrorMessage("Ang file is missing the 'GRID' header entry.");
     setErrorCode(-300);
-    return;
+    return -300;
   }
 
   // Initialize all the pointers and allocate memory
   setNumberOfElements(totalDataPoints);
-  size_t numBytes = totalDataPoints * sizeof(float);
   m_Phi1 = allocateArray<float>(totalDataPoints);
   m_Phi = allocateArray<float>(totalDataPoints);
   m_Phi2 = allocateArray<float>(totalDataPoints);
@@ -429,26 +499,50 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   m_SEMSignal = allocateArray<float>(totalDataPoints);
   m_Fit = allocateArray<float>(totalDataPoints);
 
-  ::memset(m_Phi1, 0, numBytes);
-  ::memset(m_Phi, 0, numBytes);
-  ::memset(m_Phi2, 0, numBytes);
-  ::memset(m_Iq, 0, numBytes);
-  ::memset(m_Ci, 0, numBytes);
-  ::memset(m_PhaseData, 0, numBytes);
-  ::memset(m_X, 0, numBytes);
-  ::memset(m_Y, 0, numBytes);
-  ::memset(m_SEMSignal, 0, numBytes);
-  ::memset(m_Fit, 0, numBytes);
-
   if(nullptr == m_Phi1 || nullptr == m_Phi || nullptr == m_Phi2 || nullptr == m_Iq || nullptr == m_SEMSignal || nullptr == m_Ci || nullptr == m_PhaseData || m_X == nullptr || m_Y == nullptr)
   {
-    ss.str("");
+    std::stringstream ss;
     ss << "Internal pointers were nullptr at " << __FILE__ << "(" << __LINE__ << ")\n";
     setErrorMessage(ss.str());
     setErrorCode(-2500);
+    return -2500;
+  }
+
+  // The columns are in the order that is documented in parseDataLine()
+  m_DataParser.setDelimiter(BatchColumnParser::Delimiter::Whitespace);
+  m_DataParser.setRequireAllColumns(false);
+  m_DataParser.setNumberOfColumns(10);
+  m_DataParser.setColumn(0, EbsdLib::NumericTypes::Type::Float, m_Phi1);
+  m_DataParser.setColumn(1, EbsdLib::NumericTypes::Type::Float, m_Phi);
+  m_DataParser.setColumn(2, EbsdLib::NumericTypes::Type::Float, m_Phi2);
+  m_DataParser.setColumn(3, EbsdLib::NumericTypes::Type::Float, m_X);
+  m_DataParser.setColumn(4, EbsdLib::NumericTypes::Type::Float, m_Y);
+  m_DataParser.setColumn(5, EbsdLib::NumericTypes::Type::Float, m_Iq);
+  m_DataParser.setColumn(6, EbsdLib::NumericTypes::Type::Float, m_Ci);
+  m_DataParser.setColumn(7, EbsdLib::NumericTypes::Type::Int32, m_PhaseData);
+  m_DataParser.setColumn(8, EbsdLib::NumericTypes::Type::Float, m_SEMSignal);
+  m_DataParser.setColumn(9, EbsdLib::NumericTypes::Type::Float, m_Fit);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::readData(std::ifstream& in, std::string& buf)
+{
+  std::string streamBuf;
+  std::stringstream ss(streamBuf);
+
+  size_t totalDataPoints = 0;
+  if(allocateDataArrays(totalDataPoints) < 0)
+  {
     return;
   }
 
+  int nOddCols = getNumOddCols();
+  int nEvenCols = getNumEvenCols();
+  int numRows = getNumRows();
+
   size_t counter = 1; // Because we are on the first line now.
 
   bool onEvenRow = false;
@@ -537,6 +631,96 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::readMemoryMappedData(const char* begin, const char* end)
+{
+  size_t totalDataPoints = 0;
+  if(allocateDataArrays(totalDataPoints) < 0)
+  {
+    return;
+  }
+
+  int nOddCols = getNumOddCols();
+  int nEvenCols = getNumEvenCols();
+  int numRows = getNumRows();
+
+  size_t counter = 0;
+  int col = 0;
+  int yChange = 0;
+  float oldY = m_Y[0];
+
+  // Lines are collected into blocks so the column parser can convert each column of the block in one pass
+  constexpr size_t k_BlockSize = 4096;
+  std::vector<std::string_view> rows(k_BlockSize);
+
+  const char* cursor = begin;
+  while(counter < totalDataPoints && cursor < end)
+  {
+    size_t blockRows = 0;
+    while(blockRows < k_BlockSize && counter + blockRows < totalDataPoints && cursor < end)
+    {
+      const char* lineEnd = static_cast<const char*>(::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+      lineEnd = (lineEnd == nullptr) ? end : lineEnd;
+      rows[blockRows++] = std::string_view(cursor, static_cast<size_t>(lineEnd - cursor));
+      cursor = (lineEnd == end) ? end : lineEnd + 1;
+    }
+
+    size_t parsedRows = parseDataRows(rows.data(), blockRows, counter);
+    for(size_t r = 0; r < parsedRows; r++)
+    {
+      size_t i = counter + r;
+      if(fabs(m_Y[i] - oldY) > 1e-6)
+      {
+        ++yChange;
+        oldY = m_Y[i];
+        col = 0;
+      }
+      else
+      {
+        col++;
+      }
+    }
+    counter += parsedRows;
+
+    if(getErrorCode() < 0)
+    {
+      ++counter;
+      std::stringstream ss;
+      ss << "Error parsing the data line (Numeric conversion). Error code is " << getErrorCode() << " and occurred at data column " << m_ErrorColumn << " (Zero Based)\n"
+         << rows[parsedRows] << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols
+         << "  Calculated Data Points: " << totalDataPoints << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col
+         << "  Current Data Point Count: " << counter << "\n";
+      setErrorMessage(ss.str());
+      break;
+    }
+  }
+
+  if(getNumFeatures() < 10)
+  {
+    deallocateArrayData<float>(m_Fit);
+  }
+  if(getNumFeatures() < 9)
+  {
+    deallocateArrayData<float>(m_SEMSignal);
+  }
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  if(counter != totalDataPoints)
+  {
+    std::stringstream ss;
+    ss << "End of ANG file reached before all data was parsed.\n"
+       << getFileName() << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
+       << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+    setErrorMessage(ss.str());
+    setErrorCode(-600);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //  Read the Header part of the ANG file
 // -----------------------------------------------------------------------------
@@ -742,136 +926,26 @@ void AngReader::parseDataLine(std::string& line, size_t i)
    * Some TSL ang files do NOT have all 10 columns. Assume these are lacking the last
    * 2 columns and all the other columns are the same as above.
    */
-  m_ErrorColumn = 0;
-  float p1 = 0.0f;
-  float p = 0.0f;
-  float p2 = 0.0f;
-  float x = -1.0f;
-  float y = -1.0f;
-  float iqual = -1.0f;
-  float conf = -1.0f;
-  float semSignal = -1.0f;
-  float fit = -1.0f;
-  int ph = 0;
-  size_t offset = 0;
-  line = EbsdStringUtils::simplified(line);
-  std::vector<std::string> tokens = EbsdStringUtils::split(line, ' ');
-  bool ok = true;
-  offset = i;
-  if(!tokens.empty())
-  {
-    p1 = std::stof(tokens[0]);
-    if(!ok)
-    {
-      setErrorCode(-2501);
-      m_ErrorColumn = 0;
-    }
-    m_Phi1[offset] = p1;
-  }
-  if(tokens.size() >= 2)
-  {
-    p = std::stof(tokens[1]);
-    if(!ok)
-    {
-      setErrorCode(-2502);
-      m_ErrorColumn = 1;
-    }
-    m_Phi[offset] = p;
-  }
-  if(tokens.size() >= 3)
-  {
-    p2 = std::stof(tokens[2]);
-    if(!ok)
-    {
-      setErrorCode(-2503);
-      m_ErrorColumn = 2;
-    }
-    m_Phi2[offset] = p2;
-  }
-  if(tokens.size() >= 4)
-  {
-    x = std::stof(tokens[3]);
-    if(!ok)
-    {
-      setErrorCode(-2504);
-      m_ErrorColumn = 3;
-    }
-    m_X[offset] = x;
-  }
-  if(tokens.size() >= 5)
-  {
-    y = std::stof(tokens[4]);
-    if(!ok)
-    {
-      setErrorCode(-2505);
-      m_ErrorColumn = 4;
-    }
-    m_Y[offset] = y;
-  }
-  if(tokens.size() >= 6)
-  {
-    iqual = std::stof(tokens[5]);
-    if(!ok)
-    {
-      setErrorCode(-2506);
-      m_ErrorColumn = 5;
-    }
-    m_Iq[offset] = iqual;
-  }
-  if(tokens.size() >= 7)
-  {
-    conf = std::stof(tokens[6]);
-    if(!ok)
-    {
-      setErrorCode(-2507);
-      m_ErrorColumn = 6;
-    }
-    m_Ci[offset] = conf;
-  }
-  if(tokens.size() >= 8)
-  {
-    try
-    {
-      ph = std::stoi(tokens[7]);
-    } catch([[maybe_unused]] const std::invalid_argument& e1)
-    {
-      setErrorCode(-2508);
-      m_ErrorColumn = 7;
-      // Some have floats instead of integers so lets try that.
-      try
-      {
-        float f = std::stof(tokens[7]);
-        setErrorCode(0);
-        ph = static_cast<int32_t>(f);
-      } catch([[maybe_unused]] const std::invalid_argument& e2)
-      {
-        setErrorCode(-2588);
-        m_ErrorColumn = 7;
-      }
-    }
-    m_PhaseData[offset] = ph;
-  }
+  std::string_view row(line);
+  parseDataRows(&row, 1, i);
+}
 
-  if(tokens.size() >= 9)
-  {
-    semSignal = std::stof(tokens[8]);
-    if(!ok)
-    {
-      setErrorCode(-2509);
-      m_ErrorColumn = 8;
-    }
-    m_SEMSignal[offset] = semSignal;
-  }
-  if(tokens.size() >= 10)
+// -----------------------------------------------------------------------------
+//  Read a block of data lines of the ANG file
+// -----------------------------------------------------------------------------
+size_t AngReader::parseDataRows(const std::string_view* rows, size_t numRows, size_t firstIndex)
+{
+  constexpr size_t k_PhaseColumn = 7;
+
+  m_ErrorColumn = 0;
+  if(m_DataParser.parseRows(rows, numRows, firstIndex) == BatchColumnParser::k_NoError)
   {
-    fit = std::stof(tokens[9]);
-    if(!ok)
-    {
-      setErrorCode(-2510);
-      m_ErrorColumn = 9;
-    }
-    m_Fit[offset] = fit;
+    return numRows;
   }
+  size_t column = m_DataParser.getErrorColumn();
+  m_ErrorColumn = static_cast<int>(column);
+  setErrorCode(column == k_PhaseColumn ? -2588 : -2501 - static_cast<int>(column));
+  return m_DataParser.getErrorRow();
 }
 
 // -----------------------------------------------------------------------------
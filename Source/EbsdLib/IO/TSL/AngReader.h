@@ -47,6 +47,7 @@
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/BatchColumnParser.hpp"
 #include "EbsdLib/IO/EbsdReader.h"
 
 /**
@@ -103,6 +104,14 @@ public:
 
   EBSD_INSTANCE_PROPERTY(bool, ReadHexGrid)
 
+  /**
+   * @brief When true the file is memory mapped and the data section is parsed in place
+   * directly from the mapped bytes instead of being read line by line through a stream.
+   * This avoids all per line string allocations and is considerably faster for large files.
+   * The default is false.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseMemoryMapping)
+
   EBSD_INSTANCE_PROPERTY(std::string, Notes)
   EBSD_INSTANCE_PROPERTY(std::string, ColumnNotes)
 
@@ -173,9 +182,36 @@ public:
 private:
   AngPhase::Pointer m_CurrentPhase;
   int m_ErrorColumn = 0;
+  BatchColumnParser m_DataParser;
 
   void readData(std::ifstream& in, std::string& buf);
 
+  /**
+   * @brief Reads the complete file through a memory mapping of the file.
+   * @return Error code
+   */
+  int readMemoryMappedFile();
+
+  /**
+   * @brief Parses the data section of the file directly from a memory mapped buffer
+   * @param begin The first byte of the data section
+   * @param end One past the last byte of the file
+   */
+  void readMemoryMappedData(const char* begin, const char* end);
+
+  /**
+   * @brief Checks the header values that must be valid before any data can be read.
+   * @return Error code
+   */
+  int validateHeader();
+
+  /**
+   * @brief Computes the number of data points from the header values and allocates all the data arrays.
+   * @param totalDataPoints The number of points that the data section should contain.
+   * @return Error code
+   */
+  int allocateDataArrays(size_t& totalDataPoints);
+
   /** @brief Parses the value from a single line of the header section of the TSL .ang file
    * @param line The line to parse
    */
@@ -186,6 +222,15 @@ private:
    */
   void parseDataLine(std::string& line, size_t i);
 
+  /** @brief Parses a block of data lines from the TSL .ang file without any
+   * intermediate string allocations.
+   * @param rows The lines of data to parse
+   * @param numRows The number of lines
+   * @param firstIndex The index of the data point of the first line
+   * @return The number of lines that were parsed before an error occurred
+   */
+  size_t parseDataRows(const std::string_view* rows, size_t numRows, size_t firstIndex);
+
   bool m_InsideNotes = false;
   bool m_InsideColumnNotes = false;
 
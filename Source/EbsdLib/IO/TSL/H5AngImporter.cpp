@@ -35,6 +35,8 @@
 
 #include "H5AngImporter.h"
 
+#include <memory>
+
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
 
@@ -105,7 +107,7 @@ H5AngImporter::~H5AngImporter() = default;
     m_msgType* dataPtr = reader.get##prpty##Pointer();                                                                                                                                                 \
     if(nullptr != dataPtr)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      err = H5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);                                                                                                                                \
+      err = datasetLayout.writeDataset(gid, key, xCells, yCells, dataPtr);                                                                                                                             \
       if(err < 0)                                                                                                                                                                                      \
       {                                                                                                                                                                                                \
         ss.str("");                                                                                                                                                                                    \
@@ -149,19 +151,46 @@ int H5AngImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5AngImporter::importFile(hid_t fileId, int64_t z, const std::string& angFile)
 {
-  herr_t err = -1;
   setCancel(false);
   setErrorCode(0);
   // setPipelineMessage("");
-  std::string streamBuf;
-  std::stringstream ss(streamBuf);
 
   //  std::cout << "H5AngImporter: Importing " << angFile;
   AngReader reader;
   reader.setFileName(angFile);
 
   // Now actually read the file
-  err = reader.readFile();
+  int err = reader.readFile();
+  return writeParsedFile(fileId, z, reader, err);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::unique_ptr<EbsdReader> H5AngImporter::createReader() const
+{
+  return std::make_unique<AngReader>();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::writeParsedFile(hid_t fileId, int64_t z, EbsdReader& ebsdReader, int readError)
+{
+  herr_t err = readError;
+  std::string streamBuf;
+  std::stringstream ss(streamBuf);
+
+  auto* angReader = dynamic_cast<AngReader*>(&ebsdReader);
+  if(nullptr == angReader)
+  {
+    ss << "H5AngImporter Error: The file '" << ebsdReader.getFileName() << "' was not parsed by an AngReader.";
+    setErrorCode(-800);
+    progressMessage(ss.str(), 100);
+    return -1;
+  }
+  AngReader& reader = *angReader;
+  const std::string angFile = reader.getFileName();
 
   // Check for errors
   if(err < 0)
@@ -300,8 +329,9 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const std::string& angFil
     return -1;
   }
 
-  int32_t rank = 1;
-  hsize_t dims[1] = {static_cast<hsize_t>(reader.getNumEvenCols() * reader.getNumRows())};
+  const H5DatasetLayout datasetLayout = getDatasetLayout();
+  hsize_t xCells = static_cast<hsize_t>(reader.getNumEvenCols());
+  hsize_t yCells = static_cast<hsize_t>(reader.getNumRows());
 
   WRITE_ANG_DATA_ARRAY(reader, float, gid, Phi1, EbsdLib::Ang::Phi1);
   WRITE_ANG_DATA_ARRAY(reader, float, gid, Phi, EbsdLib::Ang::Phi);
@@ -135,6 +135,20 @@ public:
 protected:
   H5AngImporter();
 
+  /**
+   * @brief Creates the AngReader that importFiles() parses each file with
+   */
+  std::unique_ptr<EbsdReader> createReader() const override;
+
+  /**
+   * @brief Writes a parsed .ang file into the HDF5 file
+   * @param fileId The valid HDF5 file Id for an already open HDF5 file
+   * @param z The slice index for the file
+   * @param ebsdReader The AngReader that parsed the file
+   * @param readError The value that AngReader::readFile() returned
+   */
+  int writeParsedFile(hid_t fileId, int64_t z, EbsdReader& ebsdReader, int readError) override;
+
 private:
   int64_t xDim;
   int64_t yDim;
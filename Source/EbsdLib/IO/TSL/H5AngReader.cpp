@@ -370,7 +370,6 @@ int H5AngReader::readData(hid_t parId)
     return getErrorCode();
   }
   setNumberOfElements(totalDataRows);
-  size_t numBytes = totalDataRows * sizeof(float);
   std::string sBuf;
   std::stringstream ss(sBuf);
 
@@ -34,11 +34,13 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "H5AngVolumeReader.h"
 
+#include <algorithm>
 #include <cmath>
-
 #include <string>
+#include <vector>
 
 #include "H5Support/H5Lite.h"
+#include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/H5Utilities.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
@@ -263,144 +265,114 @@ std::vector<AngPhase::Pointer> H5AngVolumeReader::getPhases()
 // -----------------------------------------------------------------------------
 int H5AngVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
 {
-  int index = 0;
   int err = -1;
   // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-  int readerIndex = 0;
-  int xpointsslice = 0;
-  int ypointsslice = 0;
-  int xpointstemp = 0;
-  int ypointstemp = 0;
-  int xstop = 0;
-  int ystop = 0;
   int zval = 0;
-
-  int xstartspot = 0;
-  int ystartspot = 0;
   int numPhases = getNumPhases();
   err = readVolumeInfo();
-  for(int slice = 0; slice < zpoints; ++slice)
+
+  hid_t fileId = H5Utilities::openFile(getFileName(), true);
+  if(fileId < 0)
   {
+    setErrorMessage("Error: Could not open .h5ebsd file for reading.");
+    setErrorCode(-90000);
+    return getErrorCode();
+  }
+  H5ScopedFileSentinel sentinel(fileId, false);
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == EbsdLib::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
+  // The data sets of each slice are read straight into the volume arrays
+  std::vector<SliceColumn> columns = {
+      {EbsdLib::Ang::Phi1, H5T_NATIVE_FLOAT, m_Phi1},
+      {EbsdLib::Ang::Phi, H5T_NATIVE_FLOAT, m_Phi},
+      {EbsdLib::Ang::Phi2, H5T_NATIVE_FLOAT, m_Phi2},
+      {EbsdLib::Ang::XPosition, H5T_NATIVE_FLOAT, m_X},
+      {EbsdLib::Ang::YPosition, H5T_NATIVE_FLOAT, m_Y},
+      {EbsdLib::Ang::ImageQuality, H5T_NATIVE_FLOAT, m_Iq},
+      {EbsdLib::Ang::ConfidenceIndex, H5T_NATIVE_FLOAT, m_Ci},
+      {EbsdLib::Ang::PhaseData, H5T_NATIVE_INT32, m_PhaseData},
+      {EbsdLib::Ang::SEMSignal, H5T_NATIVE_FLOAT, m_SEMSignal},
+      {EbsdLib::Ang::Fit, H5T_NATIVE_FLOAT, m_Fit},
+  };
+
+  for(int64_t slice = 0; slice < zpoints; ++slice)
+  {
+    std::string index = EbsdStringUtils::number(slice + getSliceStart());
+    hid_t gid = H5Gopen(fileId, index.c_str(), H5P_DEFAULT);
+    if(gid < 0)
+    {
+      setErrorMessage("H5AngVolumeReader Error: Could not open path '" + index + "'");
+      setErrorCode(-90023);
+      return getErrorCode();
+    }
+
     H5AngReader::Pointer reader = H5AngReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(EbsdStringUtils::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-    err = reader->readFile();
+    reader->setHDF5Path(index);
+    err = reader->readHeader(gid);
     if(err < 0)
     {
       setErrorCode(reader->getErrorCode());
       setErrorMessage(reader->getErrorMessage());
+      err = H5Gclose(gid);
       return getErrorCode();
     }
-    readerIndex = 0;
-    xpointsslice = reader->getNumEvenCols();
-    ypointsslice = reader->getNumRows();
-    float* euler1Ptr = reader->getPhi1Pointer();
-    if(nullptr == euler1Ptr)
+    if(reader->getGrid().find(EbsdLib::Ang::SquareGrid) != 0)
     {
-      setErrorCode(-99090);
-      setErrorMessage("Euler1 Pointer was nullptr from Reader");
+      setErrorCode(-90400);
+      setErrorMessage("Ang Files with Hex Grids Are NOT currently supported. Please convert them to Square Grid files first");
+      err = H5Gclose(gid);
       return getErrorCode();
     }
-    float* euler2Ptr = reader->getPhiPointer();
-    float* euler3Ptr = reader->getPhi2Pointer();
-    float* xPtr = reader->getXPositionPointer();
-    float* yPtr = reader->getYPositionPointer();
-    float* iqPtr = reader->getImageQualityPointer();
-    float* ciPtr = reader->getConfidenceIndexPointer();
-    int* phasePtr = reader->getPhaseDataPointer();
-    float* sigPtr = reader->getSEMSignalPointer();
-    float* fitPtr = reader->getFitPointer();
 
-    xpointstemp = static_cast<int>(xpoints);
-    ypointstemp = static_cast<int>(ypoints);
-    xstartspot = (xpointstemp - xpointsslice) / 2;
-    ystartspot = (ypointstemp - ypointsslice) / 2;
-    xstop = xpointsslice;
-    ystop = ypointsslice;
+    const int64_t xpointsslice = reader->getNumEvenCols();
+    const int64_t ypointsslice = reader->getNumRows();
 
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == EbsdLib::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
     if(ZDir == EbsdLib::RefFrameZDir::LowtoHigh)
     {
-      zval = slice;
+      zval = static_cast<int>(slice);
     }
     if(ZDir == EbsdLib::RefFrameZDir::HightoLow)
     {
       zval = static_cast<int>((zpoints - 1) - slice);
     }
 
-    // Copy the data from the current storage into the new memory Location
-    for(int j = 0; j < ystop; j++)
+    hid_t dataGid = H5Gopen(gid, EbsdLib::H5OIM::Data.c_str(), H5P_DEFAULT);
+    if(dataGid < 0)
     {
-      for(int i = 0; i < xstop; i++)
-      {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
-        if(nullptr != euler1Ptr)
-        {
-          m_Phi1[index] = euler1Ptr[readerIndex];
-        }
-        if(nullptr != euler2Ptr)
-        {
-          m_Phi[index] = euler2Ptr[readerIndex];
-        }
-        if(nullptr != euler3Ptr)
-        {
-          m_Phi2[index] = euler3Ptr[readerIndex];
-        }
-        if(nullptr != xPtr)
-        {
-          m_X[index] = xPtr[readerIndex];
-        }
-        if(nullptr != yPtr)
-        {
-          m_Y[index] = yPtr[readerIndex];
-        }
-        if(nullptr != iqPtr)
-        {
-          m_Iq[index] = iqPtr[readerIndex];
-        }
-        if(nullptr != ciPtr)
-        {
-          m_Ci[index] = ciPtr[readerIndex];
-        }
-        if(nullptr != phasePtr)
-        {
-          m_PhaseData[index] = phasePtr[readerIndex];
-        } // Phase
-        if(nullptr != sigPtr)
-        {
-          m_SEMSignal[index] = sigPtr[readerIndex];
-        }
-        if(nullptr != fitPtr)
-        {
-          m_Fit[index] = fitPtr[readerIndex];
-        }
-
-        /* For TSL OIM Files if there is a single phase then the value of the phase
-         * data is zero (0). If there are 2 or more phases then the lowest value
-         * of phase is one (1). In the rest of the reconstruction code we follow the
-         * convention that the lowest value is One (1) even if there is only a single
-         * phase. The next if statement converts all zeros to ones if there is a single
-         * phase in the OIM data.
-         */
-        if(numPhases == 1 && nullptr != phasePtr && m_PhaseData[index] < 1)
-        {
-          m_PhaseData[index] = 1;
-        }
+      setErrorMessage("H5AngVolumeReader Error: Could not open 'Data' Group");
+      setErrorCode(-90012);
+      err = H5Gclose(gid);
+      return getErrorCode();
+    }
+    err = readSliceIntoVolume(dataGid, columns, xpoints, ypoints, zpoints, zval, xpointsslice, ypointsslice);
+    H5Gclose(dataGid);
+    H5Gclose(gid);
+    if(err < 0)
+    {
+      return err;
+    }
 
-        ++readerIndex;
+    /* For TSL OIM Files if there is a single phase then the value of the phase
+     * data is zero (0). If there are 2 or more phases then the lowest value
+     * of phase is one (1). In the rest of the reconstruction code we follow the
+     * convention that the lowest value is One (1) even if there is only a single
+     * phase. The next if statement converts all zeros to ones if there is a single
+     * phase in the OIM data.
+     */
+    if(numPhases == 1 && nullptr != m_PhaseData)
+    {
+      const SliceRegion region = CenterSlice(xpoints, ypoints, xpointsslice, ypointsslice);
+      for(int64_t j = 0; j < region.numRows; ++j)
+      {
+        int* row = m_PhaseData + (zval * ypoints + region.dstYStart + j) * xpoints + region.dstXStart;
+        std::replace_if(row, row + region.rowLength, [](int phase) { return phase < 1; }, 1);
       }
     }
   }
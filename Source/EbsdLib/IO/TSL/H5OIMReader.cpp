@@ -547,7 +547,6 @@ int H5OIMReader::readData(hid_t parId)
     return -90012;
   }
   setNumberOfElements(totalDataRows);
-  size_t numBytes = totalDataRows * sizeof(float);
   std::string sBuf;
   std::stringstream ss(sBuf);
 
@@ -598,7 +597,7 @@ int H5OIMReader::readData(hid_t parId)
       m_PatternDims[0] = static_cast<int>(dims[1]);
       m_PatternDims[1] = static_cast<int>(dims[2]);
 
-      m_PatternData = this->allocateArray<uint8_t>(totalDataRows);
+      m_PatternData = this->allocateArray<uint8_t>(totalDataRows, false); // The data set read overwrites every value
       err = H5Lite::readPointerDataset(gid, EbsdLib::Ang::PatternData, m_PatternData);
     }
   }
@@ -607,6 +606,34 @@ int H5OIMReader::readData(hid_t parId)
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5PatternReader::Pointer H5OIMReader::createPatternReader()
+{
+  return H5PatternReader::Create(*this, getFileName(), getPatternDatasetPath(), m_ChunkCache);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5OIMReader::readPatterns(size_t firstIndex, size_t count, uint8_t* buffer)
+{
+  return H5PatternReader::ReadPatterns(*this, m_PatternReader, getFileName(), getPatternDatasetPath(), m_ChunkCache, firstIndex, count, buffer);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string H5OIMReader::getPatternDatasetPath() const
+{
+  if(m_HDF5Path.empty())
+  {
+    return {};
+  }
+  return m_HDF5Path + "/" + EbsdLib::H5OIM::EBSD + "/" + EbsdLib::H5OIM::Data + "/" + EbsdLib::Ang::PatternData;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -44,6 +44,7 @@
 
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/H5PatternReader.h"
 
 #include "AngPhase.h"
 #include "AngReader.h"
@@ -186,6 +187,32 @@ public:
    */
   void readAllArrays(bool b);
 
+  /**
+   * @brief Opens the PatternData data set of the scan selected with setHDF5Path() so that
+   * the patterns can be read a range at a time, for example with an H5PatternReader::BlockIterator.
+   * Prefer this over ReadPatternData for large scans since the patterns never have to fit into
+   * memory at once. The returned reader is independent of this reader.
+   * @return The pattern reader or nullptr if the data set could not be opened, in which case
+   * the error code and message of this reader are set.
+   */
+  H5PatternReader::Pointer createPatternReader();
+
+  /**
+   * @brief The chunk cache that createPatternReader() and readPatterns() open the pattern data
+   * set with. Set it before the first call to readPatterns().
+   */
+  EBSD_INSTANCE_PROPERTY(H5ChunkCache, ChunkCache)
+
+  /**
+   * @brief Reads a range of patterns into buffer with a single hyperslab read. The pattern data
+   * set is opened on the first call and stays open until the file name or HDF5 path changes.
+   * @param firstIndex Index of the first pattern
+   * @param count Number of patterns
+   * @param buffer Must hold count * PatternHeight * PatternWidth bytes
+   * @return Negative value on error
+   */
+  int readPatterns(size_t firstIndex, size_t count, uint8_t* buffer);
+
   int getXDimension() override;
   void setXDimension(int xdim) override;
   int getYDimension() override;
@@ -208,12 +235,20 @@ protected:
    */
   int readData(hid_t parId);
 
+  /**
+   * @brief Returns the path of the pattern data set of the scan selected with setHDF5Path(),
+   * or an empty string if no scan is selected
+   */
+  std::string getPatternDatasetPath() const;
+
 private:
   std::string m_HDF5Path = {};
 
   std::set<std::string> m_ArrayNames;
   bool m_ReadAllArrays = true;
 
+  H5PatternReader::Pointer m_PatternReader;
+
 public:
   H5OIMReader(const H5OIMReader&) = delete;            // Copy Constructor Not Implemented
   H5OIMReader(H5OIMReader&&) = delete;                 // Move Constructor Not Implemented
@@ -116,6 +116,12 @@ public:
    */
   std::array<size_t, 3> getOdfNumBins() const override;
 
+  /**
+   * @brief Returns the default 5 degree grid that the ODF and MDF bins are based on
+   * @return
+   */
+  OdfGrid getOdfGrid() const override;
+
   /**
    * @brief calculateMisorientation Finds the misorientation between 2 quaternions and returns the result as an Axis Angle value
    * @param q1 Input Quaternion
@@ -132,6 +138,19 @@ public:
    */
   virtual OrientationF calculateMisorientation(const QuatF& q1, const QuatF& q2) const override;
 
+  /**
+   * @brief calculateMisorientations Finds the misorientations between n pairs of quaternions. The
+   * symmetry operator that gives the smallest angle is selected from the scalar part of each
+   * candidate alone and only that candidate is converted to an axis angle. The pairs are
+   * processed in parallel. Only the angle matches calculateMisorientation(), the axis is not
+   * reduced to the standard stereographic triangle.
+   * @param q1 n quaternions stored as <x,y,z,w>
+   * @param q2 n quaternions stored as <x,y,z,w>
+   * @param n The number of pairs
+   * @param axisAngleOut n axis angles stored as <n1,n2,n3,angle> with the angle in radians
+   */
+  void calculateMisorientations(const float* q1, const float* q2, size_t n, float* axisAngleOut) const override;
+
   QuatD getQuatSymOp(int i) const override;
   void getRodSymOp(int i, double* r) const override;
 
@@ -144,10 +163,17 @@ public:
   QuatD getNearestQuat(const QuatD& q1, const QuatD& q2) const override;
   QuatF getNearestQuat(const QuatF& q1f, const QuatF& q2f) const override;
 
+  QuatD getFZQuat(const QuatD& qr) const override;
+  void getFZQuats(const float* in, size_t n, float* out) const override;
+  using LaueOps::determineEulerAngles;
+  using LaueOps::determineRodriguesVector;
+  using LaueOps::getMisoBin;
+  using LaueOps::getOdfBin;
   int getMisoBin(const OrientationType& rod) const override;
   bool inUnitTriangle(double eta, double chi) const override;
   OrientationType determineEulerAngles(double random[3], int choose) const override;
   OrientationType randomizeEulerAngles(const OrientationType& synea) const override;
+  OrientationType randomizeEulerAngles(const OrientationType& synea, EbsdLib::Philox4x32& generator) const override;
   OrientationType determineRodriguesVector(double random[3], int choose) const override;
   int getOdfBin(const OrientationType& rod) const override;
   void getSchmidFactorAndSS(double load[3], double& schmidfactor, double angleComps[2], int& slipsys) const override;
@@ -181,6 +207,8 @@ public:
    */
   EbsdLib::Rgb generateIPFColor(double phi1, double phi, double phi2, double dir0, double dir1, double dir2, bool degToRad) const override;
 
+  void generateIPFColors(const float* eulers, const size_t* indices, size_t count, const double refDir[3], bool convertDegrees, uint8_t* rgbOut) const override;
+
   /**
    * @brief generateRodriguesColor Generates an RGB Color from a Rodrigues Vector
    * @param r1 First component of the Rodrigues Vector
@@ -47,10 +47,11 @@
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/IPFColorKernels.hpp"
+#include "EbsdLib/LaueOps/SymmetryKernels.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/GeometryMath.h"
 #include "EbsdLib/Utilities/ColorUtilities.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 
 namespace CubicHigh
 {
@@ -60,8 +61,7 @@ static const std::array<double, 3> OdfDimInitValue = {std::pow((0.75 * (EbsdLib:
                                                       std::pow((0.75 * (EbsdLib::Constants::k_PiOver4D - std::sin(EbsdLib::Constants::k_PiOver4D))), (1.0 / 3.0)),
                                                       std::pow((0.75 * (EbsdLib::Constants::k_PiOver4D - std::sin(EbsdLib::Constants::k_PiOver4D))), (1.0 / 3.0))};
 
-static const std::array<double, 3> OdfDimStepValue = {OdfDimInitValue[0] / static_cast<double>(OdfNumBins[0] / 2), OdfDimInitValue[1] / static_cast<double>(OdfNumBins[1] / 2),
-                                                      OdfDimInitValue[2] / static_cast<double>(OdfNumBins[2] / 2)};
+static const OdfGrid k_OdfGrid(OdfNumBins, OdfDimInitValue);
 
 static const int symSize0 = 6;
 static const int symSize1 = 12;
@@ -72,55 +72,57 @@ static const int k_MdfSize = 5832;
 static const int k_SymOpsCount = 24;
 static const int k_NumMdfBins = 13;
 
-static const std::vector<QuatD> QuatSym = {QuatD(0.000000000, 0.000000000, 0.000000000, 1.000000000),
-                                           QuatD(1.000000000, 0.000000000, 0.000000000, 0.000000000),
-                                           QuatD(0.000000000, 1.000000000, 0.000000000, 0.000000000),
-                                           QuatD(0.000000000, 0.000000000, 1.000000000, 0.000000000),
-                                           QuatD(EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000, EbsdLib::Constants::k_1OverRoot2D),
-                                           QuatD(0.000000000, EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D),
-                                           QuatD(0.000000000, 0.000000000, EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D),
-                                           QuatD(-EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000, EbsdLib::Constants::k_1OverRoot2D),
-                                           QuatD(0.000000000, -EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D),
-                                           QuatD(0.000000000, 0.000000000, -EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D),
-                                           QuatD(EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000),
-                                           QuatD(-EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000),
-                                           QuatD(0.000000000, EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000),
-                                           QuatD(0.000000000, -EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000),
-                                           QuatD(EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D, 0.000000000),
-                                           QuatD(-EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D, 0.000000000),
-                                           QuatD(0.500000000, 0.500000000, 0.500000000, 0.500000000),
-                                           QuatD(-0.500000000, -0.500000000, -0.500000000, 0.500000000),
-                                           QuatD(0.500000000, -0.500000000, 0.500000000, 0.500000000),
-                                           QuatD(-0.500000000, 0.500000000, -0.500000000, 0.500000000),
-                                           QuatD(-0.500000000, 0.500000000, 0.500000000, 0.500000000),
-                                           QuatD(0.500000000, -0.500000000, -0.500000000, 0.500000000),
-                                           QuatD(-0.500000000, -0.500000000, 0.500000000, 0.500000000),
-                                           QuatD(0.500000000, 0.500000000, -0.500000000, 0.500000000)};
-
-static const std::vector<OrientationD> RodSym = {{0.0, 0.0, 0.0},
-                                                 {10000000000.0, 0.0, 0.0},
-                                                 {0.0, 10000000000.0, 0.0},
-                                                 {0.0, 0.0, 10000000000.0},
-                                                 {1.0, 0.0, 0.0},
-                                                 {0.0, 1.0, 0.0},
-                                                 {0.0, 0.0, 1.0},
-                                                 {-1.0, 0.0, 0.0},
-                                                 {0.0, -1.0, 0.0},
-                                                 {0.0, 0.0, -1.0},
-                                                 {10000000000.0, 10000000000.0, 0.0},
-                                                 {-10000000000.0, 10000000000.0, 0.0},
-                                                 {0.0, 10000000000.0, 10000000000.0},
-                                                 {0.0, -10000000000.0, 10000000000.0},
-                                                 {10000000000.0, 0.0, 10000000000.0},
-                                                 {-10000000000.0, 0.0, 10000000000.0},
-                                                 {1.0, 1.0, 1.0},
-                                                 {-1.0, -1.0, -1.0},
-                                                 {1.0, -1.0, 1.0},
-                                                 {-1.0, 1.0, -1.0},
-                                                 {-1.0, 1.0, 1.0},
-                                                 {1.0, -1.0, -1.0},
-                                                 {-1.0, -1.0, 1.0},
-                                                 {1.0, 1.0, -1.0}};
+static constexpr SymmetryKernels::QuatTable<k_SymOpsCount> QuatSymTable = {{{0.000000000, 0.000000000, 0.000000000, 1.000000000},
+                                                                            {1.000000000, 0.000000000, 0.000000000, 0.000000000},
+                                                                            {0.000000000, 1.000000000, 0.000000000, 0.000000000},
+                                                                            {0.000000000, 0.000000000, 1.000000000, 0.000000000},
+                                                                            {EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000, EbsdLib::Constants::k_1OverRoot2D},
+                                                                            {0.000000000, EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D},
+                                                                            {0.000000000, 0.000000000, EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D},
+                                                                            {-EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000, EbsdLib::Constants::k_1OverRoot2D},
+                                                                            {0.000000000, -EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D},
+                                                                            {0.000000000, 0.000000000, -EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D},
+                                                                            {EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000},
+                                                                            {-EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000, 0.000000000},
+                                                                            {0.000000000, EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000},
+                                                                            {0.000000000, -EbsdLib::Constants::k_1OverRoot2D, EbsdLib::Constants::k_1OverRoot2D, 0.000000000},
+                                                                            {EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D, 0.000000000},
+                                                                            {-EbsdLib::Constants::k_1OverRoot2D, 0.000000000, EbsdLib::Constants::k_1OverRoot2D, 0.000000000},
+                                                                            {0.500000000, 0.500000000, 0.500000000, 0.500000000},
+                                                                            {-0.500000000, -0.500000000, -0.500000000, 0.500000000},
+                                                                            {0.500000000, -0.500000000, 0.500000000, 0.500000000},
+                                                                            {-0.500000000, 0.500000000, -0.500000000, 0.500000000},
+                                                                            {-0.500000000, 0.500000000, 0.500000000, 0.500000000},
+                                                                            {0.500000000, -0.500000000, -0.500000000, 0.500000000},
+                                                                            {-0.500000000, -0.500000000, 0.500000000, 0.500000000},
+                                                                            {0.500000000, 0.500000000, -0.500000000, 0.500000000}}};
+static const std::vector<QuatD> QuatSym = SymmetryKernels::ToQuaternions(QuatSymTable);
+static constexpr SymmetryKernels::SymOpTable<k_SymOpsCount> QuatSymF = SymmetryKernels::ToSymOpTable(QuatSymTable);
+
+static constexpr SymmetryKernels::RodTable<k_SymOpsCount> RodSym = {{{0.0, 0.0, 0.0},
+                                                                     {10000000000.0, 0.0, 0.0},
+                                                                     {0.0, 10000000000.0, 0.0},
+                                                                     {0.0, 0.0, 10000000000.0},
+                                                                     {1.0, 0.0, 0.0},
+                                                                     {0.0, 1.0, 0.0},
+                                                                     {0.0, 0.0, 1.0},
+                                                                     {-1.0, 0.0, 0.0},
+                                                                     {0.0, -1.0, 0.0},
+                                                                     {0.0, 0.0, -1.0},
+                                                                     {10000000000.0, 10000000000.0, 0.0},
+                                                                     {-10000000000.0, 10000000000.0, 0.0},
+                                                                     {0.0, 10000000000.0, 10000000000.0},
+                                                                     {0.0, -10000000000.0, 10000000000.0},
+                                                                     {10000000000.0, 0.0, 10000000000.0},
+                                                                     {-10000000000.0, 0.0, 10000000000.0},
+                                                                     {1.0, 1.0, 1.0},
+                                                                     {-1.0, -1.0, -1.0},
+                                                                     {1.0, -1.0, 1.0},
+                                                                     {-1.0, 1.0, -1.0},
+                                                                     {-1.0, 1.0, 1.0},
+                                                                     {1.0, -1.0, -1.0},
+                                                                     {-1.0, -1.0, 1.0},
+                                                                     {1.0, 1.0, -1.0}}};
 
 static const double SlipDirections[12][3] = {{0.0, 1.0, -1.0}, {1.0, 0.0, -1.0}, {1.0, -1.0, 0.0}, {1.0, -1.0, 0.0}, {1.0, 0.0, 1.0}, {0.0, 1.0, 1.0},
                                              {1.0, 1.0, 0.0},  {0.0, 1.0, 1.0},  {1.0, 0.0, -1.0}, {1.0, 1.0, 0.0},  {1.0, 0.0, 1.0}, {0.0, 1.0, -1.0}};
@@ -176,6 +178,16 @@ static const double MatSym[k_SymOpsCount][3][3] = {{{1.0, 0.0, 0.0}, {0.0, 1.0,
 
                                                    {{0.0, -1.0, 0.0}, {-1.0, 0.0, 0.0}, {0.0, 0.0, -1.0}}};
 
+/**
+ * @brief Color key of the standard stereographic triangle
+ */
+struct IPFColorKey
+{
+  EbsdLib::Rgb operator()(double eta, double chi) const
+  {
+    return IPFColorKernels::CubicColor(eta, chi, 45.0, true);
+  }
+};
 } // namespace CubicHigh
 
 // -----------------------------------------------------------------------------
@@ -232,6 +244,14 @@ std::array<size_t, 3> CubicOps::getOdfNumBins() const
   return CubicHigh::OdfNumBins;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OdfGrid CubicOps::getOdfGrid() const
+{
+  return CubicHigh::k_OdfGrid;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -258,6 +278,12 @@ OrientationF CubicOps::calculateMisorientation(const QuatF& q1f, const QuatF& q2
   return axisAngle;
 }
 
+// -----------------------------------------------------------------------------
+void CubicOps::calculateMisorientations(const float* q1, const float* q2, size_t n, float* axisAngleOut) const
+{
+  SymmetryKernels::CalculateMisorientations(CubicHigh::QuatSymF, q1, q2, n, axisAngleOut);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -558,7 +584,7 @@ void CubicOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType CubicOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(CubicHigh::RodSym, rod);
+  return SymmetryKernels::RodNearestOrigin(CubicHigh::RodSym, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -569,7 +595,7 @@ OrientationType CubicOps::getMDFFZRod(const OrientationType& inRod) const
   double w, n1, n2, n3;
   double FZw, FZn1, FZn2, FZn3;
 
-  OrientationType rod = _calcRodNearestOrigin(CubicHigh::RodSym, inRod);
+  OrientationType rod = SymmetryKernels::RodNearestOrigin(CubicHigh::RodSym, inRod);
   OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
 
   n1 = ax[0];
@@ -623,17 +649,25 @@ OrientationType CubicOps::getMDFFZRod(const OrientationType& inRod) const
 
 QuatD CubicOps::getNearestQuat(const QuatD& q1, const QuatD& q2) const
 {
-  return _calcNearestQuat(CubicHigh::QuatSym, q1, q2);
+  return SymmetryKernels::NearestQuat(CubicHigh::QuatSymTable, q1, q2);
 }
 
 QuatF CubicOps::getNearestQuat(const QuatF& q1f, const QuatF& q2f) const
 {
-  return _calcNearestQuat(CubicHigh::QuatSym, q1f.to<double>(), q2f.to<double>()).to<float>();
+  return SymmetryKernels::NearestQuat(CubicHigh::QuatSymTable, q1f.to<double>(), q2f.to<double>()).to<float>();
 }
 
 QuatD CubicOps::getFZQuat(const QuatD& qr) const
 {
-  return _calcQuatNearestOrigin(CubicHigh::QuatSym, qr);
+  return SymmetryKernels::QuatNearestOrigin(CubicHigh::QuatSymTable, qr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getFZQuats(const float* in, size_t n, float* out) const
+{
+  SymmetryKernels::GetFZQuats(CubicHigh::QuatSymF, in, n, out);
 }
 
 // -----------------------------------------------------------------------------
@@ -641,23 +675,7 @@ QuatD CubicOps::getFZQuat(const QuatD& qr) const
 // -----------------------------------------------------------------------------
 int CubicOps::getMisoBin(const OrientationType& rod) const
 {
-  double dim[3];
-  double bins[3];
-  double step[3];
-
-  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
-
-  dim[0] = CubicHigh::OdfDimInitValue[0];
-  dim[1] = CubicHigh::OdfDimInitValue[1];
-  dim[2] = CubicHigh::OdfDimInitValue[2];
-  step[0] = CubicHigh::OdfDimStepValue[0];
-  step[1] = CubicHigh::OdfDimStepValue[1];
-  step[2] = CubicHigh::OdfDimStepValue[2];
-  bins[0] = static_cast<double>(CubicHigh::OdfNumBins[0]);
-  bins[1] = static_cast<double>(CubicHigh::OdfNumBins[1]);
-  bins[2] = static_cast<double>(CubicHigh::OdfNumBins[2]);
-
-  return _calcMisoBin(dim, bins, step, ho);
+  return LaueOps::getMisoBin(CubicHigh::k_OdfGrid, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -665,28 +683,7 @@ int CubicOps::getMisoBin(const OrientationType& rod) const
 // -----------------------------------------------------------------------------
 OrientationType CubicOps::determineEulerAngles(double random[3], int choose) const
 {
-  double init[3];
-  double step[3];
-  int32_t phi[3];
-  double h1, h2, h3;
-
-  init[0] = CubicHigh::OdfDimInitValue[0];
-  init[1] = CubicHigh::OdfDimInitValue[1];
-  init[2] = CubicHigh::OdfDimInitValue[2];
-  step[0] = CubicHigh::OdfDimStepValue[0];
-  step[1] = CubicHigh::OdfDimStepValue[1];
-  step[2] = CubicHigh::OdfDimStepValue[2];
-  phi[0] = static_cast<int32_t>(choose % CubicHigh::OdfNumBins[0]);
-  phi[1] = static_cast<int32_t>((choose / CubicHigh::OdfNumBins[0]) % CubicHigh::OdfNumBins[1]);
-  phi[2] = static_cast<int32_t>(choose / (CubicHigh::OdfNumBins[0] * CubicHigh::OdfNumBins[1]));
-
-  _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
-  ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  return LaueOps::determineEulerAngles(CubicHigh::k_OdfGrid, random, choose);
 }
 
 // -----------------------------------------------------------------------------
@@ -700,31 +697,23 @@ OrientationType CubicOps::randomizeEulerAngles(const OrientationType& synea) con
   return OrientationTransformation::qu2eu<QuatD, OrientationType>(qc);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OrientationType CubicOps::randomizeEulerAngles(const OrientationType& synea, EbsdLib::Philox4x32& generator) const
+{
+  size_t symOp = getRandomSymmetryOperatorIndex(CubicHigh::k_SymOpsCount, generator);
+  QuatD quat = OrientationTransformation::eu2qu<OrientationType, QuatD>(synea);
+  QuatD qc = CubicHigh::QuatSym[symOp] * quat;
+  return OrientationTransformation::qu2eu<QuatD, OrientationType>(qc);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 OrientationType CubicOps::determineRodriguesVector(double random[3], int choose) const
 {
-  double init[3];
-  double step[3];
-  int32_t phi[3];
-  double h1, h2, h3;
-
-  init[0] = CubicHigh::OdfDimInitValue[0];
-  init[1] = CubicHigh::OdfDimInitValue[1];
-  init[2] = CubicHigh::OdfDimInitValue[2];
-  step[0] = CubicHigh::OdfDimStepValue[0];
-  step[1] = CubicHigh::OdfDimStepValue[1];
-  step[2] = CubicHigh::OdfDimStepValue[2];
-  phi[0] = static_cast<int32_t>(choose % CubicHigh::OdfNumBins[0]);
-  phi[1] = static_cast<int32_t>((choose / CubicHigh::OdfNumBins[0]) % CubicHigh::OdfNumBins[1]);
-  phi[2] = static_cast<int32_t>(choose / (CubicHigh::OdfNumBins[0] * CubicHigh::OdfNumBins[1]));
-
-  _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
-  ro = getMDFFZRod(ro);
-  return ro;
+  return LaueOps::determineRodriguesVector(CubicHigh::k_OdfGrid, random, choose);
 }
 
 // -----------------------------------------------------------------------------
@@ -732,23 +721,7 @@ OrientationType CubicOps::determineRodriguesVector(double random[3], int choose)
 // -----------------------------------------------------------------------------
 int CubicOps::getOdfBin(const OrientationType& rod) const
 {
-  double dim[3];
-  double bins[3];
-  double step[3];
-
-  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
-
-  dim[0] = CubicHigh::OdfDimInitValue[0];
-  dim[1] = CubicHigh::OdfDimInitValue[1];
-  dim[2] = CubicHigh::OdfDimInitValue[2];
-  step[0] = CubicHigh::OdfDimStepValue[0];
-  step[1] = CubicHigh::OdfDimStepValue[1];
-  step[2] = CubicHigh::OdfDimStepValue[2];
-  bins[0] = static_cast<double>(CubicHigh::OdfNumBins[0]);
-  bins[1] = static_cast<double>(CubicHigh::OdfNumBins[1]);
-  bins[2] = static_cast<double>(CubicHigh::OdfNumBins[2]);
-
-  return _calcODFBin(dim, bins, step, ho);
+  return LaueOps::getOdfBin(CubicHigh::k_OdfGrid, rod);
 }
 
 void CubicOps::getSchmidFactorAndSS(double load[3], double& schmidfactor, double angleComps[2], int& slipsys) const
@@ -1556,23 +1529,6 @@ void _TripletSort(T a, T b, T c, T& x, T& y, T& z)
   }
 }
 
-bool inUnitTriangleD(double eta, double chi)
-{
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiMax;
-  if(etaDeg > 45.0)
-  {
-    chiMax = sqrt(1.0 / (2.0 + std::tan(0.5 * EbsdLib::Constants::k_PiD - eta) * std::tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
-  }
-  else
-  {
-    chiMax = sqrt(1.0 / (2.0 + std::tan(eta) * std::tan(eta)));
-  }
-  EbsdLibMath::bound(chiMax, -1.0, 1.0);
-  chiMax = acos(chiMax);
-  return !(eta < 0.0 || eta > (45.0 * EbsdLib::Constants::k_PiOver180D) || chi < 0.0 || chi > chiMax);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1612,83 +1568,18 @@ EbsdLib::Rgb CubicOps::generateIPFColor(double phi1, double phi, double phi2, do
     phi = phi * EbsdLib::Constants::k_DegToRadD;
     phi2 = phi2 * EbsdLib::Constants::k_DegToRadD;
   }
+  const double refDir[3] = {refDir0, refDir1, refDir2};
+  auto inTriangle = [this](double eta, double chi) { return CubicOps::inUnitTriangle(eta, chi); };
+  return IPFColorKernels::GenerateIPFColor(CubicHigh::QuatSymTable, getHasInversion(), phi1, phi, phi2, refDir, inTriangle, CubicHigh::IPFColorKey());
+}
 
-  double g[3][3];
-  double p[3];
-  double refDirection[3] = {0.0f, 0.0f, 0.0f};
-  double chi = 0.0f, eta = 0.0f;
-  double _rgb[3] = {0.0, 0.0, 0.0};
-
-  OrientationType eu(phi1, phi, phi2);
-  OrientationType om(9); // Reusable for the loop
-  QuatD q1 = OrientationTransformation::eu2qu<OrientationType, QuatD>(eu);
-
-  for(int j = 0; j < CubicHigh::k_SymOpsCount; j++)
-  {
-    QuatD qu = getQuatSymOp(j) * q1;
-    OrientationTransformation::qu2om<QuatD, OrientationType>(qu).toGMatrix(g);
-
-    refDirection[0] = refDir0;
-    refDirection[1] = refDir1;
-    refDirection[2] = refDir2;
-    EbsdMatrixMath::Multiply3x3with3x1(g, refDirection, p);
-    EbsdMatrixMath::Normalize3x1(p);
-
-    if(!getHasInversion() && p[2] < 0)
-    {
-      continue;
-    }
-    if(getHasInversion() && p[2] < 0)
-    {
-      p[0] = -p[0], p[1] = -p[1], p[2] = -p[2];
-    }
-    chi = std::acos(p[2]);
-    eta = std::atan2(p[1], p[0]);
-    if(!inUnitTriangleD(eta, chi))
-    {
-      continue;
-    }
-    break;
-  }
-  double etaMin = 0.0;
-  double etaMax = 45.0;
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiMax;
-  if(etaDeg > 45.0)
-  {
-    chiMax = std::sqrt(1.0 / (2.0 + std::tan(0.5 * EbsdLib::Constants::k_PiD - eta) * std::tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
-  }
-  else
-  {
-    chiMax = std::sqrt(1.0 / (2.0 + std::tan(eta) * std::tan(eta)));
-  }
-  EbsdLibMath::bound(chiMax, -1.0, 1.0);
-  chiMax = std::acos(chiMax);
-
-  _rgb[0] = 1.0 - chi / chiMax;
-  _rgb[2] = std::fabs(etaDeg - etaMin) / (etaMax - etaMin);
-  _rgb[1] = 1 - _rgb[2];
-  _rgb[1] *= chi / chiMax;
-  _rgb[2] *= chi / chiMax;
-  _rgb[0] = std::sqrt(_rgb[0]);
-  _rgb[1] = std::sqrt(_rgb[1]);
-  _rgb[2] = std::sqrt(_rgb[2]);
-
-  double max = _rgb[0];
-  if(_rgb[1] > max)
-  {
-    max = _rgb[1];
-  }
-  if(_rgb[2] > max)
-  {
-    max = _rgb[2];
-  }
-
-  _rgb[0] = _rgb[0] / max;
-  _rgb[1] = _rgb[1] / max;
-  _rgb[2] = _rgb[2] / max;
-
-  return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(_rgb[0] * 255), static_cast<int32_t>(_rgb[1] * 255), static_cast<int32_t>(_rgb[2] * 255), 255);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::generateIPFColors(const float* eulers, const size_t* indices, size_t count, const double refDir[3], bool convertDegrees, uint8_t* rgbOut) const
+{
+  auto inTriangle = [this](double eta, double chi) { return CubicOps::inUnitTriangle(eta, chi); };
+  IPFColorKernels::GenerateIPFColors(CubicHigh::QuatSymTable, getHasInversion(), eulers, indices, count, refDir, convertDegrees, inTriangle, CubicHigh::IPFColorKey(), rgbOut);
 }
 
 // -----------------------------------------------------------------------------
@@ -1730,103 +1621,20 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleF
     label2 = config.labels.at(2);
   }
 
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize0, dims, label0 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize1, dims, label1 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize2, dims, label2 + std::string("xyzCoords"), true);
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
+  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image. The
+  // orientations are binned block by block so the sphere coordinates of all the orientations are never stored.
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities =
+      generatePoleFigureIntensities(config, {CubicHigh::symSize0, CubicHigh::symSize1, CubicHigh::symSize2}, {label0, label1, label2});
+  EbsdLib::DoubleArrayType::Pointer intensity001 = intensities[0];
+  EbsdLib::DoubleArrayType::Pointer intensity011 = intensities[1];
+  EbsdLib::DoubleArrayType::Pointer intensity111 = intensities[2];
 
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
-
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2, true);
+  std::vector<size_t> dims(1, 4);
+  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0);
+  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1);
+  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2);
 
   std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
   if(config.order.size() == 3)
@@ -1843,7 +1651,7 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleF
   }
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-
+  bool doParallel = true;
   if(doParallel)
   {
     std::shared_ptr<tbb::task_group> g(new tbb::task_group);
@@ -0,0 +1,311 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/FixedOrientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/SymmetryKernels.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/EbsdMatrixMath.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The IPFColorKernels namespace holds the inverse pole figure coloring that is shared
+ * by all the LaueOps classes. The symmetry operators are a constexpr table so the search
+ * for the standard stereographic triangle is unrolled for each Laue class, and the class
+ * specific unit triangle test and color key are passed in as function objects so that
+ * they are inlined instead of being called through the vtable.
+ */
+namespace IPFColorKernels
+{
+/**
+ * @brief Finds the symmetric equivalent of the reference direction that lies in the
+ * standard stereographic triangle of the Laue class.
+ *
+ * Only the z row of each rotation matrix is computed before the hemisphere test, so
+ * operators that put the direction in the lower hemisphere of a non centro-symmetric
+ * class are rejected without building the rest of the matrix.
+ * @param quatSym The symmetry operators of the Laue class
+ * @param hasInversion Whether the Laue class is centro-symmetric
+ * @param q1 The orientation
+ * @param refDir The reference direction in the sample frame
+ * @param inUnitTriangle Returns true if (eta, chi) lies in the standard triangle
+ * @param eta Azimuthal angle of the direction in radians
+ * @param chi Polar angle of the direction in radians
+ */
+template <size_t N, typename InUnitTriangleFunc>
+void FindStandardTriangle(const SymmetryKernels::QuatTable<N>& quatSym, bool hasInversion, const QuatD& q1, const double refDir[3], InUnitTriangleFunc inUnitTriangle, double& eta, double& chi)
+{
+  eta = 0.0;
+  chi = 0.0;
+  for(size_t j = 0; j < N; j++)
+  {
+    const QuatD qu = QuatD(quatSym[j][0], quatSym[j][1], quatSym[j][2], quatSym[j][3]) * q1;
+    const double x = qu.x();
+    const double y = qu.y();
+    const double z = qu.z();
+    const double w = qu.w();
+    // Same arithmetic as qu2om followed by Multiply3x3with3x1
+    const double qq = w * w - (x * x + y * y + z * z);
+    double p[3] = {0.0, 0.0, 0.0};
+    p[2] = 2.0 * (z * x - w * y) * refDir[0] + 2.0 * (z * y + w * x) * refDir[1] + (qq + 2.0 * z * z) * refDir[2];
+    if(!hasInversion && p[2] < 0)
+    {
+      continue;
+    }
+    p[0] = (qq + 2.0 * x * x) * refDir[0] + 2.0 * (x * y - w * z) * refDir[1] + 2.0 * (x * z + w * y) * refDir[2];
+    p[1] = 2.0 * (y * x + w * z) * refDir[0] + (qq + 2.0 * y * y) * refDir[1] + 2.0 * (y * z - w * x) * refDir[2];
+    EbsdMatrixMath::Normalize3x1(p);
+
+    if(hasInversion && p[2] < 0)
+    {
+      p[0] = -p[0], p[1] = -p[1], p[2] = -p[2];
+    }
+    chi = std::acos(p[2]);
+    eta = std::atan2(p[1], p[0]);
+    if(inUnitTriangle(eta, chi))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Scales the color so that its largest component is 1 and packs it into an Rgb value
+ * @param rgb The color components. The square root is taken of each component first.
+ * @param normalize When true the components are scaled so that the largest one is 1.0
+ */
+inline EbsdLib::Rgb PackColor(double rgb[3], bool normalize = true)
+{
+  rgb[0] = std::sqrt(rgb[0]);
+  rgb[1] = std::sqrt(rgb[1]);
+  rgb[2] = std::sqrt(rgb[2]);
+
+  if(!normalize)
+  {
+    return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(rgb[0] * 255), static_cast<int32_t>(rgb[1] * 255), static_cast<int32_t>(rgb[2] * 255), 255);
+  }
+
+  double max = rgb[0];
+  if(rgb[1] > max)
+  {
+    max = rgb[1];
+  }
+  if(rgb[2] > max)
+  {
+    max = rgb[2];
+  }
+
+  rgb[0] = rgb[0] / max;
+  rgb[1] = rgb[1] / max;
+  rgb[2] = rgb[2] / max;
+
+  return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(rgb[0] * 255), static_cast<int32_t>(rgb[1] * 255), static_cast<int32_t>(rgb[2] * 255), 255);
+}
+
+/**
+ * @brief Computes the color key of the cubic classes where the largest polar angle of the
+ * standard triangle depends on the azimuthal angle.
+ * @param eta Azimuthal angle in radians
+ * @param chi Polar angle in radians
+ * @param etaMax The largest azimuthal angle of the standard triangle in degrees
+ * @param normalize When true the color is scaled so that its largest component is 1.0
+ */
+inline EbsdLib::Rgb CubicColor(double eta, double chi, double etaMax, bool normalize)
+{
+  const double etaMin = 0.0;
+  const double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
+  double chiMax;
+  if(etaDeg > 45.0)
+  {
+    chiMax = std::sqrt(1.0 / (2.0 + std::tan(0.5 * EbsdLib::Constants::k_PiD - eta) * std::tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
+  }
+  else
+  {
+    chiMax = std::sqrt(1.0 / (2.0 + std::tan(eta) * std::tan(eta)));
+  }
+  EbsdLibMath::bound(chiMax, -1.0, 1.0);
+  chiMax = std::acos(chiMax);
+
+  double rgb[3] = {0.0, 0.0, 0.0};
+  rgb[0] = 1.0 - chi / chiMax;
+  rgb[2] = std::fabs(etaDeg - etaMin) / (etaMax - etaMin);
+  rgb[1] = 1 - rgb[2];
+  rgb[1] *= chi / chiMax;
+  rgb[2] *= chi / chiMax;
+  return PackColor(rgb, normalize);
+}
+
+/**
+ * @brief Computes the color key of the classes whose standard triangle spans the polar
+ * angles 0 to 90 degrees between two azimuthal angles.
+ * @param eta Azimuthal angle in radians
+ * @param chi Polar angle in radians
+ * @param etaMin The smallest azimuthal angle of the standard triangle in degrees
+ * @param etaMax The largest azimuthal angle of the standard triangle in degrees
+ */
+inline EbsdLib::Rgb SectorColor(double eta, double chi, double etaMin, double etaMax)
+{
+  const double chiMax = 90.0;
+  const double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
+  const double chiDeg = chi * EbsdLib::Constants::k_180OverPiD;
+
+  double rgb[3] = {0.0, 0.0, 0.0};
+  rgb[0] = 1.0 - chiDeg / chiMax;
+  rgb[2] = std::fabs(etaDeg - etaMin) / (etaMax - etaMin);
+  rgb[1] = 1 - rgb[2];
+  rgb[1] *= chiDeg / chiMax;
+  rgb[2] *= chiDeg / chiMax;
+  return PackColor(rgb);
+}
+
+/**
+ * @brief Generates the IPF color of a single orientation.
+ * @param quatSym The symmetry operators of the Laue class
+ * @param hasInversion Whether the Laue class is centro-symmetric
+ * @param phi1 First Euler angle in radians
+ * @param phi Second Euler angle in radians
+ * @param phi2 Third Euler angle in radians
+ * @param refDir The reference direction in the sample frame
+ * @param inUnitTriangle Returns true if (eta, chi) lies in the standard triangle
+ * @param colorKey Returns the Rgb color of the direction (eta, chi) in the standard triangle
+ */
+template <size_t N, typename InUnitTriangleFunc, typename ColorKeyFunc>
+EbsdLib::Rgb GenerateIPFColor(const SymmetryKernels::QuatTable<N>& quatSym, bool hasInversion, double phi1, double phi, double phi2, const double refDir[3], InUnitTriangleFunc inUnitTriangle,
+                              ColorKeyFunc colorKey)
+{
+  const Euler3<double> eu(phi1, phi, phi2);
+  const QuatD q1 = OrientationTransformation::eu2qu<Euler3<double>, QuatD>(eu);
+  double eta = 0.0;
+  double chi = 0.0;
+  FindStandardTriangle(quatSym, hasInversion, q1, refDir, inUnitTriangle, eta, chi);
+  return colorKey(eta, chi);
+}
+
+/**
+ * @brief This is the functor that the TBB classes use to generate the IPF colors of a
+ * list of points that all belong to the same phase.
+ */
+template <size_t N, typename InUnitTriangleFunc, typename ColorKeyFunc>
+class GenerateIPFColorsImpl
+{
+public:
+  GenerateIPFColorsImpl(const SymmetryKernels::QuatTable<N>& quatSym, bool hasInversion, const float* eulers, const size_t* indices, const double refDir[3], bool convertDegrees,
+                        InUnitTriangleFunc inUnitTriangle, ColorKeyFunc colorKey, uint8_t* rgbOut)
+  : m_QuatSym(quatSym)
+  , m_HasInversion(hasInversion)
+  , m_Eulers(eulers)
+  , m_Indices(indices)
+  , m_RefDir{refDir[0], refDir[1], refDir[2]}
+  , m_ConvertDegrees(convertDegrees)
+  , m_InUnitTriangle(inUnitTriangle)
+  , m_ColorKey(colorKey)
+  , m_RgbOut(rgbOut)
+  {
+  }
+  virtual ~GenerateIPFColorsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    const double scale = m_ConvertDegrees ? EbsdLib::Constants::k_DegToRadD : 1.0;
+    for(size_t i = start; i < end; i++)
+    {
+      const size_t index = m_Indices[i];
+      const float* euler = m_Eulers + index * 3;
+      const EbsdLib::Rgb argb = GenerateIPFColor(m_QuatSym, m_HasInversion, euler[0] * scale, euler[1] * scale, euler[2] * scale, m_RefDir, m_InUnitTriangle, m_ColorKey);
+      m_RgbOut[index * 3] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+      m_RgbOut[index * 3 + 1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+      m_RgbOut[index * 3 + 2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const SymmetryKernels::QuatTable<N>& m_QuatSym;
+  bool m_HasInversion = false;
+  const float* m_Eulers = nullptr;
+  const size_t* m_Indices = nullptr;
+  double m_RefDir[3];
+  bool m_ConvertDegrees = false;
+  InUnitTriangleFunc m_InUnitTriangle;
+  ColorKeyFunc m_ColorKey;
+  uint8_t* m_RgbOut = nullptr;
+};
+
+/**
+ * @brief Generates the IPF colors of the points listed in 'indices'
+ * @param quatSym The symmetry operators of the Laue class
+ * @param hasInversion Whether the Laue class is centro-symmetric
+ * @param eulers Euler angles of all the points stored as <phi1,Phi,phi2>
+ * @param indices The indices of the points to color
+ * @param count The number of indices
+ * @param refDir The reference direction in the sample frame
+ * @param convertDegrees Whether the Euler angles are in degrees
+ * @param inUnitTriangle Returns true if (eta, chi) lies in the standard triangle
+ * @param colorKey Returns the Rgb color of the direction (eta, chi) in the standard triangle
+ * @param rgbOut RGB colors of all the points. Only the listed points are written.
+ */
+template <size_t N, typename InUnitTriangleFunc, typename ColorKeyFunc>
+void GenerateIPFColors(const SymmetryKernels::QuatTable<N>& quatSym, bool hasInversion, const float* eulers, const size_t* indices, size_t count, const double refDir[3], bool convertDegrees,
+                       InUnitTriangleFunc inUnitTriangle, ColorKeyFunc colorKey, uint8_t* rgbOut)
+{
+  using ImplType = GenerateIPFColorsImpl<N, InUnitTriangleFunc, ColorKeyFunc>;
+  ImplType impl(quatSym, hasInversion, eulers, indices, refDir, convertDegrees, inUnitTriangle, colorKey, rgbOut);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 256), impl, tbb::auto_partitioner());
+#else
+  impl.convert(0, count);
+#endif
+}
+} // namespace IPFColorKernels
@@ -35,9 +35,15 @@
 
 #include "LaueOps.h"
 
-#include <chrono>
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#endif
+
+#include <algorithm>
 #include <limits>
-#include <random>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdMacros.h"
@@ -47,13 +53,14 @@
 #include "EbsdLib/LaueOps/HexagonalOps.h"
 #include "EbsdLib/LaueOps/MonoclinicOps.h"
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
+#include "EbsdLib/LaueOps/SymmetryKernels.hpp"
 #include "EbsdLib/LaueOps/TetragonalLowOps.h"
 #include "EbsdLib/LaueOps/TetragonalOps.h"
 #include "EbsdLib/LaueOps/TriclinicOps.h"
 #include "EbsdLib/LaueOps/TrigonalLowOps.h"
 #include "EbsdLib/LaueOps/TrigonalOps.h"
-#include "EbsdLib/Math/EbsdLibRandom.h"
 #include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
 
 namespace Detail
 {
@@ -140,46 +147,9 @@ OrientationD LaueOps::calculateMisorientationInternal(const std::vector<QuatD>&
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-OrientationType LaueOps::_calcRodNearestOrigin(const std::vector<OrientationD>& rodsym, const OrientationType& inRod) const
+OrientationType LaueOps::_calcRodNearestOrigin(const std::vector<OrientationD>& rodsym, const OrientationType& rod) const
 {
-  double denom = 0.0f, dist = 0.0f;
-  double smallestdist = 100000000.0f;
-  double rc1 = 0.0f, rc2 = 0.0f, rc3 = 0.0f;
-  OrientationType outRod(4, 0.0f);
-  // Turn into an actual 3 Comp Rodrigues Vector
-  OrientationType rod = inRod;
-  rod[0] *= rod[3];
-  rod[1] *= rod[3];
-  rod[2] *= rod[3];
-  size_t numsym = rodsym.size();
-  for(size_t i = 0; i < numsym; i++)
-  {
-    denom = 1 - (rod[0] * rodsym[i][0] + rod[1] * rodsym[i][1] + rod[2] * rodsym[i][2]);
-    rc1 = (rod[0] + rodsym[i][0] - (rod[1] * rodsym[i][2] - rod[2] * rodsym[i][1])) / denom;
-    rc2 = (rod[1] + rodsym[i][1] - (rod[2] * rodsym[i][0] - rod[0] * rodsym[i][2])) / denom;
-    rc3 = (rod[2] + rodsym[i][2] - (rod[0] * rodsym[i][1] - rod[1] * rodsym[i][0])) / denom;
-    dist = rc1 * rc1 + rc2 * rc2 + rc3 * rc3;
-    if(dist < smallestdist)
-    {
-      smallestdist = dist;
-      outRod[0] = rc1;
-      outRod[1] = rc2;
-      outRod[2] = rc3;
-    }
-  }
-  double mag = sqrt(outRod[0] * outRod[0] + outRod[1] * outRod[1] + outRod[2] * outRod[2]);
-  if(mag == 0.0f)
-  {
-    outRod[3] = std::numeric_limits<double>::infinity();
-  }
-  else
-  {
-    outRod[3] = mag;
-    outRod[0] = outRod[0] / outRod[3];
-    outRod[1] = outRod[1] / outRod[3];
-    outRod[2] = outRod[2] / outRod[3];
-  }
-  return outRod;
+  return SymmetryKernels::RodNearestOrigin(rodsym, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -187,136 +157,64 @@ OrientationType LaueOps::_calcRodNearestOrigin(const std::vector<OrientationD>&
 // -----------------------------------------------------------------------------
 QuatD LaueOps::_calcNearestQuat(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const
 {
-  QuatD out;
-  double dist = 0.0;
-  double smallestdist = 1000000.0f;
-  QuatD qmax;
-  size_t numsym = quatsym.size();
-  for(size_t i = 0; i < numsym; i++)
-  {
-    QuatD qc = quatsym[i] * q2;
-    if(qc.w() < 0)
-    {
-      qc.negate();
-    }
-    dist = static_cast<double>(1 - (qc.w() * q1.w() + qc.x() * q1.x() + qc.y() * q1.y() + qc.z() * q1.z()));
-    if(dist < smallestdist)
-    {
-      smallestdist = dist;
-      qmax = qc;
-    }
-  }
-  out = qmax;
-  if(out.w() < 0)
-  {
-    out.negate();
-  }
-  return out;
+  return SymmetryKernels::NearestQuat(quatsym, q1, q2);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
 QuatD LaueOps::_calcQuatNearestOrigin(const std::vector<QuatD>& quatsym, const QuatD& qr) const
 {
-  double dist = 0.0;
-  double smallestdist = 1000000.0f;
-  QuatD qmax;
-  size_t numsym = quatsym.size();
-  for(size_t i = 0; i < numsym; i++)
-  {
-    QuatD qc = quatsym[i] * qr;
+  return SymmetryKernels::QuatNearestOrigin(quatsym, qr);
+}
 
-    dist = 1 - (qc.w() * qc.w());
-    if(dist < smallestdist)
-    {
-      smallestdist = dist;
-      qmax = qc;
-    }
-  }
-  QuatD out = qmax;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OdfGrid LaueOps::createOdfGrid(double binSize, OdfGrid::Layout layout) const
+{
+  return getOdfGrid().withBinSize(binSize, layout);
+}
 
-  if(out.w() < 0)
-  {
-    out.negate();
-  }
-  return out;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LaueOps::getMisoBin(const OdfGrid& grid, const OrientationType& rod) const
+{
+  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
+  return grid.getBin(ho);
 }
 
-int LaueOps::_calcMisoBin(double dim[3], double bins[3], double step[3], const OrientationType& ho) const
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LaueOps::getOdfBin(const OdfGrid& grid, const OrientationType& rod) const
 {
-  int miso1bin = int((ho[0] + dim[0]) / step[0]);
-  int miso2bin = int((ho[1] + dim[1]) / step[1]);
-  int miso3bin = int((ho[2] + dim[2]) / step[2]);
-  if(miso1bin >= bins[0])
-  {
-    miso1bin = static_cast<int>(bins[0] - 1);
-  }
-  if(miso2bin >= bins[1])
-  {
-    miso2bin = static_cast<int>(bins[1] - 1);
-  }
-  if(miso3bin >= bins[2])
-  {
-    miso3bin = static_cast<int>(bins[2] - 1);
-  }
-  if(miso1bin < 0)
-  {
-    miso1bin = 0;
-  }
-  if(miso2bin < 0)
-  {
-    miso2bin = 0;
-  }
-  if(miso3bin < 0)
-  {
-    miso3bin = 0;
-  }
-  return (static_cast<int>((bins[0] * bins[1] * miso3bin) + (bins[0] * miso2bin) + miso1bin));
+  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
+  return grid.getBin(ho);
 }
 
-void LaueOps::_calcDetermineHomochoricValues(double random[3], double init[3], double step[3], int32_t phi[3], double& r1, double& r2, double& r3) const
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OrientationType LaueOps::determineEulerAngles(const OdfGrid& grid, double random[3], int choose) const
 {
-  r1 = (step[0] * phi[0]) + (step[0] * random[0]) - (init[0]);
-  r2 = (step[1] * phi[1]) + (step[1] * random[1]) - (init[1]);
-  r3 = (step[2] * phi[2]) + (step[2] * random[2]) - (init[2]);
+  OrientationType ho = grid.getHomochoric(choose, random);
+  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  ro = getODFFZRod(ro);
+  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
+  return eu;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int LaueOps::_calcODFBin(double dim[3], double bins[3], double step[3], const OrientationType& ho) const
+OrientationType LaueOps::determineRodriguesVector(const OdfGrid& grid, double random[3], int choose) const
 {
-  int g1euler1bin;
-  int g1euler2bin;
-  int g1euler3bin;
-  int g1odfbin;
-  g1euler1bin = int((ho[0] + dim[0]) / step[0]);
-  g1euler2bin = int((ho[1] + dim[1]) / step[1]);
-  g1euler3bin = int((ho[2] + dim[2]) / step[2]);
-  if(g1euler1bin >= bins[0])
-  {
-    g1euler1bin = static_cast<int>(bins[0] - 1);
-  }
-  if(g1euler2bin >= bins[1])
-  {
-    g1euler2bin = static_cast<int>(bins[1] - 1);
-  }
-  if(g1euler3bin >= bins[2])
-  {
-    g1euler3bin = static_cast<int>(bins[2] - 1);
-  }
-  if(g1euler1bin < 0)
-  {
-    g1euler1bin = 0;
-  }
-  if(g1euler2bin < 0)
-  {
-    g1euler2bin = 0;
-  }
-  if(g1euler3bin < 0)
-  {
-    g1euler3bin = 0;
-  }
-  g1odfbin = static_cast<int>((g1euler3bin * bins[0] * bins[1]) + (g1euler2bin * bins[0]) + (g1euler1bin));
-  return g1odfbin;
+  OrientationType ho = grid.getHomochoric(choose, random);
+  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  ro = getMDFFZRod(ro);
+  return ro;
 }
 
 // -----------------------------------------------------------------------------
@@ -413,22 +311,363 @@ std::vector<std::string> LaueOps::GetLaueNames()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-size_t LaueOps::getRandomSymmetryOperatorIndex(int numSymOps) const
+void LaueOps::GenerateIPFColors(const float* eulers, const int32_t* phases, const std::vector<uint32_t>& crystalStructures, const double refDir[3], const bool* goodVoxels, size_t numPoints,
+                                uint8_t* rgbOut, bool convertDegrees)
 {
+  std::fill(rgbOut, rgbOut + numPoints * 3, static_cast<uint8_t>(0));
 
-  using SizeTDistributionType = std::uniform_int_distribution<size_t>;
+  const size_t numPhases = crystalStructures.size();
+  auto isValidPoint = [&](size_t i) {
+    const int32_t phase = phases[i];
+    return (nullptr == goodVoxels || goodVoxels[i]) && phase >= 0 && static_cast<size_t>(phase) < numPhases && crystalStructures[phase] < EbsdLib::CrystalStructure::LaueGroupEnd;
+  };
 
-  const SizeTDistributionType::result_type rangeMin = 0;
-  const SizeTDistributionType::result_type rangeMax = static_cast<SizeTDistributionType::result_type>(numSymOps - 1);
+  // Sort the indices of the valid points by phase so that each phase is one contiguous run
+  std::vector<size_t> phaseStart(numPhases + 1, 0);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    if(isValidPoint(i))
+    {
+      phaseStart[phases[i] + 1]++;
+    }
+  }
+  for(size_t phase = 0; phase < numPhases; phase++)
+  {
+    phaseStart[phase + 1] += phaseStart[phase];
+  }
+  std::vector<size_t> indices(phaseStart[numPhases]);
+  std::vector<size_t> nextIndex(phaseStart.begin(), phaseStart.end() - 1);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    if(isValidPoint(i))
+    {
+      indices[nextIndex[phases[i]]++] = i;
+    }
+  }
 
-  std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-  std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  generator.seed(seed);
-  SizeTDistributionType distribution(rangeMin, rangeMax);
+  std::vector<LaueOps::Pointer> ops = GetAllOrientationOps();
+  for(size_t phase = 0; phase < numPhases; phase++)
+  {
+    const size_t count = phaseStart[phase + 1] - phaseStart[phase];
+    if(count > 0)
+    {
+      ops[crystalStructures[phase]]->generateIPFColors(eulers, indices.data() + phaseStart[phase], count, refDir, convertDegrees, rgbOut);
+    }
+  }
+}
 
-  size_t symOp = distribution(generator); // Random remaining position.
-  return symOp;
+namespace PoleFigureEngine
+{
+// The number of orientations that are converted to sphere coordinates at a time
+constexpr size_t k_BlockSize = 4096;
+// The orientations are split into at most this many partitions that each bin into their own accumulators. The
+// partitions depend only on the input so the merged result does not depend on the number of threads.
+constexpr size_t k_MaxPartitions = 32;
+// The upper limit of the memory used by all the accumulators of all the partitions
+constexpr size_t k_MaxAccumulatorBytes = 256 * 1024 * 1024;
+
+/**
+ * @brief The bins of one partition for each of the 3 pole figure families. Only the Lambert squares or
+ * the discrete bins are used depending on the configuration.
+ */
+struct Accumulators
+{
+  std::array<ModifiedLambertProjection::Pointer, 3> lambert;
+  std::array<std::vector<double>, 3> discrete;
+};
+
+/**
+ * @brief Bins the sphere coordinates of a single family into the discrete stereographic image. This
+ * is the same binning that ComputeStereographicProjection uses.
+ */
+void AddDiscreteCoords(const float* xyz, size_t numCoords, int imageDim, double* intensity)
+{
+  const int halfDim = imageDim / 2;
+  for(size_t i = 0; i < numCoords; i++)
+  {
+    float x0 = xyz[i * 3 + 0];
+    float x1 = xyz[i * 3 + 1];
+    float x2 = xyz[i * 3 + 2];
+    if(x2 < 0.0f)
+    {
+      x0 *= -1.0f;
+      x1 *= -1.0f;
+      x2 *= -1.0f;
+    }
+    float x = x0 / (1 + x2);
+    float y = x1 / (1 + x2);
+
+    int xCoord = static_cast<int>(x * (halfDim - 1)) + halfDim;
+    int yCoord = static_cast<int>(y * (halfDim - 1)) + halfDim;
+
+    intensity[static_cast<size_t>((yCoord * imageDim) + xCoord)]++;
+  }
+}
+
+/**
+ * @brief Bins the sphere coordinates of a single family into the Lambert squares. This is the same
+ * binning that ModifiedLambertProjection::LambertBallToSquare uses.
+ */
+void AddLambertCoords(const float* xyz, size_t numCoords, ModifiedLambertProjection& lambert)
+{
+  float sqCoord[2] = {0.0f, 0.0f};
+  for(size_t i = 0; i < numCoords; i++)
+  {
+    if(lambert.getSquareCoord(xyz + i * 3, sqCoord))
+    {
+      lambert.addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+    }
+    else
+    {
+      lambert.addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+    }
+  }
+}
+
+/**
+ * @brief The AccumulateImpl class converts the orientations of a range of partitions to sphere coordinates
+ * a block at a time and bins them into the accumulators of each partition.
+ */
+class AccumulateImpl
+{
+  const LaueOps* m_Ops;
+  PoleFigureConfiguration_t* m_Config;
+  std::array<size_t, 3> m_FamilySizes;
+  size_t m_NumPartitions;
+  std::vector<Accumulators>* m_Accumulators;
+
+public:
+  AccumulateImpl(const LaueOps* ops, PoleFigureConfiguration_t* config, const std::array<size_t, 3>& familySizes, size_t numPartitions, std::vector<Accumulators>* accumulators)
+  : m_Ops(ops)
+  , m_Config(config)
+  , m_FamilySizes(familySizes)
+  , m_NumPartitions(numPartitions)
+  , m_Accumulators(accumulators)
+  {
+  }
+  virtual ~AccumulateImpl() = default;
+
+  void accumulate(size_t start, size_t end) const
+  {
+    const size_t numOrientations = m_Config->eulers->getNumberOfTuples();
+    const size_t numBlocks = (numOrientations + k_BlockSize - 1) / k_BlockSize;
+    const std::vector<size_t> cDims(1, 3);
+
+    std::array<EbsdLib::FloatArrayType::Pointer, 3> coords;
+    for(size_t f = 0; f < 3; f++)
+    {
+      coords[f] = EbsdLib::FloatArrayType::CreateArray(k_BlockSize * m_FamilySizes[f], cDims, "PoleFigureCoords", true);
+    }
+
+    for(size_t p = start; p < end; p++)
+    {
+      Accumulators& accumulators = (*m_Accumulators)[p];
+      const size_t firstBlock = p * numBlocks / m_NumPartitions;
+      const size_t lastBlock = (p + 1) * numBlocks / m_NumPartitions;
+      for(size_t block = firstBlock; block < lastBlock; block++)
+      {
+        const size_t first = block * k_BlockSize;
+        const size_t count = std::min(k_BlockSize, numOrientations - first);
+        EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::WrapPointer(m_Config->eulers->getPointer(first * 3), count, cDims, "PoleFigureEulers", false);
+        m_Ops->generateSphereCoordsFromEulers(eulers.get(), coords[0].get(), coords[1].get(), coords[2].get());
+
+        for(size_t f = 0; f < 3; f++)
+        {
+          if(m_Config->discrete)
+          {
+            AddDiscreteCoords(coords[f]->getPointer(0), count * m_FamilySizes[f], m_Config->imageDim, accumulators.discrete[f].data());
+          }
+          else
+          {
+            AddLambertCoords(coords[f]->getPointer(0), count * m_FamilySizes[f], *accumulators.lambert[f]);
+          }
+        }
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    accumulate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The MergeImpl class sums the accumulators of all the partitions for one family in partition
+ * order, creates the intensity image and finds its min and max values. This should be called from a TBB Task
+ */
+class MergeImpl
+{
+  PoleFigureConfiguration_t* m_Config;
+  std::vector<Accumulators>* m_Accumulators;
+  size_t m_Family;
+  EbsdLib::DoubleArrayType* m_Intensity;
+  double* m_Min;
+  double* m_Max;
+
+public:
+  MergeImpl(PoleFigureConfiguration_t* config, std::vector<Accumulators>* accumulators, size_t family, EbsdLib::DoubleArrayType* intensity, double* min, double* max)
+  : m_Config(config)
+  , m_Accumulators(accumulators)
+  , m_Family(family)
+  , m_Intensity(intensity)
+  , m_Min(min)
+  , m_Max(max)
+  {
+  }
+  virtual ~MergeImpl() = default;
+
+  void operator()() const
+  {
+    std::vector<Accumulators>& accumulators = *m_Accumulators;
+    const size_t numPartitions = accumulators.size();
+    double* intensity = m_Intensity->getPointer(0);
+    const size_t numPixels = m_Intensity->getNumberOfTuples();
+
+    if(m_Config->discrete)
+    {
+      const std::vector<double>& first = accumulators[0].discrete[m_Family];
+      std::copy(first.begin(), first.begin() + numPixels, intensity);
+      for(size_t p = 1; p < numPartitions; p++)
+      {
+        const std::vector<double>& bins = accumulators[p].discrete[m_Family];
+        for(size_t i = 0; i < numPixels; i++)
+        {
+          intensity[i] += bins[i];
+        }
+      }
+    }
+    else
+    {
+      ModifiedLambertProjection& lambert = *accumulators[0].lambert[m_Family];
+      double* north = lambert.getNorthSquare()->getPointer(0);
+      double* south = lambert.getSouthSquare()->getPointer(0);
+      const size_t numBins = lambert.getNorthSquare()->getNumberOfTuples();
+      for(size_t p = 1; p < numPartitions; p++)
+      {
+        const double* pNorth = accumulators[p].lambert[m_Family]->getNorthSquare()->getPointer(0);
+        const double* pSouth = accumulators[p].lambert[m_Family]->getSouthSquare()->getPointer(0);
+        for(size_t i = 0; i < numBins; i++)
+        {
+          north[i] += pNorth[i];
+          south[i] += pSouth[i];
+        }
+      }
+      lambert.normalizeSquaresToMRD();
+      lambert.createStereographicProjection(m_Config->imageDim, *m_Intensity);
+    }
+
+    double max = std::numeric_limits<double>::min();
+    double min = std::numeric_limits<double>::max();
+    for(size_t i = 0; i < numPixels; i++)
+    {
+      if(intensity[i] > max)
+      {
+        max = intensity[i];
+      }
+      if(intensity[i] < min)
+      {
+        min = intensity[i];
+      }
+    }
+    *m_Min = min;
+    *m_Max = max;
+  }
+};
+} // namespace PoleFigureEngine
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::DoubleArrayType::Pointer> LaueOps::generatePoleFigureIntensities(PoleFigureConfiguration_t& config, const std::array<size_t, 3>& familySizes,
+                                                                                      const std::array<std::string, 3>& labels) const
+{
+  using namespace PoleFigureEngine;
+
+  const size_t numOrientations = config.eulers->getNumberOfTuples();
+  const size_t numBlocks = (numOrientations + k_BlockSize - 1) / k_BlockSize;
+  const size_t numPixels = static_cast<size_t>(config.imageDim * config.imageDim);
+  const size_t binsPerFamily = config.discrete ? numPixels : static_cast<size_t>(2 * config.lambertDim * config.lambertDim);
+  const size_t maxPartitions = std::max(static_cast<size_t>(1), k_MaxAccumulatorBytes / (3 * binsPerFamily * sizeof(double)));
+  const size_t numPartitions = std::max(static_cast<size_t>(1), std::min({numBlocks, k_MaxPartitions, maxPartitions}));
+
+  std::vector<Accumulators> accumulators(numPartitions);
+  for(auto& partition : accumulators)
+  {
+    for(size_t f = 0; f < 3; f++)
+    {
+      if(config.discrete)
+      {
+        partition.discrete[f].resize(numPixels, 0.0);
+      }
+      else
+      {
+        partition.lambert[f] = ModifiedLambertProjection::New();
+        partition.lambert[f]->initializeSquares(config.lambertDim, config.sphereRadius);
+      }
+    }
+  }
+
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities(3);
+  std::vector<size_t> cDims = {1};
+  for(size_t f = 0; f < 3; f++)
+  {
+    // The merge writes every pixel so the arrays are not initialized here
+    intensities[f] = EbsdLib::DoubleArrayType::CreateUninitializedArray(numPixels, cDims, labels[f] + "_Intensity_Image");
+  }
+  std::array<double, 3> mins = {0.0, 0.0, 0.0};
+  std::array<double, 3> maxs = {0.0, 0.0, 0.0};
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPartitions, 1), AccumulateImpl(this, &config, familySizes, numPartitions, &accumulators), tbb::auto_partitioner());
+
+    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
+    for(size_t f = 0; f < 3; f++)
+    {
+      g->run(MergeImpl(&config, &accumulators, f, intensities[f].get(), &mins[f], &maxs[f]));
+    }
+    g->wait(); // Wait for all the threads to complete before moving on.
+  }
+  else
+#endif
+  {
+    AccumulateImpl serial(this, &config, familySizes, numPartitions, &accumulators);
+    serial.accumulate(0, numPartitions);
+    for(size_t f = 0; f < 3; f++)
+    {
+      MergeImpl merge(&config, &accumulators, f, intensities[f].get(), &mins[f], &maxs[f]);
+      merge();
+    }
+  }
+
+  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
+  config.minScale = std::min({mins[0], mins[1], mins[2]});
+  config.maxScale = std::max({maxs[0], maxs[1], maxs[2]});
+
+  return intensities;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t LaueOps::getRandomSymmetryOperatorIndex(int numSymOps) const
+{
+  // Each thread seeds its own generator once instead of querying the entropy source on every call
+  thread_local EbsdLib::Philox4x32 generator(EbsdLib::Philox4x32::RandomSeed());
+  return getRandomSymmetryOperatorIndex(numSymOps, generator);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t LaueOps::getRandomSymmetryOperatorIndex(int numSymOps, EbsdLib::Philox4x32& generator) const
+{
+  return generator.nextIndex(static_cast<size_t>(numSymOps));
 }
 
 // -----------------------------------------------------------------------------
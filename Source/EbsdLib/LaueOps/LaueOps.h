@@ -34,6 +34,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,8 @@
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/OdfGrid.hpp"
+#include "EbsdLib/Math/Philox4x32.hpp"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
 /*
@@ -90,6 +93,23 @@ public:
    */
   static std::vector<std::string> GetLaueNames();
 
+  /**
+   * @brief GenerateIPFColors Generates the IPF colors of many points at once. The points are
+   * grouped by phase and each group is colored with a single call to generateIPFColors of the
+   * LaueOps class of that phase. Points that are not good, that have an invalid phase, or
+   * whose phase has no valid Laue class are colored black.
+   * @param eulers Euler angles stored as <phi1,Phi,phi2> for each point
+   * @param phases The phase of each point
+   * @param crystalStructures The Laue class (EbsdLib::CrystalStructure value) of each phase
+   * @param refDir The 3 Component Reference Direction
+   * @param goodVoxels Which points to color. May be nullptr to color all points.
+   * @param numPoints The number of points
+   * @param rgbOut [output] The RGB color of each point stored as 3 uint8_t values
+   * @param convertDegrees Are the input angles in Degrees
+   */
+  static void GenerateIPFColors(const float* eulers, const int32_t* phases, const std::vector<uint32_t>& crystalStructures, const double refDir[3], const bool* goodVoxels, size_t numPoints,
+                                uint8_t* rgbOut, bool convertDegrees = false);
+
   /**
    * @brief getODFSize Returns the number of elements in the ODF array
    * @return
@@ -132,6 +152,22 @@ public:
    */
   virtual std::array<size_t, 3> getOdfNumBins() const = 0;
 
+  /**
+   * @brief Returns the default 5 degree grid that the ODF and MDF bins of this Laue class are based on
+   * @return
+   */
+  virtual OdfGrid getOdfGrid() const = 0;
+
+  /**
+   * @brief Creates an ODF/MDF grid of this Laue class with a different bin size. The grid can be passed to
+   * the getOdfBin, getMisoBin, determineEulerAngles and determineRodriguesVector overloads and to the
+   * Texture and StatsGen functions.
+   * @param binSize The bin size in degrees
+   * @param layout The order of the bins in memory. The blocked layout is better suited for fine grids.
+   * @return
+   */
+  OdfGrid createOdfGrid(double binSize, OdfGrid::Layout layout = OdfGrid::Layout::Blocked) const;
+
   /**
    * @brief calculateMisorientation Finds the misorientation between 2 quaternions and returns the result as an Axis Angle value
    * @param q1 Input Quaternion
@@ -148,6 +184,24 @@ public:
    */
   virtual OrientationF calculateMisorientation(const QuatF& q1, const QuatF& q2) const = 0;
 
+  /**
+   * @brief calculateMisorientations Finds the misorientations between n pairs of quaternions. The
+   * symmetry operator that gives the smallest angle is selected from the scalar part of each
+   * candidate alone and only that candidate is converted to an axis angle. The pairs are
+   * processed in parallel.
+   *
+   * Only the angle matches calculateMisorientation(). The axis is the one of the selected symmetric
+   * equivalent and is not reduced to the standard stereographic triangle, so pairs with the same
+   * misorientation can return different, symmetrically equivalent axes. Use calculateMisorientation()
+   * where the reduced axis is needed.
+   * @param q1 n quaternions stored as <x,y,z,w>
+   * @param q2 n quaternions stored as <x,y,z,w>
+   * @param n The number of pairs
+   * @param axisAngleOut n axis angles stored as <n1,n2,n3,angle> with the angle in radians and an
+   * unreduced axis
+   */
+  virtual void calculateMisorientations(const float* q1, const float* q2, size_t n, float* axisAngleOut) const = 0;
+
   /**
    * @brief getQuatSymOp Returns the symmetry operator at index i
    * @param i The index into the Symmetry operators array
@@ -189,6 +243,16 @@ public:
    */
   virtual QuatD getFZQuat(const QuatD& qr) const;
 
+  /**
+   * @brief getFZQuats Reduces n quaternions into the Fundemental Zone (FZ). The result is the
+   * same as calling getFZQuat on each quaternion but the whole array is processed in a single
+   * vectorized loop that runs in parallel.
+   * @param in n quaternions stored as <x,y,z,w>
+   * @param n The number of quaternions
+   * @param out n quaternions stored as <x,y,z,w> with w >= 0. May be the same pointer as 'in'.
+   */
+  virtual void getFZQuats(const float* in, size_t n, float* out) const = 0;
+
   /**
    * @brief getMisoBin Returns the misorientation bin that the input Rodregues vector lies in.
    * @param rod
@@ -196,18 +260,68 @@ public:
    */
   virtual int getMisoBin(const OrientationType& rod) const = 0;
 
+  /**
+   * @brief getMisoBin Returns the misorientation bin of a grid that the input Rodrigues vector lies in.
+   * @param grid The MDF grid
+   * @param rod
+   * @return
+   */
+  int getMisoBin(const OdfGrid& grid, const OrientationType& rod) const;
+
   virtual bool inUnitTriangle(double eta, double chi) const = 0;
 
   virtual OrientationType determineEulerAngles(double random[3], int choose) const = 0;
 
+  /**
+   * @brief determineEulerAngles Returns the Euler angles of a random orientation inside of a bin of an ODF grid
+   * @param grid The ODF grid
+   * @param random The position inside of the bin along each axis in [0,1)
+   * @param choose The index of the bin
+   * @return
+   */
+  OrientationType determineEulerAngles(const OdfGrid& grid, double random[3], int choose) const;
+
   virtual OrientationType randomizeEulerAngles(const OrientationType& euler) const = 0;
 
+  /**
+   * @brief randomizeEulerAngles Applies a randomly selected symmetry operator of this Laue class to an orientation
+   * @param euler The Euler angles to randomize
+   * @param generator The generator that the symmetry operator is drawn from
+   * @return The symmetrically equivalent Euler angles
+   */
+  virtual OrientationType randomizeEulerAngles(const OrientationType& euler, EbsdLib::Philox4x32& generator) const = 0;
+
   virtual size_t getRandomSymmetryOperatorIndex(int numSymOps) const;
 
+  /**
+   * @brief getRandomSymmetryOperatorIndex Draws a uniformly distributed symmetry operator index
+   * @param numSymOps The number of symmetry operators
+   * @param generator The generator to draw from
+   * @return An index in the range [0, numSymOps)
+   */
+  size_t getRandomSymmetryOperatorIndex(int numSymOps, EbsdLib::Philox4x32& generator) const;
+
   virtual OrientationType determineRodriguesVector(double random[3], int choose) const = 0;
 
+  /**
+   * @brief determineRodriguesVector Returns the Rodrigues vector of a random misorientation inside of a bin of an MDF grid
+   * @param grid The MDF grid
+   * @param random The position inside of the bin along each axis in [0,1)
+   * @param choose The index of the bin
+   * @return
+   */
+  OrientationType determineRodriguesVector(const OdfGrid& grid, double random[3], int choose) const;
+
   virtual int getOdfBin(const OrientationType& rod) const = 0;
 
+  /**
+   * @brief getOdfBin Returns the bin of an ODF grid that the input Rodrigues vector lies in.
+   * @param grid The ODF grid
+   * @param rod
+   * @return
+   */
+  int getOdfBin(const OdfGrid& grid, const OrientationType& rod) const;
+
   virtual void getSchmidFactorAndSS(double load[3], double& schmidfactor, double angleComps[2], int& slipsys) const = 0;
 
   virtual void getSchmidFactorAndSS(double load[3], double plane[3], double direction[3], double& schmidfactor, double angleComps[2], int& slipsys) const = 0;
@@ -244,6 +358,19 @@ public:
    */
   virtual EbsdLib::Rgb generateIPFColor(double e0, double e1, double e2, double dir0, double dir1, double dir2, bool convertDegrees) const = 0;
 
+  /**
+   * @brief generateIPFColors Generates the RGB Colors of a list of points in parallel. The
+   * result for each point is the same as from generateIPFColor.
+   * @param eulers Euler angles stored as <phi1,Phi,phi2> for each point
+   * @param indices The indices of the points to color
+   * @param count The number of indices
+   * @param refDir The 3 Component Reference Direction
+   * @param convertDegrees Are the input angles in Degrees
+   * @param rgbOut [output] The RGB color of each point stored as 3 uint8_t values. Only the
+   * listed points are written.
+   */
+  virtual void generateIPFColors(const float* eulers, const size_t* indices, size_t count, const double refDir[3], bool convertDegrees, uint8_t* rgbOut) const = 0;
+
   /**
    * @brief generateRodriguesColor Generates an RGB Color from a Rodrigues Vector
    * @param r1 First component of the Rodrigues Vector
@@ -272,6 +399,19 @@ public:
    */
   virtual std::vector<EbsdLib::UInt8ArrayType::Pointer> generatePoleFigure(PoleFigureConfiguration_t& config) const = 0;
 
+  /**
+   * @brief generatePoleFigureIntensities Computes the intensity images of the 3 pole figure families without
+   * creating the XYZ coordinates of all the orientations. The orientations are converted to sphere coordinates
+   * a block at a time and binned directly into Lambert squares (or discrete bins) that are merged once all the
+   * orientations have been processed. The images are the same as binning the full output of generateSphereCoordsFromEulers.
+   * @param config The pole figure configuration. The minScale and maxScale values are set from all 3 images.
+   * @param familySizes The number of sphere coordinates that generateSphereCoordsFromEulers creates per orientation for each family
+   * @param labels The names of the 3 families
+   * @return The 3 intensity images, each imageDim x imageDim
+   */
+  std::vector<EbsdLib::DoubleArrayType::Pointer> generatePoleFigureIntensities(PoleFigureConfiguration_t& config, const std::array<size_t, 3>& familySizes,
+                                                                               const std::array<std::string, 3>& labels) const;
+
 protected:
   LaueOps();
 
@@ -285,16 +425,21 @@ protected:
    */
   virtual OrientationD calculateMisorientationInternal(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const;
 
+  /**
+   * @brief Finds the symmetric equivalent of rod that lies closest to the origin. Forwards to SymmetryKernels::RodNearestOrigin.
+   */
   OrientationType _calcRodNearestOrigin(const std::vector<OrientationD>& rodsym, const OrientationType& rod) const;
 
+  /**
+   * @brief Finds the symmetric equivalent of q2 that lies closest to q1. Forwards to SymmetryKernels::NearestQuat.
+   */
   QuatD _calcNearestQuat(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const;
 
+  /**
+   * @brief Finds the symmetric equivalent of qr in the fundamental zone. Forwards to SymmetryKernels::QuatNearestOrigin.
+   */
   QuatD _calcQuatNearestOrigin(const std::vector<QuatD>& quatsym, const QuatD& qr) const;
 
-  int _calcMisoBin(double dim[3], double bins[3], double step[3], const OrientationType& homochoric) const;
-  void _calcDetermineHomochoricValues(double random[3], double init[3], double step[3], int32_t phi[3], double& r1, double& r2, double& r3) const;
-  int _calcODFBin(double dim[3], double bins[3], double step[3], const OrientationType& homochoric) const;
-
 public:
   LaueOps(const LaueOps&) = delete;            // Copy Constructor Not Implemented
   LaueOps(LaueOps&&) = delete;                 // Move Constructor Not Implemented
@@ -0,0 +1,224 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class OdfGrid OdfGrid.hpp EbsdLib/LaueOps/OdfGrid.hpp
+ * @brief Describes the bins of an ODF or MDF. The fundamental zone of a Laue class is covered by a
+ * regular grid in homochoric space that spans [-extent, extent] along each axis. Each LaueOps class
+ * provides its default 5 degree grid through LaueOps::getOdfGrid() and finer or coarser grids through
+ * LaueOps::createOdfGrid().
+ *
+ * The bins are either stored in the classic linear order (axis 0 fastest) or in blocks of
+ * k_BlockDim^3 bins. The blocked order keeps the neighbors of a bin close in memory which matters
+ * for fine grids, e.g. a 1 degree cubic ODF has 729000 bins. Partial blocks are used at the upper
+ * edges so both layouts have exactly the same number of bins.
+ */
+class OdfGrid
+{
+public:
+  enum class Layout : int32_t
+  {
+    Linear = 0,
+    Blocked = 1
+  };
+
+  /**
+   * @brief The bin size in degrees of the default grids of the LaueOps classes
+   */
+  static constexpr double k_DefaultBinSize = 5.0;
+
+  /**
+   * @brief The number of bins along each axis of a block of the blocked layout
+   */
+  static constexpr int32_t k_BlockDim = 8;
+
+  OdfGrid() = default;
+
+  /**
+   * @brief Creates a grid
+   * @param numBins The number of bins along each axis. Each should be even.
+   * @param extents The half width of the grid in homochoric space along each axis
+   * @param layout The order of the bins in memory
+   */
+  OdfGrid(const std::array<size_t, 3>& numBins, const std::array<double, 3>& extents, Layout layout = Layout::Linear)
+  : m_NumBins({static_cast<int32_t>(numBins[0]), static_cast<int32_t>(numBins[1]), static_cast<int32_t>(numBins[2])})
+  , m_Extents(extents)
+  , m_Layout(layout)
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      m_Step[i] = m_Extents[i] / static_cast<double>(m_NumBins[i] / 2);
+    }
+  }
+
+  ~OdfGrid() = default;
+
+  OdfGrid(const OdfGrid&) = default;
+  OdfGrid(OdfGrid&&) = default;
+  OdfGrid& operator=(const OdfGrid&) = default;
+  OdfGrid& operator=(OdfGrid&&) = default;
+
+  /**
+   * @brief Creates a grid that covers the same extents with bins of a different size. The number of
+   * bins along each axis is scaled relative to this grid, which is assumed to have k_DefaultBinSize
+   * bins, and rounded to an even number.
+   * @param binSize The bin size in degrees
+   * @param layout The order of the bins in memory
+   */
+  OdfGrid withBinSize(double binSize, Layout layout) const
+  {
+    const double scale = k_DefaultBinSize / binSize;
+    std::array<size_t, 3> numBins = {0, 0, 0};
+    for(size_t i = 0; i < 3; i++)
+    {
+      const double halfBins = std::round(static_cast<double>(m_NumBins[i]) * scale * 0.5);
+      numBins[i] = static_cast<size_t>(2.0 * std::max(1.0, halfBins));
+    }
+    return {numBins, m_Extents, layout};
+  }
+
+  std::array<size_t, 3> getNumBins() const
+  {
+    return {static_cast<size_t>(m_NumBins[0]), static_cast<size_t>(m_NumBins[1]), static_cast<size_t>(m_NumBins[2])};
+  }
+
+  const std::array<double, 3>& getExtents() const
+  {
+    return m_Extents;
+  }
+
+  const std::array<double, 3>& getStep() const
+  {
+    return m_Step;
+  }
+
+  Layout getLayout() const
+  {
+    return m_Layout;
+  }
+
+  /**
+   * @brief Returns the total number of bins
+   */
+  size_t size() const
+  {
+    return static_cast<size_t>(m_NumBins[0]) * static_cast<size_t>(m_NumBins[1]) * static_cast<size_t>(m_NumBins[2]);
+  }
+
+  /**
+   * @brief Returns the index of a bin from its position along each axis
+   */
+  int getIndex(int32_t bin0, int32_t bin1, int32_t bin2) const
+  {
+    if(m_Layout == Layout::Linear)
+    {
+      return (bin2 * m_NumBins[0] * m_NumBins[1]) + (bin1 * m_NumBins[0]) + bin0;
+    }
+    const int32_t block0 = bin0 / k_BlockDim;
+    const int32_t block1 = bin1 / k_BlockDim;
+    const int32_t block2 = bin2 / k_BlockDim;
+    const int32_t dim0 = std::min(k_BlockDim, m_NumBins[0] - block0 * k_BlockDim);
+    const int32_t dim1 = std::min(k_BlockDim, m_NumBins[1] - block1 * k_BlockDim);
+    const int32_t dim2 = std::min(k_BlockDim, m_NumBins[2] - block2 * k_BlockDim);
+    // All the bins of the preceding slabs, rows and blocks come first
+    int offset = block2 * k_BlockDim * m_NumBins[0] * m_NumBins[1];
+    offset += dim2 * block1 * k_BlockDim * m_NumBins[0];
+    offset += dim2 * dim1 * block0 * k_BlockDim;
+    return offset + ((bin2 - block2 * k_BlockDim) * dim1 + (bin1 - block1 * k_BlockDim)) * dim0 + (bin0 - block0 * k_BlockDim);
+  }
+
+  /**
+   * @brief Returns the position of a bin along each axis from its index
+   */
+  std::array<int32_t, 3> getBinPosition(int index) const
+  {
+    if(m_Layout == Layout::Linear)
+    {
+      return {index % m_NumBins[0], (index / m_NumBins[0]) % m_NumBins[1], index / (m_NumBins[0] * m_NumBins[1])};
+    }
+    const int32_t block2 = index / (k_BlockDim * m_NumBins[0] * m_NumBins[1]);
+    index -= block2 * k_BlockDim * m_NumBins[0] * m_NumBins[1];
+    const int32_t dim2 = std::min(k_BlockDim, m_NumBins[2] - block2 * k_BlockDim);
+    const int32_t block1 = index / (dim2 * k_BlockDim * m_NumBins[0]);
+    index -= dim2 * block1 * k_BlockDim * m_NumBins[0];
+    const int32_t dim1 = std::min(k_BlockDim, m_NumBins[1] - block1 * k_BlockDim);
+    const int32_t block0 = index / (dim2 * dim1 * k_BlockDim);
+    index -= dim2 * dim1 * block0 * k_BlockDim;
+    const int32_t dim0 = std::min(k_BlockDim, m_NumBins[0] - block0 * k_BlockDim);
+    return {block0 * k_BlockDim + index % dim0, block1 * k_BlockDim + (index / dim0) % dim1, block2 * k_BlockDim + index / (dim0 * dim1)};
+  }
+
+  /**
+   * @brief Returns the bin that a homochoric vector lies in. Vectors outside of the grid are
+   * assigned to the nearest bin.
+   */
+  int getBin(const OrientationD& ho) const
+  {
+    std::array<int32_t, 3> bin = {0, 0, 0};
+    for(size_t i = 0; i < 3; i++)
+    {
+      bin[i] = static_cast<int32_t>((ho[i] + m_Extents[i]) / m_Step[i]);
+      bin[i] = std::max(0, std::min(bin[i], m_NumBins[i] - 1));
+    }
+    return getIndex(bin[0], bin[1], bin[2]);
+  }
+
+  /**
+   * @brief Returns a homochoric vector inside of a bin
+   * @param index The index of the bin
+   * @param random The position inside of the bin along each axis in [0,1)
+   */
+  OrientationD getHomochoric(int index, const double random[3]) const
+  {
+    const std::array<int32_t, 3> bin = getBinPosition(index);
+    return OrientationD((m_Step[0] * bin[0]) + (m_Step[0] * random[0]) - (m_Extents[0]), (m_Step[1] * bin[1]) + (m_Step[1] * random[1]) - (m_Extents[1]),
+                        (m_Step[2] * bin[2]) + (m_Step[2] * random[2]) - (m_Extents[2]));
+  }
+
+private:
+  std::array<int32_t, 3> m_NumBins = {0, 0, 0};
+  std::array<double, 3> m_Extents = {0.0, 0.0, 0.0};
+  std::array<double, 3> m_Step = {0.0, 0.0, 0.0};
+  Layout m_Layout = Layout::Linear;
+};
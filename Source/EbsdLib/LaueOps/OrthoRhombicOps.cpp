@@ -46,9 +46,10 @@
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/IPFColorKernels.hpp"
+#include "EbsdLib/LaueOps/SymmetryKernels.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
 namespace OrthoRhombic
@@ -58,8 +59,7 @@ static const std::array<size_t, 3> OdfNumBins = {36, 36, 36}; // Represents a 5D
 static const std::array<double, 3> OdfDimInitValue = {std::pow((0.75 * ((EbsdLib::Constants::k_PiOver2D)-std::sin((EbsdLib::Constants::k_PiOver2D)))), (1.0 / 3.0)),
                                                       std::pow((0.75 * ((EbsdLib::Constants::k_PiOver2D)-std::sin((EbsdLib::Constants::k_PiOver2D)))), (1.0 / 3.0)),
                                                       std::pow((0.75 * ((EbsdLib::Constants::k_PiOver2D)-std::sin((EbsdLib::Constants::k_PiOver2D)))), (1.0 / 3.0))};
-static const std::array<double, 3> OdfDimStepValue = {OdfDimInitValue[0] / static_cast<double>(OdfNumBins[0] / 2), OdfDimInitValue[1] / static_cast<double>(OdfNumBins[1] / 2),
-                                                      OdfDimInitValue[2] / static_cast<double>(OdfNumBins[2] / 2)};
+static const OdfGrid k_OdfGrid(OdfNumBins, OdfDimInitValue);
 
 static const int symSize0 = 2;
 static const int symSize1 = 2;
@@ -70,10 +70,12 @@ static const int k_MdfSize = 46656;
 static const int k_SymOpsCount = 4;
 static const int k_NumMdfBins = 36;
 
-static const std::vector<QuatD> QuatSym = {QuatD(0.000000000, 0.000000000, 0.000000000, 1.000000000), QuatD(1.000000000, 0.000000000, 0.000000000, 0.000000000),
-                                           QuatD(0.000000000, 1.000000000, 0.000000000, 0.000000000), QuatD(0.000000000, 0.000000000, 1.000000000, 0.000000000)};
+static constexpr SymmetryKernels::QuatTable<k_SymOpsCount> QuatSymTable = {{{0.000000000, 0.000000000, 0.000000000, 1.000000000}, {1.000000000, 0.000000000, 0.000000000, 0.000000000},
+                                                                            {0.000000000, 1.000000000, 0.000000000, 0.000000000}, {0.000000000, 0.000000000, 1.000000000, 0.000000000}}};
+static const std::vector<QuatD> QuatSym = SymmetryKernels::ToQuaternions(QuatSymTable);
+static constexpr SymmetryKernels::SymOpTable<k_SymOpsCount> QuatSymF = SymmetryKernels::ToSymOpTable(QuatSymTable);
 
-static const std::vector<OrientationD> RodSym = {{0.0, 0.0, 0.0}, {10000000000.0, 0.0, 0.0}, {0.0, 10000000000.0, 0.0}, {0.0, 0.0, 10000000000.0}};
+static constexpr SymmetryKernels::RodTable<k_SymOpsCount> RodSym = {{{0.0, 0.0, 0.0}, {10000000000.0, 0.0, 0.0}, {0.0, 10000000000.0, 0.0}, {0.0, 0.0, 10000000000.0}}};
 
 static const double MatSym[k_SymOpsCount][3][3] = {{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}},
 
@@ -83,6 +85,16 @@ static const double MatSym[k_SymOpsCount][3][3] = {{{1.0, 0.0, 0.0}, {0.0, 1.0,
 
                                                    {{-1.0, 0.0, 0.0}, {0.0, -1.0, 0.0}, {0.0, 0.0, 1.0}}};
 
+/**
+ * @brief Color key of the standard stereographic triangle
+ */
+struct IPFColorKey
+{
+  EbsdLib::Rgb operator()(double eta, double chi) const
+  {
+    return IPFColorKernels::SectorColor(eta, chi, 0.0, 90.0);
+  }
+};
 } // namespace OrthoRhombic
 
 // -----------------------------------------------------------------------------
@@ -139,6 +151,14 @@ std::array<size_t, 3> OrthoRhombicOps::getOdfNumBins() const
   return OrthoRhombic::OdfNumBins;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OdfGrid OrthoRhombicOps::getOdfGrid() const
+{
+  return OrthoRhombic::k_OdfGrid;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -163,6 +183,12 @@ OrientationF OrthoRhombicOps::calculateMisorientation(const QuatF& q1f, const Qu
   return axisAngle;
 }
 
+// -----------------------------------------------------------------------------
+void OrthoRhombicOps::calculateMisorientations(const float* q1, const float* q2, size_t n, float* axisAngleOut) const
+{
+  SymmetryKernels::CalculateMisorientations(OrthoRhombic::QuatSymF, q1, q2, n, axisAngleOut);
+}
+
 QuatD OrthoRhombicOps::getQuatSymOp(int32_t i) const
 {
   return OrthoRhombic::QuatSym[i];
@@ -206,7 +232,7 @@ void OrthoRhombicOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType OrthoRhombicOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(OrthoRhombic::RodSym, rod);
+  return SymmetryKernels::RodNearestOrigin(OrthoRhombic::RodSym, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -219,7 +245,7 @@ OrientationType OrthoRhombicOps::getMDFFZRod(const OrientationType& inRod) const
   double w, n1, n2, n3;
   double FZn1 = 0.0f, FZn2 = 0.0f, FZn3 = 0.0f, FZw = 0.0f;
 
-  OrientationType rod = _calcRodNearestOrigin(OrthoRhombic::RodSym, inRod);
+  OrientationType rod = SymmetryKernels::RodNearestOrigin(OrthoRhombic::RodSym, inRod);
   OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
   n1 = ax[0];
   n2 = ax[1], n3 = ax[2], w = ax[3];
@@ -234,17 +260,25 @@ OrientationType OrthoRhombicOps::getMDFFZRod(const OrientationType& inRod) const
 // -----------------------------------------------------------------------------
 QuatD OrthoRhombicOps::getNearestQuat(const QuatD& q1, const QuatD& q2) const
 {
-  return _calcNearestQuat(OrthoRhombic::QuatSym, q1, q2);
+  return SymmetryKernels::NearestQuat(OrthoRhombic::QuatSymTable, q1, q2);
 }
 
 QuatF OrthoRhombicOps::getNearestQuat(const QuatF& q1f, const QuatF& q2f) const
 {
-  return _calcNearestQuat(OrthoRhombic::QuatSym, q1f.to<double>(), q2f.to<double>()).to<float>();
+  return SymmetryKernels::NearestQuat(OrthoRhombic::QuatSymTable, q1f.to<double>(), q2f.to<double>()).to<float>();
 }
 
 QuatD OrthoRhombicOps::getFZQuat(const QuatD& qr) const
 {
-  return _calcQuatNearestOrigin(OrthoRhombic::QuatSym, qr);
+  return SymmetryKernels::QuatNearestOrigin(OrthoRhombic::QuatSymTable, qr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OrthoRhombicOps::getFZQuats(const float* in, size_t n, float* out) const
+{
+  SymmetryKernels::GetFZQuats(OrthoRhombic::QuatSymF, in, n, out);
 }
 
 // -----------------------------------------------------------------------------
@@ -252,22 +286,7 @@ QuatD OrthoRhombicOps::getFZQuat(const QuatD& qr) const
 // -----------------------------------------------------------------------------
 int OrthoRhombicOps::getMisoBin(const OrientationType& rod) const
 {
-  double dim[3];
-  double bins[3];
-  double step[3];
-  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
-
-  dim[0] = OrthoRhombic::OdfDimInitValue[0];
-  dim[1] = OrthoRhombic::OdfDimInitValue[1];
-  dim[2] = OrthoRhombic::OdfDimInitValue[2];
-  step[0] = OrthoRhombic::OdfDimStepValue[0];
-  step[1] = OrthoRhombic::OdfDimStepValue[1];
-  step[2] = OrthoRhombic::OdfDimStepValue[2];
-  bins[0] = static_cast<double>(OrthoRhombic::OdfNumBins[0]);
-  bins[1] = static_cast<double>(OrthoRhombic::OdfNumBins[1]);
-  bins[2] = static_cast<double>(OrthoRhombic::OdfNumBins[2]);
-
-  return _calcMisoBin(dim, bins, step, ho);
+  return LaueOps::getMisoBin(OrthoRhombic::k_OdfGrid, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -275,28 +294,7 @@ int OrthoRhombicOps::getMisoBin(const OrientationType& rod) const
 // -----------------------------------------------------------------------------
 OrientationType OrthoRhombicOps::determineEulerAngles(double random[3], int choose) const
 {
-  double init[3];
-  double step[3];
-  int32_t phi[3];
-  double h1, h2, h3;
-
-  init[0] = OrthoRhombic::OdfDimInitValue[0];
-  init[1] = OrthoRhombic::OdfDimInitValue[1];
-  init[2] = OrthoRhombic::OdfDimInitValue[2];
-  step[0] = OrthoRhombic::OdfDimStepValue[0];
-  step[1] = OrthoRhombic::OdfDimStepValue[1];
-  step[2] = OrthoRhombic::OdfDimStepValue[2];
-  phi[0] = static_cast<int32_t>(choose % OrthoRhombic::OdfNumBins[0]);
-  phi[1] = static_cast<int32_t>((choose / OrthoRhombic::OdfNumBins[0]) % OrthoRhombic::OdfNumBins[1]);
-  phi[2] = static_cast<int32_t>(choose / (OrthoRhombic::OdfNumBins[0] * OrthoRhombic::OdfNumBins[1]));
-
-  _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
-  ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  return LaueOps::determineEulerAngles(OrthoRhombic::k_OdfGrid, random, choose);
 }
 
 // -----------------------------------------------------------------------------
@@ -310,31 +308,23 @@ OrientationType OrthoRhombicOps::randomizeEulerAngles(const OrientationType& syn
   return OrientationTransformation::qu2eu<QuatD, OrientationType>(qc);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OrientationType OrthoRhombicOps::randomizeEulerAngles(const OrientationType& synea, EbsdLib::Philox4x32& generator) const
+{
+  size_t symOp = getRandomSymmetryOperatorIndex(OrthoRhombic::k_SymOpsCount, generator);
+  QuatD quat = OrientationTransformation::eu2qu<OrientationType, QuatD>(synea);
+  QuatD qc = OrthoRhombic::QuatSym[symOp] * quat;
+  return OrientationTransformation::qu2eu<QuatD, OrientationType>(qc);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 OrientationType OrthoRhombicOps::determineRodriguesVector(double random[3], int choose) const
 {
-  double init[3];
-  double step[3];
-  int32_t phi[3];
-  double h1, h2, h3;
-
-  init[0] = OrthoRhombic::OdfDimInitValue[0];
-  init[1] = OrthoRhombic::OdfDimInitValue[1];
-  init[2] = OrthoRhombic::OdfDimInitValue[2];
-  step[0] = OrthoRhombic::OdfDimStepValue[0];
-  step[1] = OrthoRhombic::OdfDimStepValue[1];
-  step[2] = OrthoRhombic::OdfDimStepValue[2];
-  phi[0] = static_cast<int32_t>(choose % OrthoRhombic::OdfNumBins[0]);
-  phi[1] = static_cast<int32_t>((choose / OrthoRhombic::OdfNumBins[0]) % OrthoRhombic::OdfNumBins[1]);
-  phi[2] = static_cast<int32_t>(choose / (OrthoRhombic::OdfNumBins[0] * OrthoRhombic::OdfNumBins[1]));
-
-  _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
-  ro = getMDFFZRod(ro);
-  return ro;
+  return LaueOps::determineRodriguesVector(OrthoRhombic::k_OdfGrid, random, choose);
 }
 
 // -----------------------------------------------------------------------------
@@ -342,23 +332,7 @@ OrientationType OrthoRhombicOps::determineRodriguesVector(double random[3], int
 // -----------------------------------------------------------------------------
 int OrthoRhombicOps::getOdfBin(const OrientationType& rod) const
 {
-  double dim[3];
-  double bins[3];
-  double step[3];
-
-  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
-
-  dim[0] = OrthoRhombic::OdfDimInitValue[0];
-  dim[1] = OrthoRhombic::OdfDimInitValue[1];
-  dim[2] = OrthoRhombic::OdfDimInitValue[2];
-  step[0] = OrthoRhombic::OdfDimStepValue[0];
-  step[1] = OrthoRhombic::OdfDimStepValue[1];
-  step[2] = OrthoRhombic::OdfDimStepValue[2];
-  bins[0] = static_cast<double>(OrthoRhombic::OdfNumBins[0]);
-  bins[1] = static_cast<double>(OrthoRhombic::OdfNumBins[1]);
-  bins[2] = static_cast<double>(OrthoRhombic::OdfNumBins[2]);
-
-  return _calcODFBin(dim, bins, step, ho);
+  return LaueOps::getOdfBin(OrthoRhombic::k_OdfGrid, rod);
 }
 
 void OrthoRhombicOps::getSchmidFactorAndSS(double load[3], double& schmidfactor, double angleComps[2], int& slipsys) const
@@ -563,76 +537,18 @@ EbsdLib::Rgb OrthoRhombicOps::generateIPFColor(double phi1, double phi, double p
     phi = phi * EbsdLib::Constants::k_DegToRadD;
     phi2 = phi2 * EbsdLib::Constants::k_DegToRadD;
   }
+  const double refDir[3] = {refDir0, refDir1, refDir2};
+  auto inTriangle = [this](double eta, double chi) { return OrthoRhombicOps::inUnitTriangle(eta, chi); };
+  return IPFColorKernels::GenerateIPFColor(OrthoRhombic::QuatSymTable, getHasInversion(), phi1, phi, phi2, refDir, inTriangle, OrthoRhombic::IPFColorKey());
+}
 
-  double g[3][3];
-  double p[3];
-  double refDirection[3] = {0.0f, 0.0f, 0.0f};
-  double chi = 0.0f, eta = 0.0f;
-  double _rgb[3] = {0.0, 0.0, 0.0};
-
-  OrientationType eu(phi1, phi, phi2);
-  OrientationType om(9); // Reusable for the loop
-  QuatD q1 = OrientationTransformation::eu2qu<OrientationType, QuatD>(eu);
-
-  for(int j = 0; j < OrthoRhombic::k_SymOpsCount; j++)
-  {
-    QuatD qu = getQuatSymOp(j) * q1;
-    OrientationTransformation::qu2om<QuatD, OrientationType>(qu).toGMatrix(g);
-
-    refDirection[0] = refDir0;
-    refDirection[1] = refDir1;
-    refDirection[2] = refDir2;
-    EbsdMatrixMath::Multiply3x3with3x1(g, refDirection, p);
-    EbsdMatrixMath::Normalize3x1(p);
-
-    if(!getHasInversion() && p[2] < 0)
-    {
-      continue;
-    }
-    if(getHasInversion() && p[2] < 0)
-    {
-      p[0] = -p[0], p[1] = -p[1], p[2] = -p[2];
-    }
-    chi = std::acos(p[2]);
-    eta = std::atan2(p[1], p[0]);
-    if(!inUnitTriangle(eta, chi))
-    {
-      continue;
-    }
-
-    break;
-  }
-
-  double etaMin = 0.0;
-  double etaMax = 90.0;
-  double chiMax = 90.0;
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiDeg = chi * EbsdLib::Constants::k_180OverPiD;
-
-  _rgb[0] = 1.0 - chiDeg / chiMax;
-  _rgb[2] = fabs(etaDeg - etaMin) / (etaMax - etaMin);
-  _rgb[1] = 1 - _rgb[2];
-  _rgb[1] *= chiDeg / chiMax;
-  _rgb[2] *= chiDeg / chiMax;
-  _rgb[0] = sqrt(_rgb[0]);
-  _rgb[1] = sqrt(_rgb[1]);
-  _rgb[2] = sqrt(_rgb[2]);
-
-  double max = _rgb[0];
-  if(_rgb[1] > max)
-  {
-    max = _rgb[1];
-  }
-  if(_rgb[2] > max)
-  {
-    max = _rgb[2];
-  }
-
-  _rgb[0] = _rgb[0] / max;
-  _rgb[1] = _rgb[1] / max;
-  _rgb[2] = _rgb[2] / max;
-
-  return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(_rgb[0] * 255), static_cast<int32_t>(_rgb[1] * 255), static_cast<int32_t>(_rgb[2] * 255), 255);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OrthoRhombicOps::generateIPFColors(const float* eulers, const size_t* indices, size_t count, const double refDir[3], bool convertDegrees, uint8_t* rgbOut) const
+{
+  auto inTriangle = [this](double eta, double chi) { return OrthoRhombicOps::inUnitTriangle(eta, chi); };
+  IPFColorKernels::GenerateIPFColors(OrthoRhombic::QuatSymTable, getHasInversion(), eulers, indices, count, refDir, convertDegrees, inTriangle, OrthoRhombic::IPFColorKey(), rgbOut);
 }
 
 // -----------------------------------------------------------------------------
@@ -680,100 +596,20 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> OrthoRhombicOps::generatePoleFigur
     label2 = config.labels.at(2);
   }
 
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  std::vector<size_t> dims(1, 3);
-  std::vector<EbsdLib::FloatArrayType::Pointer> coords(3);
-  coords[0] = EbsdLib::FloatArrayType::CreateArray(numOrientations * OrthoRhombic::symSize0, dims, label0 + std::string("001_Coords"), true);
-  coords[1] = EbsdLib::FloatArrayType::CreateArray(numOrientations * OrthoRhombic::symSize1, dims, label1 + std::string("100_Coords"), true);
-  coords[2] = EbsdLib::FloatArrayType::CreateArray(numOrientations * OrthoRhombic::symSize2, dims, label2 + std::string("010_Coords"), true);
-
   config.sphereRadius = 1.0;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, coords[0].get(), coords[1].get(), coords[2].get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity100 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity010 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(coords[0].get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(coords[1].get(), &config, intensity100.get()));
-    g->run(ComputeStereographicProjection(coords[2].get(), &config, intensity010.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(coords[0].get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(coords[1].get(), &config, intensity100.get());
-    m011();
-    ComputeStereographicProjection m111(coords[2].get(), &config, intensity010.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
+  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image. The
+  // orientations are binned block by block so the sphere coordinates of all the orientations are never stored.
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities =
+      generatePoleFigureIntensities(config, {OrthoRhombic::symSize0, OrthoRhombic::symSize1, OrthoRhombic::symSize2}, {label0, label1, label2});
+  EbsdLib::DoubleArrayType::Pointer intensity001 = intensities[0];
+  EbsdLib::DoubleArrayType::Pointer intensity100 = intensities[1];
+  EbsdLib::DoubleArrayType::Pointer intensity010 = intensities[2];
 
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity100->getPointer(0);
-  count = intensity100->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity010->getPointer(0);
-  count = intensity010->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
-
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image100 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image010 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
+  std::vector<size_t> dims(1, 4);
+  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label0);
+  EbsdLib::UInt8ArrayType::Pointer image100 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label1);
+  EbsdLib::UInt8ArrayType::Pointer image010 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label2);
 
   std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
   if(config.order.size() == 3)
@@ -790,6 +626,7 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> OrthoRhombicOps::generatePoleFigur
   }
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
   if(doParallel)
   {
     std::shared_ptr<tbb::task_group> g(new tbb::task_group);
@@ -31,6 +31,17 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SO3Sampler.h"
 
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <vector>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -95,6 +106,164 @@ static const int FZoarray[32] = {NoAxisOrder,        NoAxisOrder,        TwoFold
                                  ThreeFoldAxisOrder, ThreeFoldAxisOrder, ThreeFoldAxisOrder, ThreeFoldAxisOrder, SixFoldAxisOrder,  SixFoldAxisOrder,  SixFoldAxisOrder,  SixFoldAxisOrder,
                                  SixFoldAxisOrder,   SixFoldAxisOrder,   SixFoldAxisOrder,   NoAxisOrder,        NoAxisOrder,       NoAxisOrder,       NoAxisOrder,       NoAxisOrder};
 
+namespace
+{
+/**
+ * @brief Pointers to the four components of a batch of Rodrigues vectors stored in
+ * a structure of arrays layout.
+ */
+struct RodriguesSoA
+{
+  const double* n1;
+  const double* n2;
+  const double* n3;
+  const double* t;
+};
+
+/**
+ * @brief Evaluates the FZ test for the points [start, end) and packs the results into
+ * one bit per point. 'start' must be a multiple of 64. The test is evaluated into a
+ * small byte array first so that the loop over the points has no branches and can be
+ * vectorized by the compiler.
+ */
+template <typename InsideFunctor>
+void EvaluateFZBlock(const RodriguesSoA& rod, size_t start, size_t end, uint64_t* mask, InsideFunctor inside)
+{
+  uint8_t flags[64];
+  for(size_t first = start; first < end; first += 64)
+  {
+    const size_t count = std::min<size_t>(64, end - first);
+    const double* n1 = rod.n1 + first;
+    const double* n2 = rod.n2 + first;
+    const double* n3 = rod.n3 + first;
+    const double* t = rod.t + first;
+    for(size_t p = 0; p < count; p++)
+    {
+      flags[p] = static_cast<uint8_t>(inside(n1[p], n2[p], n3[p], t[p]));
+    }
+    uint64_t word = 0;
+    for(size_t p = 0; p < count; p++)
+    {
+      word |= static_cast<uint64_t>(flags[p]) << p;
+    }
+    mask[first / 64] = word;
+  }
+}
+
+/**
+ * @brief Batch version of SO3Sampler::IsinsideFZ(). The switch over the FZ type and
+ * axis order is done once for the whole range instead of once per point. The plane
+ * tests are combined with non short circuit operators so that every point does the
+ * same work.
+ */
+void EvaluateFZMask(int32_t FZtype, int32_t FZorder, const RodriguesSoA& rod, size_t start, size_t end, uint64_t* mask)
+{
+  constexpr double k_Infinity = std::numeric_limits<double>::infinity();
+  constexpr double r1 = 1.0;
+  switch(FZtype)
+  {
+  case AnorthicType:
+    EvaluateFZBlock(rod, start, end, mask, [](double, double, double, double) { return true; });
+    return;
+  case CyclicType: {
+    const double bp = LPs::BP[FZorder - 1];
+    EvaluateFZBlock(rod, start, end, mask, [bp](double, double, double z, double t) {
+      const bool finite = t != k_Infinity;
+      return (finite & (std::fabs(z * t) <= bp)) | (!finite & (z == 0.0));
+    });
+    return;
+  }
+  case DihedralType: {
+    const double bp = LPs::BP[FZorder - 1];
+    switch(FZorder)
+    {
+    case TwoFoldAxisOrder:
+    case FourFoldAxisOrder: {
+      const bool fourFold = FZorder == FourFoldAxisOrder;
+      EvaluateFZBlock(rod, start, end, mask, [bp, fourFold](double x, double y, double z, double t) {
+        const double r0 = x * t;
+        const double r1v = y * t;
+        bool inside = (t != k_Infinity) & (std::fabs(z * t) <= bp) & (std::fabs(r0) <= r1) & (std::fabs(r1v) <= r1);
+        inside = inside & (!fourFold | ((LPs::r22 * std::fabs(r0 + r1v) <= r1) & (LPs::r22 * std::fabs(r0 - r1v) <= r1)));
+        return inside;
+      });
+      return;
+    }
+    case ThreeFoldAxisOrder:
+      EvaluateFZBlock(rod, start, end, mask, [bp](double x, double y, double z, double t) {
+        const double r0 = x * t;
+        const double r1v = y * t;
+        return (t != k_Infinity) & (std::fabs(z * t) <= bp) & (std::fabs(LPs::srt * r0 + 0.50 * r1v) <= r1) & (std::fabs(LPs::srt * r0 - 0.50 * r1v) <= r1) & (std::fabs(r1v) <= r1);
+      });
+      return;
+    case SixFoldAxisOrder:
+      EvaluateFZBlock(rod, start, end, mask, [bp](double x, double y, double z, double t) {
+        const double r0 = x * t;
+        const double r1v = y * t;
+        return (t != k_Infinity) & (std::fabs(z * t) <= bp) & (std::fabs(0.50 * r0 + LPs::srt * r1v) <= r1) & (std::fabs(LPs::srt * r0 + 0.50 * r1v) <= r1) &
+               (std::fabs(LPs::srt * r0 - 0.50 * r1v) <= r1) & (std::fabs(0.50 * r0 - LPs::srt * r1v) <= r1) & (std::fabs(r1v) <= r1) & (std::fabs(r0) <= r1);
+      });
+      return;
+    default:
+      break;
+    }
+    break;
+  }
+  case TetrahedralType:
+  case OctahedralType: {
+    // The primary cube planes are only needed for the octahedral case
+    const double cubeLimit = (FZtype == OctahedralType) ? LPs::BP[3] : k_Infinity;
+    EvaluateFZBlock(rod, start, end, mask, [cubeLimit](double x, double y, double z, double t) {
+      const double a = std::fabs(x * t);
+      const double b = std::fabs(y * t);
+      const double c = std::fabs(z * t);
+      return (t != k_Infinity) & (a <= cubeLimit) & (b <= cubeLimit) & (c <= cubeLimit) & ((a + b + c) <= r1);
+    });
+    return;
+  }
+  default:
+    break;
+  }
+  EvaluateFZBlock(rod, start, end, mask, [](double, double, double, double) { return false; });
+}
+
+/**
+ * @brief Evaluates the FZ test for a range of 64 bit mask words in parallel
+ */
+class IsinsideFZImpl
+{
+public:
+  IsinsideFZImpl(int32_t FZtype, int32_t FZorder, const RodriguesSoA& rod, size_t count, uint64_t* mask)
+  : m_FZType(FZtype)
+  , m_FZOrder(FZorder)
+  , m_Rodrigues(rod)
+  , m_Count(count)
+  , m_Mask(mask)
+  {
+  }
+  virtual ~IsinsideFZImpl() = default;
+
+  void evaluate(size_t startWord, size_t endWord) const
+  {
+    EvaluateFZMask(m_FZType, m_FZOrder, m_Rodrigues, startWord * 64, std::min(endWord * 64, m_Count), m_Mask);
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    evaluate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t m_FZType;
+  int32_t m_FZOrder;
+  RodriguesSoA m_Rodrigues;
+  size_t m_Count;
+  uint64_t* m_Mask;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -357,6 +526,44 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
   return res;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SO3Sampler::GetFZType(int pgnum)
+{
+  return FZtarray[pgnum - 1];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SO3Sampler::GetFZOrder(int pgnum)
+{
+  return FZoarray[pgnum - 1];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::IsinsideFZ(const double* rodrigues, size_t count, int pgnum, uint64_t* mask)
+{
+  const RodriguesSoA rod = {rodrigues, rodrigues + count, rodrigues + 2 * count, rodrigues + 3 * count};
+  const size_t numWords = (count + 63) / 64;
+  IsinsideFZImpl impl(FZtarray[pgnum - 1], FZoarray[pgnum - 1], rod, count, mask);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numWords, 256), impl, tbb::auto_partitioner());
+#else
+  impl.evaluate(0, numWords);
+#endif
+
+  size_t numInside = 0;
+  for(size_t w = 0; w < numWords; w++)
+  {
+    numInside += std::bitset<64>(mask[w]).count();
+  }
+  return numInside;
+}
+
 //--------------------------------------------------------------------------
 //
 // FUNCTION: SampleRFZ
@@ -457,6 +664,174 @@ SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps, int pgnum
   return FZlist;
 }
 
+namespace
+{
+// Number of slabs that the streaming version generates before handing them to the callback
+const size_t k_SlabsPerBatch = 16;
+
+/**
+ * @brief Generates the points of the Rodrigues FZ sampling for a range of slabs of
+ * constant cubochoric x. Each slab is written into its own buffer in a structure of
+ * arrays layout so that the slabs can be delivered or concatenated in order.
+ */
+class SampleRFZSlabImpl
+{
+public:
+  SampleRFZSlabImpl(int nsteps, int pgnum, int firstSlab, std::vector<std::vector<double>>& slabs)
+  : m_NSteps(nsteps)
+  , m_FZType(FZtarray[pgnum - 1])
+  , m_FZOrder(FZoarray[pgnum - 1])
+  , m_FirstSlab(firstSlab)
+  , m_Slabs(slabs)
+  {
+    m_Delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  }
+  virtual ~SampleRFZSlabImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    using CubochoricType = Cubochoric3<double>;
+    using RodriguesType = Rodrigues4<double>;
+
+    // One row of constant x and y is converted into a structure of arrays buffer and
+    // then tested against the FZ as a batch.
+    const size_t rowSize = static_cast<size_t>(2 * m_NSteps);
+    std::vector<double> row(4 * rowSize);
+    std::vector<uint64_t> rowMask((rowSize + 63) / 64);
+    const RodriguesSoA rowRod = {row.data(), row.data() + rowSize, row.data() + 2 * rowSize, row.data() + 3 * rowSize};
+
+    std::vector<double> points;
+    for(size_t s = start; s < end; s++)
+    {
+      const double x = static_cast<double>(m_FirstSlab + static_cast<int>(s) - m_NSteps) * m_Delta;
+      points.clear();
+      for(int j = -m_NSteps; j < m_NSteps; j++)
+      {
+        const double y = static_cast<double>(j) * m_Delta;
+        for(size_t k = 0; k < rowSize; k++)
+        {
+          const double z = static_cast<double>(static_cast<int>(k) - m_NSteps) * m_Delta;
+          CubochoricType cu(x, y, z);
+          RodriguesType rod = OrientationTransformation::cu2ro<CubochoricType, RodriguesType>(cu);
+          for(size_t c = 0; c < 4; c++)
+          {
+            row[c * rowSize + k] = rod[c];
+          }
+        }
+        EvaluateFZMask(m_FZType, m_FZOrder, rowRod, 0, rowSize, rowMask.data());
+        for(size_t k = 0; k < rowSize; k++)
+        {
+          if((rowMask[k / 64] >> (k % 64)) & 1u)
+          {
+            for(size_t c = 0; c < 4; c++)
+            {
+              points.push_back(row[c * rowSize + k]);
+            }
+          }
+        }
+      }
+
+      // Transpose the slab into a structure of arrays layout
+      const size_t count = points.size() / 4;
+      std::vector<double>& slab = m_Slabs[s];
+      slab.resize(points.size());
+      for(size_t p = 0; p < count; p++)
+      {
+        for(size_t c = 0; c < 4; c++)
+        {
+          slab[c * count + p] = points[p * 4 + c];
+        }
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int m_NSteps;
+  int32_t m_FZType;
+  int32_t m_FZOrder;
+  int m_FirstSlab;
+  double m_Delta = 0.0;
+  std::vector<std::vector<double>>& m_Slabs;
+};
+
+// -----------------------------------------------------------------------------
+void GenerateSlabs(int nsteps, int pgnum, int firstSlab, std::vector<std::vector<double>>& slabs)
+{
+  SampleRFZSlabImpl impl(nsteps, pgnum, firstSlab, slabs);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, slabs.size(), 1), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, slabs.size());
+#endif
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdLib::DoubleArrayType::Pointer SO3Sampler::SampleRFZToArray(int nsteps, int pgnum)
+{
+  std::vector<std::vector<double>> slabs(static_cast<size_t>(2 * nsteps));
+  GenerateSlabs(nsteps, pgnum, 0, slabs);
+
+  size_t total = 0;
+  for(const auto& slab : slabs)
+  {
+    total += slab.size() / 4;
+  }
+
+  EbsdLib::DoubleArrayType::Pointer rodrigues = EbsdLib::DoubleArrayType::CreateArray(total * 4, "Rodrigues", true);
+  if(total == 0)
+  {
+    return rodrigues;
+  }
+  double* out = rodrigues->getPointer(0);
+  size_t offset = 0;
+  for(auto& slab : slabs)
+  {
+    const size_t count = slab.size() / 4;
+    for(size_t c = 0; c < 4; c++)
+    {
+      std::copy(slab.begin() + c * count, slab.begin() + (c + 1) * count, out + c * total + offset);
+    }
+    offset += count;
+    std::vector<double>().swap(slab);
+  }
+  return rodrigues;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::SampleRFZ(int nsteps, int pgnum, const RodriguesBlockCallback& callback)
+{
+  const size_t numSlabs = static_cast<size_t>(2 * nsteps);
+  std::vector<std::vector<double>> slabs;
+  size_t total = 0;
+  for(size_t firstSlab = 0; firstSlab < numSlabs; firstSlab += k_SlabsPerBatch)
+  {
+    slabs.resize(std::min(k_SlabsPerBatch, numSlabs - firstSlab));
+    GenerateSlabs(nsteps, pgnum, static_cast<int>(firstSlab), slabs);
+    for(const auto& slab : slabs)
+    {
+      const size_t count = slab.size() / 4;
+      if(count > 0)
+      {
+        callback(slab.data(), count);
+      }
+      total += count;
+    }
+  }
+  return total;
+}
+
 // -----------------------------------------------------------------------------
 SO3Sampler::Pointer SO3Sampler::NullPointer()
 {
@@ -31,10 +31,13 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
 
+#include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
@@ -71,9 +74,41 @@ public:
    */
   using OrientationListArrayType = std::list<OrientationType>;
 
+  /**
+   * @brief Receives a block of sampled Rodrigues vectors. The block is stored in a
+   * structure of arrays layout: rodrigues[c * count + i] is component c of the i'th
+   * vector where the components are (n1, n2, n3, tan(w/2)).
+   */
+  using RodriguesBlockCallback = std::function<void(const double* rodrigues, size_t count)>;
+
   // sampler routine
   OrientationListArrayType SampleRFZ(int nsteps, int pgnum);
 
+  /**
+   * @brief Generates the same uniform sampling of the Rodrigues fundamental zone as
+   * SampleRFZ() but stores the result in a single contiguous array. The grid is
+   * generated in parallel, one slab of constant cubochoric x at a time, and the
+   * slabs are concatenated in order so the points appear in exactly the same order
+   * as the list version.
+   * @param nsteps Number of grid steps along each semi edge of the cubochoric cube
+   * @param pgnum Point group number
+   * @return Array with 4 * N values in a structure of arrays layout: all N values of
+   * n1, then all of n2, n3 and finally tan(w/2).
+   */
+  EbsdLib::DoubleArrayType::Pointer SampleRFZToArray(int nsteps, int pgnum);
+
+  /**
+   * @brief Generates the uniform sampling of the Rodrigues fundamental zone and hands
+   * the points to the callback in blocks instead of storing all of them. Blocks are
+   * generated in parallel but delivered on the calling thread in the same order as
+   * SampleRFZ() so that the memory used is bounded by a small number of slabs.
+   * @param nsteps Number of grid steps along each semi edge of the cubochoric cube
+   * @param pgnum Point group number
+   * @param callback Receives each block of points
+   * @return Total number of points inside the fundamental zone
+   */
+  size_t SampleRFZ(int nsteps, int pgnum, const RodriguesBlockCallback& callback);
+
   /**
    * @brief IsinsideFZ
    * @param rod
@@ -83,6 +118,33 @@ public:
    */
   bool IsinsideFZ(double* rod, int FZtype, int FZorder);
 
+  /**
+   * @brief Tests a batch of Rodrigues vectors against the fundamental zone of a point
+   * group. The point group dependent branch is taken once for the whole batch and the
+   * plane tests are evaluated without branches so that the loop vectorizes. Large
+   * batches are split across threads.
+   * @param rodrigues 4 * count values in a structure of arrays layout:
+   * rodrigues[c * count + i] is component c of the i'th vector (n1, n2, n3, tan(w/2)).
+   * @param count Number of vectors
+   * @param pgnum Point group number
+   * @param mask Output with (count + 63) / 64 words. Bit (i % 64) of mask[i / 64] is set
+   * when the i'th vector is inside the FZ.
+   * @return Number of vectors inside the FZ
+   */
+  size_t IsinsideFZ(const double* rodrigues, size_t count, int pgnum, uint64_t* mask);
+
+  /**
+   * @brief Returns the FZ type that IsinsideFZ() expects for a point group number
+   * @param pgnum Point group number
+   */
+  static int GetFZType(int pgnum);
+
+  /**
+   * @brief Returns the FZ order that IsinsideFZ() expects for a point group number
+   * @param pgnum Point group number
+   */
+  static int GetFZOrder(int pgnum);
+
   /**
    * @brief insideCubicFZ
    * @param rod
@@ -29,9 +29,17 @@ set(EbsdLib_${DIR_NAME}_SRCS
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/TetragonalLowOps.cpp
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/TriclinicOps.cpp
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/MonoclinicOps.cpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/IPFColorKernels.hpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OdfGrid.hpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/SymmetryKernels.hpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/SymmetryKernels.cpp
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/SO3Sampler.cpp
 )
 
+# The batched symmetry kernels rely on the compiler vectorizing its loops
+set_source_files_properties(${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/SymmetryKernels.cpp
+  PROPERTIES COMPILE_OPTIONS "${EbsdLib_BATCH_KERNEL_FLAGS}")
+
 #cmp_IDE_SOURCE_PROPERTIES("LaueOps" "${EbsdLib${DIR_NAME}HDRS}" "${EbsdLib${DIR_NAME}SRCS}" "0")
 if(EbsdLib_INSTALL_FILES)
   install(FILES ${EbsdLib_${DIR_NAME}_HDRS}
@@ -0,0 +1,335 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SymmetryKernels.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/Math/SimdMath.hpp"
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace SymmetryKernels
+{
+namespace
+{
+constexpr size_t k_BlockSize = 64;
+
+/**
+ * @brief A block of quaternions in structure of arrays layout together with the symmetry
+ * operator selected for each of them. Keeping all the arrays in one object lets the
+ * compiler see that they do not overlap.
+ */
+struct QuatBlock
+{
+  alignas(64) float x[k_BlockSize];
+  alignas(64) float y[k_BlockSize];
+  alignas(64) float z[k_BlockSize];
+  alignas(64) float w[k_BlockSize];
+  alignas(64) float sx[k_BlockSize];
+  alignas(64) float sy[k_BlockSize];
+  alignas(64) float sz[k_BlockSize];
+  alignas(64) float sw[k_BlockSize];
+};
+
+/**
+ * @brief Finds for each quaternion q of a block the symmetry operator s for which s * q
+ * has the largest |w|. Only the scalar part of each candidate is computed. The strict
+ * comparison keeps the first operator on ties. The loop over the operators is the inner
+ * loop so that the running best stays in registers and the selects vectorize across the
+ * quaternions of the block.
+ */
+template <size_t N>
+void SelectSymOps(const SymOpTable<N>& symOps, QuatBlock& block, size_t count)
+{
+  EBSD_SIMD_LOOP
+  for(size_t i = 0; i < count; i++)
+  {
+    float bestW = -1.0f;
+    float bestSx = 0.0f;
+    float bestSy = 0.0f;
+    float bestSz = 0.0f;
+    float bestSw = 1.0f;
+    for(size_t s = 0; s < N; s++)
+    {
+      const float w = SimdMath::abs(block.w[i] * symOps[s][3] - block.x[i] * symOps[s][0] - block.y[i] * symOps[s][1] - block.z[i] * symOps[s][2]);
+      const bool better = w > bestW;
+      bestW = better ? w : bestW;
+      bestSx = better ? symOps[s][0] : bestSx;
+      bestSy = better ? symOps[s][1] : bestSy;
+      bestSz = better ? symOps[s][2] : bestSz;
+      bestSw = better ? symOps[s][3] : bestSw;
+    }
+    block.sx[i] = bestSx;
+    block.sy[i] = bestSy;
+    block.sz[i] = bestSz;
+    block.sw[i] = bestSw;
+  }
+}
+} // namespace
+
+/**
+ * @brief This is the functor that the TBB classes use to compute the misorientations
+ * of a range of quaternion pairs.
+ *
+ * For each pair qr = q1 * conjugate(q2) is formed and the operator s with the largest
+ * |w| of s * qr is found. Only the scalar part of each candidate is computed, so the
+ * search needs no trig. Only the winning candidate is converted to an axis angle. The
+ * pairs are processed in blocks in structure of arrays layout so that every loop
+ * vectorizes.
+ */
+template <size_t N>
+class CalculateMisorientationsImpl
+{
+public:
+  static constexpr size_t k_BlockSize = SymmetryKernels::k_BlockSize;
+
+  CalculateMisorientationsImpl(const SymOpTable<N>& symOps, const float* q1, const float* q2, float* axisAngleOut)
+  : m_SymOps(symOps)
+  , m_Q1(q1)
+  , m_Q2(q2)
+  , m_AxisAngleOut(axisAngleOut)
+  {
+  }
+  virtual ~CalculateMisorientationsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t blockStart = start; blockStart < end; blockStart += k_BlockSize)
+    {
+      calculateBlock(blockStart, std::min(k_BlockSize, end - blockStart));
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const SymOpTable<N>& m_SymOps;
+  const float* m_Q1 = nullptr;
+  const float* m_Q2 = nullptr;
+  float* m_AxisAngleOut = nullptr;
+
+  void calculateBlock(size_t blockStart, size_t count) const
+  {
+    QuatBlock qr;
+
+    const float* q1 = m_Q1 + blockStart * 4;
+    const float* q2 = m_Q2 + blockStart * 4;
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < count; i++)
+    {
+      // qr = q1 * conjugate(q2)
+      const float ax = q1[i * 4];
+      const float ay = q1[i * 4 + 1];
+      const float az = q1[i * 4 + 2];
+      const float aw = q1[i * 4 + 3];
+      const float bx = -q2[i * 4];
+      const float by = -q2[i * 4 + 1];
+      const float bz = -q2[i * 4 + 2];
+      const float bw = q2[i * 4 + 3];
+      qr.x[i] = bx * aw + bw * ax + bz * ay - by * az;
+      qr.y[i] = by * aw + bw * ay + bx * az - bz * ax;
+      qr.z[i] = bz * aw + bw * az + by * ax - bx * ay;
+      qr.w[i] = bw * aw - bx * ax - by * ay - bz * az;
+    }
+
+    // The smallest misorientation angle belongs to the candidate with the largest |w|.
+    SelectSymOps<N>(m_SymOps, qr, count);
+
+    float* out = m_AxisAngleOut + blockStart * 4;
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < count; i++)
+    {
+      // qc = s * qr, flipped so that w >= 0
+      const float sx = qr.sx[i];
+      const float sy = qr.sy[i];
+      const float sz = qr.sz[i];
+      const float sw = qr.sw[i];
+      float x = qr.x[i] * sw + qr.w[i] * sx + qr.z[i] * sy - qr.y[i] * sz;
+      float y = qr.y[i] * sw + qr.w[i] * sy + qr.x[i] * sz - qr.z[i] * sx;
+      float z = qr.z[i] * sw + qr.w[i] * sz + qr.y[i] * sx - qr.x[i] * sy;
+      float w = qr.w[i] * sw - qr.x[i] * sx - qr.y[i] * sy - qr.z[i] * sz;
+      const float sign = w < 0.0f ? -1.0f : 1.0f;
+      x *= sign;
+      y *= sign;
+      z *= sign;
+      w *= sign;
+      const float sinHalfAngle = SimdMath::sqrt(x * x + y * y + z * z);
+      // atan2 keeps full precision for small angles where acos(w) does not
+      const float angle = 2.0f * SimdMath::atan2(sinHalfAngle, w);
+      const bool isIdentity = sinHalfAngle == 0.0f || angle == 0.0f;
+      const float invSin = 1.0f / (isIdentity ? 1.0f : sinHalfAngle);
+      out[i * 4] = isIdentity ? 0.0f : x * invSin;
+      out[i * 4 + 1] = isIdentity ? 0.0f : y * invSin;
+      out[i * 4 + 2] = isIdentity ? 1.0f : z * invSin;
+      out[i * 4 + 3] = isIdentity ? 0.0f : angle;
+    }
+  }
+};
+
+/**
+ * @brief This is the functor that the TBB classes use to reduce a range of quaternions
+ * into the fundamental zone.
+ *
+ * For each quaternion q the operator s with the largest |w| of s * q is found and
+ * s * q, flipped so that w >= 0, is written out. Each block is copied into structure
+ * of arrays layout before anything is written so the input and output may alias.
+ */
+template <size_t N>
+class GetFZQuatsImpl
+{
+public:
+  static constexpr size_t k_BlockSize = SymmetryKernels::k_BlockSize;
+
+  GetFZQuatsImpl(const SymOpTable<N>& symOps, const float* in, float* out)
+  : m_SymOps(symOps)
+  , m_In(in)
+  , m_Out(out)
+  {
+  }
+  virtual ~GetFZQuatsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t blockStart = start; blockStart < end; blockStart += k_BlockSize)
+    {
+      calculateBlock(blockStart, std::min(k_BlockSize, end - blockStart));
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const SymOpTable<N>& m_SymOps;
+  const float* m_In = nullptr;
+  float* m_Out = nullptr;
+
+  void calculateBlock(size_t blockStart, size_t count) const
+  {
+    QuatBlock q;
+
+    const float* in = m_In + blockStart * 4;
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < count; i++)
+    {
+      q.x[i] = in[i * 4];
+      q.y[i] = in[i * 4 + 1];
+      q.z[i] = in[i * 4 + 2];
+      q.w[i] = in[i * 4 + 3];
+    }
+
+    SelectSymOps<N>(m_SymOps, q, count);
+
+    float* out = m_Out + blockStart * 4;
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < count; i++)
+    {
+      // qc = s * q, flipped so that w >= 0
+      const float sx = q.sx[i];
+      const float sy = q.sy[i];
+      const float sz = q.sz[i];
+      const float sw = q.sw[i];
+      const float x = q.x[i] * sw + q.w[i] * sx + q.z[i] * sy - q.y[i] * sz;
+      const float y = q.y[i] * sw + q.w[i] * sy + q.x[i] * sz - q.z[i] * sx;
+      const float z = q.z[i] * sw + q.w[i] * sz + q.y[i] * sx - q.x[i] * sy;
+      const float w = q.w[i] * sw - q.x[i] * sx - q.y[i] * sy - q.z[i] * sz;
+      const float sign = w < 0.0f ? -1.0f : 1.0f;
+      out[i * 4] = x * sign;
+      out[i * 4 + 1] = y * sign;
+      out[i * 4 + 2] = z * sign;
+      out[i * 4 + 3] = w * sign;
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+template <size_t N>
+void CalculateMisorientations(const SymOpTable<N>& symOps, const float* q1, const float* q2, size_t n, float* axisAngleOut)
+{
+  using ImplType = CalculateMisorientationsImpl<N>;
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n, ImplType::k_BlockSize), ImplType(symOps, q1, q2, axisAngleOut), tbb::auto_partitioner());
+#else
+  ImplType serial(symOps, q1, q2, axisAngleOut);
+  serial.convert(0, n);
+#endif
+}
+
+// The number of symmetry operators of each of the Laue classes
+template void CalculateMisorientations<1>(const SymOpTable<1>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<2>(const SymOpTable<2>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<3>(const SymOpTable<3>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<4>(const SymOpTable<4>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<6>(const SymOpTable<6>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<8>(const SymOpTable<8>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<12>(const SymOpTable<12>&, const float*, const float*, size_t, float*);
+template void CalculateMisorientations<24>(const SymOpTable<24>&, const float*, const float*, size_t, float*);
+
+// -----------------------------------------------------------------------------
+template <size_t N>
+void GetFZQuats(const SymOpTable<N>& symOps, const float* in, size_t n, float* out)
+{
+  using ImplType = GetFZQuatsImpl<N>;
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n, ImplType::k_BlockSize), ImplType(symOps, in, out), tbb::auto_partitioner());
+#else
+  ImplType serial(symOps, in, out);
+  serial.convert(0, n);
+#endif
+}
+
+template void GetFZQuats<1>(const SymOpTable<1>&, const float*, size_t, float*);
+template void GetFZQuats<2>(const SymOpTable<2>&, const float*, size_t, float*);
+template void GetFZQuats<3>(const SymOpTable<3>&, const float*, size_t, float*);
+template void GetFZQuats<4>(const SymOpTable<4>&, const float*, size_t, float*);
+template void GetFZQuats<6>(const SymOpTable<6>&, const float*, size_t, float*);
+template void GetFZQuats<8>(const SymOpTable<8>&, const float*, size_t, float*);
+template void GetFZQuats<12>(const SymOpTable<12>&, const float*, size_t, float*);
+template void GetFZQuats<24>(const SymOpTable<24>&, const float*, size_t, float*);
+} // namespace SymmetryKernels
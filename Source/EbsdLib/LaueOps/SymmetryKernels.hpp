@@ -0,0 +1,241 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+
+/**
+ * @brief The SymmetryKernels namespace holds the symmetry operator tables and the kernels
+ * that the LaueOps classes use to reduce orientations into the fundamental zone and to
+ * compute misorientations. The number of symmetry operators is a template argument so
+ * the loops over the operators are unrolled for each Laue class and the tables can be
+ * constexpr arrays instead of heap allocated vectors. The reduction kernels also accept the
+ * std::vector tables of the older LaueOps interface.
+ */
+namespace SymmetryKernels
+{
+/**
+ * @brief Symmetry operators stored as <x,y,z,w> double quaternions
+ */
+template <size_t N>
+using QuatTable = std::array<std::array<double, 4>, N>;
+
+/**
+ * @brief Symmetry operators stored as 3 component Rodrigues vectors
+ */
+template <size_t N>
+using RodTable = std::array<std::array<double, 3>, N>;
+
+/**
+ * @brief Symmetry operators stored as <x,y,z,w> float quaternions
+ */
+template <size_t N>
+using SymOpTable = std::array<std::array<float, 4>, N>;
+
+/**
+ * @brief Creates the float table of symmetry operators that the batch kernels use
+ * @param quatSym The symmetry operators of the Laue class
+ */
+template <size_t N>
+constexpr SymOpTable<N> ToSymOpTable(const QuatTable<N>& quatSym)
+{
+  SymOpTable<N> table = {};
+  for(size_t i = 0; i < N; i++)
+  {
+    for(size_t j = 0; j < 4; j++)
+    {
+      table[i][j] = static_cast<float>(quatSym[i][j]);
+    }
+  }
+  return table;
+}
+
+/**
+ * @brief Creates the symmetry operators as Quaternion objects for the code paths that
+ * still take a std::vector<QuatD>.
+ * @param quatSym The symmetry operators of the Laue class
+ */
+template <size_t N>
+std::vector<QuatD> ToQuaternions(const QuatTable<N>& quatSym)
+{
+  std::vector<QuatD> quats;
+  quats.reserve(N);
+  for(const auto& q : quatSym)
+  {
+    quats.emplace_back(q[0], q[1], q[2], q[3]);
+  }
+  return quats;
+}
+
+/**
+ * @brief Finds the symmetric equivalent of a Rodrigues vector that lies closest to the origin.
+ * @param rodSym The symmetry operators of the Laue class, a RodTable or a std::vector<OrientationD>
+ * @param inRod Rodrigues vector stored as <n1,n2,n3,tan(w/2)>
+ * @return The equivalent Rodrigues vector stored as <n1,n2,n3,tan(w/2)>
+ */
+template <typename RodSymTable>
+OrientationType RodNearestOrigin(const RodSymTable& rodSym, const OrientationType& inRod)
+{
+  // Turn into an actual 3 Comp Rodrigues Vector
+  const double r0 = inRod[0] * inRod[3];
+  const double r1 = inRod[1] * inRod[3];
+  const double r2 = inRod[2] * inRod[3];
+  double smallestdist = 100000000.0;
+  double out0 = 0.0;
+  double out1 = 0.0;
+  double out2 = 0.0;
+  for(size_t i = 0; i < rodSym.size(); i++)
+  {
+    const double denom = 1 - (r0 * rodSym[i][0] + r1 * rodSym[i][1] + r2 * rodSym[i][2]);
+    const double rc1 = (r0 + rodSym[i][0] - (r1 * rodSym[i][2] - r2 * rodSym[i][1])) / denom;
+    const double rc2 = (r1 + rodSym[i][1] - (r2 * rodSym[i][0] - r0 * rodSym[i][2])) / denom;
+    const double rc3 = (r2 + rodSym[i][2] - (r0 * rodSym[i][1] - r1 * rodSym[i][0])) / denom;
+    const double dist = rc1 * rc1 + rc2 * rc2 + rc3 * rc3;
+    if(dist < smallestdist)
+    {
+      smallestdist = dist;
+      out0 = rc1;
+      out1 = rc2;
+      out2 = rc3;
+    }
+  }
+  OrientationType outRod(4, 0.0);
+  const double mag = std::sqrt(out0 * out0 + out1 * out1 + out2 * out2);
+  if(mag == 0.0)
+  {
+    outRod[3] = std::numeric_limits<double>::infinity();
+  }
+  else
+  {
+    outRod[0] = out0 / mag;
+    outRod[1] = out1 / mag;
+    outRod[2] = out2 / mag;
+    outRod[3] = mag;
+  }
+  return outRod;
+}
+
+/**
+ * @brief Finds the symmetric equivalent of q2 that lies closest to q1.
+ * @param quatSym The symmetry operators of the Laue class, a QuatTable or a std::vector<QuatD>
+ * @param q1 The reference quaternion
+ * @param q2 The quaternion to reduce
+ * @return The equivalent of q2 with w >= 0
+ */
+template <typename QuatSymTable>
+QuatD NearestQuat(const QuatSymTable& quatSym, const QuatD& q1, const QuatD& q2)
+{
+  double smallestdist = 1000000.0;
+  QuatD qmax;
+  for(size_t i = 0; i < quatSym.size(); i++)
+  {
+    QuatD qc = QuatD(quatSym[i][0], quatSym[i][1], quatSym[i][2], quatSym[i][3]) * q2;
+    if(qc.w() < 0)
+    {
+      qc.negate();
+    }
+    const double dist = 1 - (qc.w() * q1.w() + qc.x() * q1.x() + qc.y() * q1.y() + qc.z() * q1.z());
+    if(dist < smallestdist)
+    {
+      smallestdist = dist;
+      qmax = qc;
+    }
+  }
+  if(qmax.w() < 0)
+  {
+    qmax.negate();
+  }
+  return qmax;
+}
+
+/**
+ * @brief Finds the symmetric equivalent of qr that lies closest to the identity, i.e. the
+ * equivalent in the fundamental zone.
+ * @param quatSym The symmetry operators of the Laue class, a QuatTable or a std::vector<QuatD>
+ * @param qr The quaternion to reduce
+ * @return The equivalent of qr with w >= 0
+ */
+template <typename QuatSymTable>
+QuatD QuatNearestOrigin(const QuatSymTable& quatSym, const QuatD& qr)
+{
+  double smallestdist = 1000000.0;
+  QuatD qmax;
+  for(size_t i = 0; i < quatSym.size(); i++)
+  {
+    const QuatD qc = QuatD(quatSym[i][0], quatSym[i][1], quatSym[i][2], quatSym[i][3]) * qr;
+    const double dist = 1 - (qc.w() * qc.w());
+    if(dist < smallestdist)
+    {
+      smallestdist = dist;
+      qmax = qc;
+    }
+  }
+  if(qmax.w() < 0)
+  {
+    qmax.negate();
+  }
+  return qmax;
+}
+
+/**
+ * @brief Computes the misorientations between n pairs of quaternions. The kernel is
+ * instantiated in SymmetryKernels.cpp for the operator counts of the Laue classes.
+ * @param symOps The symmetry operators of the Laue class
+ * @param q1 n quaternions stored as <x,y,z,w>
+ * @param q2 n quaternions stored as <x,y,z,w>
+ * @param n The number of pairs
+ * @param axisAngleOut n axis angles stored as <n1,n2,n3,angle>
+ */
+template <size_t N>
+void CalculateMisorientations(const SymOpTable<N>& symOps, const float* q1, const float* q2, size_t n, float* axisAngleOut);
+
+/**
+ * @brief Reduces n quaternions into the fundamental zone. This is the batch version of
+ * QuatNearestOrigin. The kernel is instantiated in SymmetryKernels.cpp for the operator
+ * counts of the Laue classes.
+ * @param symOps The symmetry operators of the Laue class
+ * @param in n quaternions stored as <x,y,z,w>
+ * @param n The number of quaternions
+ * @param out n quaternions stored as <x,y,z,w> with w >= 0. May be the same as 'in'.
+ */
+template <size_t N>
+void GetFZQuats(const SymOpTable<N>& symOps, const float* in, size_t n, float* out);
+} // namespace SymmetryKernels
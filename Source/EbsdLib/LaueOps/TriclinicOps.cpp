@@ -47,9 +47,10 @@
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/IPFColorKernels.hpp"
+#include "EbsdLib/LaueOps/SymmetryKernels.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
 namespace Triclinic
@@ -59,8 +60,7 @@ static const std::array<size_t, 3> OdfNumBins = {72, 72, 72}; // Represents a 5D
 static const std::array<double, 3> OdfDimInitValue = {std::pow((0.75 * ((EbsdLib::Constants::k_PiD)-std::sin((EbsdLib::Constants::k_PiD)))), (1.0 / 3.0)),
                                                       std::pow((0.75 * ((EbsdLib::Constants::k_PiD)-std::sin((EbsdLib::Constants::k_PiD)))), (1.0 / 3.0)),
                                                       std::pow((0.75 * ((EbsdLib::Constants::k_PiD)-std::sin((EbsdLib::Constants::k_PiD)))), (1.0 / 3.0))};
-static const std::array<double, 3> OdfDimStepValue = {OdfDimInitValue[0] / static_cast<double>(OdfNumBins[0] / 2), OdfDimInitValue[1] / static_cast<double>(OdfNumBins[1] / 2),
-                                                      OdfDimInitValue[2] / static_cast<double>(OdfNumBins[2] / 2)};
+static const OdfGrid k_OdfGrid(OdfNumBins, OdfDimInitValue);
 
 static const int symSize0 = 2;
 static const int symSize1 = 2;
@@ -71,12 +71,24 @@ static const int k_MdfSize = 373248;
 static const int k_SymOpsCount = 1;
 static const int k_NumMdfBins = 36;
 
-static const std::vector<QuatD> QuatSym = {QuatD(0.000000000, 0.000000000, 0.000000000, 1.000000000)};
+static constexpr SymmetryKernels::QuatTable<k_SymOpsCount> QuatSymTable = {{{0.000000000, 0.000000000, 0.000000000, 1.000000000}}};
+static const std::vector<QuatD> QuatSym = SymmetryKernels::ToQuaternions(QuatSymTable);
+static constexpr SymmetryKernels::SymOpTable<k_SymOpsCount> QuatSymF = SymmetryKernels::ToSymOpTable(QuatSymTable);
 
-static const std::vector<OrientationD> RodSym = {{0.0, 0.0, 0.0}};
+static constexpr SymmetryKernels::RodTable<k_SymOpsCount> RodSym = {{{0.0, 0.0, 0.0}}};
 
 static const double MatSym[k_SymOpsCount][3][3] = {{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
 
+/**
+ * @brief Color key of the standard stereographic triangle
+ */
+struct IPFColorKey
+{
+  EbsdLib::Rgb operator()(double eta, double chi) const
+  {
+    return IPFColorKernels::SectorColor(eta, chi, 0.0, 180.0);
+  }
+};
 } // namespace Triclinic
 
 // -----------------------------------------------------------------------------
@@ -133,6 +145,14 @@ std::array<size_t, 3> TriclinicOps::getOdfNumBins() const
   return Triclinic::OdfNumBins;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OdfGrid TriclinicOps::getOdfGrid() const
+{
+  return Triclinic::k_OdfGrid;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -159,6 +179,12 @@ OrientationF TriclinicOps::calculateMisorientation(const QuatF& q1f, const QuatF
   return axisAngle;
 }
 
+// -----------------------------------------------------------------------------
+void TriclinicOps::calculateMisorientations(const float* q1, const float* q2, size_t n, float* axisAngleOut) const
+{
+  SymmetryKernels::CalculateMisorientations(Triclinic::QuatSymF, q1, q2, n, axisAngleOut);
+}
+
 QuatD TriclinicOps::getQuatSymOp(int32_t i) const
 {
   return Triclinic::QuatSym[i];
@@ -201,7 +227,7 @@ void TriclinicOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType TriclinicOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(Triclinic::RodSym, rod);
+  return SymmetryKernels::RodNearestOrigin(Triclinic::RodSym, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -211,7 +237,7 @@ OrientationType TriclinicOps::getMDFFZRod(const OrientationType& inRod) const
 {
   throw EbsdLib::method_not_implemented("TriclinicOps::getMDFFZRod not implemented");
 
-  OrientationType rod = LaueOps::_calcRodNearestOrigin(Triclinic::RodSym, inRod);
+  OrientationType rod = SymmetryKernels::RodNearestOrigin(Triclinic::RodSym, inRod);
 
   OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
   /// FIXME: Are we missing code for TriclinicOps MDF FZ Rodrigues calculation?
@@ -224,35 +250,35 @@ OrientationType TriclinicOps::getMDFFZRod(const OrientationType& inRod) const
 // -----------------------------------------------------------------------------
 QuatD TriclinicOps::getNearestQuat(const QuatD& q1, const QuatD& q2) const
 {
-  return _calcNearestQuat(Triclinic::QuatSym, q1, q2);
+  return SymmetryKernels::NearestQuat(Triclinic::QuatSymTable, q1, q2);
 }
 QuatF TriclinicOps::getNearestQuat(const QuatF& q1f, const QuatF& q2f) const
 {
-  return _calcNearestQuat(Triclinic::QuatSym, q1f.to<double>(), q2f.to<double>()).to<float>();
+  return SymmetryKernels::NearestQuat(Triclinic::QuatSymTable, q1f.to<double>(), q2f.to<double>()).to<float>();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int TriclinicOps::getMisoBin(const OrientationType& rod) const
+QuatD TriclinicOps::getFZQuat(const QuatD& qr) const
 {
-  double dim[3];
-  double bins[3];
-  double step[3];
-
-  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
+  return SymmetryKernels::QuatNearestOrigin(Triclinic::QuatSymTable, qr);
+}
 
-  dim[0] = Triclinic::OdfDimInitValue[0];
-  dim[1] = Triclinic::OdfDimInitValue[1];
-  dim[2] = Triclinic::OdfDimInitValue[2];
-  step[0] = Triclinic::OdfDimStepValue[0];
-  step[1] = Triclinic::OdfDimStepValue[1];
-  step[2] = Triclinic::OdfDimStepValue[2];
-  bins[0] = static_cast<double>(Triclinic::OdfNumBins[0]);
-  bins[1] = static_cast<double>(Triclinic::OdfNumBins[1]);
-  bins[2] = static_cast<double>(Triclinic::OdfNumBins[2]);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriclinicOps::getFZQuats(const float* in, size_t n, float* out) const
+{
+  SymmetryKernels::GetFZQuats(Triclinic::QuatSymF, in, n, out);
+}
 
-  return _calcMisoBin(dim, bins, step, ho);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TriclinicOps::getMisoBin(const OrientationType& rod) const
+{
+  return LaueOps::getMisoBin(Triclinic::k_OdfGrid, rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -260,28 +286,7 @@ int TriclinicOps::getMisoBin(const OrientationType& rod) const
 // -----------------------------------------------------------------------------
 OrientationType TriclinicOps::determineEulerAngles(double random[3], int choose) const
 {
-  double init[3];
-  double step[3];
-  int32_t phi[3];
-  double h1, h2, h3;
-
-  init[0] = Triclinic::OdfDimInitValue[0];
-  init[1] = Triclinic::OdfDimInitValue[1];
-  init[2] = Triclinic::OdfDimInitValue[2];
-  step[0] = Triclinic::OdfDimStepValue[0];
-  step[1] = Triclinic::OdfDimStepValue[1];
-  step[2] = Triclinic::OdfDimStepValue[2];
-  phi[0] = static_cast<int32_t>(choose % Triclinic::OdfNumBins[0]);
-  phi[1] = static_cast<int32_t>((choose / Triclinic::OdfNumBins[0]) % Triclinic::OdfNumBins[1]);
-  phi[2] = static_cast<int32_t>(choose / (Triclinic::OdfNumBins[0] * Triclinic::OdfNumBins[1]));
-
-  _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
-  ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  return LaueOps::determineEulerAngles(Triclinic::k_OdfGrid, random, choose);
 }
 
 // -----------------------------------------------------------------------------
@@ -298,28 +303,20 @@ OrientationType TriclinicOps::randomizeEulerAngles(const OrientationType& synea)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-OrientationType TriclinicOps::determineRodriguesVector(double random[3], int choose) const
+OrientationType TriclinicOps::randomizeEulerAngles(const OrientationType& synea, EbsdLib::Philox4x32& generator) const
 {
-  double init[3];
-  double step[3];
-  int32_t phi[3];
-  double h1, h2, h3;
-
-  init[0] = Triclinic::OdfDimInitValue[0];
-  init[1] = Triclinic::OdfDimInitValue[1];
-  init[2] = Triclinic::OdfDimInitValue[2];
-  step[0] = Triclinic::OdfDimStepValue[0];
-  step[1] = Triclinic::OdfDimStepValue[1];
-  step[2] = Triclinic::OdfDimStepValue[2];
-  phi[0] = static_cast<int32_t>(choose % Triclinic::OdfNumBins[0]);
-  phi[1] = static_cast<int32_t>((choose / Triclinic::OdfNumBins[0]) % Triclinic::OdfNumBins[1]);
-  phi[2] = static_cast<int32_t>(choose / (Triclinic::OdfNumBins[0] * Triclinic::OdfNumBins[1]));
+  size_t symOp = getRandomSymmetryOperatorIndex(Triclinic::k_SymOpsCount, generator);
+  QuatD quat = OrientationTransformation::eu2qu<OrientationType, QuatD>(synea);
+  QuatD qc = Triclinic::QuatSym[symOp] * quat;
+  return OrientationTransformation::qu2eu<QuatD, OrientationType>(qc);
+}
 
-  _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
-  ro = getMDFFZRod(ro);
-  return ro;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OrientationType TriclinicOps::determineRodriguesVector(double random[3], int choose) const
+{
+  return LaueOps::determineRodriguesVector(Triclinic::k_OdfGrid, random, choose);
 }
 
 // -----------------------------------------------------------------------------
@@ -327,23 +324,7 @@ OrientationType TriclinicOps::determineRodriguesVector(double random[3], int cho
 // -----------------------------------------------------------------------------
 int TriclinicOps::getOdfBin(const OrientationType& rod) const
 {
-  double dim[3];
-  double bins[3];
-  double step[3];
-
-  OrientationType ho = OrientationTransformation::ro2ho<OrientationType, OrientationType>(rod);
-
-  dim[0] = Triclinic::OdfDimInitValue[0];
-  dim[1] = Triclinic::OdfDimInitValue[1];
-  dim[2] = Triclinic::OdfDimInitValue[2];
-  step[0] = Triclinic::OdfDimStepValue[0];
-  step[1] = Triclinic::OdfDimStepValue[1];
-  step[2] = Triclinic::OdfDimStepValue[2];
-  bins[0] = static_cast<double>(Triclinic::OdfNumBins[0]);
-  bins[1] = static_cast<double>(Triclinic::OdfNumBins[1]);
-  bins[2] = static_cast<double>(Triclinic::OdfNumBins[2]);
-
-  return _calcODFBin(dim, bins, step, ho);
+  return LaueOps::getOdfBin(Triclinic::k_OdfGrid, rod);
 }
 
 void TriclinicOps::getSchmidFactorAndSS(double load[3], double& schmidfactor, double angleComps[2], int& slipsys) const
@@ -555,76 +536,18 @@ EbsdLib::Rgb TriclinicOps::generateIPFColor(double phi1, double phi, double phi2
     phi = phi * EbsdLib::Constants::k_DegToRadD;
     phi2 = phi2 * EbsdLib::Constants::k_DegToRadD;
   }
+  const double refDir[3] = {refDir0, refDir1, refDir2};
+  auto inTriangle = [this](double eta, double chi) { return TriclinicOps::inUnitTriangle(eta, chi); };
+  return IPFColorKernels::GenerateIPFColor(Triclinic::QuatSymTable, getHasInversion(), phi1, phi, phi2, refDir, inTriangle, Triclinic::IPFColorKey());
+}
 
-  double g[3][3];
-  double p[3];
-  double refDirection[3] = {0.0f, 0.0f, 0.0f};
-  double chi = 0.0f, eta = 0.0f;
-  double _rgb[3] = {0.0, 0.0, 0.0};
-
-  OrientationType eu(phi1, phi, phi2);
-  OrientationType om(9); // Reusable for the loop
-  QuatD q1 = OrientationTransformation::eu2qu<OrientationType, QuatD>(eu);
-
-  for(int j = 0; j < Triclinic::k_SymOpsCount; j++)
-  {
-    QuatD qu = getQuatSymOp(j) * q1;
-    OrientationTransformation::qu2om<QuatD, OrientationType>(qu).toGMatrix(g);
-
-    refDirection[0] = refDir0;
-    refDirection[1] = refDir1;
-    refDirection[2] = refDir2;
-    EbsdMatrixMath::Multiply3x3with3x1(g, refDirection, p);
-    EbsdMatrixMath::Normalize3x1(p);
-
-    if(!getHasInversion() && p[2] < 0)
-    {
-      continue;
-    }
-    if(getHasInversion() && p[2] < 0)
-    {
-      p[0] = -p[0], p[1] = -p[1], p[2] = -p[2];
-    }
-    chi = std::acos(p[2]);
-    eta = std::atan2(p[1], p[0]);
-    if(!inUnitTriangle(eta, chi))
-    {
-      continue;
-    }
-
-    break;
-  }
-
-  double etaMin = 0.0;
-  double etaMax = 180.0;
-  double chiMax = 90.0;
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiDeg = chi * EbsdLib::Constants::k_180OverPiD;
-
-  _rgb[0] = 1.0 - chiDeg / chiMax;
-  _rgb[2] = fabs(etaDeg - etaMin) / (etaMax - etaMin);
-  _rgb[1] = 1 - _rgb[2];
-  _rgb[1] *= chiDeg / chiMax;
-  _rgb[2] *= chiDeg / chiMax;
-  _rgb[0] = sqrt(_rgb[0]);
-  _rgb[1] = sqrt(_rgb[1]);
-  _rgb[2] = sqrt(_rgb[2]);
-
-  double max = _rgb[0];
-  if(_rgb[1] > max)
-  {
-    max = _rgb[1];
-  }
-  if(_rgb[2] > max)
-  {
-    max = _rgb[2];
-  }
-
-  _rgb[0] = _rgb[0] / max;
-  _rgb[1] = _rgb[1] / max;
-  _rgb[2] = _rgb[2] / max;
-
-  return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(_rgb[0] * 255), static_cast<int32_t>(_rgb[1] * 255), static_cast<int32_t>(_rgb[2] * 255), 255);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriclinicOps::generateIPFColors(const float* eulers, const size_t* indices, size_t count, const double refDir[3], bool convertDegrees, uint8_t* rgbOut) const
+{
+  auto inTriangle = [this](double eta, double chi) { return TriclinicOps::inUnitTriangle(eta, chi); };
+  IPFColorKernels::GenerateIPFColors(Triclinic::QuatSymTable, getHasInversion(), eulers, indices, count, refDir, convertDegrees, inTriangle, Triclinic::IPFColorKey(), rgbOut);
 }
 
 // -----------------------------------------------------------------------------
@@ -671,102 +594,20 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> TriclinicOps::generatePoleFigure(P
     label2 = config.labels.at(2);
   }
 
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * Triclinic::symSize0, dims, label0 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * Triclinic::symSize1, dims, label1 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * Triclinic::symSize2, dims, label2 + std::string("xyzCoords"), true);
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
+  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image. The
+  // orientations are binned block by block so the sphere coordinates of all the orientations are never stored.
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities =
+      generatePoleFigureIntensities(config, {Triclinic::symSize0, Triclinic::symSize1, Triclinic::symSize2}, {label0, label1, label2});
+  EbsdLib::DoubleArrayType::Pointer intensity001 = intensities[0];
+  EbsdLib::DoubleArrayType::Pointer intensity011 = intensities[1];
+  EbsdLib::DoubleArrayType::Pointer intensity111 = intensities[2];
 
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
+  std::vector<size_t> dims(1, 4);
+  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label0);
+  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label1);
+  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label2);
   std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
   if(config.order.size() == 3)
   {
@@ -782,7 +623,7 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> TriclinicOps::generatePoleFigure(P
   }
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-
+  bool doParallel = true;
   if(doParallel)
   {
     std::shared_ptr<tbb::task_group> g(new tbb::task_group);
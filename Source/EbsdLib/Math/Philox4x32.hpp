@@ -0,0 +1,200 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/**
+ * @file Philox4x32.hpp
+ * @brief The counter based Philox4x32-10 pseudorandom number generator of Salmon et al.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3" (SC11). Each block of 4 random numbers is
+ * a pure function of a 128 bit counter and a 64 bit key, so there is no state to seed or
+ * warm up and any position of any stream can be computed directly.
+ *
+ * The key is the seed. The upper 64 bits of the counter select an independent stream and
+ * the lower 64 bits count the blocks within that stream. Parallel code creates one
+ * generator per chunk of work with the chunk index as the stream, which makes the result
+ * depend only on the seed and the chunking, never on how the chunks are scheduled.
+ */
+
+namespace EbsdLib
+{
+class Philox4x32
+{
+public:
+  using result_type = uint32_t;
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  /**
+   * @brief Creates a generator for one stream of a seed
+   * @param seed The seed. The same seed and stream always produce the same sequence.
+   * @param stream The index of the stream
+   */
+  explicit Philox4x32(uint64_t seed, uint64_t stream = 0)
+  : m_Key({static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)})
+  , m_Counter({0, 0, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)})
+  {
+  }
+
+  static constexpr result_type min()
+  {
+    return 0;
+  }
+
+  static constexpr result_type max()
+  {
+    return 0xFFFFFFFFU;
+  }
+
+  /**
+   * @brief Returns the next 32 random bits. The generator satisfies UniformRandomBitGenerator
+   * so it can also be used with the std distributions.
+   */
+  result_type operator()()
+  {
+    if(m_Index == 4)
+    {
+      m_Block = Generate(m_Counter, m_Key);
+      incrementCounter();
+      m_Index = 0;
+    }
+    return m_Block[m_Index++];
+  }
+
+  /**
+   * @brief Returns the next 64 random bits
+   */
+  uint64_t nextUInt64()
+  {
+    const uint64_t lo = operator()();
+    const uint64_t hi = operator()();
+    return (hi << 32) | lo;
+  }
+
+  /**
+   * @brief Returns a uniform random number in [0,1) with 53 bit resolution
+   */
+  double nextDouble()
+  {
+    return static_cast<double>(nextUInt64() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * @brief Returns a uniform random index in [0,n). n must be smaller than 2^32.
+   */
+  size_t nextIndex(size_t n)
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(operator()()) * static_cast<uint64_t>(n)) >> 32);
+  }
+
+  /**
+   * @brief Skips the next z random numbers of the stream
+   */
+  void discard(uint64_t z)
+  {
+    const uint64_t buffered = 4 - m_Index;
+    if(z <= buffered)
+    {
+      m_Index += static_cast<uint32_t>(z);
+      return;
+    }
+    z -= buffered;
+    uint64_t blocks = (static_cast<uint64_t>(m_Counter[1]) << 32) | m_Counter[0];
+    blocks += z / 4;
+    m_Counter[0] = static_cast<uint32_t>(blocks);
+    m_Counter[1] = static_cast<uint32_t>(blocks >> 32);
+    m_Index = 4;
+    if(z % 4 != 0)
+    {
+      operator()();
+      m_Index = static_cast<uint32_t>(z % 4);
+    }
+  }
+
+  /**
+   * @brief Computes the block of 4 random numbers at a counter with 10 rounds of the Philox
+   * bijection.
+   * @param counter The 128 bit counter
+   * @param key The 64 bit key
+   */
+  static Counter Generate(Counter counter, Key key)
+  {
+    constexpr uint32_t k_M0 = 0xD2511F53U;
+    constexpr uint32_t k_M1 = 0xCD9E8D57U;
+    constexpr uint32_t k_W0 = 0x9E3779B9U;
+    constexpr uint32_t k_W1 = 0xBB67AE85U;
+
+    for(int round = 0; round < 10; round++)
+    {
+      if(round > 0)
+      {
+        key[0] += k_W0;
+        key[1] += k_W1;
+      }
+      const uint64_t p0 = static_cast<uint64_t>(k_M0) * counter[0];
+      const uint64_t p1 = static_cast<uint64_t>(k_M1) * counter[2];
+      counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(p1), static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(p0)};
+    }
+    return counter;
+  }
+
+  /**
+   * @brief Returns a seed from the system entropy source for callers that do not need
+   * reproducible results.
+   */
+  static uint64_t RandomSeed()
+  {
+    std::random_device randomDevice;
+    return (static_cast<uint64_t>(randomDevice()) << 32) | static_cast<uint64_t>(randomDevice());
+  }
+
+private:
+  Key m_Key;
+  Counter m_Counter;
+  Counter m_Block = {0, 0, 0, 0};
+  uint32_t m_Index = 4;
+
+  void incrementCounter()
+  {
+    if(++m_Counter[0] == 0)
+    {
+      ++m_Counter[1];
+    }
+  }
+};
+} // namespace EbsdLib
@@ -0,0 +1,267 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file SimdMath.hpp
+ * @brief Branch free versions of the elementary functions that the batch orientation
+ * kernels need. Every function is written as straight line code on a single value
+ * with the conditionals expressed as selects so that a loop over a structure-of-arrays
+ * block of values is vectorized by the compiler for whatever instruction set the
+ * translation unit is compiled for (SSE, AVX2, AVX-512, NEON). The same code is the
+ * portable scalar fallback when the compiler does not vectorize the loop.
+ *
+ * Divisions are always evaluated with a safe divisor so that no lane produces a spurious
+ * infinity or NaN. The translation units that use these functions in vectorized loops
+ * must be compiled with -fno-math-errno and -fno-trapping-math (GCC, Clang). Otherwise
+ * every square root carries a branch that sets errno and the compiler refuses to evaluate
+ * both sides of a select, and the loops stay scalar.
+ *
+ * All functions live in an inline namespace named after EbsdLib_SIMD_ISA so that a
+ * translation unit that is compiled with, e.g., -mavx2 never shares an inline function
+ * with the rest of the library. Define EbsdLib_SIMD_ISA before including this header
+ * in such a translation unit.
+ *
+ * The float versions are accurate to a few ulp and the double versions to about 1 ulp
+ * over the argument ranges that appear in the orientation conversions.
+ */
+
+#ifndef EbsdLib_SIMD_ISA
+#define EbsdLib_SIMD_ISA Portable
+#endif
+
+/**
+ * @brief EBSD_SIMD_LOOP tells the compiler that the iterations of the following loop
+ * are independent so that it can be vectorized without a runtime alias check.
+ */
+#if defined(__clang__)
+#define EBSD_SIMD_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define EBSD_SIMD_LOOP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define EBSD_SIMD_LOOP __pragma(loop(ivdep))
+#else
+#define EBSD_SIMD_LOOP
+#endif
+
+namespace SimdMath
+{
+inline namespace EbsdLib_SIMD_ISA
+{
+/**
+ * @brief The number of values that the batch kernels process per iteration. This
+ * matches one AVX-512 register of floats or one AVX2 register of floats.
+ */
+#if defined(__AVX512F__)
+inline constexpr size_t k_BatchWidth = 16;
+#else
+inline constexpr size_t k_BatchWidth = 8;
+#endif
+
+namespace detail
+{
+/**
+ * @brief Rounds to the nearest integer without calling nearbyint() which does not
+ * vectorize on baseline x86_64. Valid for |x| < 2^22 (float) or 2^51 (double).
+ */
+inline float roundToInt(float x)
+{
+  constexpr float k_Magic = 12582912.0f; // 1.5 * 2^23
+  return (x + k_Magic) - k_Magic;
+}
+
+inline double roundToInt(double x)
+{
+  constexpr double k_Magic = 6755399441055744.0; // 1.5 * 2^52
+  return (x + k_Magic) - k_Magic;
+}
+} // namespace detail
+
+/**
+ * @brief Absolute value and square root that are guaranteed to be expanded inline.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+inline float abs(float x)
+{
+  return __builtin_fabsf(x);
+}
+inline double abs(double x)
+{
+  return __builtin_fabs(x);
+}
+inline float sqrt(float x)
+{
+  return __builtin_sqrtf(x);
+}
+inline double sqrt(double x)
+{
+  return __builtin_sqrt(x);
+}
+#else
+inline float abs(float x)
+{
+  return std::fabs(x);
+}
+inline double abs(double x)
+{
+  return std::fabs(x);
+}
+inline float sqrt(float x)
+{
+  return std::sqrt(x);
+}
+inline double sqrt(double x)
+{
+  return std::sqrt(x);
+}
+#endif
+
+/**
+ * @brief Computes the sine and cosine of x at the same time.
+ * @param x Angle in radians. Best accuracy for |x| < 1000
+ * @param sinOut
+ * @param cosOut
+ */
+inline void sinCos(float x, float& sinOut, float& cosOut)
+{
+  // Cody-Waite reduction by pi/2 in three parts
+  constexpr float k_2OverPi = 0.636619772367581343f;
+  constexpr float k_PiOver2A = 1.5703125f;
+  constexpr float k_PiOver2B = 4.837512969970703125e-4f;
+  constexpr float k_PiOver2C = 7.54978995489188216e-8f;
+
+  const float j = detail::roundToInt(x * k_2OverPi);
+  const int32_t quadrant = static_cast<int32_t>(j);
+  const float r = ((x - j * k_PiOver2A) - j * k_PiOver2B) - j * k_PiOver2C;
+  const float z = r * r;
+
+  // Minimax polynomials on [-pi/4, pi/4]
+  const float s = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+  const float c = 1.0f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f);
+
+  const bool swap = (quadrant & 1) != 0;
+  const float sv = swap ? c : s;
+  const float cv = swap ? s : c;
+  sinOut = (quadrant & 2) != 0 ? -sv : sv;
+  cosOut = ((quadrant + 1) & 2) != 0 ? -cv : cv;
+}
+
+inline void sinCos(double x, double& sinOut, double& cosOut)
+{
+  constexpr double k_2OverPi = 6.36619772367581382433e-01;
+  constexpr double k_PiOver2A = 1.57079632673412561417e+00;
+  constexpr double k_PiOver2B = 6.07710050630396597660e-11;
+  constexpr double k_PiOver2C = 2.02226624879595063154e-21;
+
+  const double j = detail::roundToInt(x * k_2OverPi);
+  const int32_t quadrant = static_cast<int32_t>(j);
+  const double r = ((x - j * k_PiOver2A) - j * k_PiOver2B) - j * k_PiOver2C;
+  const double z = r * r;
+
+  const double s = r + r * z *
+                           (-1.66666666666666324348e-01 +
+                            z * (8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+  const double c = 1.0 - 0.5 * z +
+                   z * z *
+                       (4.16666666666666019037e-02 +
+                        z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+
+  const bool swap = (quadrant & 1) != 0;
+  const double sv = swap ? c : s;
+  const double cv = swap ? s : c;
+  sinOut = (quadrant & 2) != 0 ? -sv : sv;
+  cosOut = ((quadrant + 1) & 2) != 0 ? -cv : cv;
+}
+
+/**
+ * @brief Arc tangent of y/x using the signs of both arguments to find the quadrant.
+ * Returns 0 when both arguments are zero.
+ */
+inline float atan2(float y, float x)
+{
+  constexpr float k_PiOver2 = 1.57079632679489661923f;
+  constexpr float k_PiOver4 = 0.78539816339744830962f;
+  constexpr float k_Pi = 3.14159265358979323846f;
+  constexpr float k_TanPiOver8 = 0.41421356237309504880f;
+
+  const float ax = abs(x);
+  const float ay = abs(y);
+  const float num = ax < ay ? ax : ay;
+  const float den = ax < ay ? ay : ax;
+  float t = num / (den == 0.0f ? 1.0f : den); // t in [0, 1]
+
+  const bool reduce = t > k_TanPiOver8;
+  const float tr = (t - 1.0f) / (t + 1.0f);
+  t = reduce ? tr : t;
+  const float z = t * t;
+  float a = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+  a = reduce ? a + k_PiOver4 : a;
+
+  a = ay > ax ? k_PiOver2 - a : a;
+  a = x < 0.0f ? k_Pi - a : a;
+  return y < 0.0f ? -a : a;
+}
+
+inline double atan2(double y, double x)
+{
+  constexpr double k_PiOver2 = 1.57079632679489661923;
+  constexpr double k_PiOver4 = 0.78539816339744830962;
+  constexpr double k_Pi = 3.14159265358979323846;
+  constexpr double k_MoreBits = 6.123233995736765886130e-17;
+
+  const double ax = abs(x);
+  const double ay = abs(y);
+  const double num = ax < ay ? ax : ay;
+  const double den = ax < ay ? ay : ax;
+  double t = num / (den == 0.0 ? 1.0 : den); // t in [0, 1]
+
+  const bool reduce = t > 0.66;
+  const double tr = (t - 1.0) / (t + 1.0);
+  t = reduce ? tr : t;
+  const double z = t * t;
+  const double p = (((-8.750608600031904122785e-01 * z - 1.615753718733365076637e+01) * z - 7.500855792314704667340e+01) * z - 1.228866684490136173410e+02) * z - 6.485021904942025371773e+01;
+  const double q = ((((z + 2.485846490142306297962e+01) * z + 1.650270098316988542046e+02) * z + 4.328810604912902668951e+02) * z + 4.853903996359136964868e+02) * z + 1.945506571482613964425e+02;
+  double a = t * (z * p / q) + t;
+  a = reduce ? a + (k_PiOver4 + 0.5 * k_MoreBits) : a;
+
+  a = ay > ax ? (k_PiOver2 - a) + k_MoreBits : a;
+  a = x < 0.0 ? (k_Pi - a) + 2.0 * k_MoreBits : a;
+  return y < 0.0 ? -a : a;
+}
+} // namespace EbsdLib_SIMD_ISA
+} // namespace SimdMath
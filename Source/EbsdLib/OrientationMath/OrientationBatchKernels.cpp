@@ -0,0 +1,288 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "OrientationBatchKernels.hpp"
+
+#include <array>
+#include <atomic>
+#include <cmath>
+
+#include "EbsdLib/Core/FixedOrientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+
+/**
+ * @brief Declares the entry points of the kernels that are compiled for one instruction set
+ * in OrientationBatchKernels[ISA].cpp
+ */
+#define OB_DECLARE_KERNELS(ISA)                                                                                                                                                                        \
+  namespace OrientationBatch::ISA                                                                                                                                                                      \
+  {                                                                                                                                                                                                    \
+  void eu2qu(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void eu2qu(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  void eu2om(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void eu2om(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  void qu2eu(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void qu2eu(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  void qu2om(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void qu2om(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  void om2qu(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void om2qu(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  void qu2ro(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void qu2ro(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  void ro2qu(const float* input, float* output, size_t count, float epsijk);                                                                                                                           \
+  void ro2qu(const double* input, double* output, size_t count, double epsijk);                                                                                                                        \
+  }
+
+OB_DECLARE_KERNELS(Portable)
+#ifdef EbsdLib_HAVE_AVX2_KERNELS
+OB_DECLARE_KERNELS(AVX2)
+#endif
+#ifdef EbsdLib_HAVE_AVX512_KERNELS
+OB_DECLARE_KERNELS(AVX512)
+#endif
+
+using namespace OrientationBatch;
+
+namespace
+{
+enum Conversion : size_t
+{
+  k_Eu2Qu = 0,
+  k_Eu2Om,
+  k_Qu2Eu,
+  k_Qu2Om,
+  k_Om2Qu,
+  k_Qu2Ro,
+  k_Ro2Qu,
+  k_NumConversions
+};
+
+template <typename T>
+using KernelFunction = void (*)(const T*, T*, size_t, T);
+
+template <typename T>
+using KernelTable = std::array<KernelFunction<T>, k_NumConversions>;
+
+#define OB_KERNEL_TABLE(ISA)                                                                                                                                                                           \
+  KernelTable<T>                                                                                                                                                                                       \
+  {                                                                                                                                                                                                    \
+    ISA::eu2qu, ISA::eu2om, ISA::qu2eu, ISA::qu2om, ISA::om2qu, ISA::qu2ro, ISA::ro2qu                                                                                                                 \
+  }
+
+// -----------------------------------------------------------------------------
+bool CpuSupports(InstructionSet instructionSet)
+{
+#if(defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  switch(instructionSet)
+  {
+  case InstructionSet::AVX2:
+    return __builtin_cpu_supports("avx2") != 0;
+  case InstructionSet::AVX512:
+    return __builtin_cpu_supports("avx512f") != 0;
+  default:
+    return true;
+  }
+#else
+  return instructionSet == InstructionSet::Portable;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+bool IsCompiledIn(InstructionSet instructionSet)
+{
+  switch(instructionSet)
+  {
+#ifdef EbsdLib_HAVE_AVX2_KERNELS
+  case InstructionSet::AVX2:
+    return true;
+#endif
+#ifdef EbsdLib_HAVE_AVX512_KERNELS
+  case InstructionSet::AVX512:
+    return true;
+#endif
+  case InstructionSet::Portable:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// -----------------------------------------------------------------------------
+std::atomic<InstructionSet>& CurrentInstructionSet()
+{
+  static std::atomic<InstructionSet> s_InstructionSet = [] {
+    for(InstructionSet instructionSet : {InstructionSet::AVX512, InstructionSet::AVX2})
+    {
+      if(IsInstructionSetSupported(instructionSet))
+      {
+        return instructionSet;
+      }
+    }
+    return InstructionSet::Portable;
+  }();
+  return s_InstructionSet;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const KernelTable<T>& GetKernelTable()
+{
+  static const KernelTable<T> s_Portable = OB_KERNEL_TABLE(Portable);
+#ifdef EbsdLib_HAVE_AVX2_KERNELS
+  static const KernelTable<T> s_AVX2 = OB_KERNEL_TABLE(AVX2);
+#endif
+#ifdef EbsdLib_HAVE_AVX512_KERNELS
+  static const KernelTable<T> s_AVX512 = OB_KERNEL_TABLE(AVX512);
+#endif
+  switch(CurrentInstructionSet().load())
+  {
+#ifdef EbsdLib_HAVE_AVX2_KERNELS
+  case InstructionSet::AVX2:
+    return s_AVX2;
+#endif
+#ifdef EbsdLib_HAVE_AVX512_KERNELS
+  case InstructionSet::AVX512:
+    return s_AVX512;
+#endif
+  default:
+    return s_Portable;
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void RunKernel(Conversion conversion, const T* input, T* output, size_t count)
+{
+  GetKernelTable<T>()[conversion](input, output, count, static_cast<T>(Rotations::Constants::epsijk));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void Om2QuFixup(const T* om, T* qu, size_t count)
+{
+  // The batch kernel takes the signs of the vector part of the quaternion from the off
+  // diagonal differences of the matrix. Where a difference is too small to decide the sign
+  // of a component that is not itself zero (rotations of nearly 180 degrees) the scalar
+  // conversion is used, which resolves the sign through the axis-angle pair.
+  const T ambiguous = sizeof(T) == 4 ? static_cast<T>(1.0E-5) : static_cast<T>(1.0E-12);
+  const T nonZero = sizeof(T) == 4 ? static_cast<T>(1.0E-6) : static_cast<T>(1.0E-13);
+  for(size_t i = 0; i < count; i++)
+  {
+    const T* m = om + i * 9;
+    T* q = qu + i * 4;
+    const bool xAmbiguous = std::fabs(m[7] - m[5]) < ambiguous && std::fabs(q[0]) > nonZero;
+    const bool yAmbiguous = std::fabs(m[2] - m[6]) < ambiguous && std::fabs(q[1]) > nonZero;
+    const bool zAmbiguous = std::fabs(m[3] - m[1]) < ambiguous && std::fabs(q[2]) > nonZero;
+    if(xAmbiguous || yAmbiguous || zAmbiguous)
+    {
+      using InputType = FixedOrientation<T, 9>;
+      using OutputType = Quaternion<T>;
+      OrientationTransformation::om2qu<InputType, OutputType>(InputType(m)).copyInto(q, OutputType::Order::VectorScalar);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ConvertOm2Qu(const T* input, T* output, size_t count)
+{
+  // Fix up each chunk while it is still in the cache
+  constexpr size_t k_ChunkSize = 4096;
+  for(size_t start = 0; start < count; start += k_ChunkSize)
+  {
+    const size_t numTuples = (count - start) < k_ChunkSize ? (count - start) : k_ChunkSize;
+    RunKernel<T>(k_Om2Qu, input + start * 9, output + start * 4, numTuples);
+    Om2QuFixup<T>(input + start * 9, output + start * 4, numTuples);
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+InstructionSet OrientationBatch::GetInstructionSet()
+{
+  return CurrentInstructionSet().load();
+}
+
+// -----------------------------------------------------------------------------
+bool OrientationBatch::IsInstructionSetSupported(InstructionSet instructionSet)
+{
+  return IsCompiledIn(instructionSet) && CpuSupports(instructionSet);
+}
+
+// -----------------------------------------------------------------------------
+bool OrientationBatch::SetInstructionSet(InstructionSet instructionSet)
+{
+  if(!IsInstructionSetSupported(instructionSet))
+  {
+    return false;
+  }
+  CurrentInstructionSet().store(instructionSet);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t OrientationBatch::GetBatchWidth()
+{
+  return GetInstructionSet() == InstructionSet::AVX512 ? 16 : 8;
+}
+
+#define OB_DEFINE_ENTRY_POINT(NAME, CONVERSION)                                                                                                                                                        \
+  void OrientationBatch::NAME(const float* input, float* output, size_t count)                                                                                                                         \
+  {                                                                                                                                                                                                    \
+    RunKernel<float>(CONVERSION, input, output, count);                                                                                                                                                \
+  }                                                                                                                                                                                                    \
+  void OrientationBatch::NAME(const double* input, double* output, size_t count)                                                                                                                       \
+  {                                                                                                                                                                                                    \
+    RunKernel<double>(CONVERSION, input, output, count);                                                                                                                                               \
+  }
+
+OB_DEFINE_ENTRY_POINT(eu2qu, k_Eu2Qu)
+OB_DEFINE_ENTRY_POINT(eu2om, k_Eu2Om)
+OB_DEFINE_ENTRY_POINT(qu2eu, k_Qu2Eu)
+OB_DEFINE_ENTRY_POINT(qu2om, k_Qu2Om)
+OB_DEFINE_ENTRY_POINT(qu2ro, k_Qu2Ro)
+OB_DEFINE_ENTRY_POINT(ro2qu, k_Ro2Qu)
+
+// -----------------------------------------------------------------------------
+void OrientationBatch::om2qu(const float* input, float* output, size_t count)
+{
+  ConvertOm2Qu<float>(input, output, count);
+}
+
+// -----------------------------------------------------------------------------
+void OrientationBatch::om2qu(const double* input, double* output, size_t count)
+{
+  ConvertOm2Qu<double>(input, output, count);
+}
@@ -0,0 +1,130 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @brief The OrientationBatch namespace holds structure-of-arrays (SoA) versions of the most
+ * heavily used conversions in OrientationTransformation. The kernels convert 8 (AVX2 and the
+ * portable fallback) or 16 (AVX-512) orientations per iteration with vectorized sin, cos and
+ * atan2. The fastest instruction set that the CPU supports is picked the first time a kernel
+ * is called.
+ *
+ * All functions take tightly packed interleaved tuples, i.e., 3 values per Euler angle, 9 per
+ * orientation matrix and 4 per quaternion or Rodrigues vector. All quaternions use the
+ * Vector-Scalar <x, y, z, w> layout that the OrientationConverter classes use. The results
+ * agree with the scalar conversions to within a few ulp.
+ */
+namespace OrientationBatch
+{
+enum class InstructionSet : int
+{
+  Portable = 0,
+  AVX2 = 1,
+  AVX512 = 2
+};
+
+/**
+ * @brief Returns the instruction set that the kernels currently use
+ */
+EbsdLib_EXPORT InstructionSet GetInstructionSet();
+
+/**
+ * @brief Returns true if the library was built with kernels for the instruction set and the CPU supports it
+ */
+EbsdLib_EXPORT bool IsInstructionSetSupported(InstructionSet instructionSet);
+
+/**
+ * @brief Forces the kernels to use the given instruction set. This is mainly useful for testing.
+ * @return false if the instruction set is not supported, in which case nothing is changed
+ */
+EbsdLib_EXPORT bool SetInstructionSet(InstructionSet instructionSet);
+
+/**
+ * @brief Returns the number of orientations that the current kernels process per iteration
+ */
+EbsdLib_EXPORT size_t GetBatchWidth();
+
+EbsdLib_EXPORT void eu2qu(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void eu2qu(const double* input, double* output, size_t count);
+EbsdLib_EXPORT void eu2om(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void eu2om(const double* input, double* output, size_t count);
+EbsdLib_EXPORT void qu2eu(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void qu2eu(const double* input, double* output, size_t count);
+EbsdLib_EXPORT void qu2om(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void qu2om(const double* input, double* output, size_t count);
+EbsdLib_EXPORT void om2qu(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void om2qu(const double* input, double* output, size_t count);
+EbsdLib_EXPORT void qu2ro(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void qu2ro(const double* input, double* output, size_t count);
+EbsdLib_EXPORT void ro2qu(const float* input, float* output, size_t count);
+EbsdLib_EXPORT void ro2qu(const double* input, double* output, size_t count);
+
+/**
+ * @brief This macro creates a small class that describes one of the batch conversions so
+ * that it can be passed as a template argument in the same way as the Convertors functors.
+ */
+#define OB_BATCH_KERNEL(CLASSNAME, INSTRIDE, OUTSTRIDE, CONVERSION_METHOD)                                                                                                                             \
+  template <typename T>                                                                                                                                                                                \
+  class CLASSNAME                                                                                                                                                                                      \
+  {                                                                                                                                                                                                    \
+  public:                                                                                                                                                                                              \
+    static constexpr size_t k_InStride = INSTRIDE;                                                                                                                                                     \
+    static constexpr size_t k_OutStride = OUTSTRIDE;                                                                                                                                                   \
+    static void convert(const T* input, T* output, size_t count)                                                                                                                                       \
+    {                                                                                                                                                                                                  \
+      CONVERSION_METHOD(input, output, count);                                                                                                                                                         \
+    }                                                                                                                                                                                                  \
+  };
+
+OB_BATCH_KERNEL(Eu2Qu, 3, 4, eu2qu)
+OB_BATCH_KERNEL(Eu2Om, 3, 9, eu2om)
+OB_BATCH_KERNEL(Qu2Eu, 4, 3, qu2eu)
+OB_BATCH_KERNEL(Qu2Om, 4, 9, qu2om)
+OB_BATCH_KERNEL(Om2Qu, 9, 4, om2qu)
+OB_BATCH_KERNEL(Qu2Ro, 4, 4, qu2ro)
+OB_BATCH_KERNEL(Ro2Qu, 4, 4, ro2qu)
+
+/**
+ * @brief Converts count tightly packed tuples with the given kernel class
+ */
+template <typename T, class Kernel>
+void convert(const T* input, T* output, size_t count)
+{
+  Kernel::convert(input, output, count);
+}
+} // namespace OrientationBatch
@@ -0,0 +1,446 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/SimdMath.hpp"
+
+/**
+ * @file OrientationBatchKernelsImpl.hpp
+ * @brief The structure-of-arrays implementations of the OrientationBatch conversions.
+ * Each kernel converts a block of SimdMath::k_BatchWidth orientations at a time: the
+ * interleaved input tuples are transposed into one small array per component, every
+ * component loop is written without branches so that the compiler vectorizes it with the
+ * SimdMath sin/cos/atan2 functions, and the results are transposed back into the
+ * interleaved output.
+ *
+ * This header is compiled once for every supported instruction set. Each of those
+ * translation units defines EbsdLib_SIMD_ISA to the name of its instruction set, which
+ * becomes the namespace of everything in here, and must include this header exactly once.
+ * Only code that is safe to compile with instruction set specific flags may be used here,
+ * which is why the scalar fix up of om2qu lives in OrientationBatchKernels.cpp.
+ */
+namespace OrientationBatch::EbsdLib_SIMD_ISA
+{
+using SimdMath::k_BatchWidth;
+
+template <typename T, size_t N>
+using BlockType = T[N][k_BatchWidth];
+
+/**
+ * @brief Converts count tightly packed tuples from input into output using the given kernel.
+ * The input must hold Kernel::k_InStride values per tuple and the output must have room for
+ * Kernel::k_OutStride values per tuple.
+ * @param input
+ * @param output
+ * @param count The number of tuples to convert
+ * @param epsijk The sign convention of the rotations, see Rotations::Constants::epsijk
+ */
+template <typename T, class Kernel>
+void convert(const T* input, T* output, size_t count, T epsijk)
+{
+  constexpr size_t k_InStride = Kernel::k_InStride;
+  constexpr size_t k_OutStride = Kernel::k_OutStride;
+
+  alignas(64) BlockType<T, k_InStride> src = {};
+  alignas(64) BlockType<T, k_OutStride> dst = {};
+
+  for(size_t start = 0; start < count; start += k_BatchWidth)
+  {
+    const size_t numLanes = (count - start) < k_BatchWidth ? (count - start) : k_BatchWidth;
+    const T* in = input + start * k_InStride;
+    T* out = output + start * k_OutStride;
+
+    for(size_t lane = 0; lane < numLanes; lane++)
+    {
+      for(size_t c = 0; c < k_InStride; c++)
+      {
+        src[c][lane] = in[lane * k_InStride + c];
+      }
+    }
+    // A short final block is padded with zeros. Those lanes are computed but never stored.
+    for(size_t lane = numLanes; lane < k_BatchWidth; lane++)
+    {
+      for(size_t c = 0; c < k_InStride; c++)
+      {
+        src[c][lane] = static_cast<T>(0.0);
+      }
+    }
+
+    Kernel::compute(src, dst, epsijk);
+
+    for(size_t lane = 0; lane < numLanes; lane++)
+    {
+      for(size_t c = 0; c < k_OutStride; c++)
+      {
+        out[lane * k_OutStride + c] = dst[c][lane];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Euler angles (Bunge, radians) to quaternion. See OrientationTransformation::eu2qu
+ */
+template <typename T>
+class Eu2Qu
+{
+public:
+  static constexpr size_t k_InStride = 3;
+  static constexpr size_t k_OutStride = 4;
+
+  static void compute(const BlockType<T, 3>& eu, BlockType<T, 4>& qu, T epsijk)
+  {
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      const T e0 = static_cast<T>(0.5) * eu[0][i];
+      const T e1 = static_cast<T>(0.5) * eu[1][i];
+      const T e2 = static_cast<T>(0.5) * eu[2][i];
+      T sPhi;
+      T cPhi;
+      T sm;
+      T cm;
+      T sp;
+      T cp;
+      SimdMath::sinCos(e1, sPhi, cPhi);
+      SimdMath::sinCos(e0 - e2, sm, cm);
+      SimdMath::sinCos(e0 + e2, sp, cp);
+
+      const T w = cPhi * cp;
+      // Keep the scalar part of the quaternion positive
+      const T sign = w < static_cast<T>(0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+      qu[0][i] = sign * (-epsijk * sPhi * cm);
+      qu[1][i] = sign * (-epsijk * sPhi * sm);
+      qu[2][i] = sign * (-epsijk * cPhi * sp);
+      qu[3][i] = sign * w;
+    }
+  }
+};
+
+/**
+ * @brief Euler angles (Bunge, radians) to orientation matrix. See OrientationTransformation::eu2om
+ */
+template <typename T>
+class Eu2Om
+{
+public:
+  static constexpr size_t k_InStride = 3;
+  static constexpr size_t k_OutStride = 9;
+
+  static void compute(const BlockType<T, 3>& eu, BlockType<T, 9>& om, T /* epsijk */)
+  {
+    const T eps = static_cast<T>(1.0E-7f);
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      T s1;
+      T c1;
+      T s;
+      T c;
+      T s2;
+      T c2;
+      SimdMath::sinCos(eu[0][i], s1, c1);
+      SimdMath::sinCos(eu[1][i], s, c);
+      SimdMath::sinCos(eu[2][i], s2, c2);
+
+      T g[9];
+      g[0] = c1 * c2 - s1 * s2 * c;
+      g[1] = s1 * c2 + c1 * s2 * c;
+      g[2] = s2 * s;
+      g[3] = -c1 * s2 - s1 * c2 * c;
+      g[4] = -s1 * s2 + c1 * c2 * c;
+      g[5] = c2 * s;
+      g[6] = s1 * s;
+      g[7] = -c1 * s;
+      g[8] = c;
+      for(size_t k = 0; k < 9; k++)
+      {
+        om[k][i] = SimdMath::abs(g[k]) < eps ? static_cast<T>(0.0) : g[k];
+      }
+    }
+  }
+};
+
+/**
+ * @brief Quaternion to Euler angles (Bunge, radians). See OrientationTransformation::qu2eu
+ */
+template <typename T>
+class Qu2Eu
+{
+public:
+  static constexpr size_t k_InStride = 4;
+  static constexpr size_t k_OutStride = 3;
+
+  static void compute(const BlockType<T, 4>& qu, BlockType<T, 3>& eu, T epsijk)
+  {
+    const T zero = static_cast<T>(0.0);
+    const T two = static_cast<T>(2.0);
+    const T pi = static_cast<T>(EbsdLib::Constants::k_PiD);
+    const T twoPi = static_cast<T>(EbsdLib::Constants::k_2PiD);
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      const T x = qu[0][i];
+      const T y = qu[1][i];
+      const T z = qu[2][i];
+      const T w = qu[3][i];
+
+      const T q03 = w * w + z * z;
+      const T q12 = x * x + y * y;
+      const T chi = SimdMath::sqrt(q03 * q12);
+      const bool degenerate = chi == zero;
+      const bool noVector = q12 == zero;
+      const T oneOverChi = static_cast<T>(1.0) / (degenerate ? static_cast<T>(1.0) : chi);
+
+      // Pick the arguments of each atan2 for the general and the two degenerate cases first
+      // so that only three atan2 evaluations are needed per orientation.
+      T y1 = (-epsijk * w * y + x * z) * oneOverChi;
+      T x1 = (-epsijk * w * x - y * z) * oneOverChi;
+      y1 = degenerate ? (noVector ? -epsijk * two * w * z : two * x * y) : y1;
+      x1 = degenerate ? (noVector ? w * w - z * z : x * x - y * y) : x1;
+      const T y2 = (epsijk * w * y + x * z) * oneOverChi;
+      const T x2 = (-epsijk * w * x + y * z) * oneOverChi;
+
+      T phi1 = SimdMath::atan2(y1, x1);
+      T Phi = SimdMath::atan2(two * chi, q03 - q12);
+      T phi2 = SimdMath::atan2(y2, x2);
+      Phi = degenerate ? (noVector ? zero : pi) : Phi;
+      phi2 = degenerate ? zero : phi2;
+
+      eu[0][i] = phi1 < zero ? phi1 + twoPi : phi1;
+      eu[1][i] = Phi < zero ? Phi + pi : Phi;
+      eu[2][i] = phi2 < zero ? phi2 + twoPi : phi2;
+    }
+  }
+};
+
+/**
+ * @brief Quaternion to orientation matrix. See OrientationTransformation::qu2om
+ */
+template <typename T>
+class Qu2Om
+{
+public:
+  static constexpr size_t k_InStride = 4;
+  static constexpr size_t k_OutStride = 9;
+
+  static void compute(const BlockType<T, 4>& qu, BlockType<T, 9>& om, T /* epsijk */)
+  {
+    const T two = static_cast<T>(2.0);
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      const T x = qu[0][i];
+      const T y = qu[1][i];
+      const T z = qu[2][i];
+      const T w = qu[3][i];
+
+      const T qq = w * w - (x * x + y * y + z * z);
+      om[0][i] = qq + two * x * x;
+      om[4][i] = qq + two * y * y;
+      om[8][i] = qq + two * z * z;
+      om[1][i] = two * (x * y - w * z);
+      om[5][i] = two * (y * z - w * x);
+      om[6][i] = two * (z * x - w * y);
+      om[3][i] = two * (y * x + w * z);
+      om[7][i] = two * (z * y + w * x);
+      om[2][i] = two * (x * z + w * y);
+    }
+  }
+};
+
+/**
+ * @brief Orientation matrix to quaternion. See OrientationTransformation::om2qu
+ *
+ * The signs of the vector part are taken from the off diagonal differences of the
+ * matrix. The tuples where those differences are too close to zero to decide the sign
+ * (rotations of nearly 180 degrees) are recomputed afterwards by the caller.
+ */
+template <typename T>
+class Om2Qu
+{
+public:
+  static constexpr size_t k_InStride = 9;
+  static constexpr size_t k_OutStride = 4;
+
+  static void compute(const BlockType<T, 9>& om, BlockType<T, 4>& qu, T epsijk)
+  {
+    const T thr = sizeof(T) == 4 ? static_cast<T>(1.0E-6L) : static_cast<T>(1.0E-10L);
+    const T zero = static_cast<T>(0.0);
+    const T one = static_cast<T>(1.0);
+    const T half = static_cast<T>(0.5);
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      T s = om[0][i] + om[4][i] + om[8][i] + one;
+      T s1 = om[0][i] - om[4][i] - om[8][i] + one;
+      T s2 = -om[0][i] + om[4][i] - om[8][i] + one;
+      T s3 = -om[0][i] - om[4][i] + om[8][i] + one;
+      s = SimdMath::abs(s) < thr ? zero : s;
+      s1 = SimdMath::abs(s1) < thr ? zero : s1;
+      s2 = SimdMath::abs(s2) < thr ? zero : s2;
+      s3 = SimdMath::abs(s3) < thr ? zero : s3;
+
+      T w = SimdMath::sqrt(s) * half;
+      T x = SimdMath::sqrt(s1) * half;
+      T y = SimdMath::sqrt(s2) * half;
+      T z = SimdMath::sqrt(s3) * half;
+      x = om[7][i] < om[5][i] ? -epsijk * x : x;
+      y = om[2][i] < om[6][i] ? -epsijk * y : y;
+      z = om[3][i] < om[1][i] ? -epsijk * z : z;
+
+      const T mag = SimdMath::sqrt(x * x + y * y + z * z + w * w);
+      const T scale = one / (mag != zero ? mag : one);
+      qu[0][i] = x * scale;
+      qu[1][i] = y * scale;
+      qu[2][i] = z * scale;
+      qu[3][i] = w * scale;
+    }
+  }
+};
+
+/**
+ * @brief Quaternion to Rodrigues vector. See OrientationTransformation::qu2ro
+ */
+template <typename T>
+class Qu2Ro
+{
+public:
+  static constexpr size_t k_InStride = 4;
+  static constexpr size_t k_OutStride = 4;
+
+  static void compute(const BlockType<T, 4>& qu, BlockType<T, 4>& ro, T /* epsijk */)
+  {
+    const T thr = static_cast<T>(1.0E-8L);
+    const T zero = static_cast<T>(0.0);
+    const T one = static_cast<T>(1.0);
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      const T x = qu[0][i];
+      const T y = qu[1][i];
+      const T z = qu[2][i];
+      const T w = qu[3][i];
+
+      const bool infinite = w < thr;
+      const T s = SimdMath::sqrt(x * x + y * y + z * z);
+      const bool identity = s < thr;
+      const T divisor = identity ? one : s;
+      // tan(acos(w)) without the trig functions
+      const T tanHalfAngle = SimdMath::sqrt((one - w) * (one + w)) / (infinite ? one : w);
+
+      ro[0][i] = infinite ? x : (identity ? zero : x / divisor);
+      ro[1][i] = infinite ? y : (identity ? zero : y / divisor);
+      ro[2][i] = infinite ? z : (identity ? zero : z / divisor);
+      ro[3][i] = infinite ? inf : (identity ? zero : tanHalfAngle);
+    }
+  }
+};
+
+/**
+ * @brief Rodrigues vector to quaternion. See OrientationTransformation::ro2qu
+ */
+template <typename T>
+class Ro2Qu
+{
+public:
+  static constexpr size_t k_InStride = 4;
+  static constexpr size_t k_OutStride = 4;
+
+  static void compute(const BlockType<T, 4>& ro, BlockType<T, 4>& qu, T /* epsijk */)
+  {
+    const T zero = static_cast<T>(0.0);
+    const T one = static_cast<T>(1.0);
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    // The scalar path evaluates cos(pi/2) for an infinite Rodrigues vector
+    const T cosHalfPi = static_cast<T>(std::cos(static_cast<T>(EbsdLib::Constants::k_PiD) * 0.5));
+    EBSD_SIMD_LOOP
+    for(size_t i = 0; i < k_BatchWidth; i++)
+    {
+      const T r0 = ro[0][i];
+      const T r1 = ro[1][i];
+      const T r2 = ro[2][i];
+      const T t = ro[3][i];
+
+      // cos(atan(t)) and sin(atan(t)) computed without overflow for large t
+      const T a = SimdMath::abs(t);
+      const bool large = a > one;
+      const T inverse = one / (large ? a : one);
+      const T v = large ? inverse : a;
+      const T k = one / SimdMath::sqrt(one + v * v);
+      const T c = large ? v * k : k;
+      const T sa = large ? k : v * k;
+      const T s = t < zero ? -sa : sa;
+      const T scale = s / SimdMath::sqrt(r0 * r0 + r1 * r1 + r2 * r2);
+
+      const bool identity = t == zero;
+      const bool infinite = t == inf;
+      qu[0][i] = identity ? zero : (infinite ? r0 : r0 * scale);
+      qu[1][i] = identity ? zero : (infinite ? r1 : r1 * scale);
+      qu[2][i] = identity ? zero : (infinite ? r2 : r2 * scale);
+      qu[3][i] = identity ? one : (infinite ? cosHalfPi : c);
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+// The entry points that OrientationBatchKernels.cpp dispatches to
+// -----------------------------------------------------------------------------
+#define EBSD_BATCH_ENTRY_POINT(NAME, KERNEL)                                                                                                                                                           \
+  void NAME(const float* input, float* output, size_t count, float epsijk)                                                                                                                             \
+  {                                                                                                                                                                                                    \
+    convert<float, KERNEL<float>>(input, output, count, epsijk);                                                                                                                                       \
+  }                                                                                                                                                                                                    \
+  void NAME(const double* input, double* output, size_t count, double epsijk)                                                                                                                          \
+  {                                                                                                                                                                                                    \
+    convert<double, KERNEL<double>>(input, output, count, epsijk);                                                                                                                                     \
+  }
+
+EBSD_BATCH_ENTRY_POINT(eu2qu, Eu2Qu)
+EBSD_BATCH_ENTRY_POINT(eu2om, Eu2Om)
+EBSD_BATCH_ENTRY_POINT(qu2eu, Qu2Eu)
+EBSD_BATCH_ENTRY_POINT(qu2om, Qu2Om)
+EBSD_BATCH_ENTRY_POINT(om2qu, Om2Qu)
+EBSD_BATCH_ENTRY_POINT(qu2ro, Qu2Ro)
+EBSD_BATCH_ENTRY_POINT(ro2qu, Ro2Qu)
+
+#undef EBSD_BATCH_ENTRY_POINT
+
+} // namespace OrientationBatch::EbsdLib_SIMD_ISA
@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -42,11 +45,13 @@
 #include <string>
 
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationRepresentation.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/OrientationMath/OrientationBatchKernels.hpp"
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -68,6 +73,9 @@
     return std::string(#name);                                                                                                                                                                         \
   }
 
+template <typename T>
+class FusedConvertRepresentation;
+
 /**
  * @brief This is the top level superclass for doing the conversions between orientation
  * representations
@@ -91,7 +99,7 @@ public:
    * @brief getOrientationRepresentation
    * @return
    */
-  OrientationRepresentation::Type getOrientationRepresentation()
+  virtual OrientationRepresentation::Type getOrientationRepresentation()
   {
     return OrientationRepresentation::Type::Unknown;
   }
@@ -133,6 +141,73 @@ public:
     }
   }
 
+  /**
+   * @brief convertRepresentationsTo Converts the input data to several representations in a
+   * single pass over the input. The input is sanity checked once, each input tuple is converted
+   * to a quaternion once and all of the requested representations are derived from that
+   * quaternion while it is still in cache. The output arrays are supplied by the caller so the
+   * same buffers can be reused across calls; an output whose number of tuples differs from the
+   * input is resized. The output data of this converter is not changed.
+   * @param repTypes The representations to convert to.
+   * @param outputs The arrays to write each representation into. Must be the same length as
+   * repTypes and each array must have the number of components of its representation.
+   * @return false if the arguments are invalid, in which case nothing is converted.
+   */
+  bool convertRepresentationsTo(const std::vector<OrientationRepresentation::Type>& repTypes, const std::vector<DataArrayPointerType>& outputs)
+  {
+    using FusedType = FusedConvertRepresentation<T>;
+    DataArrayPointerType input = this->getInputData();
+    OrientationRepresentation::Type inputType = getOrientationRepresentation();
+    if(nullptr == input || inputType == OrientationRepresentation::Type::Unknown || repTypes.size() != outputs.size())
+    {
+      return false;
+    }
+    std::vector<int32_t> componentCounts = GetComponentCounts<std::vector<int32_t>>();
+    size_t nTuples = input->getNumberOfTuples();
+    size_t inStride = static_cast<size_t>(input->getNumberOfComponents());
+    for(size_t i = 0; i < repTypes.size(); i++)
+    {
+      int repIndex = static_cast<int>(repTypes[i]);
+      if(repIndex < GetMinIndex() || repIndex > GetMaxIndex() || nullptr == outputs[i] || outputs[i]->getNumberOfComponents() != componentCounts[repIndex])
+      {
+        return false;
+      }
+    }
+
+    sanityCheckInputData();
+
+    std::vector<typename FusedType::Target> targets(repTypes.size());
+    bool needsQuaternions = false;
+    for(size_t i = 0; i < repTypes.size(); i++)
+    {
+      if(outputs[i]->getNumberOfTuples() != nTuples)
+      {
+        outputs[i]->resizeTuples(nTuples);
+      }
+      typename FusedType::Target& target = targets[i];
+      target.outPtr = outputs[i]->getPointer(0);
+      target.outStride = static_cast<size_t>(componentCounts[static_cast<int>(repTypes[i])]);
+      target.fromInput = (repTypes[i] == inputType);
+      target.convert = target.fromInput ? &FusedType::CopyTuples : FusedType::FromQuaternionFunction(repTypes[i]);
+      needsQuaternions = needsQuaternions || !target.fromInput;
+    }
+
+    typename FusedType::BlockConversionFunc toQuaternion = nullptr;
+    if(needsQuaternions && !(inputType == OrientationRepresentation::Type::Quaternion && inStride == FusedType::k_QuatStride))
+    {
+      toQuaternion = FusedType::ToQuaternionFunction(inputType, inStride);
+    }
+
+    T* inPtr = input->getPointer(0);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples, FusedType::k_BlockSize), FusedType(inPtr, inStride, toQuaternion, targets), tbb::auto_partitioner());
+#else
+    FusedType serial(inPtr, inStride, toQuaternion, targets);
+    serial.convert(0, nTuples);
+#endif
+    return true;
+  }
+
   /**
    * @brief toEulers Converts the input orientations to Euler Angles
    */
@@ -305,10 +380,10 @@ private:
     CLASSNAME() = default;                                                                                                                                                                             \
     void operator()(InputType* input, InputType* output)                                                                                                                                               \
     {                                                                                                                                                                                                  \
-      using OrientationInputType = Orientation<InputType>;                                                                                                                                             \
-      OrientationInputType inputOrientation(input, INSTRIDE);                                                                                                                                          \
-      OrientationInputType outputOrientation(output, OUTSTRIDE);                                                                                                                                       \
-      outputOrientation = OrientationTransformation::CONVERSION_METHOD<OrientationInputType, OrientationInputType>(inputOrientation);                                                                  \
+      using OrientationInputType = FixedOrientation<InputType, INSTRIDE>;                                                                                                                              \
+      using OrientationOutputType = FixedOrientation<InputType, OUTSTRIDE>;                                                                                                                            \
+      OrientationInputType inputOrientation(input);                                                                                                                                                    \
+      OrientationTransformation::CONVERSION_METHOD<OrientationInputType, OrientationOutputType>(inputOrientation).copyInto(output, OUTSTRIDE);                                                         \
     }                                                                                                                                                                                                  \
   };
 
@@ -320,9 +395,9 @@ private:
     CLASSNAME() = default;                                                                                                                                                                             \
     void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
-      using InputType = Orientation<NumericType>;                                                                                                                                                      \
+      using InputType = FixedOrientation<NumericType, INSTRIDE>;                                                                                                                                       \
       using OutputType = Quaternion<NumericType>;                                                                                                                                                      \
-      InputType inputOrientation(input, INSTRIDE);                                                                                                                                                     \
+      InputType inputOrientation(input);                                                                                                                                                               \
       OrientationTransformation::CONVERSION_METHOD<InputType, OutputType>(inputOrientation).copyInto(output, Quaternion<NumericType>::Order::VectorScalar);                                            \
     }                                                                                                                                                                                                  \
   };
@@ -336,10 +411,9 @@ private:
     void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
       using QuaternionType = Quaternion<NumericType>;                                                                                                                                                  \
-      using OutputType = Orientation<NumericType>;                                                                                                                                                     \
+      using OutputType = FixedOrientation<NumericType, OUTSTRIDE>;                                                                                                                                     \
       QuaternionType inputQuat(input[0], input[1], input[2], input[3]);                                                                                                                                \
-      OutputType outputOrientation = OrientationTransformation::CONVERSION_METHOD<QuaternionType, OutputType>(inputQuat);                                                                              \
-      outputOrientation.copyInto(output, OUTSTRIDE);                                                                                                                                                   \
+      OrientationTransformation::CONVERSION_METHOD<QuaternionType, OutputType>(inputQuat).copyInto(output, OUTSTRIDE);                                                                                 \
     }                                                                                                                                                                                                  \
   };
 
@@ -457,6 +531,232 @@ private:
   size_t m_OutStride = 0;
 };
 
+/**
+ * @brief This templated class is the functor that the TBB classes use to run one
+ * of the OrientationBatch structure-of-arrays kernels over a range of tuples. The
+ * input must be tightly packed, i.e., have exactly Kernel::k_InStride components.
+ */
+template <typename T, class Kernel>
+class ConvertRepresentationBatch
+{
+public:
+  ConvertRepresentationBatch(T* inPtr, T* outPtr)
+  : m_InPtr(inPtr)
+  , m_OutPtr(outPtr)
+  {
+  }
+  virtual ~ConvertRepresentationBatch() = default;
+
+  /**
+   * @brief This is the main conversion routine
+   * @param start Starting index
+   * @param end Ending index
+   */
+  void convert(size_t start, size_t end) const
+  {
+    OrientationBatch::convert<T, Kernel>(m_InPtr + (start * Kernel::k_InStride), m_OutPtr + (start * Kernel::k_OutStride), end - start);
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  T* m_InPtr = nullptr;
+  T* m_OutPtr = nullptr;
+};
+
+/**
+ * @brief This templated class is the functor that the TBB classes use to fill several
+ * output representations in a single pass over the input. A range of tuples is walked in
+ * small blocks: each block of input tuples is converted to quaternions once, the quaternions
+ * stay in cache, and every requested output is then derived from them. Where an
+ * OrientationBatch kernel exists for a step it is used instead of the scalar Convertors functor.
+ */
+template <typename T>
+class FusedConvertRepresentation
+{
+public:
+  /**
+   * @brief Converts count tuples from input (with inStride components per tuple) to output
+   * (with outStride components per tuple)
+   */
+  using BlockConversionFunc = void (*)(T* input, size_t inStride, T* output, size_t outStride, size_t count);
+
+  /**
+   * @brief A single requested output. When fromInput is true the tuples are converted
+   * directly from the input array, otherwise from the block of quaternions.
+   */
+  struct Target
+  {
+    BlockConversionFunc convert = nullptr;
+    T* outPtr = nullptr;
+    size_t outStride = 0;
+    bool fromInput = false;
+  };
+
+  static constexpr size_t k_BlockSize = 256;
+  static constexpr size_t k_QuatStride = 4;
+
+  /**
+   * @param inPtr The input tuples
+   * @param inStride The number of components of each input tuple
+   * @param toQuaternion Converts input tuples to quaternions. nullptr when the input already
+   * is packed quaternions or when no target needs the quaternions.
+   * @param targets The outputs to fill
+   */
+  FusedConvertRepresentation(T* inPtr, size_t inStride, BlockConversionFunc toQuaternion, const std::vector<Target>& targets)
+  : m_InPtr(inPtr)
+  , m_InStride(inStride)
+  , m_ToQuaternion(toQuaternion)
+  , m_Targets(targets)
+  {
+  }
+  virtual ~FusedConvertRepresentation() = default;
+
+  /**
+   * @brief This is the main conversion routine
+   * @param start Starting index
+   * @param end Ending index
+   */
+  void convert(size_t start, size_t end) const
+  {
+    std::array<T, k_BlockSize * k_QuatStride> quatBlock;
+    for(size_t blockStart = start; blockStart < end; blockStart += k_BlockSize)
+    {
+      size_t count = std::min(k_BlockSize, end - blockStart);
+      T* input = m_InPtr + (blockStart * m_InStride);
+      T* quats = input; /* Packed quaternion input is used in place */
+      if(m_ToQuaternion != nullptr)
+      {
+        m_ToQuaternion(input, m_InStride, quatBlock.data(), k_QuatStride, count);
+        quats = quatBlock.data();
+      }
+      for(const auto& target : m_Targets)
+      {
+        T* output = target.outPtr + (blockStart * target.outStride);
+        if(target.fromInput)
+        {
+          target.convert(input, m_InStride, output, target.outStride, count);
+        }
+        else
+        {
+          target.convert(quats, k_QuatStride, output, target.outStride, count);
+        }
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+  /**
+   * @brief Copies the first outStride components of each tuple
+   */
+  static void CopyTuples(T* input, size_t inStride, T* output, size_t outStride, size_t count)
+  {
+    if(inStride == outStride)
+    {
+      std::memcpy(output, input, count * outStride * sizeof(T));
+      return;
+    }
+    for(size_t i = 0; i < count; ++i)
+    {
+      std::copy(input + (i * inStride), input + (i * inStride) + outStride, output + (i * outStride));
+    }
+  }
+
+  /**
+   * @brief Converts the tuples one at a time with a Convertors functor
+   */
+  template <class Converter>
+  static void ConvertTuples(T* input, size_t inStride, T* output, size_t outStride, size_t count)
+  {
+    Converter conv;
+    for(size_t i = 0; i < count; ++i)
+    {
+      conv(input + (i * inStride), output + (i * outStride));
+    }
+  }
+
+  /**
+   * @brief Converts packed tuples with an OrientationBatch kernel
+   */
+  template <class Kernel>
+  static void ConvertTuplesBatch(T* input, size_t /* inStride */, T* output, size_t /* outStride */, size_t count)
+  {
+    OrientationBatch::convert<T, Kernel>(input, output, count);
+  }
+
+  /**
+   * @brief Returns the function that converts tuples of the given representation to quaternions
+   * @param repType The representation of the input
+   * @param inStride The number of components of each input tuple
+   */
+  static BlockConversionFunc ToQuaternionFunction(OrientationRepresentation::Type repType, size_t inStride)
+  {
+    switch(repType)
+    {
+    case OrientationRepresentation::Type::Euler:
+      return inStride == 3 ? &ConvertTuplesBatch<OrientationBatch::Eu2Qu<T>> : &ConvertTuples<Convertors::Eu2Qu<T>>;
+    case OrientationRepresentation::Type::OrientationMatrix:
+      return inStride == 9 ? &ConvertTuplesBatch<OrientationBatch::Om2Qu<T>> : &ConvertTuples<Convertors::Om2Qu<T>>;
+    case OrientationRepresentation::Type::Quaternion:
+      return &CopyTuples;
+    case OrientationRepresentation::Type::AxisAngle:
+      return &ConvertTuples<Convertors::Ax2Qu<T>>;
+    case OrientationRepresentation::Type::Rodrigues:
+      return inStride == 4 ? &ConvertTuplesBatch<OrientationBatch::Ro2Qu<T>> : &ConvertTuples<Convertors::Ro2Qu<T>>;
+    case OrientationRepresentation::Type::Homochoric:
+      return &ConvertTuples<Convertors::Ho2Qu<T>>;
+    case OrientationRepresentation::Type::Cubochoric:
+      return &ConvertTuples<Convertors::Cu2Qu<T>>;
+    default:
+      return nullptr;
+    }
+  }
+
+  /**
+   * @brief Returns the function that converts packed quaternions to the given representation
+   * @param repType The representation of the output
+   */
+  static BlockConversionFunc FromQuaternionFunction(OrientationRepresentation::Type repType)
+  {
+    switch(repType)
+    {
+    case OrientationRepresentation::Type::Euler:
+      return &ConvertTuplesBatch<OrientationBatch::Qu2Eu<T>>;
+    case OrientationRepresentation::Type::OrientationMatrix:
+      return &ConvertTuplesBatch<OrientationBatch::Qu2Om<T>>;
+    case OrientationRepresentation::Type::Quaternion:
+      return &CopyTuples;
+    case OrientationRepresentation::Type::AxisAngle:
+      return &ConvertTuples<Convertors::Qu2Ax<T>>;
+    case OrientationRepresentation::Type::Rodrigues:
+      return &ConvertTuplesBatch<OrientationBatch::Qu2Ro<T>>;
+    case OrientationRepresentation::Type::Homochoric:
+      return &ConvertTuples<Convertors::Qu2Ho<T>>;
+    case OrientationRepresentation::Type::Cubochoric:
+      return &ConvertTuples<Convertors::Qu2Cu<T>>;
+    default:
+      return nullptr;
+    }
+  }
+
+private:
+  T* m_InPtr = nullptr;
+  size_t m_InStride = 0;
+  BlockConversionFunc m_ToQuaternion = nullptr;
+  std::vector<Target> m_Targets;
+};
+
 /**
  * @brief OC_CONVERT_BODY Generates the body of method that will perform the conversion
  */
@@ -470,8 +770,7 @@ private:
   int inStride = input->getNumberOfComponents();                                                                                                                                                       \
   size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
   std::vector<size_t> cDims = {outStride};                                                                                                                                                             \
-  DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME, true);                                                                                                     \
-  output->initializeWithZeros(); /* Intialize the array with Zeros */                                                                                                                                  \
+  DataArrayPointerType output = DataArrayType::CreateUninitializedArray(nTuples, cDims, #OUT_ARRAY_NAME); /* Every value is written below */                                                           \
   T* outPtr = output->getPointer(0);                                                                                                                                                                   \
   tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());                            \
   this->setOutputData(output);
@@ -486,8 +785,7 @@ private:
   int inStride = input->getNumberOfComponents();                                                                                                                                                       \
   size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
   std::vector<size_t> cDims = {outStride}; /* Create the n component (nx1) based array.*/                                                                                                              \
-  DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME, true);                                                                                                     \
-  output->initializeWithZeros(); /* Intialize the array with Zeros */                                                                                                                                  \
+  DataArrayPointerType output = DataArrayType::CreateUninitializedArray(nTuples, cDims, #OUT_ARRAY_NAME); /* Every value is written below */                                                           \
   T* outPtr = output->getPointer(0);                                                                                                                                                                   \
   ConvertRepresentation<T, Convertors::FUNCTOR<T>> serial(inPtr, outPtr, inStride, outStride);                                                                                                         \
   serial.convert(0, nTuples);                                                                                                                                                                          \
@@ -495,6 +793,61 @@ private:
 
 #endif
 
+/**
+ * @brief OC_CONVERT_BATCH_BODY Generates the body of a method that will perform the conversion
+ * with the OrientationBatch kernel of the same name as FUNCTOR when the input tuples are packed
+ * and falls back to the Convertors functor otherwise.
+ */
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+
+#define OC_CONVERT_BATCH_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)                                                                                                                   \
+  sanityCheckInputData();                                                                                                                                                                              \
+  DataArrayPointerType input = this->getInputData();                                                                                                                                                   \
+  T* inPtr = input->getPointer(0);                                                                                                                                                                     \
+  size_t nTuples = this->getInputData()->getNumberOfTuples();                                                                                                                                          \
+  int inStride = input->getNumberOfComponents();                                                                                                                                                       \
+  size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
+  std::vector<size_t> cDims = {outStride};                                                                                                                                                             \
+  DataArrayPointerType output = DataArrayType::CreateUninitializedArray(nTuples, cDims, #OUT_ARRAY_NAME); /* Every value is written below */                                                           \
+  T* outPtr = output->getPointer(0);                                                                                                                                                                   \
+  using BatchKernelType = OrientationBatch::FUNCTOR<T>;                                                                                                                                                \
+  if(static_cast<size_t>(inStride) == BatchKernelType::k_InStride) /* Packed input uses the SoA batch kernel */                                                                                        \
+  {                                                                                                                                                                                                    \
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), ConvertRepresentationBatch<T, BatchKernelType>(inPtr, outPtr), tbb::auto_partitioner());                                                 \
+  }                                                                                                                                                                                                    \
+  else                                                                                                                                                                                                 \
+  {                                                                                                                                                                                                    \
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());                          \
+  }                                                                                                                                                                                                    \
+  this->setOutputData(output);
+
+#else
+
+#define OC_CONVERT_BATCH_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)                                                                                                                   \
+  sanityCheckInputData();                                                                                                                                                                              \
+  DataArrayPointerType input = this->getInputData();                                                                                                                                                   \
+  T* inPtr = input->getPointer(0);                                                                                                                                                                     \
+  size_t nTuples = this->getInputData()->getNumberOfTuples();                                                                                                                                          \
+  int inStride = input->getNumberOfComponents();                                                                                                                                                       \
+  size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
+  std::vector<size_t> cDims = {outStride};                                                                                                                                                             \
+  DataArrayPointerType output = DataArrayType::CreateUninitializedArray(nTuples, cDims, #OUT_ARRAY_NAME); /* Every value is written below */                                                           \
+  T* outPtr = output->getPointer(0);                                                                                                                                                                   \
+  using BatchKernelType = OrientationBatch::FUNCTOR<T>;                                                                                                                                                \
+  if(static_cast<size_t>(inStride) == BatchKernelType::k_InStride) /* Packed input uses the SoA batch kernel */                                                                                        \
+  {                                                                                                                                                                                                    \
+    ConvertRepresentationBatch<T, BatchKernelType> serial(inPtr, outPtr);                                                                                                                              \
+    serial.convert(0, nTuples);                                                                                                                                                                        \
+  }                                                                                                                                                                                                    \
+  else                                                                                                                                                                                                 \
+  {                                                                                                                                                                                                    \
+    ConvertRepresentation<T, Convertors::FUNCTOR<T>> serial(inPtr, outPtr, inStride, outStride);                                                                                                       \
+    serial.convert(0, nTuples);                                                                                                                                                                        \
+  }                                                                                                                                                                                                    \
+  this->setOutputData(output);
+
+#endif
+
 /* =============================================================================
  *
  * ===========================================================================*/
@@ -560,7 +913,7 @@ public:
 
   virtual ~EulerConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::Euler;
   }
@@ -574,12 +927,12 @@ public:
 
   void toOrientationMatrix() override
   {
-    OC_CONVERT_BODY(9, OrientationMatrix, eu2om, Eu2Om)
+    OC_CONVERT_BATCH_BODY(9, OrientationMatrix, eu2om, Eu2Om)
   }
 
   void toQuaternion() override
   {
-    OC_CONVERT_BODY(4, Quaternion, eu2qu, Eu2Qu)
+    OC_CONVERT_BATCH_BODY(4, Quaternion, eu2qu, Eu2Qu)
   }
 
   void toAxisAngle() override
@@ -745,7 +1098,7 @@ public:
 
   virtual ~OrientationMatrixConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::OrientationMatrix;
   }
@@ -766,7 +1119,7 @@ public:
   void toQuaternion() override
   {
     sanityCheckInputData();
-    OC_CONVERT_BODY(4, Quaternion, om2qu, Om2Qu)
+    OC_CONVERT_BATCH_BODY(4, Quaternion, om2qu, Om2Qu)
   }
 
   void toAxisAngle() override
@@ -911,19 +1264,19 @@ public:
 
   virtual ~QuaternionConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::Quaternion;
   }
 
   void toEulers() override
   {
-    OC_CONVERT_BODY(3, Eulers, qu2eu, Qu2Eu)
+    OC_CONVERT_BATCH_BODY(3, Eulers, qu2eu, Qu2Eu)
   }
 
   void toOrientationMatrix() override
   {
-    OC_CONVERT_BODY(9, OrientationMatrix, qu2om, Qu2Om)
+    OC_CONVERT_BATCH_BODY(9, OrientationMatrix, qu2om, Qu2Om)
   }
 
   void toQuaternion() override
@@ -941,7 +1294,7 @@ public:
 
   void toRodrigues() override
   {
-    OC_CONVERT_BODY(4, Rodrigues, qu2ro, Qu2Ro)
+    OC_CONVERT_BATCH_BODY(4, Rodrigues, qu2ro, Qu2Ro)
   }
 
   void toHomochoric() override
@@ -1069,7 +1422,7 @@ public:
 
   virtual ~AxisAngleConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::AxisAngle;
   }
@@ -1228,7 +1581,7 @@ public:
 
   virtual ~RodriguesConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::Rodrigues;
   }
@@ -1245,7 +1598,7 @@ public:
 
   void toQuaternion() override
   {
-    OC_CONVERT_BODY(4, Quaternions, ro2qu, Ro2Qu)
+    OC_CONVERT_BATCH_BODY(4, Quaternions, ro2qu, Ro2Qu)
   }
 
   void toAxisAngle() override
@@ -1387,7 +1740,7 @@ public:
 
   virtual ~HomochoricConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::Homochoric;
   }
@@ -1547,7 +1900,7 @@ public:
 
   virtual ~CubochoricConverter() = default;
 
-  OrientationRepresentation::Type getOrientationRepresentation()
+  OrientationRepresentation::Type getOrientationRepresentation() override
   {
     return OrientationRepresentation::Type::Cubochoric;
   }
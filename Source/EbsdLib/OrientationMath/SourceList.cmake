@@ -2,11 +2,35 @@ set(DIR_NAME OrientationMath)
 
 set(EbsdLib_${DIR_NAME}_HDRS
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationConverter.hpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernels.hpp
 )
 
 set(EbsdLib_${DIR_NAME}_SRCS
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernels.cpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsImpl.hpp
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsPortable.cpp
 )
 
+#------------------------------------------------------------------------------
+# The batch orientation kernels are compiled once per instruction set and the
+# best one is picked at runtime.
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+  if(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|amd64")
+    list(APPEND EbsdLib_${DIR_NAME}_SRCS
+      ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsAVX2.cpp
+      ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsAVX512.cpp
+    )
+    set_source_files_properties(${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsAVX2.cpp
+      PROPERTIES COMPILE_OPTIONS "${EbsdLib_BATCH_KERNEL_FLAGS};-mavx2")
+    set_source_files_properties(${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsAVX512.cpp
+      PROPERTIES COMPILE_OPTIONS "${EbsdLib_BATCH_KERNEL_FLAGS};-mavx512f")
+    set_source_files_properties(${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernels.cpp
+      PROPERTIES COMPILE_DEFINITIONS "EbsdLib_HAVE_AVX2_KERNELS;EbsdLib_HAVE_AVX512_KERNELS")
+  endif()
+endif()
+set_source_files_properties(${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/${DIR_NAME}/OrientationBatchKernelsPortable.cpp
+  PROPERTIES COMPILE_OPTIONS "${EbsdLib_BATCH_KERNEL_FLAGS}")
+
 #cmp_IDE_SOURCE_PROPERTIES( "OrientationMath" "${EbsdLib_OrientationMath_HDRS}" "${EbsdLib_OrientationMath_SRCS}" "0")
 
 if(EbsdLib_INSTALL_FILES)
@@ -24,6 +24,16 @@ endif(BUILD_SHARED_LIBS)
 
 include(${EbsdLibProj_SOURCE_DIR}/cmake/EbsdLibMacros.cmake)
 
+#-------------------------------------------------------------------------------
+# The batch kernels rely on the compiler vectorizing their loops which needs
+# -fno-math-errno so that sqrt() has no side effects and -fno-trapping-math so
+# that both sides of a select may be evaluated.
+#-------------------------------------------------------------------------------
+set(EbsdLib_BATCH_KERNEL_FLAGS "")
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+  set(EbsdLib_BATCH_KERNEL_FLAGS "-fno-math-errno;-fno-trapping-math")
+endif()
+
 #-------------------------------------------------------------------------------
 # Core
 #-------------------------------------------------------------------------------
@@ -0,0 +1,270 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/OdfGrid.hpp"
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief Kernels that smear weighted orientations (texture components) over the bins of an ODF.
+ * Each component adds its weight to the bins within 'sigma' bins of its own bin, scaled by
+ * 1 - (distance / sigma)^2. Bins that fall outside of the ODF grid are dropped.
+ */
+namespace ODFKernels
+{
+/**
+ * @brief The components are split into at most this many partitions that each add into their own
+ * copy of the ODF. The partitions only depend on the number of components so the result does not
+ * depend on the number of threads.
+ */
+constexpr size_t k_MaxPartitions = 32;
+// A partition is only created for at least this many components
+constexpr size_t k_MinComponentsPerPartition = 1024;
+// The upper limit of the memory used by the copies of the ODF of all the partitions
+constexpr size_t k_MaxAccumulatorBytes = 256 * 1024 * 1024;
+
+/**
+ * @brief A bin offset of a stencil and the fraction of the weight that is added to that bin
+ */
+struct StencilPoint
+{
+  std::array<int32_t, 3> offset;
+  float fraction;
+};
+
+using Stencil = std::vector<StencilPoint>;
+
+/**
+ * @brief Creates the stencil of all the bin offsets that are within 'radius' bins of the center
+ * @param radius The integer part of sigma
+ */
+inline Stencil CreateStencil(int32_t radius)
+{
+  Stencil stencil;
+  if(radius < 0)
+  {
+    return stencil;
+  }
+  if(radius == 0)
+  {
+    stencil.push_back({{0, 0, 0}, 1.0f});
+    return stencil;
+  }
+  for(int32_t j = -radius; j <= radius; j++)
+  {
+    for(int32_t k = -radius; k <= radius; k++)
+    {
+      for(int32_t l = -radius; l <= radius; l++)
+      {
+        const float dist = static_cast<float>(std::sqrt(static_cast<double>(j * j + k * k + l * l)));
+        if(dist <= static_cast<float>(radius))
+        {
+          const float fraction = static_cast<float>(1.0 - (double(dist / radius) * double(dist / radius)));
+          stencil.push_back({{j, k, l}, fraction});
+        }
+      }
+    }
+  }
+  return stencil;
+}
+
+/**
+ * @brief This is the functor that the TBB classes use to add the texture components of a range of
+ * partitions to the copy of the ODF of each partition.
+ */
+template <class LaueOpsType, class Container>
+class AccumulateODFImpl
+{
+public:
+  AccumulateODFImpl(const OdfGrid& grid, const Container& e1s, const Container& e2s, const Container& e3s, const Container& weights, const Container& sigmas, size_t numEntries,
+                    const std::vector<Stencil>& stencils, size_t numPartitions, std::vector<std::vector<double>>* accumulators, std::vector<double>* totalWeights)
+  : m_Grid(grid)
+  , m_E1s(e1s)
+  , m_E2s(e2s)
+  , m_E3s(e3s)
+  , m_Weights(weights)
+  , m_Sigmas(sigmas)
+  , m_NumEntries(numEntries)
+  , m_Stencils(stencils)
+  , m_NumPartitions(numPartitions)
+  , m_Accumulators(accumulators)
+  , m_TotalWeights(totalWeights)
+  {
+  }
+  virtual ~AccumulateODFImpl() = default;
+
+  void accumulate(size_t start, size_t end) const
+  {
+    LaueOpsType ops;
+    const std::array<size_t, 3> odfNumBins = m_Grid.getNumBins();
+    const std::array<int32_t, 3> numBins = {static_cast<int32_t>(odfNumBins[0]), static_cast<int32_t>(odfNumBins[1]), static_cast<int32_t>(odfNumBins[2])};
+
+    for(size_t p = start; p < end; p++)
+    {
+      double* odf = (*m_Accumulators)[p].data();
+      double totalWeight = 0.0;
+      const size_t first = p * m_NumEntries / m_NumPartitions;
+      const size_t last = (p + 1) * m_NumEntries / m_NumPartitions;
+      for(size_t i = first; i < last; i++)
+      {
+        if(!(m_Sigmas[i] >= 0))
+        {
+          continue;
+        }
+        OrientationF eu(m_E1s[i], m_E2s[i], m_E3s[i]);
+        OrientationD rod = OrientationTransformation::eu2ro<OrientationF, OrientationD>(eu);
+        rod = ops.getODFFZRod(rod);
+        const std::array<int32_t, 3> bin = m_Grid.getBinPosition(ops.getOdfBin(m_Grid, rod));
+
+        const Stencil& stencil = m_Stencils[static_cast<size_t>(m_Sigmas[i])];
+        for(const StencilPoint& point : stencil)
+        {
+          const int32_t addbin1 = bin[0] + point.offset[0];
+          const int32_t addbin2 = bin[1] + point.offset[1];
+          const int32_t addbin3 = bin[2] + point.offset[2];
+          if(addbin1 < 0 || addbin1 >= numBins[0] || addbin2 < 0 || addbin2 >= numBins[1] || addbin3 < 0 || addbin3 >= numBins[2])
+          {
+            continue;
+          }
+          const double addweight = m_Weights[i] * point.fraction;
+          odf[m_Grid.getIndex(addbin1, addbin2, addbin3)] += addweight;
+          totalWeight += addweight;
+        }
+      }
+      (*m_TotalWeights)[p] = totalWeight;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    accumulate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OdfGrid& m_Grid;
+  const Container& m_E1s;
+  const Container& m_E2s;
+  const Container& m_E3s;
+  const Container& m_Weights;
+  const Container& m_Sigmas;
+  size_t m_NumEntries = 0;
+  const std::vector<Stencil>& m_Stencils;
+  size_t m_NumPartitions = 1;
+  std::vector<std::vector<double>>* m_Accumulators = nullptr;
+  std::vector<double>* m_TotalWeights = nullptr;
+};
+
+/**
+ * @brief Adds the weights of all the texture components to the bins of an ODF
+ * @param grid The bins of the ODF
+ * @param e1s The first euler angles
+ * @param e2s The second euler angles
+ * @param e3s The third euler angles
+ * @param weights Array of weights values.
+ * @param sigmas Array of sigma values. The integer part is the radius of the component in bins.
+ * @param numEntries The number of components
+ * @param odf [output] The sum of the weights that were added to each bin. This is resized to the size of the grid
+ * @return The sum of all the weights that were added to the ODF
+ */
+template <class LaueOpsType, class Container>
+double AccumulateODF(const OdfGrid& grid, const Container& e1s, const Container& e2s, const Container& e3s, const Container& weights, const Container& sigmas, size_t numEntries,
+                     std::vector<double>& odf)
+{
+  const size_t odfSize = grid.size();
+  odf.assign(odfSize, 0.0);
+
+  // One stencil for each integer sigma. These only depend on the radius so they are shared by all the components.
+  int32_t maxRadius = -1;
+  for(size_t i = 0; i < numEntries; i++)
+  {
+    if(sigmas[i] >= 0)
+    {
+      maxRadius = std::max(maxRadius, static_cast<int32_t>(sigmas[i]));
+    }
+  }
+  std::vector<Stencil> stencils(static_cast<size_t>(maxRadius + 1));
+  for(int32_t radius = 0; radius <= maxRadius; radius++)
+  {
+    stencils[radius] = CreateStencil(radius);
+  }
+
+  // The first partition adds directly into the output so a small number of components does not allocate anything else
+  const size_t maxPartitions = std::max(static_cast<size_t>(1), k_MaxAccumulatorBytes / (std::max(odfSize, static_cast<size_t>(1)) * sizeof(double)));
+  const size_t numPartitions = std::max(static_cast<size_t>(1), std::min({numEntries / k_MinComponentsPerPartition, k_MaxPartitions, maxPartitions}));
+  std::vector<std::vector<double>> accumulators(numPartitions);
+  accumulators[0].swap(odf);
+  for(size_t p = 1; p < numPartitions; p++)
+  {
+    accumulators[p].resize(odfSize, 0.0);
+  }
+  std::vector<double> totalWeights(numPartitions, 0.0);
+
+  AccumulateODFImpl<LaueOpsType, Container> impl(grid, e1s, e2s, e3s, weights, sigmas, numEntries, stencils, numPartitions, &accumulators, &totalWeights);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numPartitions, 1), impl, tbb::auto_partitioner());
+#else
+  impl.accumulate(0, numPartitions);
+#endif
+
+  // Merge the partitions in order
+  odf.swap(accumulators[0]);
+  double totalWeight = totalWeights[0];
+  for(size_t p = 1; p < numPartitions; p++)
+  {
+    const std::vector<double>& partition = accumulators[p];
+    for(size_t i = 0; i < odfSize; i++)
+    {
+      odf[i] += partition[i];
+    }
+    totalWeight += totalWeights[p];
+  }
+  return totalWeight;
+}
+} // namespace ODFKernels
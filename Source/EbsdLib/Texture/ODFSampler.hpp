@@ -0,0 +1,369 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/OdfGrid.hpp"
+#include "EbsdLib/Math/Philox4x32.hpp"
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @class ODFSampler ODFSampler.hpp EbsdLib/Texture/ODFSampler.hpp
+ * @brief Draws ODF bins with a probability proportional to their density. The cumulative
+ * density of the ODF is computed once so each draw is a binary search instead of a linear
+ * scan over all the bins. A uniform random number selects the same bin as the linear scan
+ * that it replaces: the first bin whose cumulative density is larger than the random number.
+ * The densities are summed in T, in bin order, and the random number is rounded to T, the
+ * same as the linear scan, so rounding of the running sum picks the same bins as before.
+ * The sampler only holds the cumulative density so it can be built once per ODF and shared
+ * between calls and threads.
+ */
+template <typename T = float>
+class ODFSampler
+{
+public:
+  /**
+   * @brief Builds the sampler for the first 'odfSize' bins of an ODF
+   * @param odf The ODF bin data
+   * @param odfSize The number of ODF bins, normally LaueOps::getODFSize()
+   */
+  template <class ContainerType>
+  ODFSampler(const ContainerType& odf, size_t odfSize)
+  : m_Cumulative(odfSize)
+  {
+    T totalDensity = 0;
+    for(size_t i = 0; i < odfSize; i++)
+    {
+      totalDensity = totalDensity + static_cast<T>(odf[i]);
+      m_Cumulative[i] = totalDensity;
+    }
+  }
+
+  ~ODFSampler() = default;
+
+  ODFSampler(const ODFSampler&) = default;
+  ODFSampler(ODFSampler&&) = default;
+  ODFSampler& operator=(const ODFSampler&) = default;
+  ODFSampler& operator=(ODFSampler&&) = default;
+
+  /**
+   * @brief Returns the number of ODF bins
+   */
+  size_t size() const
+  {
+    return m_Cumulative.size();
+  }
+
+  /**
+   * @brief Returns the sum of the densities of all the bins
+   */
+  double getTotalDensity() const
+  {
+    return m_Cumulative.empty() ? 0.0 : static_cast<double>(m_Cumulative.back());
+  }
+
+  /**
+   * @brief Returns the bin that a uniform random number in [0,1) falls into. Bin 0 is
+   * returned when the random number is larger than the total density of the ODF.
+   * @param random The uniform random number
+   */
+  int sample(double random) const
+  {
+    const T value = static_cast<T>(random);
+    const auto iter = std::upper_bound(m_Cumulative.begin(), m_Cumulative.end(), value);
+    if(iter == m_Cumulative.end() || value < 0)
+    {
+      return 0;
+    }
+    return static_cast<int>(iter - m_Cumulative.begin());
+  }
+
+  /**
+   * @brief Draws a bin from the ODF
+   * @param generator The random number generator
+   */
+  int sample(EbsdLib::Philox4x32& generator) const
+  {
+    return sample(generator.nextDouble());
+  }
+
+private:
+  std::vector<T> m_Cumulative;
+};
+
+namespace ODFSampling
+{
+/**
+ * @brief The number of orientations that are drawn from one random number stream. The
+ * samples of a block only depend on the seed and the block index so the output does not
+ * depend on the number of threads.
+ */
+constexpr size_t k_BlockSize = 4096;
+
+/**
+ * @brief This is the functor that the TBB classes use to draw random orientations from an
+ * ODF. Each block of k_BlockSize orientations uses its own stream of the generator.
+ */
+template <typename T, class LaueOpsType>
+class GenerateEulersImpl
+{
+public:
+  GenerateEulersImpl(const OdfGrid& grid, const ODFSampler<T>& sampler, T* eulers, size_t npoints, uint64_t seed)
+  : m_Grid(grid)
+  , m_Sampler(sampler)
+  , m_Eulers(eulers)
+  , m_NumPoints(npoints)
+  , m_Seed(seed)
+  {
+  }
+  virtual ~GenerateEulersImpl() = default;
+
+  void generate(size_t startBlock, size_t endBlock) const
+  {
+    LaueOpsType ops;
+    std::array<double, 3> randx3 = {0.0, 0.0, 0.0};
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      EbsdLib::Philox4x32 generator(m_Seed, block);
+      const size_t end = std::min(m_NumPoints, (block + 1) * k_BlockSize);
+      for(size_t i = block * k_BlockSize; i < end; i++)
+      {
+        const int choose = m_Sampler.sample(generator);
+        randx3[0] = generator.nextDouble();
+        randx3[1] = generator.nextDouble();
+        randx3[2] = generator.nextDouble();
+        OrientationD eu = ops.determineEulerAngles(m_Grid, randx3.data(), choose);
+        m_Eulers[3 * i + 0] = static_cast<T>(eu[0]);
+        m_Eulers[3 * i + 1] = static_cast<T>(eu[1]);
+        m_Eulers[3 * i + 2] = static_cast<T>(eu[2]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OdfGrid& m_Grid;
+  const ODFSampler<T>& m_Sampler;
+  T* m_Eulers = nullptr;
+  size_t m_NumPoints = 0;
+  uint64_t m_Seed = 0;
+};
+
+/**
+ * @brief Draws random orientations from an ODF
+ * @param grid The bins of the ODF
+ * @param sampler The sampler of the ODF
+ * @param eulers [output] The Euler angles of the orientations. This memory must already be preallocated to 3 * npoints values.
+ * @param npoints The number of orientations to draw
+ * @param seed The seed of the random number generator
+ */
+template <typename T, class LaueOpsType>
+void GenerateEulers(const OdfGrid& grid, const ODFSampler<T>& sampler, T* eulers, size_t npoints, uint64_t seed)
+{
+  const size_t numBlocks = (npoints + k_BlockSize - 1) / k_BlockSize;
+  GenerateEulersImpl<T, LaueOpsType> impl(grid, sampler, eulers, npoints, seed);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numBlocks);
+#endif
+}
+
+/**
+ * @brief The number of random misorientations that Texture::CalculateMDFData draws by default
+ */
+constexpr size_t k_DefaultMDFSampleCount = 10000;
+
+/**
+ * @brief The number of accepted misorientations that are drawn from one random number stream
+ */
+constexpr size_t k_MDFBlockSize = 256;
+
+/**
+ * @brief The blocks of misorientations are split into at most this many partitions that each count
+ * into their own histogram.
+ */
+constexpr size_t k_MaxMDFPartitions = 32;
+
+/**
+ * @brief Draws two orientations from the ODF and returns the MDF bin of their misorientation
+ * @param ops The Laue class of the ODF
+ * @param grid The bins of the ODF and the MDF
+ * @param sampler The sampler of the ODF
+ * @param generator The random number generator
+ */
+template <class LaueOpsType>
+int SampleMisorientationBin(const LaueOpsType& ops, const OdfGrid& grid, const ODFSampler<float>& sampler, EbsdLib::Philox4x32& generator)
+{
+  const int choose1 = sampler.sample(generator);
+  const int choose2 = sampler.sample(generator);
+  // This is used to create a random Homochoric vector
+  std::array<double, 3> randx3 = {generator.nextDouble(), generator.nextDouble(), generator.nextDouble()};
+  OrientationD eu = ops.determineEulerAngles(grid, randx3.data(), choose1);
+  QuatD q1 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+
+  randx3 = {generator.nextDouble(), generator.nextDouble(), generator.nextDouble()};
+  eu = ops.determineEulerAngles(grid, randx3.data(), choose2);
+  QuatD q2 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+  OrientationD ax = ops.calculateMisorientation(q1, q2);
+  OrientationD ro = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
+
+  ro = ops.getMDFFZRod(ro); // <==== THIS IS NOT IMPELMENTED FOR ALL LAUE CLASSES
+  return ops.getMisoBin(grid, ro);
+}
+
+/**
+ * @brief This is the functor that the TBB classes use to draw random misorientations from an ODF.
+ * The blocks of each partition are counted into the histogram of that partition. Misorientations
+ * that fall into a reserved bin are rejected and drawn again from the same stream so every block
+ * contributes exactly k_MDFBlockSize misorientations.
+ */
+template <class LaueOpsType>
+class SampleMisorientationsImpl
+{
+public:
+  SampleMisorientationsImpl(const OdfGrid& grid, const ODFSampler<float>& sampler, const std::vector<bool>& reserved, size_t numSamples, size_t numPartitions, uint64_t seed,
+                            std::vector<std::vector<uint32_t>>* histograms)
+  : m_Grid(grid)
+  , m_Sampler(sampler)
+  , m_Reserved(reserved)
+  , m_NumSamples(numSamples)
+  , m_NumPartitions(numPartitions)
+  , m_Seed(seed)
+  , m_Histograms(histograms)
+  {
+  }
+  virtual ~SampleMisorientationsImpl() = default;
+
+  void sample(size_t start, size_t end) const
+  {
+    LaueOpsType ops;
+    const size_t numBlocks = (m_NumSamples + k_MDFBlockSize - 1) / k_MDFBlockSize;
+    for(size_t p = start; p < end; p++)
+    {
+      std::vector<uint32_t>& histogram = (*m_Histograms)[p];
+      const size_t firstBlock = p * numBlocks / m_NumPartitions;
+      const size_t lastBlock = (p + 1) * numBlocks / m_NumPartitions;
+      for(size_t block = firstBlock; block < lastBlock; block++)
+      {
+        EbsdLib::Philox4x32 generator(m_Seed, block);
+        const size_t count = std::min(k_MDFBlockSize, m_NumSamples - block * k_MDFBlockSize);
+        size_t accepted = 0;
+        while(accepted < count)
+        {
+          const int mbin = SampleMisorientationBin(ops, m_Grid, m_Sampler, generator);
+          if(m_Reserved[static_cast<size_t>(mbin)])
+          {
+            continue;
+          }
+          histogram[static_cast<size_t>(mbin)]++;
+          accepted++;
+        }
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    sample(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OdfGrid& m_Grid;
+  const ODFSampler<float>& m_Sampler;
+  const std::vector<bool>& m_Reserved;
+  size_t m_NumSamples = 0;
+  size_t m_NumPartitions = 1;
+  uint64_t m_Seed = 0;
+  std::vector<std::vector<uint32_t>>* m_Histograms = nullptr;
+};
+
+/**
+ * @brief Draws random misorientations from an ODF and counts them into the bins of an MDF. The
+ * partition histograms hold integer counts so the merged histogram only depends on the seed and
+ * the number of samples, not on the number of threads.
+ * @param grid The bins of the ODF and the MDF
+ * @param sampler The sampler of the ODF
+ * @param reserved The MDF bins that no misorientation may be counted into. Its size is the size of the MDF.
+ * @param numSamples The number of misorientations to count
+ * @param seed The seed of the random number generator
+ * @return The number of misorientations in each MDF bin
+ */
+template <class LaueOpsType>
+std::vector<uint64_t> SampleMisorientations(const OdfGrid& grid, const ODFSampler<float>& sampler, const std::vector<bool>& reserved, size_t numSamples, uint64_t seed)
+{
+  const size_t mdfSize = reserved.size();
+  const size_t numBlocks = (numSamples + k_MDFBlockSize - 1) / k_MDFBlockSize;
+  const size_t numPartitions = std::max(static_cast<size_t>(1), std::min(numBlocks, k_MaxMDFPartitions));
+  std::vector<std::vector<uint32_t>> histograms(numPartitions, std::vector<uint32_t>(mdfSize, 0));
+
+  SampleMisorientationsImpl<LaueOpsType> impl(grid, sampler, reserved, numSamples, numPartitions, seed, &histograms);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numPartitions, 1), impl, tbb::auto_partitioner());
+#else
+  impl.sample(0, numPartitions);
+#endif
+
+  std::vector<uint64_t> counts(mdfSize, 0);
+  for(const auto& histogram : histograms)
+  {
+    for(size_t i = 0; i < mdfSize; i++)
+    {
+      counts[i] += histogram[i];
+    }
+  }
+  return counts;
+}
+} // namespace ODFSampling
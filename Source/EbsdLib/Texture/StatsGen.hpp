@@ -39,14 +39,17 @@
 #define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
 #endif
 
-#include <chrono>
-#include <random>
+#include <array>
+#include <cstdint>
+#include <iostream>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/LaueOps/LaueOps.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
+#include "EbsdLib/Math/Philox4x32.hpp"
+#include "EbsdLib/Texture/ODFSampler.hpp"
 #include "EbsdLib/Texture/Texture.hpp"
 
 /**
@@ -240,49 +243,59 @@ public:
    * @param odf Pointer to ODF bin data which has been sized to CubicOps::k_OdfSize
    * @param eulers Euler angles to be generated. This memory must already be preallocated.
    * @param npoints The number of points for the Scatter Plot which is at least the number of elements used in the allocation of the various output arrays.
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
    */
   template <typename T, class LaueOpsType, class ContainerType>
-  static int GenODFPlotData(const ContainerType& odf, T* eulers, size_t npoints)
+  static int GenODFPlotData(const ContainerType& odf, T* eulers, size_t npoints, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
   {
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
-    std::array<double, 3> randx3;
+    LaueOpsType ops;
+    return GenODFPlotData<T, LaueOpsType, ContainerType>(odf, ops.getOdfGrid(), eulers, npoints, seed);
+  }
 
-    int err = 0;
-    int choose = 0;
-    T totaldensity;
-    T random, density;
+  /**
+   * @brief Generates random orientations from an ODF that was calculated on a specific grid
+   * @param odf The ODF bin data
+   * @param grid The ODF grid of the parameterized LaueOps class
+   * @param eulers Euler angles to be generated. This memory must already be preallocated.
+   * @param npoints The number of points for the Scatter Plot which is at least the number of elements used in the allocation of the various output arrays.
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
+   */
+  template <typename T, class LaueOpsType, class ContainerType>
+  static int GenODFPlotData(const ContainerType& odf, const OdfGrid& grid, T* eulers, size_t npoints, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
+  {
+    ODFSampler<T> sampler(odf, grid.size());
+    return GenODFPlotData<T, LaueOpsType>(grid, sampler, eulers, npoints, seed);
+  }
 
+  /**
+   * @brief Generates random orientations from an ODF that has already been prepared for sampling.
+   * Building the ODFSampler once and reusing it avoids recomputing the cumulative density when
+   * several sets of orientations are generated from the same ODF.
+   * @param sampler The sampler built from the ODF bin data
+   * @param eulers Euler angles to be generated. This memory must already be preallocated.
+   * @param npoints The number of points for the Scatter Plot which is at least the number of elements used in the allocation of the various output arrays.
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
+   */
+  template <typename T, class LaueOpsType>
+  static int GenODFPlotData(const ODFSampler<T>& sampler, T* eulers, size_t npoints, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
+  {
     LaueOpsType ops;
-    T td1;
-    for(size_t i = 0; i < npoints; i++)
-    {
-      random = distribution(generator);
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < ops.getODFSize(); j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      randx3[0] = distribution(generator);
-      randx3[1] = distribution(generator);
-      randx3[2] = distribution(generator);
-      OrientationD eu = ops.determineEulerAngles(randx3.data(), choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    return GenODFPlotData<T, LaueOpsType>(ops.getOdfGrid(), sampler, eulers, npoints, seed);
+  }
+
+  /**
+   * @brief Generates random orientations from an ODF on a specific grid that has already been prepared for sampling.
+   * @param grid The ODF grid of the parameterized LaueOps class
+   * @param sampler The sampler built from the ODF bin data
+   * @param eulers Euler angles to be generated. This memory must already be preallocated.
+   * @param npoints The number of points for the Scatter Plot which is at least the number of elements used in the allocation of the various output arrays.
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
+   */
+  template <typename T, class LaueOpsType>
+  static int GenODFPlotData(const OdfGrid& grid, const ODFSampler<T>& sampler, T* eulers, size_t npoints, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
+  {
+    ODFSampling::GenerateEulers<T, LaueOpsType>(grid, sampler, eulers, npoints, seed);
+    return 0;
   }
 #if 0
 
@@ -444,16 +457,13 @@ public:
    * @param xC X Values of the C axis PF Scatter plot (Output). This memory must already be preallocated.
    * @param yC Y Values of the C axis PF Scatter plot (Output). This memory must already be preallocated.
    * @param size The number of points for the Scatter Plot
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
    */
   template <typename T>
-  static int GenAxisODFPlotData(T* odf, T* eulers, int npoints)
+  static int GenAxisODFPlotData(T* odf, T* eulers, int npoints, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
   {
 
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
+    EbsdLib::Philox4x32 generator(seed);
     std::array<double, 3> randx3;
 
     int err = 0;
@@ -465,7 +475,7 @@ public:
     float td1;
     for(int i = 0; i < npoints; i++)
     {
-      random = distribution(generator);
+      random = generator.nextDouble();
       choose = 0;
       totaldensity = 0;
       for(int j = 0; j < ops.getODFSize(); j++)
@@ -479,9 +489,9 @@ public:
           break;
         }
       }
-      randx3[0] = distribution(generator);
-      randx3[1] = distribution(generator);
-      randx3[2] = distribution(generator);
+      randx3[0] = generator.nextDouble();
+      randx3[1] = generator.nextDouble();
+      randx3[2] = generator.nextDouble();
       OrientationD eu = ops.determineEulerAngles(randx3.data(), choose);
       eulers[3 * i + 0] = eu[0];
       eulers[3 * i + 1] = eu[1];
@@ -498,28 +508,39 @@ public:
    * @param y [outout] Y Values of the Scatter plot. This memory must already be preallocated.
    * @param npoints The number of XY points for the Scatter Plot
    * @param size The number of samples of the MDF to take
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
+   */
+  template <typename T, class LaueOpsType, class ContainerType>
+  static int GenMDFPlotData(ContainerType& mdf, ContainerType& xval, ContainerType& yval, int size, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
+  {
+    LaueOpsType ops;
+    return GenMDFPlotData<T, LaueOpsType, ContainerType>(mdf, ops.getOdfGrid(), xval, yval, size, seed);
+  }
+
+  /**
+   * @brief  This method will generate MDF data from an MDF that was calculated on a specific grid and
+   * generate 1 XY scatter plots.
+   * @param mdf [input] This is the input MDF data which is already computed on the grid
+   * @param grid The MDF grid of the parameterized LaueOps class
+   * @param x [output] X Values of the Scatter plot.
+   * @param y [outout] Y Values of the Scatter plot.
+   * @param size The number of samples of the MDF to take
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
    */
   template <typename T, class LaueOpsType, class ContainerType>
-  static int GenMDFPlotData(ContainerType& mdf, ContainerType& xval, ContainerType& yval, int size)
+  static int GenMDFPlotData(ContainerType& mdf, const OdfGrid& grid, ContainerType& xval, ContainerType& yval, int size, uint64_t seed = EbsdLib::Philox4x32::RandomSeed())
   {
     float radtodeg = 180.0f / static_cast<float>(M_PI);
 
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
+    EbsdLib::Philox4x32 generator(seed);
 
     int err = 0;
-    float density = 0.0f;
-    float totaldensity = 0.0f;
     int choose = 0;
-    float random = 0.0f;
 
     LaueOpsType ops;
     xval.resize(ops.getMdfPlotBins());
     yval.resize(ops.getMdfPlotBins());
-    int32_t opsMdfSize = ops.getMDFSize();
+    const ODFSampler<float> sampler(mdf, grid.size());
     std::array<double, 3> randx3;
 
     for(int i = 0; i < yval.size(); i++)
@@ -527,28 +548,14 @@ public:
       yval[i] = 0.0f;
     }
 
-    float td1 = 0.0f;
     for(int i = 0; i < size; i++)
     {
-      random = static_cast<float>(distribution(generator));
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < opsMdfSize; j++)
-      {
-        density = mdf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = sampler.sample(generator);
 
       // Create a random rod vector
-      randx3 = {distribution(generator), distribution(generator), distribution(generator)};
+      randx3 = {generator.nextDouble(), generator.nextDouble(), generator.nextDouble()};
 
-      OrientationD rod = ops.determineRodriguesVector(randx3.data(), choose);
+      OrientationD rod = ops.determineRodriguesVector(grid, randx3.data(), choose);
       OrientationD ax = OrientationTransformation::ro2ax<OrientationD, OrientationD>(rod);
 
       float w = static_cast<float>(ax[3] * radtodeg);
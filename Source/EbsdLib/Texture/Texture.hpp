@@ -35,9 +35,9 @@
 
 #pragma once
 
-#include <chrono>
+#include <array>
+#include <cstdint>
 #include <fstream>
-#include <random>
 #include <vector>
 
 #include <string>
@@ -53,6 +53,9 @@
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
+#include "EbsdLib/Math/Philox4x32.hpp"
+#include "EbsdLib/Texture/ODFKernels.hpp"
+#include "EbsdLib/Texture/ODFSampler.hpp"
 
 /**
  * @brief This class holds default data for Orientation Distribution Function (ODF)
@@ -86,120 +89,49 @@ public:
   static void CalculateODFData(Container& e1s, Container& e2s, Container& e3s, Container& weights, Container& sigmas, bool normalize, Container& odf, size_t numEntries)
   {
     LaueOps ops;
-    std::array<size_t, 3> odfNumBins = ops.getOdfNumBins();
-    odf.resize(ops.getODFSize());
-    EbsdLib::Int32ArrayType::Pointer textureBins = EbsdLib::Int32ArrayType::CreateArray(numEntries, "TextureBins", true);
-    int32_t* TextureBins = textureBins->getPointer(0);
+    CalculateODFData<T, LaueOps, Container>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries, ops.getOdfGrid());
+  }
 
-    float addweight = 0;
-    float totaladdweight = 0;
-    float totalweight = float(ops.getODFSize());
-    int bin, addbin;
-    int bin1, bin2, bin3;
-    int addbin1, addbin2, addbin3;
-    float dist, fraction;
-    // Use double precision for the calculations
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      OrientationF eu(e1s[i], e2s[i], e3s[i]);
-      OrientationD rod = OrientationTransformation::eu2ro<OrientationF, OrientationD>(eu);
+  /**
+   * @brief This will calculate ODF data on a specific ODF grid, e.g. one created with
+   * LaueOps::createOdfGrid() for a finer bin size than the default 5 degrees.
+   * @param e1s The first euler angles
+   * @param e2s The second euler angles
+   * @param e3s The third euler angles
+   * @param weights Array of weights values.
+   * @param sigmas Array of sigma values in bins of the grid.
+   * @param normalize Should the ODF data be normalized by the totalWeight value
+   * before returning.
+   * @param odf (OUT) The ODF data that is generated from this function. It is resized to the size of the grid.
+   * @param numEntries The number of entries in the euler, weight and sigma arrays
+   * @param grid The ODF grid of the parameterized LaueOps class
+   */
+  template <typename T, class LaueOps, class Container>
+  static void CalculateODFData(Container& e1s, Container& e2s, Container& e3s, Container& weights, Container& sigmas, bool normalize, Container& odf, size_t numEntries, const OdfGrid& grid)
+  {
+    const int odfSize = static_cast<int>(grid.size());
+    odf.resize(odfSize);
 
-      rod = ops.getODFFZRod(rod);
-      bin = ops.getOdfBin(rod);
-      TextureBins[i] = static_cast<int>(bin);
-    }
+    std::vector<double> odfSum;
+    const double totaladdweight = ODFKernels::AccumulateODF<LaueOps, Container>(grid, e1s, e2s, e3s, weights, sigmas, numEntries, odfSum);
 
-    for(int i = 0; i < ops.getODFSize(); i++)
-    {
-      odf[i] = 0;
-    }
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      bin = TextureBins[i];
-      bin1 = bin % odfNumBins[0];
-      bin2 = static_cast<int32_t>((bin / odfNumBins[0]) % odfNumBins[1]);
-      bin3 = bin / static_cast<int32_t>((odfNumBins[0] * odfNumBins[1]));
-      for(int j = static_cast<int>(-sigmas[i]); j <= sigmas[i]; j++)
-      {
-        int jsqrd = j * j;
-        for(int k = static_cast<int>(-sigmas[i]); k <= sigmas[i]; k++)
-        {
-          int ksqrd = k * k;
-          for(int l = static_cast<int>(-sigmas[i]); l <= sigmas[i]; l++)
-          {
-            int lsqrd = l * l;
-            addbin1 = bin1 + int(j);
-            addbin2 = bin2 + int(k);
-            addbin3 = bin3 + int(l);
-            int good = 1;
-            if(addbin1 < 0)
-            {
-              good = 0;
-            }
-            if(addbin1 >= odfNumBins[0])
-            {
-              good = 0;
-            }
-            if(addbin2 < 0)
-            {
-              good = 0;
-            }
-            if(addbin2 >= odfNumBins[1])
-            {
-              good = 0;
-            }
-            if(addbin3 < 0)
-            {
-              good = 0;
-            }
-            if(addbin3 >= odfNumBins[2])
-            {
-              good = 0;
-            }
-            addbin = static_cast<int>((addbin3 * odfNumBins[0] * odfNumBins[1]) + (addbin2 * odfNumBins[0]) + (addbin1));
-            dist = static_cast<float>(std::pow(static_cast<float>(jsqrd + ksqrd + lsqrd), 0.5));
-            fraction = static_cast<float>(1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i]))));
-            if(dist <= int(sigmas[i]) && good == 1)
-            {
-              addweight = (weights[i] * fraction);
-              if(sigmas[i] == 0.0)
-              {
-                addweight = weights[i];
-              }
-              odf[addbin] = odf[addbin] + addweight;
-              totaladdweight = totaladdweight + addweight;
-            }
-          }
-        }
-      }
-    }
-    // These next loops *look* like they can be parallelized but the arrays are not large enough
-    // to see any benefit so don't go down that road. std::transform is also slower than the
-    // manual loops that are coded.
+    // Either scale the ODF down to the total weight or fill up the remaining weight with a uniform
+    // background, then optionally normalize. All of this is applied in a single pass.
+    const double totalweight = static_cast<double>(odfSize);
+    double scale = 1.0;
+    double background = 0.0;
     if(totaladdweight > totalweight)
     {
-      float scale = (totaladdweight / totalweight);
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / scale;
-      }
+      scale = totaladdweight / totalweight;
     }
     else
     {
-      float remainingweight = totalweight - totaladdweight;
-      float background = remainingweight / static_cast<float>(ops.getODFSize());
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] += background;
-      }
+      background = (totalweight - totaladdweight) / totalweight;
     }
-    if(normalize)
+    const double normalization = normalize ? totalweight : 1.0;
+    for(int i = 0; i < odfSize; i++)
     {
-      // Normalize the odf
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / totalweight;
-      }
+      odf[i] = static_cast<T>((odfSum[i] / scale + background) / normalization);
     }
   }
 
@@ -213,33 +145,49 @@ public:
    * @param numEntries The number of elemnts in teh Angles/Axes/Weights arrays which should all the be same size or at least
    * the value passed here is the minium size of all the arrays. The sizes of the ODF and MDF arrays are
    * determined by calling the getODFSize and getMDFSize functions of the parameterized LaueOps class.
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
+   * @param numSamples The number of random misorientations that make up the MDF. More samples give a smoother MDF.
    */
   template <typename T, class LaueOps, class Container>
-  static void CalculateMDFData(Container& angles, Container& axes, Container& weights, const Container& odf, Container& mdf, size_t numEntries)
+  static void CalculateMDFData(Container& angles, Container& axes, Container& weights, const Container& odf, Container& mdf, size_t numEntries,
+                               uint64_t seed = EbsdLib::Philox4x32::RandomSeed(), size_t numSamples = ODFSampling::k_DefaultMDFSampleCount)
   {
+    LaueOps orientationOps;
+    CalculateMDFData<T, LaueOps, Container>(angles, axes, weights, odf, mdf, numEntries, orientationOps.getOdfGrid(), seed, numSamples);
+  }
 
+  /**
+   * @brief CalculateMDFData Calculates MDF (Misorientation Distribution Function) data on a specific grid. The
+   * ODF must have been calculated on the same grid.
+   * @param angles The angles
+   * @param axes The axes
+   * @param weights The weights
+   * @param odf The ODF which has been already computed on the grid
+   * @param mdf [output] The MDF array. It is resized to the size of the grid.
+   * @param numEntries The number of elements in the Angles/Axes/Weights arrays
+   * @param grid The ODF and MDF grid of the parameterized LaueOps class
+   * @param seed The seed of the random number generator. The same seed always generates the same data.
+   * @param numSamples The number of random misorientations that make up the MDF. More samples give a smoother MDF.
+   */
+  template <typename T, class LaueOps, class Container>
+  static void CalculateMDFData(Container& angles, Container& axes, Container& weights, const Container& odf, Container& mdf, size_t numEntries, const OdfGrid& grid,
+                               uint64_t seed = EbsdLib::Philox4x32::RandomSeed(), size_t numSamples = ODFSampling::k_DefaultMDFSampleCount)
+  {
     LaueOps orientationOps;
     const size_t odfsize = odf.size();
-    const int mdfsize = orientationOps.getMDFSize();
-    mdf.resize(orientationOps.getMDFSize());
+    const int mdfsize = static_cast<int>(grid.size());
+    mdf.resize(mdfsize);
 
-    // Create a Random Number generator
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
+    // Build the cumulative density of the ODF once instead of scanning it for every sample
+    const ODFSampler<float> sampler(odf, odfsize);
 
     int mbin;
-    int choose1, choose2;
-    float totaldensity;
-    float random1, random2, density;
 
     for(int i = 0; i < mdfsize; i++)
     {
       mdf[i] = 0.0;
     }
-    int remainingcount = 10000;
+    int64_t remainingcount = static_cast<int64_t>(numSamples);
     int aSize = static_cast<int>(numEntries);
     for(int i = 0; i < aSize; i++)
     {
@@ -247,61 +195,33 @@ public:
       OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
 
       rod = orientationOps.getMDFFZRod(rod);
-      mbin = orientationOps.getMisoBin(rod);
-      mdf[mbin] = static_cast<T>(-1 * static_cast<int>((weights[i] / static_cast<float>(mdfsize)) * 10000.0));
-      remainingcount = static_cast<int>(remainingcount + mdf[mbin]);
+      mbin = orientationOps.getMisoBin(grid, rod);
+      mdf[mbin] = static_cast<T>(-1 * static_cast<int64_t>((weights[i] / static_cast<float>(mdfsize)) * static_cast<double>(numSamples)));
+      remainingcount = static_cast<int64_t>(remainingcount + mdf[mbin]);
     }
 
-    for(int i = 0; i < remainingcount; i++)
+    // The bins of the specified misorientations are reserved and the rest of the samples are drawn from the ODF
+    if(remainingcount > 0)
     {
-      random1 = static_cast<float>(distribution(generator));
-      random2 = static_cast<float>(distribution(generator));
-      choose1 = 0;
-      choose2 = 0;
-      totaldensity = 0;
-      for(size_t j = 0; j < odfsize; j++)
+      std::vector<bool> reserved(static_cast<size_t>(mdfsize), false);
+      for(int i = 0; i < mdfsize; i++)
       {
-        density = odf[j];
-        float d = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random1 >= d && random1 < totaldensity)
-        {
-          choose1 = static_cast<int>(j);
-        }
-        if(random2 >= d && random2 < totaldensity)
-        {
-          choose2 = static_cast<int>(j);
-        }
+        reserved[i] = mdf[i] < 0;
       }
-      // This is used to create a random Homochoric vector
-      std::array<double, 3> randx3 = {distribution(generator), distribution(generator), distribution(generator)};
-      OrientationD eu = orientationOps.determineEulerAngles(randx3.data(), choose1);
-      QuatD q1 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
-
-      randx3 = {distribution(generator), distribution(generator), distribution(generator)};
-      eu = orientationOps.determineEulerAngles(randx3.data(), choose2);
-      QuatD q2 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
-      OrientationD ax = orientationOps.calculateMisorientation(q1, q2);
-      OrientationD ro = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
-
-      ro = orientationOps.getMDFFZRod(ro); // <==== THIS IS NOT IMPELMENTED FOR ALL LAUE CLASSES
-      mbin = orientationOps.getMisoBin(ro);
-      if(mdf[mbin] >= 0)
-      {
-        mdf[mbin]++;
-      }
-      if(mdf[mbin] < 0)
+      std::vector<uint64_t> counts = ODFSampling::SampleMisorientations<LaueOps>(grid, sampler, reserved, static_cast<size_t>(remainingcount), seed);
+      for(int i = 0; i < mdfsize; i++)
       {
-        i = i - 1;
+        mdf[i] += static_cast<T>(counts[i]);
       }
     }
+
     for(int i = 0; i < mdfsize; i++)
     {
       if(mdf[i] < 0)
       {
         mdf[i] = -mdf[i];
       }
-      mdf[i] = mdf[i] / static_cast<T>(10000.0);
+      mdf[i] = mdf[i] / static_cast<T>(numSamples);
     }
   }
 
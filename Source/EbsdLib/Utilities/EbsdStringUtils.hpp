@@ -33,9 +33,13 @@
 
 #include <array>
 #include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 /*' '(0x20)space(SPC)
@@ -218,4 +222,61 @@ inline std::string simplified(const std::string& text)
   return finalString;
 }
 
+/**
+ * @brief Returns true if the character is one of the white space characters listed at the top of this file.
+ */
+inline bool is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/**
+ * @brief Parses a number from the character range [first, last) without creating any
+ * intermediate std::string. Like std::stoi/std::stof, a leading '+' is accepted and
+ * parsing stops at the first character that can not be part of the number.
+ * @param first Start of the characters
+ * @param last One past the end of the characters
+ * @param value Receives the parsed value
+ * @return Pointer to the first character that was not consumed or nullptr if no number could be parsed.
+ */
+template <typename T>
+inline const char* parse_number(const char* first, const char* last, T& value)
+{
+  if(first != last && *first == '+')
+  {
+    ++first;
+  }
+  if constexpr(std::is_integral_v<T>)
+  {
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+  else
+  {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+    // The standard library does not provide floating point from_chars so copy the
+    // token into a small stack buffer and use the C conversion functions instead.
+    constexpr size_t k_MaxTokenLength = 63;
+    char buffer[k_MaxTokenLength + 1];
+    size_t length = static_cast<size_t>(last - first);
+    length = length > k_MaxTokenLength ? k_MaxTokenLength : length;
+    std::memcpy(buffer, first, length);
+    buffer[length] = '\0';
+    char* end = nullptr;
+    if constexpr(std::is_same_v<T, float>)
+    {
+      value = std::strtof(buffer, &end);
+    }
+    else
+    {
+      value = static_cast<T>(std::strtod(buffer, &end));
+    }
+    return end == buffer ? nullptr : first + (end - buffer);
+#endif
+  }
+}
+
 } // namespace EbsdStringUtils
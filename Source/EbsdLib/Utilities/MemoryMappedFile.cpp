@@ -0,0 +1,470 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#endif
+
+namespace
+{
+#if !defined(_WIN32)
+// -----------------------------------------------------------------------------
+size_t PageSize()
+{
+  const long pageSize = ::sysconf(_SC_PAGESIZE);
+  return pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+}
+
+// -----------------------------------------------------------------------------
+bool GrowFile(int fd, size_t oldBytes, size_t numBytes)
+{
+#if !defined(__APPLE__)
+  // Reserving the blocks up front turns a full disk into a failed allocation instead of a
+  // SIGBUS on the first write to a page the file system can not back.
+  const int err = ::posix_fallocate(fd, static_cast<off_t>(oldBytes), static_cast<off_t>(numBytes - oldBytes));
+  if(err == 0)
+  {
+    return true;
+  }
+  if(err != EINVAL && err != EOPNOTSUPP)
+  {
+    return false;
+  }
+#else
+  (void)oldBytes;
+#endif
+  // The file system can not reserve blocks so fall back to a sparse file
+  return ::ftruncate(fd, static_cast<off_t>(numBytes)) == 0;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+std::string ScratchDirectory(const std::string& directory)
+{
+  if(!directory.empty())
+  {
+    return directory;
+  }
+  std::error_code errorCode;
+  fs::path tempPath = fs::temp_directory_path(errorCode);
+  if(errorCode)
+  {
+#if defined(_WIN32)
+    return ".";
+#else
+    return "/tmp";
+#endif
+  }
+  return tempPath.string();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::open(const std::string& filePath, OpenMode mode)
+{
+  close();
+  size_t fileSize = 0;
+#if defined(_WIN32)
+  HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER fileSizeInfo;
+  if(GetFileSizeEx(fileHandle, &fileSizeInfo) == 0)
+  {
+    CloseHandle(fileHandle);
+    return false;
+  }
+  m_FileHandle = fileHandle;
+  fileSize = static_cast<size_t>(fileSizeInfo.QuadPart);
+#else
+  int fd = ::open(filePath.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    return false;
+  }
+  struct stat fileStat;
+  if(::fstat(fd, &fileStat) != 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  m_FileDescriptor = fd;
+  fileSize = static_cast<size_t>(fileStat.st_size);
+#endif
+  m_IsOpen = true;
+  m_IsWritable = (mode == OpenMode::CopyOnWrite);
+  if(fileSize == 0)
+  {
+    return true;
+  }
+  if(!mapView(fileSize))
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::createScratch(const std::string& directory, size_t numBytes)
+{
+  close();
+  if(numBytes == 0)
+  {
+    return false;
+  }
+  const std::string scratchDir = ScratchDirectory(directory);
+#if defined(_WIN32)
+  char scratchPath[MAX_PATH];
+  if(GetTempFileNameA(scratchDir.c_str(), "ebs", 0, scratchPath) == 0)
+  {
+    return false;
+  }
+  HANDLE fileHandle = CreateFileA(scratchPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    DeleteFileA(scratchPath);
+    return false;
+  }
+  m_FileHandle = fileHandle;
+#else
+  std::string pathTemplate = scratchDir + "/EbsdLibScratch-XXXXXX";
+  std::vector<char> scratchPath(pathTemplate.begin(), pathTemplate.end());
+  scratchPath.push_back('\0');
+  int fd = ::mkstemp(scratchPath.data());
+  if(fd < 0)
+  {
+    return false;
+  }
+  // The open descriptor keeps the file alive; removing the name now means it can not leak
+  ::unlink(scratchPath.data());
+  m_FileDescriptor = fd;
+#endif
+  m_IsOpen = true;
+  m_IsWritable = true;
+  m_IsScratch = true;
+  if(!resize(numBytes))
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::resize(size_t numBytes)
+{
+  if(!m_IsScratch || numBytes == 0)
+  {
+    return false;
+  }
+  if(numBytes == m_Size)
+  {
+    return true;
+  }
+  const size_t oldSize = m_Size;
+  const bool shrinking = numBytes < oldSize;
+#if !defined(_WIN32)
+  // Growing the file while the old view is still mapped keeps it valid if the new view fails
+  if(numBytes > m_FileSize)
+  {
+    if(!GrowFile(m_FileDescriptor, m_FileSize, numBytes))
+    {
+      return false;
+    }
+    m_FileSize = numBytes;
+  }
+#endif
+  // On Windows creating the larger mapping object extends the file
+  if(!mapView(numBytes))
+  {
+    return false;
+  }
+  if(shrinking)
+  {
+#if !defined(_WIN32)
+    // Give the blocks past the end back to the file system
+    if(::ftruncate(m_FileDescriptor, static_cast<off_t>(numBytes)) == 0)
+    {
+      m_FileSize = numBytes;
+    }
+#endif
+    // Windows refuses to truncate a file that is mapped so the file simply stays at its largest size there
+    return true;
+  }
+  // Bytes that the file kept from before an earlier shrink still hold the old values
+  const size_t staleEnd = std::min(numBytes, m_FileSize);
+  if(staleEnd > oldSize)
+  {
+    std::memset(m_Data + oldSize, 0, staleEnd - oldSize);
+  }
+  m_FileSize = std::max(m_FileSize, numBytes);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::mapView(size_t numBytes)
+{
+#if defined(_WIN32)
+  DWORD protection = PAGE_READONLY;
+  DWORD access = FILE_MAP_READ;
+  if(m_IsScratch)
+  {
+    protection = PAGE_READWRITE;
+    access = FILE_MAP_ALL_ACCESS;
+  }
+  else if(m_IsWritable)
+  {
+    protection = PAGE_WRITECOPY;
+    access = FILE_MAP_COPY;
+  }
+  const auto size64 = static_cast<unsigned long long>(numBytes);
+  HANDLE mappingHandle = CreateFileMappingA(static_cast<HANDLE>(m_FileHandle), nullptr, protection, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFull), nullptr);
+  if(mappingHandle == nullptr)
+  {
+    return false;
+  }
+  void* ptr = MapViewOfFile(mappingHandle, access, 0, 0, numBytes);
+  if(ptr == nullptr)
+  {
+    CloseHandle(mappingHandle);
+    return false;
+  }
+  unmapView();
+  m_MappingHandle = mappingHandle;
+#else
+  int protection = PROT_READ;
+  int flags = MAP_PRIVATE;
+  if(m_IsWritable)
+  {
+    protection |= PROT_WRITE;
+  }
+  if(m_IsScratch)
+  {
+    flags = MAP_SHARED;
+  }
+  void* ptr = ::mmap(nullptr, numBytes, protection, flags, m_FileDescriptor, 0);
+  if(ptr == MAP_FAILED)
+  {
+    return false;
+  }
+  unmapView();
+#endif
+  m_Data = static_cast<char*>(ptr);
+  m_Size = numBytes;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::unmapView()
+{
+#if defined(_WIN32)
+  if(m_Data != nullptr)
+  {
+    UnmapViewOfFile(m_Data);
+  }
+  if(m_MappingHandle != nullptr)
+  {
+    CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+  }
+  m_MappingHandle = nullptr;
+#else
+  if(m_Data != nullptr)
+  {
+    ::munmap(m_Data, m_Size);
+  }
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::close()
+{
+  unmapView();
+#if defined(_WIN32)
+  if(m_FileHandle != nullptr)
+  {
+    CloseHandle(static_cast<HANDLE>(m_FileHandle));
+  }
+  m_FileHandle = nullptr;
+#else
+  if(m_FileDescriptor >= 0)
+  {
+    ::close(m_FileDescriptor);
+  }
+  m_FileDescriptor = -1;
+#endif
+  m_Size = 0;
+  m_FileSize = 0;
+  m_IsOpen = false;
+  m_IsWritable = false;
+  m_IsScratch = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::isOpen() const
+{
+  return m_IsOpen;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* MemoryMappedFile::data() const
+{
+  return m_Data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+char* MemoryMappedFile::writableData() const
+{
+  return m_IsWritable ? m_Data : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::isWritable() const
+{
+  return m_IsWritable;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::isScratch() const
+{
+  return m_IsScratch;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MemoryMappedFile::size() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::advise(AccessHint hint) const
+{
+  advise(hint, 0, m_Size);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::advise(AccessHint hint, size_t offset, size_t length) const
+{
+  if(m_Data == nullptr || offset >= m_Size || length == 0)
+  {
+    return;
+  }
+  length = std::min(length, m_Size - offset);
+#if defined(_WIN32)
+  (void)hint;
+#else
+  int advice = POSIX_MADV_NORMAL;
+  switch(hint)
+  {
+  case AccessHint::Sequential:
+    advice = POSIX_MADV_SEQUENTIAL;
+    break;
+  case AccessHint::Random:
+    advice = POSIX_MADV_RANDOM;
+    break;
+  case AccessHint::WillNeed:
+    advice = POSIX_MADV_WILLNEED;
+    break;
+  default:
+    break;
+  }
+  // posix_madvise() requires a page aligned start address
+  const size_t pageSize = PageSize();
+  const size_t alignedOffset = offset - (offset % pageSize);
+  ::posix_madvise(m_Data + alignedOffset, length + (offset - alignedOffset), advice);
+#endif
+}
@@ -0,0 +1,190 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class MemoryMappedFile MemoryMappedFile.h EbsdLib/Utilities/MemoryMappedFile.h
+ * @brief This class maps an existing file read-only into the address space of the
+ * process so that its contents can be parsed in place without copying the bytes
+ * through a stream buffer. It can also create a writable scratch file whose pages are
+ * backed by the file system instead of the swap file so that data sets larger than the
+ * physical memory can be held. The mapping is released when the object is destroyed.
+ */
+class EbsdLib_EXPORT MemoryMappedFile
+{
+public:
+  /**
+   * @brief Hints passed to the operating system about how the mapped bytes will be accessed.
+   */
+  enum class AccessHint : int
+  {
+    Normal = 0,
+    Sequential = 1,
+    Random = 2,
+    WillNeed = 3
+  };
+
+  /**
+   * @brief How an existing file is mapped by open()
+   */
+  enum class OpenMode : int
+  {
+    ReadOnly = 0,   ///< Writing to the mapped bytes is an access violation
+    CopyOnWrite = 1 ///< Written pages become private copies; the file itself is never modified
+  };
+
+  MemoryMappedFile();
+  ~MemoryMappedFile();
+
+  /**
+   * @brief Maps the complete file. Any previously mapped file is closed first.
+   * @param filePath The file to map
+   * @param mode Whether the mapped bytes may be modified in memory
+   * @return true if the file was opened and mapped. A zero length file is considered
+   * a successful open with a nullptr data pointer.
+   */
+  bool open(const std::string& filePath, OpenMode mode = OpenMode::ReadOnly);
+
+  /**
+   * @brief Creates an unnamed scratch file and maps it read/write. The file is removed from
+   * the file system as soon as it is created (or flagged delete-on-close on Windows) so
+   * that it can never be left behind. The contents of a new scratch file are all zero.
+   * Any previously mapped file is closed first.
+   * @param directory The directory to create the file in. An empty string selects the
+   * temporary directory of the system.
+   * @param numBytes The initial size of the file. Must be greater than zero.
+   * @return true if the file was created and mapped.
+   */
+  bool createScratch(const std::string& directory, size_t numBytes);
+
+  /**
+   * @brief Grows or shrinks a scratch file and maps it again. The existing bytes are kept and
+   * any new bytes are zero. The address returned by data() may change.
+   * @param numBytes The new size of the file. Must be greater than zero.
+   * @return false if this is not a scratch file or the file could not be resized, e.g. because
+   * the disk is full, in which case the previous mapping is left untouched.
+   */
+  bool resize(size_t numBytes);
+
+  /**
+   * @brief Unmaps the file and closes any open handles.
+   */
+  void close();
+
+  /**
+   * @brief Returns true if a file is currently open
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Returns a pointer to the first byte of the mapped file.
+   */
+  const char* data() const;
+
+  /**
+   * @brief Returns a pointer to the first byte of the mapped file if the mapping may be
+   * written to, i.e. it is a scratch file or was opened copy-on-write. Returns nullptr
+   * for read-only mappings.
+   */
+  char* writableData() const;
+
+  /**
+   * @brief Returns true if the mapped bytes may be modified
+   */
+  bool isWritable() const;
+
+  /**
+   * @brief Returns true if the mapping is a scratch file created with createScratch()
+   */
+  bool isScratch() const;
+
+  /**
+   * @brief Returns the number of mapped bytes which is the size of the file.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Tells the operating system how the mapped bytes are going to be accessed. This
+   * is only a hint and is silently ignored on platforms that do not support it.
+   * @param hint
+   */
+  void advise(AccessHint hint) const;
+
+  /**
+   * @brief Same as advise(AccessHint) but only for the bytes [offset, offset + length).
+   * The range is widened to whole pages.
+   * @param hint
+   * @param offset Byte offset from the start of the mapping
+   * @param length Number of bytes
+   */
+  void advise(AccessHint hint, size_t offset, size_t length) const;
+
+private:
+  /**
+   * @brief Maps the first numBytes of the open file using the current mode. The previous
+   * view is only released once the new one exists.
+   */
+  bool mapView(size_t numBytes);
+
+  /**
+   * @brief Unmaps the view but keeps the file handle open
+   */
+  void unmapView();
+
+  char* m_Data = nullptr;
+  size_t m_Size = 0;
+  size_t m_FileSize = 0; ///< Length of a scratch file, which stays above m_Size after a shrink on Windows
+  bool m_IsOpen = false;
+  bool m_IsWritable = false;
+  bool m_IsScratch = false;
+#if defined(_WIN32)
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#else
+  int m_FileDescriptor = -1;
+#endif
+
+public:
+  MemoryMappedFile(const MemoryMappedFile&) = delete;            // Copy Constructor Not Implemented
+  MemoryMappedFile(MemoryMappedFile&&) = delete;                 // Move Constructor Not Implemented
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete; // Copy Assignment Not Implemented
+  MemoryMappedFile& operator=(MemoryMappedFile&&) = delete;      // Move Assignment Not Implemented
+};
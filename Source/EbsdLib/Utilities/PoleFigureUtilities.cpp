@@ -89,7 +89,7 @@ int writeVtkFile(EbsdLib::FloatArrayType* xyz, const std::string& filename)
 EbsdLib::UInt8ArrayType::Pointer PoleFigureUtilities::CreateColorImage(EbsdLib::DoubleArrayType* data, int width, int height, int nColors, const std::string& name, double min, double max)
 {
   std::vector<size_t> dims(1, 4);
-  EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(width * height), dims, name, true);
+  EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(width * height), dims, name);
   PoleFigureConfiguration_t config;
   config.imageDim = width;
   config.numColors = nColors;
@@ -121,8 +121,7 @@ void PoleFigureUtilities::CreateColorImage(EbsdLib::DoubleArrayType* data, PoleF
   float max = static_cast<float>(config.maxScale);
   float min = static_cast<float>(config.minScale);
 
-  // Initialize the image with all zeros
-  image->initializeWithZeros();
+  // Every pixel is written below, inside the circle with the color and outside it with white
   uint32_t* rgbaPtr = reinterpret_cast<uint32_t*>(image->getPointer(0));
 
   int numColors = config.numColors;
@@ -33,9 +33,14 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/IO/TSL/AngReader.h"
@@ -50,6 +55,124 @@
 
 #include "EbsdLib/Test/EbsdLibTestFileLocations.h"
 
+#ifdef EbsdLib_ENABLE_HDF5
+namespace
+{
+/**
+ * @brief Parses nothing. Files are named by their index and the file named "bad" fails to parse.
+ * Later files take less time so that the parsers finish out of order.
+ */
+class MockEbsdReader : public EbsdReader
+{
+public:
+  int readFile() override
+  {
+    if(getFileName() == "bad")
+    {
+      return -1000;
+    }
+    const int index = std::stoi(getFileName());
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * ((20 - index) % 5)));
+    return 0;
+  }
+  int readHeaderOnly() override
+  {
+    return 0;
+  }
+  int getXDimension() override
+  {
+    return 1;
+  }
+  void setXDimension(int xdim) override
+  {
+  }
+  int getYDimension() override
+  {
+    return 1;
+  }
+  void setYDimension(int ydim) override
+  {
+  }
+  void* getPointerByName(const std::string& featureName) override
+  {
+    return nullptr;
+  }
+  EbsdLib::NumericTypes::Type getPointerType(const std::string& featureName) override
+  {
+    return EbsdLib::NumericTypes::Type::UnknownNumType;
+  }
+};
+
+/**
+ * @brief Records what EbsdImporter::importFiles() hands to the writer without touching the HDF5 file
+ */
+class MockEbsdImporter : public EbsdImporter
+{
+public:
+  std::vector<int64_t> writtenSlices;
+  std::vector<std::string> writtenFiles;
+  std::atomic<int32_t> activeWriters = {0};
+  std::atomic<int32_t> maxActiveWriters = {0};
+  size_t cancelAfter = 0; ///< Cancel the import from progressMessage() after this many files, 0 never cancels
+  size_t numMessages = 0;
+
+  int importFile(hid_t fileId, int64_t index, const std::string& ebsd) override
+  {
+    return -1;
+  }
+  void getDims(int64_t& x, int64_t& y) override
+  {
+    x = 1;
+    y = 1;
+  }
+  void getSpacing(float& x, float& y) override
+  {
+    x = 1.0f;
+    y = 1.0f;
+  }
+  int numberOfSlicesImported() override
+  {
+    return 1;
+  }
+  void setFileVersion(uint32_t version) override
+  {
+  }
+  void progressMessage(const std::string& message, int progress) override
+  {
+    numMessages++;
+    if(cancelAfter > 0 && numMessages == cancelAfter)
+    {
+      setCancel(true);
+    }
+  }
+
+protected:
+  std::unique_ptr<EbsdReader> createReader() const override
+  {
+    return std::make_unique<MockEbsdReader>();
+  }
+
+  int writeParsedFile(hid_t fileId, int64_t z, EbsdReader& reader, int readError) override
+  {
+    const int32_t active = ++activeWriters;
+    int32_t previousMax = maxActiveWriters;
+    while(active > previousMax && !maxActiveWriters.compare_exchange_weak(previousMax, active))
+    {
+    }
+    // Give a second writer the chance to show up
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if(readError >= 0)
+    {
+      writtenSlices.push_back(z);
+      writtenFiles.push_back(reader.getFileName());
+    }
+    --activeWriters;
+    return readError;
+  }
+};
+} // namespace
+#endif
+
 class AngImportTest
 {
 public:
@@ -163,6 +286,151 @@ public:
     DREAM3D_REQUIRED(ptr[159], ==, 12.56637f)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void CompareColumn(T* streamPtr, T* mappedPtr, size_t numElements)
+  {
+    DREAM3D_REQUIRE_VALID_POINTER(streamPtr)
+    DREAM3D_REQUIRE_VALID_POINTER(mappedPtr)
+    for(size_t i = 0; i < numElements; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(streamPtr[i], mappedPtr[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMemoryMappedRead()
+  {
+    AngReader streamReader;
+    streamReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    AngReader mappedReader;
+    mappedReader.setUseMemoryMapping(true);
+    mappedReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    err = mappedReader.readFile();
+    std::cout << mappedReader.getErrorMessage();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    size_t numElements = mappedReader.getNumberOfElements();
+    DREAM3D_REQUIRED(numElements, ==, streamReader.getNumberOfElements())
+    DREAM3D_REQUIRED(mappedReader.getPhaseVector().size(), ==, streamReader.getPhaseVector().size())
+    DREAM3D_REQUIRED(mappedReader.getOriginalHeader(), ==, streamReader.getOriginalHeader())
+
+    CompareColumn(streamReader.getPhi1Pointer(), mappedReader.getPhi1Pointer(), numElements);
+    CompareColumn(streamReader.getPhiPointer(), mappedReader.getPhiPointer(), numElements);
+    CompareColumn(streamReader.getPhi2Pointer(), mappedReader.getPhi2Pointer(), numElements);
+    CompareColumn(streamReader.getXPositionPointer(), mappedReader.getXPositionPointer(), numElements);
+    CompareColumn(streamReader.getYPositionPointer(), mappedReader.getYPositionPointer(), numElements);
+    CompareColumn(streamReader.getImageQualityPointer(), mappedReader.getImageQualityPointer(), numElements);
+    CompareColumn(streamReader.getConfidenceIndexPointer(), mappedReader.getConfidenceIndexPointer(), numElements);
+    CompareColumn(streamReader.getPhaseDataPointer(), mappedReader.getPhaseDataPointer(), numElements);
+    CompareColumn(streamReader.getSEMSignalPointer(), mappedReader.getSEMSignalPointer(), numElements);
+    CompareColumn(streamReader.getFitPointer(), mappedReader.getFitPointer(), numElements);
+
+    // A truncated file must produce the same error code through both paths
+    AngReader shortStreamReader;
+    shortStreamReader.setFileName(UnitTest::AngImportTest::ShortFile);
+    int streamErr = shortStreamReader.readFile();
+    AngReader shortMappedReader;
+    shortMappedReader.setUseMemoryMapping(true);
+    shortMappedReader.setFileName(UnitTest::AngImportTest::ShortFile);
+    err = shortMappedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, streamErr)
+
+    AngReader gridReader;
+    gridReader.setUseMemoryMapping(true);
+    gridReader.setFileName(UnitTest::AngImportTest::GridMissing);
+    err = gridReader.readFile();
+    DREAM3D_REQUIRED(err, ==, -300)
+  }
+
+#ifdef EbsdLib_ENABLE_HDF5
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchImport()
+  {
+    std::vector<std::string> angFiles = {UnitTest::AngImportTest::TestFile1, UnitTest::AngImportTest::TestFile2, UnitTest::AngImportTest::TestFile3};
+
+    hid_t fileId = H5Utilities::createFile(UnitTest::AngImportTest::H5EbsdOutputFile);
+    DREAM3D_REQUIRE(fileId > 0)
+
+    EbsdImporter::Pointer importer = H5AngImporter::New();
+    int err = importer->importFiles(fileId, 1, angFiles, 2);
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    // Every file has to land in its own slice, in the order that the files were given
+    for(size_t i = 0; i < angFiles.size(); i++)
+    {
+      std::string originalFile;
+      std::string path = "/" + std::to_string(i + 1) + "/" + EbsdLib::H5OIM::Header + "/" + EbsdLib::H5OIM::OriginalFile;
+      err = H5Lite::readStringDataset(fileId, path, originalFile);
+      DREAM3D_REQUIRED(err, >=, 0)
+      DREAM3D_REQUIRE_EQUAL(originalFile, angFiles[i])
+    }
+
+    // A file that can not be parsed stops the import with an error
+    std::vector<std::string> badFiles = {UnitTest::AngImportTest::TestFile1, UnitTest::AngImportTest::HexHeader};
+    err = importer->importFiles(fileId, 10, badFiles, 2);
+    DREAM3D_REQUIRED(err, <, 0)
+
+    err = H5Utilities::closeFile(fileId);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMockBatchImport()
+  {
+    const size_t numFiles = 20;
+    std::vector<std::string> files;
+    for(size_t i = 0; i < numFiles; i++)
+    {
+      files.push_back(std::to_string(i));
+    }
+
+    // The files are written one at a time into consecutive slices in the order they were given
+    {
+      MockEbsdImporter importer;
+      int err = importer.importFiles(-1, 5, files, 4);
+      DREAM3D_REQUIRED(err, ==, 0)
+      DREAM3D_REQUIRE_EQUAL(importer.writtenFiles.size(), numFiles)
+      for(size_t i = 0; i < numFiles; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(importer.writtenSlices[i], static_cast<int64_t>(5 + i))
+        DREAM3D_REQUIRE_EQUAL(importer.writtenFiles[i], files[i])
+      }
+      DREAM3D_REQUIRE_EQUAL(importer.maxActiveWriters.load(), 1)
+    }
+
+    // Cancelling after the third file stops all further writes
+    {
+      MockEbsdImporter importer;
+      importer.cancelAfter = 3;
+      int err = importer.importFiles(-1, 0, files, 4);
+      DREAM3D_REQUIRED(err, ==, 0)
+      DREAM3D_REQUIRE_EQUAL(importer.writtenFiles.size(), 3)
+      DREAM3D_REQUIRE_EQUAL(importer.numMessages, 3)
+    }
+
+    // A file that fails to parse stops the import with the error of the reader
+    {
+      std::vector<std::string> badFiles = files;
+      badFiles[7] = "bad";
+      MockEbsdImporter importer;
+      int err = importer.importFiles(-1, 0, badFiles, 4);
+      DREAM3D_REQUIRED(err, ==, -1000)
+      DREAM3D_REQUIRE_EQUAL(importer.writtenFiles.size(), 7)
+    }
+  }
+#endif
+
   void operator()()
   {
     int err = EXIT_SUCCESS;
@@ -173,6 +441,11 @@ public:
     DREAM3D_REGISTER_TEST(TestHexGrid())
     DREAM3D_REGISTER_TEST(TestMissingGrid())
     DREAM3D_REGISTER_TEST(TestShortFile())
+    DREAM3D_REGISTER_TEST(TestMemoryMappedRead())
+#ifdef EbsdLib_ENABLE_HDF5
+    DREAM3D_REGISTER_TEST(TestBatchImport())
+    DREAM3D_REGISTER_TEST(TestMockBatchImport())
+#endif
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
@@ -39,7 +39,9 @@
 #include <cstring>
 #include <fstream>
 
+#include "EbsdLib/IO/BatchColumnParser.hpp"
 #include "EbsdLib/IO/HKL/CtfReader.h"
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 
 #include "UnitTestSupport.hpp"
 
@@ -232,6 +234,252 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareReaders(CtfReader& serialReader, CtfReader& parallelReader)
+  {
+    DREAM3D_REQUIRED(serialReader.getNumberOfElements(), ==, parallelReader.getNumberOfElements())
+    size_t numElements = serialReader.getNumberOfElements();
+    std::vector<std::string> columnNames = serialReader.getColumnNames();
+    for(const auto& name : columnNames)
+    {
+      void* serialPtr = serialReader.getPointerByName(name);
+      void* parallelPtr = parallelReader.getPointerByName(name);
+      if(serialPtr == nullptr)
+      {
+        DREAM3D_REQUIRE_NULL_POINTER(parallelPtr)
+        continue;
+      }
+      DREAM3D_REQUIRE_VALID_POINTER(parallelPtr)
+      int typeSize = serialReader.getTypeSize(name);
+      DREAM3D_REQUIRE(::memcmp(serialPtr, parallelPtr, numElements * typeSize) == 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestParallelRead()
+  {
+    // The test files are much smaller than the default block size so they are also read with
+    // small blocks, which puts many lines across block boundaries.
+    const std::vector<size_t> blockSizes = {1, 7, 100, 4096, CtfReader().getParallelBlockSize()};
+
+    for(const auto& filePath : {UnitTest::CtfReaderTest::USInputFile1, UnitTest::CtfReaderTest::EuropeanInputFile2, UnitTest::CtfReaderTest::USInputFile2})
+    {
+      CtfReader serialReader;
+      serialReader.setFileName(filePath);
+      int err = serialReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      for(size_t blockSize : blockSizes)
+      {
+        CtfReader parallelReader;
+        parallelReader.setUseParallelRead(true);
+        parallelReader.setParallelBlockSize(blockSize);
+        parallelReader.setFileName(filePath);
+        err = parallelReader.readFile();
+        DREAM3D_REQUIRED(err, >=, 0)
+        CompareReaders(serialReader, parallelReader);
+      }
+    }
+
+    int err = 0;
+    for(size_t blockSize : blockSizes)
+    {
+      CtfReader shortReader;
+      shortReader.setUseParallelRead(true);
+      shortReader.setParallelBlockSize(blockSize);
+      shortReader.setFileName(UnitTest::CtfReaderTest::ShortFile);
+      err = shortReader.readFile();
+      DREAM3D_REQUIRED(err, ==, -105)
+    }
+
+    // Build a 3 slice file from a 2D file so the Z slice handling can be compared.
+    std::string filePath = UnitTest::TestTempDir + "/CTF_ParallelRead_3D.ctf";
+    {
+      std::ifstream in(UnitTest::CtfReaderTest::USInputFile1, std::ios_base::in | std::ios_base::binary);
+      std::ofstream out(filePath, std::ios_base::out | std::ios_base::binary);
+      std::string line;
+      std::vector<std::string> dataLines;
+      bool inData = false;
+      while(std::getline(in, line))
+      {
+        if(inData)
+        {
+          if(!EbsdStringUtils::trimmed(line).empty())
+          {
+            dataLines.push_back(line);
+          }
+          continue;
+        }
+        out << line << "\n";
+        if(line.find("YCells") == 0)
+        {
+          out << "ZCells\t3\r\n";
+        }
+        if(line.find("Phase\tX") == 0)
+        {
+          inData = true;
+        }
+      }
+      for(int slice = 0; slice < 3; slice++)
+      {
+        for(const auto& dataLine : dataLines)
+        {
+          // Give each slice a different band count so the slices can be told apart
+          std::vector<std::string> tokens = EbsdStringUtils::split(dataLine, '\t');
+          tokens[3] = std::to_string(slice);
+          for(size_t t = 0; t < tokens.size(); t++)
+          {
+            out << tokens[t] << (t + 1 < tokens.size() ? "\t" : "\n");
+          }
+        }
+      }
+    }
+
+    for(int slice = -1; slice < 3; slice++)
+    {
+      CtfReader serialReader;
+      serialReader.setFileName(filePath);
+      if(slice >= 0)
+      {
+        serialReader.readOnlySliceIndex(slice);
+      }
+      err = serialReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      for(size_t blockSize : blockSizes)
+      {
+        CtfReader parallelReader;
+        parallelReader.setUseParallelRead(true);
+        parallelReader.setParallelBlockSize(blockSize);
+        parallelReader.setFileName(filePath);
+        if(slice >= 0)
+        {
+          parallelReader.readOnlySliceIndex(slice);
+        }
+        err = parallelReader.readFile();
+        DREAM3D_REQUIRED(err, >=, 0)
+        CompareReaders(serialReader, parallelReader);
+        if(slice >= 0)
+        {
+          DREAM3D_REQUIRED(parallelReader.getBandCountPointer()[0], ==, slice)
+        }
+      }
+    }
+
+    // A bad value in the middle of the data must be reported the same way as the serial reader
+    // no matter which block the line lands in.
+    std::string badFilePath = UnitTest::TestTempDir + "/CTF_ParallelRead_BadValue.ctf";
+    {
+      std::ifstream in(UnitTest::CtfReaderTest::USInputFile1, std::ios_base::in | std::ios_base::binary);
+      std::ofstream out(badFilePath, std::ios_base::out | std::ios_base::binary);
+      std::string line;
+      int dataLine = -1;
+      while(std::getline(in, line))
+      {
+        if(dataLine == 50)
+        {
+          std::vector<std::string> tokens = EbsdStringUtils::split(line, '\t');
+          tokens[5] = "abc";
+          line.clear();
+          for(size_t t = 0; t < tokens.size(); t++)
+          {
+            line += tokens[t] + (t + 1 < tokens.size() ? "\t" : "");
+          }
+        }
+        if(dataLine >= 0)
+        {
+          dataLine++;
+        }
+        if(line.find("Phase\tX") == 0)
+        {
+          dataLine = 0;
+        }
+        out << line << "\n";
+      }
+    }
+    CtfReader badSerialReader;
+    badSerialReader.setFileName(badFilePath);
+    int serialErr = badSerialReader.readFile();
+    DREAM3D_REQUIRED(serialErr, <, 0)
+    for(size_t blockSize : blockSizes)
+    {
+      CtfReader parallelReader;
+      parallelReader.setUseParallelRead(true);
+      parallelReader.setParallelBlockSize(blockSize);
+      parallelReader.setFileName(badFilePath);
+      err = parallelReader.readFile();
+      DREAM3D_REQUIRED(err, ==, serialErr)
+      DREAM3D_REQUIRE(parallelReader.getErrorMessage() == badSerialReader.getErrorMessage())
+    }
+
+    if(REMOVE_TEST_FILES == 1)
+    {
+      fs::remove(filePath);
+      fs::remove(badFilePath);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchColumnParser()
+  {
+    // Tab delimited rows with European decimals, empty tokens and an integer column holding a float
+    std::vector<int32_t> phases(4, -1);
+    std::vector<float> values(4, -1.0f);
+    BatchColumnParser parser;
+    parser.setDelimiter(BatchColumnParser::Delimiter::Tab);
+    parser.setRequireAllColumns(true);
+    parser.setConvertDecimalCommas(true);
+    parser.setNumberOfColumns(3);
+    parser.setColumn(0, EbsdLib::NumericTypes::Type::Int32, phases.data());
+    parser.setColumn(2, EbsdLib::NumericTypes::Type::Float, values.data());
+
+    std::vector<std::string_view> rows = {"1\t99\t0.5", " 2\t\t99\t1,25\r", "3.0\t99\t-2", "4\t99"};
+    int32_t err = parser.parseRows(rows.data(), 3, 1);
+    DREAM3D_REQUIRED(err, ==, BatchColumnParser::k_NoError)
+    DREAM3D_REQUIRED(phases[0], ==, -1)
+    DREAM3D_REQUIRED(phases[1], ==, 1)
+    DREAM3D_REQUIRED(phases[2], ==, 2)
+    DREAM3D_REQUIRED(phases[3], ==, 3)
+    DREAM3D_REQUIRE(values[1] == 0.5f)
+    DREAM3D_REQUIRE(values[2] == 1.25f)
+    DREAM3D_REQUIRE(values[3] == -2.0f)
+
+    err = parser.parseRows(rows.data() + 2, 2, 0);
+    DREAM3D_REQUIRED(err, ==, BatchColumnParser::k_ColumnCountMismatch)
+    DREAM3D_REQUIRED(parser.getErrorRow(), ==, 1)
+    DREAM3D_REQUIRED(parser.getErrorTokenCount(), ==, 2)
+
+    std::string_view badRow = "1\t2\tabc";
+    err = parser.parseRow(badRow, 0);
+    DREAM3D_REQUIRED(err, ==, BatchColumnParser::k_ConversionError)
+    DREAM3D_REQUIRED(parser.getErrorColumn(), ==, 2)
+
+    // A decimal comma token too long for the conversion buffer is an error, not a truncated value
+    std::string longToken = "1," + std::string(70, '5');
+    std::string longRow = "1\t2\t" + longToken;
+    err = parser.parseRow(longRow, 0);
+    DREAM3D_REQUIRED(err, ==, BatchColumnParser::k_ConversionError)
+    DREAM3D_REQUIRED(parser.getErrorColumn(), ==, 2)
+
+    // White space delimited rows that are allowed to be missing trailing columns
+    parser.setDelimiter(BatchColumnParser::Delimiter::Whitespace);
+    parser.setRequireAllColumns(false);
+    parser.setConvertDecimalCommas(false);
+    std::vector<std::string_view> angRows = {"  7  8   9.5  10", "5 6"};
+    err = parser.parseRows(angRows.data(), 2, 0);
+    DREAM3D_REQUIRED(err, ==, BatchColumnParser::k_NoError)
+    DREAM3D_REQUIRED(phases[0], ==, 7)
+    DREAM3D_REQUIRE(values[0] == 9.5f)
+    DREAM3D_REQUIRED(phases[1], ==, 5)
+    DREAM3D_REQUIRE(values[1] == 0.5f)
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -247,6 +495,8 @@ public:
     DREAM3D_REGISTER_TEST(TestShortFile())
     DREAM3D_REGISTER_TEST(TestZeroXYCells())
     DREAM3D_REGISTER_TEST(TestWriteCtfFile());
+    DREAM3D_REGISTER_TEST(TestParallelRead());
+    DREAM3D_REGISTER_TEST(TestBatchColumnParser());
   }
 
 public:
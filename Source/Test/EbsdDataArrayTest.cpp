@@ -0,0 +1,326 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/EbsdLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
+
+class EbsdDataArrayTest
+{
+public:
+  EbsdDataArrayTest() = default;
+  virtual ~EbsdDataArrayTest() = default;
+
+  EBSD_GET_NAME_OF_CLASS_DECL(EbsdDataArrayTest)
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+// fs::remove();
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void CheckAllocationPolicy(EbsdLib::AllocationPolicy policy, size_t minAlignment)
+  {
+    std::vector<size_t> cDims = {3};
+    typename EbsdDataArray<T>::Pointer array = EbsdDataArray<T>::CreateArray(1000, cDims, "Test", true, policy);
+    DREAM3D_REQUIRE_VALID_POINTER(array.get());
+    DREAM3D_REQUIRE(array->getAllocationPolicy() == policy);
+
+    const size_t alignment = array->getAlignment();
+    DREAM3D_REQUIRE(alignment >= minAlignment);
+    const auto address = reinterpret_cast<uintptr_t>(array->getPointer(0));
+    DREAM3D_REQUIRE_EQUAL(address % alignment, 0);
+
+    // New memory is zero initialized
+    size_t numNonZero = 0;
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      numNonZero += (array->getValue(i) != static_cast<T>(0)) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numNonZero, 0);
+
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      array->setValue(i, static_cast<T>(i % 100));
+    }
+
+    // Growing keeps the values and the alignment
+    array->resizeTuples(5000);
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(array->getPointer(0)) % alignment, 0);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(2999), static_cast<T>(2999 % 100));
+    DREAM3D_REQUIRE_EQUAL(array->getValue(3000), static_cast<T>(0));
+
+    // Erasing tuples keeps the alignment
+    std::vector<size_t> erase = {0, 10, 20};
+    int32_t err = array->eraseTuples(erase);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(array->getPointer(0)) % alignment, 0);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(0), static_cast<T>(3));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAllocationPolicy()
+  {
+    CheckAllocationPolicy<float>(EbsdLib::AllocationPolicy::Default, alignof(float));
+    CheckAllocationPolicy<float>(EbsdLib::AllocationPolicy::Aligned, 64);
+    CheckAllocationPolicy<double>(EbsdLib::AllocationPolicy::HugePage, 64);
+    CheckAllocationPolicy<int32_t>(EbsdLib::AllocationPolicy::FirstTouch, 64);
+    CheckAllocationPolicy<uint8_t>(EbsdLib::AllocationPolicy::Aligned, 64);
+    CheckAllocationPolicy<float>(EbsdLib::AllocationPolicy::MemoryMapped, 4096);
+
+    // Only arrays of at least one huge page get the huge page alignment
+    EbsdLib::FloatArrayType::Pointer smallArray = EbsdLib::FloatArrayType::CreateArray(1000, {1ULL}, "Small", true, EbsdLib::AllocationPolicy::HugePage);
+    DREAM3D_REQUIRE_EQUAL(smallArray->getAlignment(), 64);
+    EbsdLib::FloatArrayType::Pointer largeArray = EbsdLib::FloatArrayType::CreateArray(1024 * 1024, {1ULL}, "Large", true, EbsdLib::AllocationPolicy::HugePage);
+#if defined(__linux__)
+    DREAM3D_REQUIRE_EQUAL(largeArray->getAlignment(), 2 * 1024 * 1024);
+#endif
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(largeArray->getPointer(0)) % largeArray->getAlignment(), 0);
+    largeArray->resizeTuples(100);
+    DREAM3D_REQUIRE_EQUAL(largeArray->getAlignment(), 64);
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(largeArray->getPointer(0)) % 64, 0);
+
+    // Switching the policy of an allocated array moves the values
+    EbsdLib::FloatArrayType::Pointer array = EbsdLib::FloatArrayType::CreateArray(100, "Test", true);
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      array->setValue(i, static_cast<float>(i));
+    }
+    int32_t err = array->setAllocationPolicy(EbsdLib::AllocationPolicy::Aligned);
+    DREAM3D_REQUIRE_EQUAL(err, 1);
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(array->getPointer(0)) % 64, 0);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(99), 99.0f);
+
+    // Wrapped memory only guarantees the alignment of the type
+    auto* data = new float[10]();
+    std::vector<size_t> cDims = {1};
+    EbsdLib::FloatArrayType::Pointer wrapped = EbsdLib::FloatArrayType::WrapPointer(data, 10, cDims, "Wrapped", true);
+    const size_t wrappedAlignment = wrapped->getAlignment();
+    DREAM3D_REQUIRE_EQUAL(wrappedAlignment, alignof(float));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestUninitializedAllocation()
+  {
+    // Large enough that the fills are split across threads
+    const size_t numTuples = 1000000;
+    std::vector<size_t> cDims = {3};
+    EbsdLib::FloatArrayType::Pointer array = EbsdLib::FloatArrayType::CreateUninitializedArray(numTuples, cDims, "Uninitialized");
+    DREAM3D_REQUIRE_VALID_POINTER(array.get());
+    DREAM3D_REQUIRE(array->isAllocated());
+    const size_t numElements = array->getSize();
+    DREAM3D_REQUIRE_EQUAL(numElements, numTuples * 3);
+
+    array->initializeWithValue(7.0f);
+    size_t numWrong = 0;
+    for(size_t i = 0; i < numElements; i++)
+    {
+      numWrong += (array->getValue(i) != 7.0f) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+
+    const size_t offset = 12345;
+    array->initializeWithValue(3.0f, offset);
+    for(size_t i = 0; i < numElements; i++)
+    {
+      numWrong += (array->getValue(i) != (i < offset ? 7.0f : 3.0f)) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+
+    EbsdLib::FloatArrayType::Pointer copy = array->deepCopy();
+    DREAM3D_REQUIRE(std::equal(array->begin(), array->end(), copy->begin()));
+
+    array->initializeWithZeros();
+    for(size_t i = 0; i < numElements; i++)
+    {
+      numWrong += (array->getValue(i) != 0.0f) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+
+    // CreateArray still returns zero initialized memory
+    EbsdLib::Int32ArrayType::Pointer zeros = EbsdLib::Int32ArrayType::CreateArray(numTuples, cDims, "Zeros", true);
+    for(size_t i = 0; i < zeros->getSize(); i++)
+    {
+      numWrong += (zeros->getValue(i) != 0) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMemoryMappedStorage()
+  {
+    std::vector<size_t> cDims = {3};
+    EbsdLib::FloatArrayType::Pointer array = EbsdLib::FloatArrayType::CreateArray(0, cDims, "Mapped", false, EbsdLib::AllocationPolicy::MemoryMapped);
+    DREAM3D_REQUIRE_VALID_POINTER(array.get());
+    array->setScratchDirectory(UnitTest::TestTempDir);
+    array->resizeTuples(100000);
+    DREAM3D_REQUIRE(array->isMemoryMapped());
+    DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 100000);
+
+    size_t index = 0;
+    for(auto& value : *array)
+    {
+      value = static_cast<float>(index++);
+    }
+    array->advise(MemoryMappedFile::AccessHint::Sequential);
+    array->advise(MemoryMappedFile::AccessHint::WillNeed, 5000, 1000);
+
+    // Growing the scratch file keeps the values and zeroes the new tuples
+    array->resizeTuples(400000);
+    DREAM3D_REQUIRE(array->isMemoryMapped());
+    size_t numWrong = 0;
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      numWrong += (array->getValue(i) != (i < 300000 ? static_cast<float>(i) : 0.0f)) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+
+    array->resizeTuples(10);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(29), 29.0f);
+
+    // Growing again after a shrink must not bring back the values that were cut off
+    array->resizeTuples(1000);
+    numWrong = 0;
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      numWrong += (array->getValue(i) != (i < 30 ? static_cast<float>(i) : 0.0f)) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+    array->resizeTuples(10);
+
+    EbsdLib::FloatArrayType::Pointer copy = array->deepCopy();
+    DREAM3D_REQUIRE(copy->isMemoryMapped());
+    DREAM3D_REQUIRE(std::equal(array->begin(), array->end(), copy->begin()));
+
+    int32_t err = array->setAllocationPolicy(EbsdLib::AllocationPolicy::Default);
+    DREAM3D_REQUIRE_EQUAL(err, 1);
+    DREAM3D_REQUIRE(!array->isMemoryMapped());
+    DREAM3D_REQUIRE_EQUAL(array->getValue(29), 29.0f);
+
+    // Map a region of an existing file that starts after a small header
+    const std::string filePath = UnitTest::TestTempDir + "/EbsdDataArray_MapFile.bin";
+    const size_t numValues = 1000;
+    const size_t headerBytes = 16;
+    {
+      std::ofstream out(filePath, std::ios::binary);
+      std::vector<char> header(headerBytes, 'H');
+      out.write(header.data(), static_cast<std::streamsize>(header.size()));
+      std::vector<int32_t> values(numValues);
+      for(size_t i = 0; i < numValues; i++)
+      {
+        values[i] = static_cast<int32_t>(i * 2);
+      }
+      out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(int32_t)));
+    }
+
+    std::vector<size_t> oneComp = {1};
+    EbsdLib::Int32ArrayType::Pointer region = EbsdLib::Int32ArrayType::MapFile(filePath, headerBytes, numValues, oneComp, "Region");
+    DREAM3D_REQUIRE_VALID_POINTER(region.get());
+    DREAM3D_REQUIRE(region->isMemoryMapped());
+    const size_t regionAlignment = region->getAlignment();
+    DREAM3D_REQUIRE_EQUAL(regionAlignment, headerBytes);
+    for(size_t i = 0; i < numValues; i++)
+    {
+      numWrong += (region->getValue(i) != static_cast<int32_t>(i * 2)) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(numWrong, 0);
+
+    // Writes go to private pages, the file is not modified
+    region->setValue(0, -1);
+    DREAM3D_REQUIRE_EQUAL(region->getValue(0), -1);
+    {
+      std::ifstream in(filePath, std::ios::binary);
+      in.seekg(static_cast<std::streamoff>(headerBytes));
+      int32_t firstValue = -1;
+      in.read(reinterpret_cast<char*>(&firstValue), sizeof(int32_t));
+      DREAM3D_REQUIRE_EQUAL(firstValue, 0);
+    }
+
+    // Resizing moves the region into a scratch file
+    region->resizeTuples(numValues * 2);
+    DREAM3D_REQUIRE(region->isMemoryMapped());
+    DREAM3D_REQUIRE_EQUAL(region->getValue(0), -1);
+    DREAM3D_REQUIRE_EQUAL(region->getValue(numValues - 1), static_cast<int32_t>((numValues - 1) * 2));
+    DREAM3D_REQUIRE_EQUAL(region->getValue(numValues), 0);
+    region = nullptr;
+
+    // Misaligned offsets and regions past the end of the file are rejected
+    EbsdLib::Int32ArrayType::Pointer invalid = EbsdLib::Int32ArrayType::MapFile(filePath, 3, 10, oneComp, "Invalid");
+    DREAM3D_REQUIRE_NULL_POINTER(invalid.get());
+    invalid = EbsdLib::Int32ArrayType::MapFile(filePath, headerBytes, numValues + 1, oneComp, "Invalid");
+    DREAM3D_REQUIRE_NULL_POINTER(invalid.get());
+
+    fs::remove(filePath);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestAllocationPolicy())
+    DREAM3D_REGISTER_TEST(TestUninitializedAllocation())
+    DREAM3D_REGISTER_TEST(TestMemoryMappedStorage())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  EbsdDataArrayTest(const EbsdDataArrayTest&) = delete;            // Copy Constructor Not Implemented
+  EbsdDataArrayTest(EbsdDataArrayTest&&) = delete;                 // Move Constructor Not Implemented
+  EbsdDataArrayTest& operator=(const EbsdDataArrayTest&) = delete; // Copy Assignment Not Implemented
+  EbsdDataArrayTest& operator=(EbsdDataArrayTest&&) = delete;      // Move Assignment Not Implemented
+};
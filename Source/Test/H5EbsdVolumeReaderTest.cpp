@@ -0,0 +1,569 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of
+ * its
+ * contributors may be used to endorse or promote products derived from this
+ * software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/H5Utilities.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/IO/H5DatasetLayout.h"
+#include "EbsdLib/IO/HKL/CtfReader.h"
+#include "EbsdLib/IO/HKL/H5CtfImporter.h"
+#include "EbsdLib/IO/HKL/H5CtfVolumeReader.h"
+#include "EbsdLib/IO/TSL/AngReader.h"
+#include "EbsdLib/IO/TSL/H5AngImporter.h"
+#include "EbsdLib/IO/TSL/H5AngVolumeReader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
+
+class H5EbsdVolumeReaderTest
+{
+public:
+  H5EbsdVolumeReaderTest() = default;
+  virtual ~H5EbsdVolumeReaderTest() = default;
+
+  EBSD_GET_NAME_OF_CLASS_DECL(H5EbsdVolumeReaderTest)
+
+  /**
+   * @brief Where a slice is expected to land in a plane of the volume
+   */
+  struct Placement
+  {
+    int64_t dstX = 0;
+    int64_t dstY = 0;
+    int64_t srcX = 0;
+    int64_t srcY = 0;
+    int64_t rowLength = 0;
+    int64_t numRows = 0;
+  };
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::AngFile1);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::AngFile2);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::CtfFile1);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::CtfFile2);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::AngOutputFile);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::CtfOutputFile);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::BadSizeOutputFile);
+    fs::remove(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile);
+#endif
+  }
+
+  /**
+   * @brief Writes a single phase .ang file whose values encode the slice, row and column of each point.
+   * The phase of every point is 0 as OIM writes it for single phase scans.
+   */
+  void WriteAngFile(const std::string& filePath, int32_t slice, int32_t numCols, int32_t numRows)
+  {
+    std::ofstream out(filePath, std::ios_base::out | std::ios_base::binary);
+    out << "# TEM_PIXperUM          1.000000\n"
+        << "# x-star                0.372300\n"
+        << "# y-star                0.689300\n"
+        << "# z-star                0.970100\n"
+        << "# WorkingDistance       5.000000\n"
+        << "#\n"
+        << "# Phase 1\n"
+        << "# MaterialName  \tNickel\n"
+        << "# Formula     \tNi\n"
+        << "# Info\t\t\n"
+        << "# Symmetry              43\n"
+        << "# LatticeConstants      3.520 3.520 3.520  90.000  90.000  90.000\n"
+        << "# NumberFamilies        1\n"
+        << "# hklFamilies   \t 1  1  1 1 0.000000\n"
+        << "# Categories 0 0 0 0 0 \n"
+        << "#\n"
+        << "# GRID: SqrGrid\n"
+        << "# XSTEP: 0.250000\n"
+        << "# YSTEP: 0.250000\n"
+        << "# NCOLS_ODD: " << numCols << "\n"
+        << "# NCOLS_EVEN: " << numCols << "\n"
+        << "# NROWS: " << numRows << "\n"
+        << "#\n"
+        << "# OPERATOR: \tAdministrator\n"
+        << "#\n"
+        << "# SAMPLEID: \t\n"
+        << "#\n"
+        << "# SCANID: \t\n"
+        << "#\n";
+    for(int32_t r = 0; r < numRows; r++)
+    {
+      for(int32_t c = 0; c < numCols; c++)
+      {
+        const int32_t value = 1000 * slice + 100 * r + c + 1;
+        out << " " << value << ".00000 0.50000 0.25000 " << c * 0.25f << " " << r * 0.25f << " " << value << ".0 0.500 0 " << value << " 1.000\n";
+      }
+    }
+  }
+
+  /**
+   * @brief Writes a .ctf file whose values encode the slice, row and column of each point
+   */
+  void WriteCtfFile(const std::string& filePath, int32_t slice, int32_t numCols, int32_t numRows)
+  {
+    std::ofstream out(filePath, std::ios_base::out | std::ios_base::binary);
+    out << "Channel Text File\n"
+        << "Prj\tVolumeReaderTest.cpr\n"
+        << "Author\t[Unknown]\n"
+        << "JobMode\tGrid\n"
+        << "XCells\t" << numCols << "\n"
+        << "YCells\t" << numRows << "\n"
+        << "XStep\t0.5\n"
+        << "YStep\t0.5\n"
+        << "AcqE1\t0\n"
+        << "AcqE2\t0\n"
+        << "AcqE3\t0\n"
+        << "Euler angles refer to Sample Coordinate system (CS0)!\tMag\t200\tCoverage\t100\tDevice\t0\tKV\t15\tTiltAngle\t70\tTiltAxis\t0\n"
+        << "Phases\t1\n"
+        << "3.231;3.231;5.148\t90;90;120\tZirc-alloy4\t9\t0\t0_5.0.6.0\t-67395467\t[Zr4.cry]\n"
+        << "Phase\tX\tY\tBands\tError\tEuler1\tEuler2\tEuler3\tMAD\tBC\tBS\n";
+    for(int32_t r = 0; r < numRows; r++)
+    {
+      for(int32_t c = 0; c < numCols; c++)
+      {
+        const int32_t value = 1000 * slice + 100 * r + c + 1;
+        out << "1\t" << (c + 1) * 0.5f << "\t" << (r + 1) * 0.5f << "\t8\t0\t" << value << "\t40.5\t29.25\t0.6\t" << value << "\t0\n";
+      }
+    }
+  }
+
+  /**
+   * @brief Writes the volume header that the H5Ebsd volume readers expect at the root of the file
+   */
+  void WriteVolumeHeader(hid_t fileId, const std::string& manufacturer, int32_t zStart, int32_t zEnd, int32_t xPoints, int32_t yPoints)
+  {
+    herr_t err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZStartIndex, zStart);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZEndIndex, zEnd);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::XPoints, xPoints);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::YPoints, yPoints);
+    DREAM3D_REQUIRED(err, >=, 0)
+    const float resolution = 0.25f;
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::XResolution, resolution);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::YResolution, resolution);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZResolution, resolution);
+    DREAM3D_REQUIRED(err, >=, 0)
+    const uint32_t stackingOrder = EbsdLib::RefFrameZDir::LowtoHigh;
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::StackingOrder, stackingOrder);
+    DREAM3D_REQUIRED(err, >=, 0)
+    const float angle = 0.0f;
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::SampleTransformationAngle, angle);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::EulerTransformationAngle, angle);
+    DREAM3D_REQUIRED(err, >=, 0)
+    const hsize_t axisDims[1] = {3};
+    const float axis[3] = {0.0f, 0.0f, 1.0f};
+    err = H5Lite::writePointerDataset(fileId, EbsdLib::H5Ebsd::SampleTransformationAxis, 1, axisDims, axis);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writePointerDataset(fileId, EbsdLib::H5Ebsd::EulerTransformationAxis, 1, axisDims, axis);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = H5Lite::writeStringDataset(fileId, EbsdLib::H5Ebsd::Manufacturer, manufacturer);
+    DREAM3D_REQUIRED(err, >=, 0)
+  }
+
+  /**
+   * @brief Counts the values of plane z of the volume that differ from the slice values placed at
+   * 'placement'. Every value outside of the placed rows has to be zero. Slice values below
+   * 'minValue' are expected as 'minValue'.
+   */
+  template <typename T>
+  size_t CountWrongValues(const T* volume, int64_t xPoints, int64_t yPoints, int64_t z, const T* slice, int64_t sliceCols, const Placement& placement, T minValue)
+  {
+    size_t numWrong = 0;
+    for(int64_t y = 0; y < yPoints; y++)
+    {
+      for(int64_t x = 0; x < xPoints; x++)
+      {
+        const int64_t col = x - placement.dstX;
+        const int64_t row = y - placement.dstY;
+        T expected = static_cast<T>(0);
+        if(col >= 0 && col < placement.rowLength && row >= 0 && row < placement.numRows)
+        {
+          expected = std::max(slice[(placement.srcY + row) * sliceCols + placement.srcX + col], minValue);
+        }
+        numWrong += (volume[(z * yPoints + y) * xPoints + x] != expected) ? 1 : 0;
+      }
+    }
+    return numWrong;
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestAngVolume()
+  {
+    // An 8 x 3 slice and a 4 x 6 slice stacked into an 8 x 6 x 2 volume
+    WriteAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, 1, 8, 3);
+    WriteAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile2, 2, 4, 6);
+    const std::vector<std::string> angFiles = {UnitTest::H5EbsdVolumeReaderTest::AngFile1, UnitTest::H5EbsdVolumeReaderTest::AngFile2};
+    {
+      hid_t fileId = H5Utilities::createFile(UnitTest::H5EbsdVolumeReaderTest::AngOutputFile);
+      DREAM3D_REQUIRED(fileId, >=, 0)
+      H5ScopedFileSentinel sentinel(fileId, false);
+      EbsdImporter::Pointer importer = H5AngImporter::New();
+      for(size_t i = 0; i < angFiles.size(); i++)
+      {
+        int err = importer->importFile(fileId, static_cast<int64_t>(i + 1), angFiles[i]);
+        DREAM3D_REQUIRED(err, >=, 0)
+      }
+      WriteVolumeHeader(fileId, EbsdLib::Ang::Manufacturer, 1, 2, 8, 6);
+    }
+
+    std::vector<AngReader> readers(angFiles.size());
+    for(size_t i = 0; i < angFiles.size(); i++)
+    {
+      readers[i].setFileName(angFiles[i]);
+      int err = readers[i].readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+    }
+    const std::vector<int64_t> sliceCols = {8, 4};
+
+    struct VolumeCase
+    {
+      int64_t xPoints;
+      int64_t yPoints;
+      std::vector<Placement> placements;
+    };
+    // The 8 x 3 slice is centered at row 1, the 4 x 6 slice at column 2. A volume only 6 points
+    // wide crops one column from each side of the wider slice.
+    const std::vector<VolumeCase> volumeCases = {
+        {8, 6, {{0, 1, 0, 0, 8, 3}, {2, 0, 0, 0, 4, 6}}},
+        {6, 6, {{0, 1, 1, 0, 6, 3}, {1, 0, 0, 0, 4, 6}}},
+    };
+
+    for(const auto& volumeCase : volumeCases)
+    {
+      for(uint32_t zDir : {EbsdLib::RefFrameZDir::LowtoHigh, EbsdLib::RefFrameZDir::HightoLow})
+      {
+        H5EbsdVolumeReader::Pointer volumeReader = H5AngVolumeReader::New();
+        volumeReader->setFileName(UnitTest::H5EbsdVolumeReaderTest::AngOutputFile);
+        volumeReader->setSliceStart(1);
+        volumeReader->setSliceEnd(2);
+        int err = volumeReader->loadData(volumeCase.xPoints, volumeCase.yPoints, 2, zDir);
+        DREAM3D_REQUIRED(err, >=, 0)
+
+        auto* phi1 = static_cast<float*>(volumeReader->getPointerByName(EbsdLib::Ang::Phi1));
+        auto* phases = static_cast<int32_t*>(volumeReader->getPointerByName(EbsdLib::Ang::PhaseData));
+        DREAM3D_REQUIRE_VALID_POINTER(phi1)
+        DREAM3D_REQUIRE_VALID_POINTER(phases)
+        for(int64_t slice = 0; slice < 2; slice++)
+        {
+          const int64_t z = (zDir == EbsdLib::RefFrameZDir::LowtoHigh) ? slice : 1 - slice;
+          const Placement& placement = volumeCase.placements[slice];
+          AngReader& reader = readers[slice];
+          size_t numWrong = CountWrongValues(phi1, volumeCase.xPoints, volumeCase.yPoints, z, reader.getPhi1Pointer(), sliceCols[slice], placement, 0.0f);
+          DREAM3D_REQUIRED(numWrong, ==, 0)
+          // The single phase scan stores phase 0, which becomes 1 in the rows of the slice only
+          numWrong = CountWrongValues(phases, volumeCase.xPoints, volumeCase.yPoints, z, reader.getPhaseDataPointer(), sliceCols[slice], placement, 1);
+          DREAM3D_REQUIRED(numWrong, ==, 0)
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestCtfVolume()
+  {
+    // A 7 x 2 slice and a 3 x 5 slice stacked into a 7 x 5 x 2 volume. The second slice has no
+    // X and Y data sets, like the files of older versions.
+    WriteCtfFile(UnitTest::H5EbsdVolumeReaderTest::CtfFile1, 1, 7, 2);
+    WriteCtfFile(UnitTest::H5EbsdVolumeReaderTest::CtfFile2, 2, 3, 5);
+    const std::vector<std::string> ctfFiles = {UnitTest::H5EbsdVolumeReaderTest::CtfFile1, UnitTest::H5EbsdVolumeReaderTest::CtfFile2};
+    {
+      hid_t fileId = H5Utilities::createFile(UnitTest::H5EbsdVolumeReaderTest::CtfOutputFile);
+      DREAM3D_REQUIRED(fileId, >=, 0)
+      H5ScopedFileSentinel sentinel(fileId, false);
+      EbsdImporter::Pointer importer = H5CtfImporter::New();
+      for(size_t i = 0; i < ctfFiles.size(); i++)
+      {
+        int err = importer->importFile(fileId, static_cast<int64_t>(i), ctfFiles[i]);
+        DREAM3D_REQUIRED(err, >=, 0)
+      }
+      const std::string dataPath = "1/" + EbsdLib::H5Aztec::Data + "/";
+      herr_t err = H5Ldelete(fileId, (dataPath + EbsdLib::Ctf::X).c_str(), H5P_DEFAULT);
+      DREAM3D_REQUIRED(err, >=, 0)
+      err = H5Ldelete(fileId, (dataPath + EbsdLib::Ctf::Y).c_str(), H5P_DEFAULT);
+      DREAM3D_REQUIRED(err, >=, 0)
+      WriteVolumeHeader(fileId, EbsdLib::Ctf::Manufacturer, 0, 1, 7, 5);
+    }
+
+    std::vector<CtfReader> readers(ctfFiles.size());
+    for(size_t i = 0; i < ctfFiles.size(); i++)
+    {
+      readers[i].setFileName(ctfFiles[i]);
+      int err = readers[i].readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+    }
+    const std::vector<int64_t> sliceCols = {7, 3};
+    // The odd leftovers round the offsets down
+    const std::vector<Placement> placements = {{0, 1, 0, 0, 7, 2}, {2, 0, 0, 0, 3, 5}};
+    const std::vector<float> noX(3 * 5, 0.0f);
+
+    for(uint32_t zDir : {EbsdLib::RefFrameZDir::LowtoHigh, EbsdLib::RefFrameZDir::HightoLow})
+    {
+      H5EbsdVolumeReader::Pointer volumeReader = H5CtfVolumeReader::New();
+      volumeReader->setFileName(UnitTest::H5EbsdVolumeReaderTest::CtfOutputFile);
+      volumeReader->setSliceStart(0);
+      volumeReader->setSliceEnd(1);
+      int err = volumeReader->loadData(7, 5, 2, zDir);
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      auto* euler1 = static_cast<float*>(volumeReader->getPointerByName(EbsdLib::Ctf::Euler1));
+      auto* bc = static_cast<int32_t*>(volumeReader->getPointerByName(EbsdLib::Ctf::BC));
+      auto* xPos = static_cast<float*>(volumeReader->getPointerByName(EbsdLib::Ctf::X));
+      DREAM3D_REQUIRE_VALID_POINTER(euler1)
+      DREAM3D_REQUIRE_VALID_POINTER(bc)
+      DREAM3D_REQUIRE_VALID_POINTER(xPos)
+      for(int64_t slice = 0; slice < 2; slice++)
+      {
+        const int64_t z = (zDir == EbsdLib::RefFrameZDir::LowtoHigh) ? slice : 1 - slice;
+        CtfReader& reader = readers[slice];
+        size_t numWrong = CountWrongValues(euler1, 7, 5, z, reader.getEuler1Pointer(), sliceCols[slice], placements[slice], 0.0f);
+        DREAM3D_REQUIRED(numWrong, ==, 0)
+        numWrong = CountWrongValues(bc, 7, 5, z, reader.getBandContrastPointer(), sliceCols[slice], placements[slice], 0);
+        DREAM3D_REQUIRED(numWrong, ==, 0)
+        const float* expectedX = (slice == 0) ? reader.getXPointer() : noX.data();
+        numWrong = CountWrongValues(xPos, 7, 5, z, expectedX, sliceCols[slice], placements[slice], 0.0f);
+        DREAM3D_REQUIRED(numWrong, ==, 0)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestWrongDatasetSize()
+  {
+    WriteAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, 1, 8, 3);
+    {
+      hid_t fileId = H5Utilities::createFile(UnitTest::H5EbsdVolumeReaderTest::BadSizeOutputFile);
+      DREAM3D_REQUIRED(fileId, >=, 0)
+      H5ScopedFileSentinel sentinel(fileId, false);
+      EbsdImporter::Pointer importer = H5AngImporter::New();
+      int err = importer->importFile(fileId, 1, UnitTest::H5EbsdVolumeReaderTest::AngFile1);
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      // Replace Phi with a data set that is one value short
+      const std::string phiPath = "1/" + EbsdLib::H5OIM::Data + "/" + EbsdLib::Ang::Phi;
+      err = H5Ldelete(fileId, phiPath.c_str(), H5P_DEFAULT);
+      DREAM3D_REQUIRED(err, >=, 0)
+      const std::vector<float> shortPhi(8 * 3 - 1, 1.0f);
+      const hsize_t dims[1] = {shortPhi.size()};
+      err = H5Lite::writePointerDataset(fileId, phiPath, 1, dims, shortPhi.data());
+      DREAM3D_REQUIRED(err, >=, 0)
+      WriteVolumeHeader(fileId, EbsdLib::Ang::Manufacturer, 1, 1, 8, 3);
+    }
+
+    H5EbsdVolumeReader::Pointer volumeReader = H5AngVolumeReader::New();
+    volumeReader->setFileName(UnitTest::H5EbsdVolumeReaderTest::BadSizeOutputFile);
+    volumeReader->setSliceStart(1);
+    volumeReader->setSliceEnd(1);
+    int err = volumeReader->loadData(8, 3, 1, EbsdLib::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, ==, -90022)
+    err = volumeReader->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -90022)
+  }
+
+  /**
+   * @brief Imports the .ang file as slice 1 of a new .h5ebsd file with the given layout
+   */
+  int ImportAngFile(const std::string& angFile, const std::string& outputFile, const H5DatasetLayout& layout)
+  {
+    hid_t fileId = H5Utilities::createFile(outputFile);
+    DREAM3D_REQUIRED(fileId, >=, 0)
+    H5ScopedFileSentinel sentinel(fileId, false);
+    EbsdImporter::Pointer importer = H5AngImporter::New();
+    importer->setDatasetLayout(layout);
+    int err = importer->importFile(fileId, 1, angFile);
+    if(err < 0)
+    {
+      return err;
+    }
+    WriteVolumeHeader(fileId, EbsdLib::Ang::Manufacturer, 1, 1, 8, 3);
+    return err;
+  }
+
+  /**
+   * @brief Loads slice 1 of the .h5ebsd file and returns the bytes of every Ang data array
+   */
+  std::vector<std::vector<char>> LoadAngArrays(const std::string& outputFile)
+  {
+    std::vector<std::vector<char>> arrays;
+    H5EbsdVolumeReader::Pointer volumeReader = H5AngVolumeReader::New();
+    volumeReader->setFileName(outputFile);
+    volumeReader->setSliceStart(1);
+    volumeReader->setSliceEnd(1);
+    int err = volumeReader->loadData(8, 3, 1, EbsdLib::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, >=, 0)
+    for(const auto& name : {EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2, EbsdLib::Ang::XPosition, EbsdLib::Ang::YPosition, EbsdLib::Ang::ImageQuality, EbsdLib::Ang::ConfidenceIndex,
+                            EbsdLib::Ang::PhaseData, EbsdLib::Ang::SEMSignal, EbsdLib::Ang::Fit})
+    {
+      const char* data = static_cast<const char*>(volumeReader->getPointerByName(name));
+      DREAM3D_REQUIRE_VALID_POINTER(data)
+      // Every Ang array holds 4 byte values
+      arrays.emplace_back(data, data + 8 * 3 * 4);
+    }
+    return arrays;
+  }
+
+  /**
+   * @brief Returns true if this HDF5 library can compress with SZip
+   */
+  bool CanEncodeSZip()
+  {
+    unsigned int filterConfig = 0;
+    return H5Zfilter_avail(H5Z_FILTER_SZIP) > 0 && H5Zget_filter_info(H5Z_FILTER_SZIP, &filterConfig) >= 0 && (filterConfig & H5Z_FILTER_CONFIG_ENCODE_ENABLED) != 0;
+  }
+
+  /**
+   * @brief Checks the storage layout and the filters of the Phi1 data set of slice 1
+   */
+  void CheckPhi1Layout(const std::string& outputFile, int rank, const std::vector<H5Z_filter_t>& filters)
+  {
+    hid_t fileId = H5Utilities::openFile(outputFile, true);
+    DREAM3D_REQUIRED(fileId, >=, 0)
+    H5ScopedFileSentinel sentinel(fileId, false);
+    const std::string phi1Path = "1/" + EbsdLib::H5OIM::Data + "/" + EbsdLib::Ang::Phi1;
+    hid_t datasetId = H5Dopen(fileId, phi1Path.c_str(), H5P_DEFAULT);
+    DREAM3D_REQUIRED(datasetId, >=, 0)
+    hid_t spaceId = H5Dget_space(datasetId);
+    int datasetRank = H5Sget_simple_extent_ndims(spaceId);
+    H5Sclose(spaceId);
+    hid_t dcpl = H5Dget_create_plist(datasetId);
+    H5D_layout_t storage = H5Pget_layout(dcpl);
+    int numFilters = H5Pget_nfilters(dcpl);
+    std::vector<herr_t> foundFilters;
+    for(H5Z_filter_t filter : filters)
+    {
+      unsigned int flags = 0;
+      size_t numValues = 0;
+      unsigned int filterConfig = 0;
+      foundFilters.push_back(H5Pget_filter_by_id2(dcpl, filter, &flags, &numValues, nullptr, 0, nullptr, &filterConfig));
+    }
+    H5Pclose(dcpl);
+    H5Dclose(datasetId);
+
+    DREAM3D_REQUIRED(datasetRank, ==, rank)
+    DREAM3D_REQUIRE_EQUAL(storage, H5D_CHUNKED)
+    DREAM3D_REQUIRED(numFilters, ==, static_cast<int>(filters.size()))
+    for(herr_t found : foundFilters)
+    {
+      DREAM3D_REQUIRED(found, >=, 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestDatasetLayouts()
+  {
+    WriteAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, 1, 8, 3);
+    int err = ImportAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, H5DatasetLayout());
+    DREAM3D_REQUIRED(err, >=, 0)
+    const std::vector<std::vector<char>> contiguousArrays = LoadAngArrays(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile);
+
+    // Two rows per chunk and 2 x 2 tiles leave partial chunks at the edges of the 8 x 3 scan
+    H5DatasetLayout rowsLayout;
+    rowsLayout.chunkShape = H5DatasetLayout::ChunkShape::Rows;
+    rowsLayout.rowsPerChunk = 2;
+    rowsLayout.compression = H5DatasetLayout::Compression::Deflate;
+    rowsLayout.shuffle = true;
+    err = ImportAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, rowsLayout);
+    DREAM3D_REQUIRED(err, >=, 0)
+    CheckPhi1Layout(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, 1, {H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE});
+    bool sameArrays = (LoadAngArrays(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile) == contiguousArrays);
+    DREAM3D_REQUIRE_EQUAL(sameArrays, true)
+
+    H5DatasetLayout tilesLayout;
+    tilesLayout.chunkShape = H5DatasetLayout::ChunkShape::Tiles;
+    tilesLayout.tileSize = 2;
+    err = ImportAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, tilesLayout);
+    DREAM3D_REQUIRED(err, >=, 0)
+    CheckPhi1Layout(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, 2, {});
+    sameArrays = (LoadAngArrays(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile) == contiguousArrays);
+    DREAM3D_REQUIRE_EQUAL(sameArrays, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestSZipLayout()
+  {
+    WriteAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, 1, 8, 3);
+    H5DatasetLayout szipLayout;
+    szipLayout.chunkShape = H5DatasetLayout::ChunkShape::Rows;
+    szipLayout.compression = H5DatasetLayout::Compression::SZip;
+    szipLayout.compressionLevel = 8;
+
+    // An SZip layout either writes SZip compressed data sets or fails when this HDF5 library can
+    // not encode with SZip. It never falls back to uncompressed data sets.
+    int err = ImportAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile1, UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, szipLayout);
+    if(!CanEncodeSZip())
+    {
+      DREAM3D_REQUIRED(err, <, 0)
+      return;
+    }
+    DREAM3D_REQUIRED(err, >=, 0)
+    CheckPhi1Layout(UnitTest::H5EbsdVolumeReaderTest::LayoutOutputFile, 1, {H5Z_FILTER_SZIP});
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestAngVolume())
+    DREAM3D_REGISTER_TEST(TestCtfVolume())
+    DREAM3D_REGISTER_TEST(TestWrongDatasetSize())
+    DREAM3D_REGISTER_TEST(TestDatasetLayouts())
+    DREAM3D_REGISTER_TEST(TestSZipLayout())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  H5EbsdVolumeReaderTest(const H5EbsdVolumeReaderTest&) = delete;            // Copy Constructor Not Implemented
+  H5EbsdVolumeReaderTest(H5EbsdVolumeReaderTest&&) = delete;                 // Move Constructor Not Implemented
+  H5EbsdVolumeReaderTest& operator=(const H5EbsdVolumeReaderTest&) = delete; // Copy Assignment Not Implemented
+  H5EbsdVolumeReaderTest& operator=(H5EbsdVolumeReaderTest&&) = delete;      // Move Assignment Not Implemented
+};
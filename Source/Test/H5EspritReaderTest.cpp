@@ -9,6 +9,7 @@
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/IO/BrukerNano/EspritConstants.h"
 #include "EbsdLib/IO/BrukerNano/H5EspritReader.h"
+#include "EbsdLib/IO/H5PatternReader.h"
 #include "EbsdLib/Test/EbsdLibTestFileLocations.h"
 
 #include "UnitTestSupport.hpp"
@@ -212,6 +213,122 @@ public:
 #endif
   }
 
+  // -----------------------------------------------------------------------------
+  void TestPatternStreaming()
+  {
+    // Write a small chunked pattern data set laid out like an Esprit file
+    const hsize_t numPatterns = 50;
+    const hsize_t patternHeight = 6;
+    const hsize_t patternWidth = 8;
+    const hsize_t chunkPatterns = 8;
+    const size_t patternSize = patternHeight * patternWidth;
+    auto expectedValue = [](size_t patternIndex, size_t i) { return static_cast<uint8_t>((patternIndex * 7 + i) % 251); };
+    {
+      std::vector<uint8_t> patterns(numPatterns * patternSize);
+      for(size_t p = 0; p < numPatterns; p++)
+      {
+        for(size_t i = 0; i < patternSize; i++)
+        {
+          patterns[p * patternSize + i] = expectedValue(p, i);
+        }
+      }
+      hid_t fileId = H5Utilities::createFile(UnitTest::H5EspritReaderTest::OutputFile);
+      DREAM3D_REQUIRED(fileId, >=, 0)
+      H5ScopedFileSentinel sentinel(fileId, false);
+      hid_t linkPropId = H5Pcreate(H5P_LINK_CREATE);
+      H5Pset_create_intermediate_group(linkPropId, 1);
+      const std::string groupPath = k_HDF5Path + "/" + EbsdLib::H5Esprit::EBSD + "/" + EbsdLib::H5Esprit::Data;
+      hid_t gid = H5Gcreate(fileId, groupPath.c_str(), linkPropId, H5P_DEFAULT, H5P_DEFAULT);
+      H5Pclose(linkPropId);
+      sentinel.addGroupId(gid);
+
+      std::vector<hsize_t> dims = {numPatterns, patternHeight, patternWidth};
+      std::vector<hsize_t> chunkDims = {chunkPatterns, patternHeight, patternWidth};
+      hid_t spaceId = H5Screate_simple(3, dims.data(), nullptr);
+      hid_t createPropId = H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(createPropId, 3, chunkDims.data());
+      hid_t datasetId = H5Dcreate(gid, EbsdLib::H5Esprit::RawPatterns.c_str(), H5T_NATIVE_UINT8, spaceId, H5P_DEFAULT, createPropId, H5P_DEFAULT);
+      DREAM3D_REQUIRED(datasetId, >=, 0)
+      herr_t err = H5Dwrite(datasetId, H5T_NATIVE_UINT8, H5S_ALL, H5S_ALL, H5P_DEFAULT, patterns.data());
+      DREAM3D_REQUIRED(err, >=, 0)
+      H5Dclose(datasetId);
+      H5Pclose(createPropId);
+      H5Sclose(spaceId);
+    }
+
+    H5EspritReader::Pointer reader = H5EspritReader::New();
+    reader->setFileName(UnitTest::H5EspritReaderTest::OutputFile);
+    reader->setHDF5Path(k_HDF5Path);
+
+    // Random access to a range that straddles two chunks
+    std::vector<uint8_t> buffer(5 * patternSize);
+    int32_t err = reader->readPatterns(6, 5, buffer.data());
+    DREAM3D_REQUIRED(err, >=, 0)
+    size_t numWrong = 0;
+    for(size_t p = 0; p < 5; p++)
+    {
+      for(size_t i = 0; i < patternSize; i++)
+      {
+        numWrong += (buffer[p * patternSize + i] != expectedValue(p + 6, i)) ? 1 : 0;
+      }
+    }
+    DREAM3D_REQUIRED(numWrong, ==, 0)
+
+    err = reader->readPatterns(48, 5, buffer.data());
+    DREAM3D_REQUIRED(err, <, 0)
+
+    // Stream every pattern in chunk aligned blocks
+    H5PatternReader::Pointer patternReader = reader->createPatternReader();
+    DREAM3D_REQUIRE_VALID_POINTER(patternReader.get());
+    size_t numRead = patternReader->getNumberOfPatterns();
+    DREAM3D_REQUIRED(numRead, ==, numPatterns)
+    size_t value = patternReader->getPatternSize();
+    DREAM3D_REQUIRED(value, ==, patternSize)
+    value = patternReader->getChunkPatterns();
+    DREAM3D_REQUIRED(value, ==, chunkPatterns)
+
+    H5PatternReader::BlockIterator iter(*patternReader, 10);
+    value = iter.getBlockSize();
+    DREAM3D_REQUIRED(value, ==, 16)
+    size_t nextIndex = 0;
+    numRead = 0;
+    while(iter.next())
+    {
+      const size_t firstIndex = iter.getFirstIndex();
+      DREAM3D_REQUIRED(firstIndex, ==, nextIndex)
+      const uint8_t* patterns = iter.data();
+      for(size_t p = 0; p < iter.getCount(); p++)
+      {
+        for(size_t i = 0; i < patternSize; i++)
+        {
+          numWrong += (patterns[p * patternSize + i] != expectedValue(firstIndex + p, i)) ? 1 : 0;
+        }
+      }
+      nextIndex = firstIndex + iter.getCount();
+      numRead += iter.getCount();
+    }
+    DREAM3D_REQUIRED(iter.getErrorCode(), >=, 0)
+    DREAM3D_REQUIRED(numRead, ==, numPatterns)
+    DREAM3D_REQUIRED(numWrong, ==, 0)
+
+    // Changing the scan reopens the pattern data set and open errors reach the Esprit reader
+    reader->setHDF5Path("MissingScan");
+    err = reader->readPatterns(0, 1, buffer.data());
+    DREAM3D_REQUIRED(err, ==, -90501)
+    err = reader->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -90501)
+    reader->setHDF5Path(k_HDF5Path);
+    err = reader->readPatterns(0, 1, buffer.data());
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    H5EspritReader::Pointer noScanReader = H5EspritReader::New();
+    noScanReader->setFileName(UnitTest::H5EspritReaderTest::OutputFile);
+    patternReader = noScanReader->createPatternReader();
+    DREAM3D_REQUIRE_NULL_POINTER(patternReader.get())
+    err = noScanReader->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -90510)
+  }
+
   // -----------------------------------------------------------------------------
   void operator()()
   {
@@ -220,6 +337,7 @@ public:
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
 
     DREAM3D_REGISTER_TEST(TestH5EspritReader())
+    DREAM3D_REGISTER_TEST(TestPatternStreaming())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
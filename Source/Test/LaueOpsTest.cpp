@@ -0,0 +1,640 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/HexagonalOps.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+
+#include "UnitTestSupport.hpp"
+
+/**
+ * @brief Makes the protected LaueOps search helpers callable from the tests
+ */
+class LaueOpsHelperProbe : public CubicOps
+{
+public:
+  using LaueOps::_calcNearestQuat;
+  using LaueOps::_calcQuatNearestOrigin;
+  using LaueOps::_calcRodNearestOrigin;
+};
+
+class LaueOpsTest
+{
+public:
+  LaueOpsTest() = default;
+  virtual ~LaueOpsTest() = default;
+
+  LaueOpsTest(const LaueOpsTest&) = delete;            // Copy Constructor Not Implemented
+  LaueOpsTest(LaueOpsTest&&) = delete;                 // Move Constructor Not Implemented
+  LaueOpsTest& operator=(const LaueOpsTest&) = delete; // Copy Assignment Not Implemented
+  LaueOpsTest& operator=(LaueOpsTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(LaueOpsTest)
+
+  // -----------------------------------------------------------------------------
+  void StoreQuat(const QuatD& q, std::vector<float>& quats)
+  {
+    quats.push_back(static_cast<float>(q.x()));
+    quats.push_back(static_cast<float>(q.y()));
+    quats.push_back(static_cast<float>(q.z()));
+    quats.push_back(static_cast<float>(q.w()));
+  }
+
+  // -----------------------------------------------------------------------------
+  QuatD LoadQuat(const std::vector<float>& quats, size_t i)
+  {
+    return QuatD(quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]);
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestCalculateMisorientations()
+  {
+    const size_t numRandomPairs = 2000;
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t opIndex = 0; opIndex < allOps.size(); opIndex++)
+    {
+      const LaueOps::Pointer& ops = allOps[opIndex];
+      if(ops->getNumSymOps() == 0)
+      {
+        continue;
+      }
+      std::vector<float> q1;
+      std::vector<float> q2;
+      for(size_t i = 0; i < numRandomPairs; i++)
+      {
+        for(std::vector<float>* quats : {&q1, &q2})
+        {
+          OrientationD eu(distribution(generator) * EbsdLib::Constants::k_2PiD, distribution(generator) * EbsdLib::Constants::k_PiD, distribution(generator) * EbsdLib::Constants::k_2PiD);
+          StoreQuat(OrientationTransformation::eu2qu<OrientationD, QuatD>(eu), *quats);
+        }
+      }
+      // Identical and symmetrically equivalent pairs have no misorientation
+      QuatD q = LoadQuat(q1, 0);
+      for(int s = 0; s < ops->getNumSymOps(); s++)
+      {
+        StoreQuat(q, q1);
+        StoreQuat(ops->getQuatSymOp(s) * q, q2);
+      }
+      const size_t numPairs = q1.size() / 4;
+      std::vector<float> axisAngles(numPairs * 4);
+      ops->calculateMisorientations(q1.data(), q2.data(), numPairs, axisAngles.data());
+
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        QuatD qa = LoadQuat(q1, i);
+        QuatD qb = LoadQuat(q2, i);
+        const float* axisAngle = axisAngles.data() + i * 4;
+        double axisLength = std::sqrt(axisAngle[0] * axisAngle[0] + axisAngle[1] * axisAngle[1] + axisAngle[2] * axisAngle[2]);
+        DREAM3D_REQUIRED(std::fabs(axisLength - 1.0), <, 1.0E-5)
+        if(i >= numRandomPairs)
+        {
+          DREAM3D_REQUIRED(axisAngle[3], <, 1.0E-3)
+          continue;
+        }
+        OrientationD exemplar = ops->calculateMisorientation(qa, qb);
+        DREAM3D_REQUIRED(std::fabs(exemplar[3] - axisAngle[3]), <, 1.0E-4)
+
+        // The axis angle must be one of the symmetrically equivalent misorientations
+        double sinHalfAngle = std::sin(axisAngle[3] * 0.5);
+        QuatD result(axisAngle[0] * sinHalfAngle, axisAngle[1] * sinHalfAngle, axisAngle[2] * sinHalfAngle, std::cos(axisAngle[3] * 0.5));
+        QuatD qr = qa * qb.conjugate();
+        double bestDot = 0.0;
+        for(int s = 0; s < ops->getNumSymOps(); s++)
+        {
+          QuatD qc = ops->getQuatSymOp(s) * qr;
+          double dot = qc.x() * result.x() + qc.y() * result.y() + qc.z() * result.z() + qc.w() * result.w();
+          bestDot = std::max(bestDot, std::fabs(dot));
+        }
+        DREAM3D_REQUIRED(bestDot, >, 1.0 - 1.0E-5)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestGetFZQuats()
+  {
+    const size_t numQuats = 2000;
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t opIndex = 0; opIndex < allOps.size(); opIndex++)
+    {
+      const LaueOps::Pointer& ops = allOps[opIndex];
+      if(ops->getNumSymOps() == 0)
+      {
+        continue;
+      }
+      std::vector<float> quats;
+      for(size_t i = 0; i < numQuats; i++)
+      {
+        OrientationD eu(distribution(generator) * EbsdLib::Constants::k_2PiD, distribution(generator) * EbsdLib::Constants::k_PiD, distribution(generator) * EbsdLib::Constants::k_2PiD);
+        StoreQuat(OrientationTransformation::eu2qu<OrientationD, QuatD>(eu), quats);
+      }
+      std::vector<float> fzQuats(quats.size());
+      ops->getFZQuats(quats.data(), numQuats, fzQuats.data());
+
+      for(size_t i = 0; i < numQuats; i++)
+      {
+        QuatD exemplar = ops->getFZQuat(LoadQuat(quats, i));
+        QuatD fz = LoadQuat(fzQuats, i);
+        DREAM3D_REQUIRED(fz.w(), >=, 0.0)
+        DREAM3D_REQUIRED(std::fabs(exemplar.x() - fz.x()), <, 1.0E-5)
+        DREAM3D_REQUIRED(std::fabs(exemplar.y() - fz.y()), <, 1.0E-5)
+        DREAM3D_REQUIRED(std::fabs(exemplar.z() - fz.z()), <, 1.0E-5)
+        DREAM3D_REQUIRED(std::fabs(exemplar.w() - fz.w()), <, 1.0E-5)
+
+        // Every symmetric equivalent reduces to the same quaternion
+        QuatD equivalent = ops->getQuatSymOp(static_cast<int>(i % ops->getNumSymOps())) * LoadQuat(quats, i);
+        QuatD fzEquivalent = ops->getFZQuat(equivalent);
+        double dot = fz.x() * fzEquivalent.x() + fz.y() * fzEquivalent.y() + fz.z() * fzEquivalent.z() + fz.w() * fzEquivalent.w();
+        DREAM3D_REQUIRED(dot, >, 1.0 - 1.0E-5)
+      }
+
+      // The reduction may be done in place
+      ops->getFZQuats(quats.data(), numQuats, quats.data());
+      DREAM3D_REQUIRE(quats == fzQuats)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestGetFZQuatsReference()
+  {
+    // Fundamental zone quaternions computed with the original LaueOps::_calcQuatNearestOrigin and the
+    // symmetry operators of each Laue class. Both getFZQuat and getFZQuats share the templated
+    // operator search so they are checked against these fixed values rather than against each other.
+    const std::array<std::array<double, 3>, 5> eulers = {{{0.3, 0.7, 1.9}, {4.1, 2.2, 0.5}, {2.6, 1.3, 5.7}, {5.5, 0.4, 3.3}, {1.2, 2.9, 4.4}}};
+    const std::vector<std::array<double, 4>> expectedQuats = {
+        // Hexagonal 6/mmm
+        {-0.332474383, -0.083902863, -0.049578136, 0.938063482},
+        {-0.338248992, -0.302220219, -0.202484179, 0.867900176},
+        {0.530285842, -0.291629061, 0.030872508, 0.795484945},
+        {-0.108276802, 0.166570216, -0.205464064, 0.958287540},
+        {0.040367000, 0.113540401, 0.028986745, 0.992289701},
+        // Cubic m3m
+        {-0.342861253, 0.005006760, -0.290677495, 0.893267982},
+        {-0.338248992, -0.302220219, -0.202484179, 0.867900176},
+        {-0.048379097, 0.309050635, 0.291253115, 0.904056852},
+        {-0.177055570, 0.090115638, 0.301206674, 0.932633388},
+        {0.040367000, 0.113540401, 0.028986745, 0.992289701},
+        // Hexagonal 6/m
+        {-0.332474383, -0.083902863, -0.049578136, 0.938063482},
+        {0.650381508, 0.609306530, -0.092605890, 0.444042328},
+        {0.530285842, -0.291629061, 0.030872508, 0.795484945},
+        {-0.108276802, 0.166570216, -0.205464064, 0.958287540},
+        {-0.521248108, -0.844854713, -0.021811354, 0.118512371},
+        // Cubic m3 (Tetrahedral)
+        {0.389196330, 0.209080342, -0.201999714, 0.874075364},
+        {-0.338248992, -0.302220219, -0.202484179, 0.867900176},
+        {-0.240156240, -0.420732931, 0.171737865, 0.857796530},
+        {-0.177055570, 0.090115638, 0.301206674, 0.932633388},
+        {0.040367000, 0.113540401, 0.028986745, 0.992289701},
+        // Triclinic -1
+        {-0.238899203, 0.245979831, -0.837175876, 0.426095819},
+        {-0.202484179, 0.867900176, 0.338248992, 0.302220219},
+        {0.012584747, -0.605055543, -0.673473918, 0.424478852},
+        {0.090115638, 0.177055570, -0.932633388, 0.301206674},
+        {-0.028986745, -0.992289701, 0.040367000, 0.113540401},
+        // Monoclinic 2/m
+        {-0.238899203, 0.245979831, -0.837175876, 0.426095819},
+        {-0.338248992, -0.302220219, -0.202484179, 0.867900176},
+        {-0.673473918, 0.424478852, -0.012584747, 0.605055543},
+        {0.090115638, 0.177055570, -0.932633388, 0.301206674},
+        {0.040367000, 0.113540401, 0.028986745, 0.992289701},
+        // OrthoRhombic mmm
+        {-0.245979831, -0.238899203, 0.426095819, 0.837175876},
+        {-0.338248992, -0.302220219, -0.202484179, 0.867900176},
+        {0.605055543, 0.012584747, 0.424478852, 0.673473918},
+        {-0.177055570, 0.090115638, 0.301206674, 0.932633388},
+        {0.040367000, 0.113540401, 0.028986745, 0.992289701},
+        // Tetragonal 4/m
+        {-0.342861253, 0.005006760, -0.290677495, 0.893267982},
+        {0.470520164, 0.756876036, 0.025476190, 0.452880122},
+        {0.436737637, -0.418940117, -0.176066100, 0.776369849},
+        {-0.177055570, 0.090115638, 0.301206674, 0.932633388},
+        {-0.028986745, -0.992289701, 0.040367000, 0.113540401},
+        // Tetragonal 4/mmm
+        {-0.342861253, 0.005006760, -0.290677495, 0.893267982},
+        {-0.338248992, -0.302220219, -0.202484179, 0.867900176},
+        {0.436737637, -0.418940117, -0.176066100, 0.776369849},
+        {-0.177055570, 0.090115638, 0.301206674, 0.932633388},
+        {0.040367000, 0.113540401, 0.028986745, 0.992289701},
+        // Trigonal -3
+        {-0.332474383, -0.083902863, -0.049578136, 0.938063482},
+        {0.650381508, 0.609306530, -0.092605890, 0.444042328},
+        {0.530285842, -0.291629061, 0.030872508, 0.795484945},
+        {-0.108276802, 0.166570216, -0.205464064, 0.958287540},
+        {-0.028986745, -0.992289701, 0.040367000, 0.113540401},
+        // Trigonal -3m
+        {-0.332474383, -0.083902863, -0.049578136, 0.938063482},
+        {-0.141822109, -0.430854882, 0.258593646, 0.852865687},
+        {0.530285842, -0.291629061, 0.030872508, 0.795484945},
+        {-0.108276802, 0.166570216, -0.205464064, 0.958287540},
+        {0.091729048, 0.078145372, -0.471041593, 0.873841458}};
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      const LaueOps& ops = *allOps[laueIndex];
+      std::vector<float> quats;
+      for(const auto& eu : eulers)
+      {
+        StoreQuat(OrientationTransformation::eu2qu<OrientationD, QuatD>(OrientationD(eu[0], eu[1], eu[2])), quats);
+      }
+      std::vector<float> fzQuats(quats.size());
+      ops.getFZQuats(quats.data(), eulers.size(), fzQuats.data());
+
+      for(size_t i = 0; i < eulers.size(); i++)
+      {
+        const std::array<double, 4>& expected = expectedQuats[laueIndex * eulers.size() + i];
+        QuatD fz = ops.getFZQuat(OrientationTransformation::eu2qu<OrientationD, QuatD>(OrientationD(eulers[i][0], eulers[i][1], eulers[i][2])));
+        DREAM3D_REQUIRED(std::fabs(fz.x() - expected[0]), <, 1.0E-8)
+        DREAM3D_REQUIRED(std::fabs(fz.y() - expected[1]), <, 1.0E-8)
+        DREAM3D_REQUIRED(std::fabs(fz.z() - expected[2]), <, 1.0E-8)
+        DREAM3D_REQUIRED(std::fabs(fz.w() - expected[3]), <, 1.0E-8)
+
+        QuatD fzBatch = LoadQuat(fzQuats, i);
+        DREAM3D_REQUIRED(std::fabs(fzBatch.x() - expected[0]), <, 1.0E-6)
+        DREAM3D_REQUIRED(std::fabs(fzBatch.y() - expected[1]), <, 1.0E-6)
+        DREAM3D_REQUIRED(std::fabs(fzBatch.z() - expected[2]), <, 1.0E-6)
+        DREAM3D_REQUIRED(std::fabs(fzBatch.w() - expected[3]), <, 1.0E-6)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestSearchHelpers()
+  {
+    // The protected helpers take the symmetry operators as vectors and have to give the same
+    // results as the Laue classes that search their constexpr tables.
+    const LaueOpsHelperProbe probe;
+    const QuatD q1 = OrientationTransformation::eu2qu<OrientationD, QuatD>(OrientationD(0.3, 0.7, 1.9));
+    const QuatD q2 = OrientationTransformation::eu2qu<OrientationD, QuatD>(OrientationD(4.1, 2.2, 0.5));
+    const OrientationType rod = OrientationTransformation::qu2ro<QuatD, OrientationType>(q2);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      const LaueOps& ops = *allOps[laueIndex];
+      std::vector<QuatD> quatSym;
+      std::vector<OrientationD> rodSym;
+      for(int i = 0; i < ops.getNumSymOps(); i++)
+      {
+        quatSym.push_back(ops.getQuatSymOp(i));
+        OrientationD r(3, 0.0);
+        ops.getRodSymOp(i, r.data());
+        rodSym.push_back(r);
+      }
+
+      QuatD fz = probe._calcQuatNearestOrigin(quatSym, q2);
+      QuatD expected = ops.getFZQuat(q2);
+      DREAM3D_REQUIRED(std::fabs(fz.x() - expected.x()), <, 1.0E-12)
+      DREAM3D_REQUIRED(std::fabs(fz.y() - expected.y()), <, 1.0E-12)
+      DREAM3D_REQUIRED(std::fabs(fz.z() - expected.z()), <, 1.0E-12)
+      DREAM3D_REQUIRED(std::fabs(fz.w() - expected.w()), <, 1.0E-12)
+
+      QuatD nearest = probe._calcNearestQuat(quatSym, q1, q2);
+      expected = ops.getNearestQuat(q1, q2);
+      DREAM3D_REQUIRED(std::fabs(nearest.x() - expected.x()), <, 1.0E-12)
+      DREAM3D_REQUIRED(std::fabs(nearest.y() - expected.y()), <, 1.0E-12)
+      DREAM3D_REQUIRED(std::fabs(nearest.z() - expected.z()), <, 1.0E-12)
+      DREAM3D_REQUIRED(std::fabs(nearest.w() - expected.w()), <, 1.0E-12)
+
+      OrientationType fzRod = probe._calcRodNearestOrigin(rodSym, rod);
+      OrientationType expectedRod = ops.getODFFZRod(rod);
+      for(size_t c = 0; c < 4; c++)
+      {
+        DREAM3D_REQUIRED(std::fabs(fzRod[c] - expectedRod[c]), <, 1.0E-12)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestGenerateIPFColors()
+  {
+    const size_t numPoints = 5000;
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    // One phase per Laue class followed by a phase with an unknown crystal structure
+    std::vector<uint32_t> crystalStructures;
+    for(uint32_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      crystalStructures.push_back(laueIndex);
+    }
+    crystalStructures.push_back(EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    const int32_t numPhases = static_cast<int32_t>(crystalStructures.size());
+
+    std::vector<float> eulers(numPoints * 3);
+    std::vector<int32_t> phases(numPoints);
+    std::unique_ptr<bool[]> goodVoxels(new bool[numPoints]);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      eulers[i * 3] = static_cast<float>(distribution(generator) * 360.0);
+      eulers[i * 3 + 1] = static_cast<float>(distribution(generator) * 180.0);
+      eulers[i * 3 + 2] = static_cast<float>(distribution(generator) * 360.0);
+      // Include phases that are out of range
+      phases[i] = static_cast<int32_t>(i % (numPhases + 2)) - 1;
+      goodVoxels[i] = (i % 7) != 0;
+    }
+
+    double refDir[3] = {0.0, 0.6, 0.8};
+    std::vector<uint8_t> colors(numPoints * 3, 128);
+    LaueOps::GenerateIPFColors(eulers.data(), phases.data(), crystalStructures, refDir, goodVoxels.get(), numPoints, colors.data(), true);
+
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      const int32_t phase = phases[i];
+      EbsdLib::Rgb argb = 0;
+      if(goodVoxels[i] && phase >= 0 && phase < numPhases && crystalStructures[phase] < EbsdLib::CrystalStructure::LaueGroupEnd)
+      {
+        argb = allOps[crystalStructures[phase]]->generateIPFColor(eulers[i * 3], eulers[i * 3 + 1], eulers[i * 3 + 2], refDir[0], refDir[1], refDir[2], true);
+      }
+      DREAM3D_REQUIRE_EQUAL(colors[i * 3], static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb)))
+      DREAM3D_REQUIRE_EQUAL(colors[i * 3 + 1], static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb)))
+      DREAM3D_REQUIRE_EQUAL(colors[i * 3 + 2], static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb)))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestGenerateIPFColorsReference()
+  {
+    // Colors computed with the original generateIPFColor of each Laue class for the reference
+    // direction <0, 0.6, 0.8>. Both generateIPFColor and GenerateIPFColors use IPFColorKernels so
+    // they are checked against these fixed values rather than against each other.
+    const std::array<std::array<float, 3>, 6> eulers = {
+        {{37.0f, 12.0f, 81.0f}, {201.0f, 95.0f, 13.0f}, {123.5f, 47.25f, 300.0f}, {310.0f, 160.0f, 222.0f}, {5.0f, 88.0f, 145.0f}, {270.0f, 30.0f, 60.0f}}};
+    const std::vector<std::array<uint8_t, 3>> expectedColors = {
+        // Hexagonal 6/mmm
+        {255, 148, 220}, {180, 53, 255}, {255, 97, 195}, {255, 32, 167}, {206, 255, 55}, {255, 91, 244},
+        // Cubic m3m
+        {9, 255, 234}, {192, 255, 58}, {117, 255, 99}, {255, 161, 241}, {101, 119, 255}, {41, 255, 77},
+        // Hexagonal 6/m
+        {255, 156, 215}, {244, 244, 255}, {255, 138, 169}, {255, 123, 118}, {204, 255, 38}, {255, 196, 173},
+        // Cubic m3 (Tetrahedral)
+        {6, 122, 223}, {150, 202, 32}, {100, 60, 226}, {168, 155, 112}, {86, 184, 153}, {39, 246, 51},
+        // Triclinic -1
+        {255, 250, 90}, {248, 251, 255}, {255, 149, 159}, {255, 71, 155}, {246, 177, 255}, {255, 188, 181},
+        // Monoclinic 2/m
+        {255, 250, 90}, {248, 251, 255}, {255, 149, 159}, {255, 71, 155}, {246, 177, 255}, {255, 188, 181},
+        // OrthoRhombic mmm
+        {255, 233, 127}, {178, 30, 255}, {255, 56, 211}, {255, 138, 100}, {250, 186, 255}, {253, 52, 255},
+        // Tetragonal 4/m
+        {255, 127, 233}, {178, 255, 30}, {255, 211, 56}, {255, 100, 138}, {250, 255, 186}, {253, 52, 255},
+        // Tetragonal 4/mmm
+        {255, 195, 180}, {179, 255, 43}, {255, 203, 79}, {255, 95, 142}, {242, 168, 255}, {255, 250, 74},
+        // Trigonal -3
+        {255, 110, 242}, {202, 143, 255}, {255, 97, 195}, {255, 148, 83}, {203, 255, 27}, {255, 138, 221},
+        // Trigonal -3m
+        {255, 105, 244}, {178, 37, 255}, {255, 68, 207}, {255, 169, 22}, {255, 232, 222}, {255, 64, 253}};
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    double refDir[3] = {0.0, 0.6, 0.8};
+    std::vector<float> eulerArray;
+    for(const auto& eu : eulers)
+    {
+      eulerArray.insert(eulerArray.end(), eu.begin(), eu.end());
+    }
+    std::vector<int32_t> phases(eulers.size(), 0);
+    std::unique_ptr<bool[]> goodVoxels(new bool[eulers.size()]);
+    std::fill(goodVoxels.get(), goodVoxels.get() + eulers.size(), true);
+
+    for(uint32_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      std::vector<uint8_t> colors(eulers.size() * 3, 0);
+      LaueOps::GenerateIPFColors(eulerArray.data(), phases.data(), {laueIndex}, refDir, goodVoxels.get(), eulers.size(), colors.data(), true);
+
+      for(size_t i = 0; i < eulers.size(); i++)
+      {
+        const std::array<uint8_t, 3>& expected = expectedColors[laueIndex * eulers.size() + i];
+        EbsdLib::Rgb argb = allOps[laueIndex]->generateIPFColor(eulers[i][0], eulers[i][1], eulers[i][2], refDir[0], refDir[1], refDir[2], true);
+        DREAM3D_REQUIRE_EQUAL(static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb)), expected[0])
+        DREAM3D_REQUIRE_EQUAL(static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb)), expected[1])
+        DREAM3D_REQUIRE_EQUAL(static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb)), expected[2])
+
+        DREAM3D_REQUIRE_EQUAL(colors[i * 3], expected[0])
+        DREAM3D_REQUIRE_EQUAL(colors[i * 3 + 1], expected[1])
+        DREAM3D_REQUIRE_EQUAL(colors[i * 3 + 2], expected[2])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureIntensities()
+  {
+    // Enough orientations that they are split into several blocks and partitions
+    const size_t numOrientations = 10000;
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numOrientations, cDims, "Eulers", true);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      eulers->setComponent(i, 0, static_cast<float>(distribution(generator) * EbsdLib::Constants::k_2PiD));
+      eulers->setComponent(i, 1, static_cast<float>(distribution(generator) * EbsdLib::Constants::k_PiD));
+      eulers->setComponent(i, 2, static_cast<float>(distribution(generator) * EbsdLib::Constants::k_2PiD));
+    }
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    // The number of sphere coordinates per orientation for each family of the Cubic and Hexagonal classes
+    std::vector<std::pair<size_t, std::array<size_t, 3>>> laueClasses = {{EbsdLib::CrystalStructure::Cubic_High, {6, 12, 8}}, {EbsdLib::CrystalStructure::Hexagonal_High, {2, 6, 6}}};
+
+    for(const auto& laueClass : laueClasses)
+    {
+      const LaueOps& ops = *allOps[laueClass.first];
+      const std::array<size_t, 3>& familySizes = laueClass.second;
+      for(bool discrete : {true, false})
+      {
+        PoleFigureConfiguration_t config;
+        config.eulers = eulers.get();
+        config.imageDim = 64;
+        config.lambertDim = 32;
+        config.numColors = 32;
+        config.sphereRadius = 1.0f;
+        config.discrete = discrete;
+        config.discreteHeatMap = false;
+
+        std::vector<EbsdLib::DoubleArrayType::Pointer> intensities = ops.generatePoleFigureIntensities(config, familySizes, {"A", "B", "C"});
+        DREAM3D_REQUIRE_EQUAL(intensities.size(), 3)
+
+        // Compare with binning the sphere coordinates of all the orientations at once
+        std::array<EbsdLib::FloatArrayType::Pointer, 3> coords;
+        for(size_t f = 0; f < 3; f++)
+        {
+          coords[f] = EbsdLib::FloatArrayType::CreateArray(numOrientations * familySizes[f], cDims, "Coords", true);
+        }
+        ops.generateSphereCoordsFromEulers(eulers.get(), coords[0].get(), coords[1].get(), coords[2].get());
+
+        double minScale = std::numeric_limits<double>::max();
+        double maxScale = std::numeric_limits<double>::min();
+        for(size_t f = 0; f < 3; f++)
+        {
+          EbsdLib::DoubleArrayType::Pointer expected = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, "Expected", true);
+          ComputeStereographicProjection projection(coords[f].get(), &config, expected.get());
+          projection();
+
+          DREAM3D_REQUIRE_EQUAL(intensities[f]->getNumberOfTuples(), expected->getNumberOfTuples())
+          for(size_t i = 0; i < expected->getNumberOfTuples(); i++)
+          {
+            const double value = expected->getValue(i);
+            minScale = std::min(minScale, value);
+            maxScale = std::max(maxScale, value);
+            if(discrete)
+            {
+              DREAM3D_REQUIRE_EQUAL(intensities[f]->getValue(i), value)
+            }
+            else
+            {
+              // The partitions are summed in a different order than a single serial pass
+              DREAM3D_REQUIRE(std::fabs(intensities[f]->getValue(i) - value) <= 1.0E-9 * std::max(1.0, std::fabs(value)))
+            }
+          }
+        }
+        DREAM3D_REQUIRE(std::fabs(config.minScale - minScale) <= 1.0E-9 * std::max(1.0, std::fabs(minScale)))
+        DREAM3D_REQUIRE(std::fabs(config.maxScale - maxScale) <= 1.0E-9 * std::max(1.0, std::fabs(maxScale)))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestOdfGrid()
+  {
+    std::mt19937_64 generator(23);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t opsIndex = 0; opsIndex < 11; opsIndex++)
+    {
+      const LaueOps& ops = *allOps[opsIndex];
+      const OdfGrid grid = ops.getOdfGrid();
+      DREAM3D_REQUIRE_EQUAL(grid.size(), static_cast<size_t>(ops.getODFSize()))
+      DREAM3D_REQUIRE(grid.getNumBins() == ops.getOdfNumBins())
+
+      // The default grid must bin exactly like the classic fixed 5 degree binning
+      const std::array<size_t, 3> numBins = ops.getOdfNumBins();
+      const std::array<double, 3>& extents = grid.getExtents();
+      for(int n = 0; n < 500; n++)
+      {
+        OrientationD eu(distribution(generator) * EbsdLib::Constants::k_2PiD, distribution(generator) * EbsdLib::Constants::k_PiD, distribution(generator) * EbsdLib::Constants::k_2PiD);
+        OrientationD rod = ops.getODFFZRod(OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu));
+        OrientationD ho = OrientationTransformation::ro2ho<OrientationD, OrientationD>(rod);
+        int expected[3] = {0, 0, 0};
+        for(size_t i = 0; i < 3; i++)
+        {
+          const double step = extents[i] / static_cast<double>(numBins[i] / 2);
+          expected[i] = std::max(0, std::min(static_cast<int>((ho[i] + extents[i]) / step), static_cast<int>(numBins[i]) - 1));
+        }
+        const int expectedBin = static_cast<int>((expected[2] * numBins[0] * numBins[1]) + (expected[1] * numBins[0]) + expected[0]);
+        const int odfBin = ops.getOdfBin(rod);
+        const int misoBin = ops.getMisoBin(rod);
+        DREAM3D_REQUIRE_EQUAL(odfBin, expectedBin)
+        DREAM3D_REQUIRE_EQUAL(misoBin, expectedBin)
+
+        // A random orientation drawn from a bin must fall back into that bin
+        double random[3] = {distribution(generator) * 0.98 + 0.01, distribution(generator) * 0.98 + 0.01, distribution(generator) * 0.98 + 0.01};
+        OrientationD homochoric = grid.getHomochoric(expectedBin, random);
+        DREAM3D_REQUIRE_EQUAL(grid.getBin(homochoric), expectedBin)
+      }
+    }
+
+    // Finer grids keep the extents and round the number of bins to an even number
+    CubicOps cubicOps;
+    OdfGrid fineGrid = cubicOps.createOdfGrid(1.0);
+    DREAM3D_REQUIRE(fineGrid.getNumBins() == (std::array<size_t, 3>{90, 90, 90}))
+    DREAM3D_REQUIRE_EQUAL(fineGrid.size(), 729000)
+    DREAM3D_REQUIRE(fineGrid.getExtents() == cubicOps.getOdfGrid().getExtents())
+    DREAM3D_REQUIRE(fineGrid.getLayout() == OdfGrid::Layout::Blocked)
+    HexagonalOps hexOps;
+    OdfGrid hexGrid = hexOps.createOdfGrid(2.5, OdfGrid::Layout::Linear);
+    DREAM3D_REQUIRE(hexGrid.getNumBins() == (std::array<size_t, 3>{72, 72, 24}))
+
+    // The blocked layout must be a permutation of the bins, including the partial blocks at the edges
+    OdfGrid blockedGrid({20, 12, 6}, cubicOps.getOdfGrid().getExtents(), OdfGrid::Layout::Blocked);
+    std::vector<int> visited(blockedGrid.size(), 0);
+    for(int32_t k = 0; k < 6; k++)
+    {
+      for(int32_t j = 0; j < 12; j++)
+      {
+        for(int32_t i = 0; i < 20; i++)
+        {
+          const int index = blockedGrid.getIndex(i, j, k);
+          DREAM3D_REQUIRE(index >= 0 && index < static_cast<int>(blockedGrid.size()))
+          visited[index]++;
+          const std::array<int32_t, 3> position = blockedGrid.getBinPosition(index);
+          DREAM3D_REQUIRE(position == (std::array<int32_t, 3>{i, j, k}))
+        }
+      }
+    }
+    for(int count : visited)
+    {
+      DREAM3D_REQUIRE_EQUAL(count, 1)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestCalculateMisorientations())
+    DREAM3D_REGISTER_TEST(TestGetFZQuats())
+    DREAM3D_REGISTER_TEST(TestGetFZQuatsReference())
+    DREAM3D_REGISTER_TEST(TestSearchHelpers())
+    DREAM3D_REGISTER_TEST(TestGenerateIPFColors())
+    DREAM3D_REGISTER_TEST(TestGenerateIPFColorsReference())
+    DREAM3D_REGISTER_TEST(TestPoleFigureIntensities())
+    DREAM3D_REGISTER_TEST(TestOdfGrid())
+  }
+};
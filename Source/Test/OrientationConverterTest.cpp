@@ -43,6 +43,7 @@
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/OrientationMath/OrientationBatchKernels.hpp"
 #include "EbsdLib/OrientationMath/OrientationConverter.hpp"
 
 #include "TestPrintFunctions.h"
@@ -188,6 +189,248 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  std::vector<T> CreateBatchTestEulers()
+  {
+    // A grid that is deliberately not a multiple of the batch width plus the special
+    // orientations that hit the degenerate branches of the conversions.
+    std::vector<T> eulers = {0.0, 0.0, 0.0, EbsdLib::Constants::k_PiD, 0.0, 0.0, 0.0, EbsdLib::Constants::k_PiD, 0.0, EbsdLib::Constants::k_PiOver2D, EbsdLib::Constants::k_PiD, 0.0,
+                             0.0, EbsdLib::Constants::k_PiOver2D, 0.0, EbsdLib::Constants::k_PiOver4D, 0.0, EbsdLib::Constants::k_PiOver4D};
+    const size_t numSteps = 11;
+    for(size_t p2 = 0; p2 < numSteps; p2++)
+    {
+      for(size_t p = 0; p <= numSteps; p++)
+      {
+        for(size_t p1 = 0; p1 < numSteps; p1++)
+        {
+          eulers.push_back(static_cast<T>(p1 * EbsdLib::Constants::k_2PiD / numSteps + 0.01));
+          eulers.push_back(static_cast<T>(p * EbsdLib::Constants::k_PiD / numSteps));
+          eulers.push_back(static_cast<T>(p2 * EbsdLib::Constants::k_2PiD / numSteps + 0.02));
+        }
+      }
+    }
+    return eulers;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T, class Scalar>
+  std::vector<T> ConvertScalar(std::vector<T>& input, size_t inStride, size_t outStride)
+  {
+    const size_t numTuples = input.size() / inStride;
+    std::vector<T> output(numTuples * outStride);
+    ConvertRepresentation<T, Scalar> serial(input.data(), output.data(), inStride, outStride);
+    serial.convert(0, numTuples);
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T, class Kernel, class Scalar>
+  std::vector<T> CompareBatchKernel(std::vector<T>& input, bool isQuaternion, bool isEuler)
+  {
+    const T tolerance = sizeof(T) == 4 ? static_cast<T>(1.0E-5) : static_cast<T>(1.0E-12);
+    const size_t outStride = Kernel::k_OutStride;
+    const size_t numTuples = input.size() / Kernel::k_InStride;
+    std::vector<T> exemplar = ConvertScalar<T, Scalar>(input, Kernel::k_InStride, outStride);
+    std::vector<T> output(numTuples * outStride);
+    OrientationBatch::convert<T, Kernel>(input.data(), output.data(), numTuples);
+
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      const T* expected = exemplar.data() + i * outStride;
+      const T* actual = output.data() + i * outStride;
+      T delta = 0.0;
+      T negatedDelta = 0.0;
+      for(size_t c = 0; c < outStride; c++)
+      {
+        if(std::isinf(expected[c]) || std::isinf(actual[c]))
+        {
+          DREAM3D_REQUIRE(expected[c] == actual[c]);
+          continue;
+        }
+        const T scale = std::max(static_cast<T>(1.0), std::fabs(expected[c]));
+        T diff = std::fabs(expected[c] - actual[c]);
+        if(isEuler) // Angles of 0 and 2Pi are the same angle
+        {
+          diff = std::fabs(std::remainder(expected[c] - actual[c], static_cast<T>(EbsdLib::Constants::k_2PiD)));
+        }
+        delta = std::max(delta, diff / scale);
+        negatedDelta = std::max(negatedDelta, std::fabs(expected[c] + actual[c]) / scale);
+      }
+      // q and -q are the same rotation
+      if(isQuaternion)
+      {
+        delta = std::min(delta, negatedDelta);
+      }
+      DREAM3D_REQUIRED(delta, <, tolerance)
+    }
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void TestBatchKernels()
+  {
+    std::vector<T> eulers = CreateBatchTestEulers<T>();
+
+    // Check the kernels of every instruction set that this machine can run
+    const OrientationBatch::InstructionSet defaultInstructionSet = OrientationBatch::GetInstructionSet();
+    for(OrientationBatch::InstructionSet instructionSet : {OrientationBatch::InstructionSet::Portable, OrientationBatch::InstructionSet::AVX2, OrientationBatch::InstructionSet::AVX512})
+    {
+      if(!OrientationBatch::SetInstructionSet(instructionSet))
+      {
+        continue;
+      }
+      std::vector<T> quats = CompareBatchKernel<T, OrientationBatch::Eu2Qu<T>, Convertors::Eu2Qu<T>>(eulers, true, false);
+      std::vector<T> oms = CompareBatchKernel<T, OrientationBatch::Eu2Om<T>, Convertors::Eu2Om<T>>(eulers, false, false);
+      CompareBatchKernel<T, OrientationBatch::Qu2Eu<T>, Convertors::Qu2Eu<T>>(quats, false, true);
+      CompareBatchKernel<T, OrientationBatch::Qu2Om<T>, Convertors::Qu2Om<T>>(quats, false, false);
+      CompareBatchKernel<T, OrientationBatch::Om2Qu<T>, Convertors::Om2Qu<T>>(oms, true, false);
+      std::vector<T> rods = CompareBatchKernel<T, OrientationBatch::Qu2Ro<T>, Convertors::Qu2Ro<T>>(quats, false, false);
+      CompareBatchKernel<T, OrientationBatch::Ro2Qu<T>, Convertors::Ro2Qu<T>>(rods, true, false);
+    }
+    DREAM3D_REQUIRE(OrientationBatch::SetInstructionSet(defaultInstructionSet))
+
+    // The converter classes must pick the batch kernels for packed input and give the same answer
+    using ArrayType = EbsdDataArray<T>;
+    const size_t numTuples = eulers.size() / 3;
+    std::vector<size_t> cDims(1, 3);
+    typename ArrayType::Pointer eulerArray = ArrayType::CreateArray(numTuples, cDims, "Eulers", true);
+    std::copy(eulers.begin(), eulers.end(), eulerArray->getPointer(0));
+    typename OrientationConverter<ArrayType, T>::Pointer converter = EulerConverter<ArrayType, T>::New();
+    converter->setInputData(eulerArray);
+    converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+    typename ArrayType::Pointer quatArray = converter->getOutputData();
+    DREAM3D_REQUIRE_EQUAL(quatArray->getNumberOfTuples(), numTuples)
+    // The converter wraps the input angles in place so convert what it actually saw
+    std::vector<T> batchQuats(numTuples * 4);
+    OrientationBatch::convert<T, OrientationBatch::Eu2Qu<T>>(eulerArray->getPointer(0), batchQuats.data(), numTuples);
+    for(size_t i = 0; i < numTuples * 4; i++)
+    {
+      DREAM3D_REQUIRE(quatArray->getValue(i) == batchQuats[i]);
+    }
+
+    // Input with extra components is not packed and must take the scalar path
+    cDims[0] = 4;
+    typename ArrayType::Pointer paddedArray = ArrayType::CreateArray(numTuples, cDims, "Eulers", true);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        paddedArray->setComponent(i, c, eulers[i * 3 + c]);
+      }
+      paddedArray->setComponent(i, 3, static_cast<T>(0.0));
+    }
+    converter->setInputData(paddedArray);
+    converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+    quatArray = converter->getOutputData();
+    std::vector<T> scalarQuats(numTuples * 4);
+    ConvertRepresentation<T, Convertors::Eu2Qu<T>> serial(paddedArray->getPointer(0), scalarQuats.data(), 4, 4);
+    serial.convert(0, numTuples);
+    for(size_t i = 0; i < numTuples * 4; i++)
+    {
+      DREAM3D_REQUIRE(quatArray->getValue(i) == scalarQuats[i]);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void CompareFusedOutput(typename EbsdDataArray<T>::Pointer expected, typename EbsdDataArray<T>::Pointer actual, bool isQuaternion, bool isEuler)
+  {
+    const T tolerance = sizeof(T) == 4 ? static_cast<T>(1.0E-5) : static_cast<T>(1.0E-12);
+    DREAM3D_REQUIRE_EQUAL(expected->getNumberOfTuples(), actual->getNumberOfTuples())
+    DREAM3D_REQUIRE_EQUAL(expected->getNumberOfComponents(), actual->getNumberOfComponents())
+    const size_t numTuples = expected->getNumberOfTuples();
+    const size_t numComps = static_cast<size_t>(expected->getNumberOfComponents());
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      T delta = 0.0;
+      T negatedDelta = 0.0;
+      for(size_t c = 0; c < numComps; c++)
+      {
+        const T expectedValue = expected->getComponent(i, c);
+        const T actualValue = actual->getComponent(i, c);
+        if(std::isinf(expectedValue) || std::isinf(actualValue))
+        {
+          DREAM3D_REQUIRE(expectedValue == actualValue);
+          continue;
+        }
+        const T scale = std::max(static_cast<T>(1.0), std::fabs(expectedValue));
+        T diff = std::fabs(expectedValue - actualValue);
+        if(isEuler) // Angles of 0 and 2Pi are the same angle
+        {
+          diff = std::fabs(std::remainder(expectedValue - actualValue, static_cast<T>(EbsdLib::Constants::k_2PiD)));
+        }
+        delta = std::max(delta, diff / scale);
+        negatedDelta = std::max(negatedDelta, std::fabs(expectedValue + actualValue) / scale);
+      }
+      if(isQuaternion)
+      {
+        delta = std::min(delta, negatedDelta);
+      }
+      DREAM3D_REQUIRED(delta, <, tolerance)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void TestFusedConversion()
+  {
+    using ArrayType = EbsdDataArray<T>;
+    using OCType = OrientationConverter<ArrayType, T>;
+    std::vector<T> eulers = CreateBatchTestEulers<T>();
+    const size_t numTuples = eulers.size() / 3;
+    typename ArrayType::Pointer eulerArray = ArrayType::CreateArray(numTuples, {3ULL}, "Eulers", true);
+    std::copy(eulers.begin(), eulers.end(), eulerArray->getPointer(0));
+
+    std::vector<OrientationRepresentation::Type> ocTypes = OCType::GetOrientationTypes();
+    auto strides = OCType::template GetComponentCounts<std::vector<size_t>>();
+    // Deliberately the wrong size so the outputs have to be resized
+    std::vector<typename ArrayType::Pointer> outputs;
+    for(size_t t = 0; t < ocTypes.size(); t++)
+    {
+      outputs.push_back(ArrayType::CreateArray(1, {strides[t]}, "Fused", true));
+    }
+
+    typename OCType::Pointer converter = EulerConverter<ArrayType, T>::New();
+    converter->setInputData(eulerArray);
+    DREAM3D_REQUIRE(converter->convertRepresentationsTo(ocTypes, outputs))
+    // The buffers can be reused
+    DREAM3D_REQUIRE(converter->convertRepresentationsTo(ocTypes, outputs))
+
+    // The Euler output is a copy of the input. Every other output must match converting
+    // to quaternions first and then to the representation
+    for(size_t i = 0; i < numTuples * 3; i++)
+    {
+      DREAM3D_REQUIRE(outputs[0]->getValue(i) == eulerArray->getValue(i));
+    }
+    converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+    typename ArrayType::Pointer quatArray = converter->getOutputData();
+    typename OCType::Pointer quatConverter = QuaternionConverter<ArrayType, T>::New();
+    quatConverter->setInputData(quatArray);
+    for(size_t t = 1; t < ocTypes.size(); t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(outputs[t]->getNumberOfTuples(), numTuples)
+      quatConverter->convertRepresentationTo(ocTypes[t]);
+      CompareFusedOutput<T>(quatConverter->getOutputData(), outputs[t], ocTypes[t] == OrientationRepresentation::Type::Quaternion, ocTypes[t] == OrientationRepresentation::Type::Euler);
+    }
+
+    // Quaternion input is used in place
+    std::vector<OrientationRepresentation::Type> quatTargets = {OrientationRepresentation::Type::Rodrigues, OrientationRepresentation::Type::Quaternion};
+    std::vector<typename ArrayType::Pointer> quatOutputs = {ArrayType::CreateArray(numTuples, {4ULL}, "Rodrigues", true), ArrayType::CreateArray(numTuples, {4ULL}, "Quats", true)};
+    DREAM3D_REQUIRE(quatConverter->convertRepresentationsTo(quatTargets, quatOutputs))
+    CompareFusedOutput<T>(outputs[4], quatOutputs[0], false, false);
+    for(size_t i = 0; i < numTuples * 4; i++)
+    {
+      DREAM3D_REQUIRE(quatOutputs[1]->getValue(i) == quatArray->getValue(i));
+    }
+
+    // Mismatched arguments are rejected
+    DREAM3D_REQUIRE(!converter->convertRepresentationsTo(quatTargets, outputs))
+    std::swap(quatOutputs[0], outputs[0]);
+    DREAM3D_REQUIRE(!converter->convertRepresentationsTo(quatTargets, quatOutputs))
+  }
+
   // -----------------------------------------------------------------------------
   void operator()()
   {
@@ -196,5 +439,9 @@ public:
     int err = 0;
     DREAM3D_REGISTER_TEST(TestEuler2Quaternion());
     DREAM3D_REGISTER_TEST(TestEulerConversion());
+    DREAM3D_REGISTER_TEST(TestBatchKernels<float>());
+    DREAM3D_REGISTER_TEST(TestBatchKernels<double>());
+    DREAM3D_REGISTER_TEST(TestFusedConversion<float>());
+    DREAM3D_REGISTER_TEST(TestFusedConversion<double>());
   }
 };
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
@@ -906,6 +907,128 @@ Orientation Matrix               : | -1.0000   0.0000   0.0000 |
     std::cout << "vg: " << vg[0] << "," << vg[1] << "," << vg[2] << std::endl;
   }
 
+  template <typename T>
+  struct FixedTypeTag
+  {
+    using type = T;
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename DynOut, typename FixOut, typename DynIn, typename FixIn, typename Function>
+  void CompareFixedConversion(const DynIn& dynIn, const FixIn& fixIn, size_t numComps, Function function)
+  {
+    DynOut dynOut = function(dynIn, FixedTypeTag<DynOut>());
+    FixOut fixOut = function(fixIn, FixedTypeTag<FixOut>());
+    for(size_t i = 0; i < numComps; i++)
+    {
+      DREAM3D_REQUIRE(dynOut[i] == fixOut[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename K>
+  void Test_FixedOrientation()
+  {
+    using DynType = Orientation<K>;
+    using QuatType = Quaternion<K>;
+    using Dyn_eu = DynType;
+    using Dyn_om = DynType;
+    using Dyn_ax = DynType;
+    using Dyn_ro = DynType;
+    using Dyn_qu = QuatType;
+    using Dyn_ho = DynType;
+    using Dyn_cu = DynType;
+    using Fix_eu = Euler3<K>;
+    using Fix_om = OrientationMatrix9<K>;
+    using Fix_ax = AxisAngle4<K>;
+    using Fix_ro = Rodrigues4<K>;
+    using Fix_qu = QuatType;
+    using Fix_ho = Homochoric3<K>;
+    using Fix_cu = Cubochoric3<K>;
+    const size_t k_Comps_eu = 3;
+    const size_t k_Comps_om = 9;
+    const size_t k_Comps_ax = 4;
+    const size_t k_Comps_ro = 4;
+    const size_t k_Comps_qu = 4;
+    const size_t k_Comps_ho = 3;
+    const size_t k_Comps_cu = 3;
+
+    // The stack based types must produce exactly the same values as the heap based Orientation class for all 42 conversions
+    std::vector<std::array<K, 3>> eulers = {{0.3926990816987242, 0.0, 0.0}, {1.1, 0.7, 2.3}, {5.2, 2.9, 0.4}, {3.14159, 1.5707963, 4.71238}};
+    for(const auto& e : eulers)
+    {
+      Dyn_eu dyn_eu(e[0], e[1], e[2]);
+      Fix_eu fix_eu(e[0], e[1], e[2]);
+      Dyn_om dyn_om = OrientationTransformation::eu2om<Dyn_eu, Dyn_om>(dyn_eu);
+      Fix_om fix_om = OrientationTransformation::eu2om<Fix_eu, Fix_om>(fix_eu);
+      Dyn_ax dyn_ax = OrientationTransformation::eu2ax<Dyn_eu, Dyn_ax>(dyn_eu);
+      Fix_ax fix_ax = OrientationTransformation::eu2ax<Fix_eu, Fix_ax>(fix_eu);
+      Dyn_ro dyn_ro = OrientationTransformation::eu2ro<Dyn_eu, Dyn_ro>(dyn_eu);
+      Fix_ro fix_ro = OrientationTransformation::eu2ro<Fix_eu, Fix_ro>(fix_eu);
+      Dyn_qu dyn_qu = OrientationTransformation::eu2qu<Dyn_eu, Dyn_qu>(dyn_eu);
+      Fix_qu fix_qu = OrientationTransformation::eu2qu<Fix_eu, Fix_qu>(fix_eu);
+      Dyn_ho dyn_ho = OrientationTransformation::eu2ho<Dyn_eu, Dyn_ho>(dyn_eu);
+      Fix_ho fix_ho = OrientationTransformation::eu2ho<Fix_eu, Fix_ho>(fix_eu);
+      Dyn_cu dyn_cu = OrientationTransformation::eu2cu<Dyn_eu, Dyn_cu>(dyn_eu);
+      Fix_cu fix_cu = OrientationTransformation::eu2cu<Fix_eu, Fix_cu>(fix_eu);
+
+#define COMPARE_FIXED_CONVERSION(FROM, TO)                                                                                                                                                             \
+  CompareFixedConversion<Dyn_##TO, Fix_##TO>(dyn_##FROM, fix_##FROM, k_Comps_##TO, [](const auto& in, auto tag) {                                                                                      \
+    using InType = std::decay_t<decltype(in)>;                                                                                                                                                         \
+    using OutType = typename decltype(tag)::type;                                                                                                                                                      \
+    return OrientationTransformation::FROM##2##TO<InType, OutType>(in);                                                                                                                                \
+  });
+
+      COMPARE_FIXED_CONVERSION(eu, om)
+      COMPARE_FIXED_CONVERSION(eu, ax)
+      COMPARE_FIXED_CONVERSION(eu, ro)
+      COMPARE_FIXED_CONVERSION(eu, qu)
+      COMPARE_FIXED_CONVERSION(eu, ho)
+      COMPARE_FIXED_CONVERSION(eu, cu)
+      COMPARE_FIXED_CONVERSION(om, eu)
+      COMPARE_FIXED_CONVERSION(om, ax)
+      COMPARE_FIXED_CONVERSION(om, ro)
+      COMPARE_FIXED_CONVERSION(om, qu)
+      COMPARE_FIXED_CONVERSION(om, ho)
+      COMPARE_FIXED_CONVERSION(om, cu)
+      COMPARE_FIXED_CONVERSION(ax, eu)
+      COMPARE_FIXED_CONVERSION(ax, om)
+      COMPARE_FIXED_CONVERSION(ax, ro)
+      COMPARE_FIXED_CONVERSION(ax, qu)
+      COMPARE_FIXED_CONVERSION(ax, ho)
+      COMPARE_FIXED_CONVERSION(ax, cu)
+      COMPARE_FIXED_CONVERSION(ro, eu)
+      COMPARE_FIXED_CONVERSION(ro, om)
+      COMPARE_FIXED_CONVERSION(ro, ax)
+      COMPARE_FIXED_CONVERSION(ro, qu)
+      COMPARE_FIXED_CONVERSION(ro, ho)
+      COMPARE_FIXED_CONVERSION(ro, cu)
+      COMPARE_FIXED_CONVERSION(qu, eu)
+      COMPARE_FIXED_CONVERSION(qu, om)
+      COMPARE_FIXED_CONVERSION(qu, ax)
+      COMPARE_FIXED_CONVERSION(qu, ro)
+      COMPARE_FIXED_CONVERSION(qu, ho)
+      COMPARE_FIXED_CONVERSION(qu, cu)
+      COMPARE_FIXED_CONVERSION(ho, eu)
+      COMPARE_FIXED_CONVERSION(ho, om)
+      COMPARE_FIXED_CONVERSION(ho, ax)
+      COMPARE_FIXED_CONVERSION(ho, ro)
+      COMPARE_FIXED_CONVERSION(ho, qu)
+      COMPARE_FIXED_CONVERSION(ho, cu)
+      COMPARE_FIXED_CONVERSION(cu, eu)
+      COMPARE_FIXED_CONVERSION(cu, om)
+      COMPARE_FIXED_CONVERSION(cu, ax)
+      COMPARE_FIXED_CONVERSION(cu, ro)
+      COMPARE_FIXED_CONVERSION(cu, qu)
+      COMPARE_FIXED_CONVERSION(cu, ho)
+#undef COMPARE_FIXED_CONVERSION
+    }
+  }
+
   void operator()()
   {
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
@@ -932,6 +1055,9 @@ Orientation Matrix               : | -1.0000   0.0000   0.0000 |
     DREAM3D_REGISTER_TEST(Test_ho2_XXX());
 
     DREAM3D_REGISTER_TEST(TestInputs());
+
+    DREAM3D_REGISTER_TEST(Test_FixedOrientation<float>());
+    DREAM3D_REGISTER_TEST(Test_FixedOrientation<double>());
   }
 
 public:
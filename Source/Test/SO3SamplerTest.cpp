@@ -30,6 +30,10 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <limits>
+#include <random>
+#include <vector>
+
 #include "EbsdLib/LaueOps/SO3Sampler.h"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -77,6 +81,107 @@ public:
     DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SO3ArrayTest()
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+    const std::vector<int> pointGroups = {1, 3, 7, 12, 28, 32};
+    for(int pgnum : pointGroups)
+    {
+      SO3Sampler::OrientationListArrayType orientations = sampler->SampleRFZ(12, pgnum);
+      EbsdLib::DoubleArrayType::Pointer rodrigues = sampler->SampleRFZToArray(12, pgnum);
+      const size_t count = orientations.size();
+      const size_t arraySize = rodrigues->getNumberOfTuples();
+      DREAM3D_REQUIRE_EQUAL(count * 4, arraySize);
+
+      std::vector<double> streamed;
+      size_t numBlocks = 0;
+      size_t total = sampler->SampleRFZ(12, pgnum, [&streamed, &numBlocks](const double* block, size_t blockCount) {
+        // Store each block in the same point major layout as the list
+        for(size_t i = 0; i < blockCount; i++)
+        {
+          for(size_t c = 0; c < 4; c++)
+          {
+            streamed.push_back(block[c * blockCount + i]);
+          }
+        }
+        numBlocks++;
+      });
+      DREAM3D_REQUIRE_EQUAL(count, total);
+      DREAM3D_REQUIRE(numBlocks > 1 || count == 0);
+
+      // Both versions must produce the same points in the same order as the list
+      const double* soa = rodrigues->getPointer(0);
+      size_t index = 0;
+      bool same = true;
+      for(const auto& rod : orientations)
+      {
+        for(size_t c = 0; c < 4; c++)
+        {
+          same = same && rod[c] == soa[c * count + index] && rod[c] == streamed[index * 4 + c];
+        }
+        index++;
+      }
+      DREAM3D_REQUIRE(same);
+    }
+
+    EbsdLib::DoubleArrayType::Pointer rodrigues = sampler->SampleRFZToArray(100, 32);
+    const size_t arraySize = rodrigues->getNumberOfTuples();
+    DREAM3D_REQUIRE_EQUAL(333227 * 4, arraySize);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void BatchFZTest()
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+
+    // Random points plus the special cases of 180 degree rotations and the identity
+    std::vector<std::vector<double>> points = {{0.0, 0.0, 1.0, std::numeric_limits<double>::infinity()},
+                                               {1.0, 0.0, 0.0, std::numeric_limits<double>::infinity()},
+                                               {0.0, 0.0, 1.0, 0.0},
+                                               {1.0, 0.0, 0.0, 1.0},
+                                               {LPs::r22, LPs::r22, 0.0, 1.0}};
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<double> distribution(-0.5 * LPs::ap, 0.5 * LPs::ap);
+    for(size_t i = 0; i < 2000; i++)
+    {
+      OrientationType cu(distribution(generator), distribution(generator), distribution(generator));
+      OrientationType rod = OrientationTransformation::cu2ro<OrientationType, OrientationType>(cu);
+      points.push_back({rod[0], rod[1], rod[2], rod[3]});
+    }
+
+    const size_t count = points.size();
+    std::vector<double> rodrigues(4 * count);
+    for(size_t i = 0; i < count; i++)
+    {
+      for(size_t c = 0; c < 4; c++)
+      {
+        rodrigues[c * count + i] = points[i][c];
+      }
+    }
+
+    std::vector<uint64_t> mask((count + 63) / 64);
+    for(int pgnum = 1; pgnum <= 32; pgnum++)
+    {
+      size_t numInside = sampler->IsinsideFZ(rodrigues.data(), count, pgnum, mask.data());
+      size_t numMismatch = 0;
+      size_t numScalarInside = 0;
+      for(size_t i = 0; i < count; i++)
+      {
+        bool scalar = sampler->IsinsideFZ(points[i].data(), SO3Sampler::GetFZType(pgnum), SO3Sampler::GetFZOrder(pgnum));
+        bool batch = ((mask[i / 64] >> (i % 64)) & 1u) != 0;
+        numScalarInside += scalar ? 1 : 0;
+        numMismatch += (scalar != batch) ? 1 : 0;
+      }
+      DREAM3D_REQUIRE_EQUAL(numMismatch, 0);
+      DREAM3D_REQUIRE_EQUAL(numInside, numScalarInside);
+    }
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -137,6 +242,8 @@ public:
     DREAM3D_REGISTER_TEST(InsideCubicFZTest())
     DREAM3D_REGISTER_TEST(TestPyramid())
     DREAM3D_REGISTER_TEST(SO3CountTest())
+    DREAM3D_REGISTER_TEST(SO3ArrayTest())
+    DREAM3D_REGISTER_TEST(BatchFZTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 };
@@ -33,6 +33,8 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -50,6 +52,7 @@
 #include "EbsdLib/LaueOps/TrigonalLowOps.h"
 #include "EbsdLib/LaueOps/TrigonalOps.h"
 #include "EbsdLib/Texture/StatsGen.hpp"
+#include "EbsdLib/Math/Philox4x32.hpp"
 #include "EbsdLib/Texture/Texture.hpp"
 
 #include "UnitTestSupport.hpp"
@@ -186,6 +189,336 @@ public:
     TestTextureOdf<TrigonalOps>();
   }
 
+  void TestPhilox4x32()
+  {
+    // Known answer vectors from the Random123 distribution
+    EbsdLib::Philox4x32::Counter result = EbsdLib::Philox4x32::Generate({0, 0, 0, 0}, {0, 0});
+    EbsdLib::Philox4x32::Counter expected = {0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U};
+    DREAM3D_REQUIRE(result == expected)
+
+    result = EbsdLib::Philox4x32::Generate({0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU}, {0xFFFFFFFFU, 0xFFFFFFFFU});
+    expected = {0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU};
+    DREAM3D_REQUIRE(result == expected)
+
+    result = EbsdLib::Philox4x32::Generate({0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U}, {0xa4093822U, 0x299f31d0U});
+    expected = {0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U};
+    DREAM3D_REQUIRE(result == expected)
+
+    // Skipping ahead must land on the same value as drawing the numbers one at a time
+    for(uint64_t skip : {0ULL, 1ULL, 3ULL, 4ULL, 5ULL, 1001ULL})
+    {
+      EbsdLib::Philox4x32 sequential(12345, 7);
+      EbsdLib::Philox4x32 skipped(12345, 7);
+      sequential();
+      skipped();
+      for(uint64_t i = 0; i < skip; i++)
+      {
+        sequential();
+      }
+      skipped.discard(skip);
+      const uint32_t expectedValue = sequential();
+      const uint32_t skippedValue = skipped();
+      DREAM3D_REQUIRE_EQUAL(expectedValue, skippedValue)
+    }
+
+    // Different streams of the same seed must not produce the same sequence
+    EbsdLib::Philox4x32 stream0(12345, 0);
+    EbsdLib::Philox4x32 stream1(12345, 1);
+    bool identical = true;
+    for(int i = 0; i < 8; i++)
+    {
+      identical = identical && (stream0() == stream1());
+    }
+    DREAM3D_REQUIRE_EQUAL(identical, false)
+
+    EbsdLib::Philox4x32 generator(42);
+    for(int i = 0; i < 10000; i++)
+    {
+      double value = generator.nextDouble();
+      DREAM3D_REQUIRE(value >= 0.0 && value < 1.0)
+      DREAM3D_REQUIRE(generator.nextIndex(24) < 24)
+    }
+  }
+
+  void TestSeededSampling()
+  {
+    const uint64_t seed = 20240501;
+    CubicOps ops;
+
+    std::vector<float> e1s = {0.5f};
+    std::vector<float> e2s = {0.25f};
+    std::vector<float> e3s = {0.75f};
+    std::vector<float> weights = {50000.0f};
+    std::vector<float> sigmas = {2.0f};
+    std::vector<float> odf;
+    Texture::CalculateODFData<float, CubicOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, odf, e1s.size());
+
+    const size_t numPoints = 1000;
+    std::vector<float> eulers0(numPoints * 3);
+    std::vector<float> eulers1(numPoints * 3);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, eulers0.data(), numPoints, seed);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, eulers1.data(), numPoints, seed);
+    DREAM3D_REQUIRE(eulers0 == eulers1)
+
+    std::vector<float> angles = {45.0f};
+    std::vector<float> axes = {1.0f, 1.0f, 1.0f};
+    std::vector<float> mdfWeights = {100.0f};
+    std::vector<float> mdf0;
+    std::vector<float> mdf1;
+    Texture::CalculateMDFData<float, CubicOps, std::vector<float>>(angles, axes, mdfWeights, odf, mdf0, angles.size(), seed);
+    Texture::CalculateMDFData<float, CubicOps, std::vector<float>>(angles, axes, mdfWeights, odf, mdf1, angles.size(), seed);
+    DREAM3D_REQUIRE(mdf0 == mdf1)
+
+    EbsdLib::Philox4x32 generator0(seed);
+    EbsdLib::Philox4x32 generator1(seed);
+    OrientationD euler(0.1, 0.2, 0.3);
+    for(int i = 0; i < 100; i++)
+    {
+      OrientationD r0 = ops.randomizeEulerAngles(euler, generator0);
+      OrientationD r1 = ops.randomizeEulerAngles(euler, generator1);
+      DREAM3D_REQUIRE(r0[0] == r1[0] && r0[1] == r1[1] && r0[2] == r1[2])
+    }
+  }
+
+  void TestODFSampler()
+  {
+    std::vector<float> e1s = {0.5f, 1.5f};
+    std::vector<float> e2s = {0.25f, 0.5f};
+    std::vector<float> e3s = {0.75f, 0.1f};
+    std::vector<float> weights = {50000.0f, 20000.0f};
+    std::vector<float> sigmas = {2.0f, 4.0f};
+    std::vector<float> odf;
+    Texture::CalculateODFData<float, CubicOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, odf, e1s.size());
+
+    // The sampler must pick the same bin as the original linear scan, which summed the densities and
+    // compared the random number in float. Random numbers right at the float cumulative densities are
+    // included because that is where summing in a different precision would pick a neighboring bin.
+    ODFSampler<float> sampler(odf, odf.size());
+    DREAM3D_REQUIRE_EQUAL(sampler.size(), odf.size())
+    std::vector<double> randoms;
+    EbsdLib::Philox4x32 generator(7);
+    for(int n = 0; n < 2000; n++)
+    {
+      randoms.push_back(generator.nextDouble());
+    }
+    float cumulative = 0.0f;
+    for(size_t j = 0; j < odf.size(); j++)
+    {
+      cumulative = cumulative + odf[j];
+      if(j % 97 == 0 && cumulative < 1.0f)
+      {
+        randoms.push_back(static_cast<double>(cumulative));
+        randoms.push_back(std::nextafter(static_cast<double>(cumulative), 0.0));
+        randoms.push_back(std::nextafter(static_cast<double>(cumulative), 1.0));
+      }
+    }
+    for(const double randomD : randoms)
+    {
+      const float random = static_cast<float>(randomD);
+      int expectedBin = 0;
+      float totalDensity = 0.0f;
+      for(size_t j = 0; j < odf.size(); j++)
+      {
+        const float previous = totalDensity;
+        totalDensity = totalDensity + odf[j];
+        if(random < totalDensity && random >= previous)
+        {
+          expectedBin = static_cast<int>(j);
+          break;
+        }
+      }
+      const int sampledBin = sampler.sample(randomD);
+      DREAM3D_REQUIRE_EQUAL(sampledBin, expectedBin)
+    }
+    DREAM3D_REQUIRE_EQUAL(sampler.sample(2.0), 0)
+
+    // Reusing a sampler must give the same orientations as building it from the ODF
+    const size_t numPoints = 3 * ODFSampling::k_BlockSize + 17;
+    std::vector<float> eulers0(numPoints * 3);
+    std::vector<float> eulers1(numPoints * 3);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, eulers0.data(), numPoints, 99);
+    StatsGen::GenODFPlotData<float, CubicOps>(sampler, eulers1.data(), numPoints, 99);
+    DREAM3D_REQUIRE(eulers0 == eulers1)
+  }
+
+  void TestMDFSampling()
+  {
+    std::vector<float> e1s = {0.5f};
+    std::vector<float> e2s = {0.25f};
+    std::vector<float> e3s = {0.75f};
+    std::vector<float> weights = {50000.0f};
+    std::vector<float> sigmas = {2.0f};
+    std::vector<float> odf;
+    Texture::CalculateODFData<float, CubicOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, odf, e1s.size());
+
+    CubicOps ops;
+    std::vector<float> angles = {45.0f};
+    std::vector<float> axes = {1.0f, 1.0f, 1.0f};
+    std::vector<float> mdfWeights = {5000.0f};
+    const size_t numSamples = 50000;
+    std::vector<float> mdf0;
+    std::vector<float> mdf1;
+    Texture::CalculateMDFData<float, CubicOps, std::vector<float>>(angles, axes, mdfWeights, odf, mdf0, angles.size(), 11, numSamples);
+    Texture::CalculateMDFData<float, CubicOps, std::vector<float>>(angles, axes, mdfWeights, odf, mdf1, angles.size(), 11, numSamples);
+    DREAM3D_REQUIRE(mdf0 == mdf1)
+    DREAM3D_REQUIRE_EQUAL(mdf0.size(), static_cast<size_t>(ops.getMDFSize()))
+
+    // The reserved bin keeps exactly its weight and the samples fill up the rest of the MDF
+    OrientationD ax(axes[0], axes[1], axes[2], angles[0]);
+    OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
+    const int reservedBin = ops.getMisoBin(ops.getMDFFZRod(rod));
+    const float reservedCount = std::floor(mdfWeights[0] / static_cast<float>(ops.getMDFSize()) * static_cast<float>(numSamples));
+    DREAM3D_REQUIRE(std::abs(mdf0[reservedBin] * static_cast<float>(numSamples) - reservedCount) < 0.5f)
+
+    double total = 0.0;
+    for(float value : mdf0)
+    {
+      DREAM3D_REQUIRE(value >= 0.0f)
+      total += value;
+    }
+    DREAM3D_REQUIRE(std::abs(total - 1.0) < 1.0E-4)
+  }
+
+  /**
+   * @brief The serial ODF smearing that Texture::CalculateODFData used before it was moved to ODFKernels,
+   * computed in double precision.
+   */
+  template <class LaueOps>
+  std::vector<double> ReferenceODF(const std::vector<float>& e1s, const std::vector<float>& e2s, const std::vector<float>& e3s, const std::vector<float>& weights, const std::vector<float>& sigmas)
+  {
+    LaueOps ops;
+    std::array<size_t, 3> odfNumBins = ops.getOdfNumBins();
+    const int numBins0 = static_cast<int>(odfNumBins[0]);
+    const int numBins1 = static_cast<int>(odfNumBins[1]);
+    const int numBins2 = static_cast<int>(odfNumBins[2]);
+    std::vector<double> odf(ops.getODFSize(), 0.0);
+    double totaladdweight = 0.0;
+    for(size_t i = 0; i < e1s.size(); i++)
+    {
+      OrientationF eu(e1s[i], e2s[i], e3s[i]);
+      OrientationD rod = OrientationTransformation::eu2ro<OrientationF, OrientationD>(eu);
+      int bin = ops.getOdfBin(ops.getODFFZRod(rod));
+      int bin1 = bin % numBins0;
+      int bin2 = (bin / numBins0) % numBins1;
+      int bin3 = bin / (numBins0 * numBins1);
+      int radius = static_cast<int>(sigmas[i]);
+      for(int j = -radius; j <= radius; j++)
+      {
+        for(int k = -radius; k <= radius; k++)
+        {
+          for(int l = -radius; l <= radius; l++)
+          {
+            int addbin1 = bin1 + j;
+            int addbin2 = bin2 + k;
+            int addbin3 = bin3 + l;
+            if(addbin1 < 0 || addbin1 >= numBins0 || addbin2 < 0 || addbin2 >= numBins1 || addbin3 < 0 || addbin3 >= numBins2)
+            {
+              continue;
+            }
+            double dist = std::sqrt(static_cast<double>(j * j + k * k + l * l));
+            if(dist <= radius)
+            {
+              double fraction = (radius == 0) ? 1.0 : 1.0 - (dist / radius) * (dist / radius);
+              odf[(addbin3 * numBins0 * numBins1) + (addbin2 * numBins0) + addbin1] += weights[i] * fraction;
+              totaladdweight += weights[i] * fraction;
+            }
+          }
+        }
+      }
+    }
+    double totalweight = static_cast<double>(ops.getODFSize());
+    for(auto& value : odf)
+    {
+      value = (totaladdweight > totalweight) ? value / (totaladdweight / totalweight) : value + (totalweight - totaladdweight) / totalweight;
+      value /= totalweight;
+    }
+    return odf;
+  }
+
+  template <class LaueOps>
+  void TestODFKernel(size_t numEntries, float weightScale)
+  {
+    EbsdLib::Philox4x32 generator(1234);
+    std::vector<float> e1s(numEntries);
+    std::vector<float> e2s(numEntries);
+    std::vector<float> e3s(numEntries);
+    std::vector<float> weights(numEntries);
+    std::vector<float> sigmas(numEntries);
+    for(size_t i = 0; i < numEntries; i++)
+    {
+      e1s[i] = static_cast<float>(generator.nextDouble() * EbsdLib::Constants::k_2PiD);
+      e2s[i] = static_cast<float>(generator.nextDouble() * EbsdLib::Constants::k_PiD);
+      e3s[i] = static_cast<float>(generator.nextDouble() * EbsdLib::Constants::k_2PiD);
+      weights[i] = static_cast<float>(generator.nextDouble() * weightScale);
+      sigmas[i] = static_cast<float>(generator.nextIndex(4));
+    }
+
+    std::vector<float> odf;
+    Texture::CalculateODFData<float, LaueOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
+    std::vector<double> reference = ReferenceODF<LaueOps>(e1s, e2s, e3s, weights, sigmas);
+    DREAM3D_REQUIRE_EQUAL(odf.size(), reference.size())
+    for(size_t i = 0; i < odf.size(); i++)
+    {
+      DREAM3D_REQUIRE(std::abs(odf[i] - reference[i]) <= 1.0E-5 * std::abs(reference[i]) + 1.0E-9)
+    }
+  }
+
+  void TestODFKernels()
+  {
+    ODFKernels::Stencil stencil = ODFKernels::CreateStencil(0);
+    DREAM3D_REQUIRE_EQUAL(stencil.size(), 1)
+    stencil = ODFKernels::CreateStencil(1);
+    DREAM3D_REQUIRE_EQUAL(stencil.size(), 7)
+    stencil = ODFKernels::CreateStencil(-1);
+    DREAM3D_REQUIRE_EQUAL(stencil.size(), 0)
+
+    // Few components with a uniform background and many components that are scaled down to the total weight
+    TestODFKernel<CubicOps>(10, 100.0f);
+    TestODFKernel<CubicOps>(5 * ODFKernels::k_MinComponentsPerPartition + 3, 10.0f);
+    TestODFKernel<HexagonalOps>(3 * ODFKernels::k_MinComponentsPerPartition, 1.0f);
+  }
+
+  void TestOdfGridResolution()
+  {
+    CubicOps ops;
+    const OdfGrid linearGrid = ops.createOdfGrid(2.5, OdfGrid::Layout::Linear);
+    const OdfGrid blockedGrid = ops.createOdfGrid(2.5, OdfGrid::Layout::Blocked);
+
+    std::vector<float> e1s = {0.5f, 1.5f};
+    std::vector<float> e2s = {0.25f, 0.5f};
+    std::vector<float> e3s = {0.75f, 0.1f};
+    std::vector<float> weights = {50000.0f, 20000.0f};
+    std::vector<float> sigmas = {4.0f, 2.0f};
+    std::vector<float> linearOdf;
+    std::vector<float> blockedOdf;
+    Texture::CalculateODFData<float, CubicOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, linearOdf, e1s.size(), linearGrid);
+    Texture::CalculateODFData<float, CubicOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, blockedOdf, e1s.size(), blockedGrid);
+    DREAM3D_REQUIRE_EQUAL(linearOdf.size(), linearGrid.size())
+    DREAM3D_REQUIRE_EQUAL(blockedOdf.size(), linearGrid.size())
+
+    // Both layouts hold the same ODF in a different order
+    for(int index = 0; index < static_cast<int>(linearGrid.size()); index++)
+    {
+      const std::array<int32_t, 3> position = linearGrid.getBinPosition(index);
+      DREAM3D_REQUIRE_EQUAL(linearOdf[index], blockedOdf[blockedGrid.getIndex(position[0], position[1], position[2])])
+    }
+
+    // Orientations drawn from the fine ODF must fall into bins that have a density
+    const size_t numPoints = 2000;
+    std::vector<float> eulers(numPoints * 3);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(blockedOdf, blockedGrid, eulers.data(), numPoints, 5);
+    const float background = *std::min_element(blockedOdf.begin(), blockedOdf.end());
+    size_t numTextured = 0;
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      OrientationD eu(eulers[3 * i], eulers[3 * i + 1], eulers[3 * i + 2]);
+      OrientationD rod = ops.getODFFZRod(OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu));
+      const int bin = ops.getOdfBin(blockedGrid, rod);
+      numTextured += blockedOdf[bin] > background ? 1 : 0;
+    }
+    DREAM3D_REQUIRE(numTextured > numPoints / 2)
+  }
+
   void operator()()
   {
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
@@ -193,6 +526,12 @@ public:
     int err = EXIT_SUCCESS;
     DREAM3D_REGISTER_TEST(TestOdfGeneration())
     DREAM3D_REGISTER_TEST(TestMdfGeneration())
+    DREAM3D_REGISTER_TEST(TestPhilox4x32())
+    DREAM3D_REGISTER_TEST(TestSeededSampling())
+    DREAM3D_REGISTER_TEST(TestODFSampler())
+    DREAM3D_REGISTER_TEST(TestMDFSampling())
+    DREAM3D_REGISTER_TEST(TestODFKernels())
+    DREAM3D_REGISTER_TEST(TestOdfGridResolution())
   }
 
 public: